@@ -21,9 +21,10 @@
 // ============================================================================
 // DISPLAY CONFIGURATION (SH1106 OLED)
 // ============================================================================
-#define DISPLAY_WIDTH       128
-#define DISPLAY_HEIGHT      64
+// Panel size: DISPLAY_WIDTH/DISPLAY_HEIGHT in DisplayManager.h (one
+// definition for every translation unit; override with build flags)
 #define DISPLAY_I2C_ADDRESS 0x3C  // Common address (try 0x3D if not working)
+#define STATUS_BAR_AUTOHIDE_MS 30000  // Status icons hide after 30 s without changes
 
 // I2C Pins for Display & Sensors
 #define I2C_SDA_PIN         6     // GPIO8 (adjust for your board)
@@ -61,6 +62,7 @@
 // ============================================================================
 #define SOUND_SENSOR_PIN    0     // HW-484 analog output - GPIO0/ADC1-0
 #define DHT11_PIN           5     // Digital pin for DHT11 - GPIO5/D5
+#define LIGHT_SENSOR_PIN    -1    // Optional LDR divider on a spare ADC pin (-1 = none)
 
 // ============================================================================
 // AUDIO FEEDBACK
@@ -68,11 +70,32 @@
 #define BUZZER_PIN          8     // GPIO8 for passive buzzer (PWM capable)
 
 
+// ============================================================================
+// NETWORK
+// ============================================================================
+#define DNS_PRIMARY_SERVER   "8.8.8.8"  // Upstream resolvers, applied once on connect
+#define DNS_SECONDARY_SERVER "8.8.4.4"  // ("" = keep the DHCP-provided server)
+
+// Extra weather places after the geolocated one (up to 4), paged with the encoder
+// #define WEATHER_EXTRA_PLACES { {"Office", 59.9139f, 10.7522f}, {"Cabin", 61.1153f, 10.4662f} }
+
+// Network windows: jobs run together, radio off in between
+#define NET_RADIO_OFF_BETWEEN_WINDOWS 1
+#define NET_WEATHER_FLEX_MS     (30UL * 60UL * 1000UL)       // Weather may run 30 min early
+#define NET_WEATHER_TIMEOUT_MS  90000UL
+#define NET_NTP_INTERVAL_MS     (6UL * 60UL * 60UL * 1000UL) // Resync clock every 6 hours...
+#define NET_NTP_FLEX_MS         (3UL * 60UL * 60UL * 1000UL) // ...or up to 3 hours early
+#define NET_NTP_RETRY_MS        (10UL * 60UL * 1000UL)
+#define NET_NTP_TIMEOUT_MS      10000UL
+
+
 // ============================================================================
 // POWER MANAGEMENT
 // ============================================================================
 #define BATTERY_ADC_PIN     ADC1_CHANNEL_0  // Battery voltage monitor
 #define SLEEP_TIMEOUT_MS    300000          // 5 minutes idle -> sleep
+#define SLEEP_ANIM_DURATION_MS 60000        // Sleeping face for 1 min before dimming
+#define DISPLAY_DIM_DURATION_MS 8000        // Contrast ramp-down before display off
 #define DEEP_SLEEP_TIMEOUT_MS 900000        // 15 min idle -> deep sleep
 
 // ============================================================================
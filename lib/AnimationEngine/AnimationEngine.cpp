@@ -6,10 +6,7 @@
 #include "AnimationEngine.h"
 
 // Include animation data
-#include "animations/anim_idle.h"
-#include "animations/anim_wink.h"
-#include "animations/anim_surprised.h"
-#include "animations/anim_dizzy.h"
+#include "animations/anim_library.h"
 
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
@@ -23,11 +20,14 @@ AnimationEngine::AnimationEngine(DisplayManager* display)
       _currentFrame(0),
       _lastFrameTime(0),
       _globalFPS(0),  // 0 = use animation's own FPS
+      _timeScale(100),
       _playing(false),
       _paused(false),
       _autoReturnToIdle(true),
       _forceLoop(false),
-      _continuousLoop(false)
+      _continuousLoop(false),
+      _playOnce(false),
+      _frameDirty(true)
 {
     // Initialize animation registry
     for (uint8_t i = 0; i < 8; i++) {
@@ -43,6 +43,7 @@ void AnimationEngine::init() {
     registerAnimation(AnimState::WINK, &anim_wink);
     registerAnimation(AnimState::SURPRISED, &anim_surprised);
     registerAnimation(AnimState::DIZZY, &anim_dizzy);
+    registerAnimation(AnimState::SLEEPING, &anim_sleeping);
     
     // Start with idle animation
     play(AnimState::IDLE);
@@ -80,12 +81,21 @@ void AnimationEngine::play(AnimState state, bool priority, bool forceLoop) {
     _paused = false;
     _forceLoop = forceLoop;
     _continuousLoop = forceLoop;  // Track if we should keep looping
+    _playOnce = false;
+    _frameDirty = true;
 
     // Serial.printf("[ANIM] Playing: %s (%d frames)%s\n",
                 //   anim->name, anim->frameCount,
                 //   forceLoop ? " [CONTINUOUS LOOP]" : "");
 }
 
+void AnimationEngine::playOnce(AnimState state) {
+    play(state, true);
+    if (_currentState == state && _playing) {
+        _playOnce = true;
+    }
+}
+
 void AnimationEngine::stop() {
     _playing = false;
     _currentFrame = 0;
@@ -119,15 +129,13 @@ void AnimationEngine::update() {
 void AnimationEngine::draw() {
     if (_currentAnimation == nullptr) return;
     
-    // Get current frame bitmap
-    const uint8_t* frameBitmap = _currentAnimation->frames[_currentFrame];
-    
-    // Draw centered on display
-    _display->drawBitmapCentered(
-        frameBitmap,
-        _currentAnimation->width,
-        _currentAnimation->height
-    );
+    // Draw current frame centered on display
+    _display->drawAssetCentered(_currentAnimation->frames[_currentFrame]);
+}
+
+void AnimationEngine::printAssetReport() const {
+    ::printAssetReport("ANIM", FACE_FRAME_NAMES, FACE_DEDUP, FACE_POOL);
+    ::printAssetReport("ANIM", SMALL_FRAME_NAMES, SMALL_DEDUP, SMALL_POOL);
 }
 
 // ============================================================================
@@ -138,6 +146,7 @@ void AnimationEngine::advanceFrame() {
     if (_currentAnimation == nullptr) return;
 
     _currentFrame++;
+    _frameDirty = true;
 
     // Check if animation complete
     if (_currentFrame >= _currentAnimation->frameCount) {
@@ -145,7 +154,7 @@ void AnimationEngine::advanceFrame() {
                     //   _currentAnimation->loop, _continuousLoop);
 
         // Check if should loop
-        if (_currentAnimation->loop || _continuousLoop) {
+        if ((_currentAnimation->loop && !_playOnce) || _continuousLoop) {
             // Loop back to start
             _currentFrame = 0;
             // Serial.println("[ANIM] Looping to frame 0");
@@ -166,22 +175,25 @@ void AnimationEngine::onAnimationComplete() {
     _playing = false;
     _continuousLoop = false;
     _forceLoop = false;
+    _playOnce = false;
 
     // Don't auto-return to idle - main loop will handle showing base frame
     // This prevents double animation triggers
 }
 
-uint16_t AnimationEngine::getFrameDelay() {
+uint16_t AnimationEngine::getFrameDelay() const {
+    if (_currentAnimation == nullptr) return 0;
+
     // Check if animation has per-frame delays
     if (_currentAnimation->frameDelays != nullptr) {
         // Use specific delay for current frame
         float delaySeconds = pgm_read_float(&_currentAnimation->frameDelays[_currentFrame]);
-        return (uint16_t)(delaySeconds * 1000.0f);  // Convert to milliseconds
+        return (uint16_t)(delaySeconds * 1000.0f * 100 / _timeScale);  // Convert to milliseconds
     }
     
     // Fall back to FPS-based timing
     uint8_t fps = _globalFPS > 0 ? _globalFPS : _currentAnimation->fps;
-    return 1000 / fps;
+    return (uint16_t)(1000UL * 100 / ((uint32_t)fps * _timeScale));
 }
 
 const Animation* AnimationEngine::getAnimation(AnimState state) {
@@ -208,6 +220,10 @@ void AnimationEngine::setGlobalFPS(uint8_t fps) {
     _globalFPS = constrain(fps, 1, 30);
 }
 
+void AnimationEngine::setTimeScale(uint8_t percent) {
+    _timeScale = constrain(percent, 25, 200);
+}
+
 void AnimationEngine::setAutoReturnToIdle(bool enabled) {
     _autoReturnToIdle = enabled;
 }
@@ -216,6 +232,7 @@ void AnimationEngine::pauseOnFrame(uint8_t frameIndex) {
     if (_currentAnimation != nullptr && frameIndex < _currentAnimation->frameCount) {
         _currentFrame = frameIndex;
         _paused = true;
+        _frameDirty = true;
     }
 }
 
@@ -240,6 +257,8 @@ void AnimationEngine::showStaticFrame(AnimState state, uint8_t frameIndex) {
     _paused = false;
     _continuousLoop = false;
     _forceLoop = false;
+    _playOnce = false;
+    _frameDirty = true;
 
     // Serial.printf("[ANIM] Static frame: %s[%d]\n", anim->name, frameIndex);
 }
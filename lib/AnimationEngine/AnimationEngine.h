@@ -8,7 +8,7 @@
  * - Multiple animation states
  * - Configurable FPS (1-30)
  * - Event-triggered transitions
- * - Memory-efficient PROGMEM storage
+ * - Page-major frames transcoded and deduplicated at compile time
  */
 
 #ifndef ANIMATION_ENGINE_H
@@ -35,7 +35,7 @@ enum class AnimState {
 // ANIMATION STRUCTURE
 // ============================================================================
 struct Animation {
-    const uint8_t* const* frames;   // Array of bitmap frame pointers
+    const PageAsset* frames;        // Transcoded frames (see anim_library.h)
     uint8_t frameCount;             // Number of frames in animation
     uint8_t width;                  // Frame width in pixels
     uint8_t height;                 // Frame height in pixels
@@ -74,6 +74,13 @@ public:
      * @param forceLoop Override animation's loop setting
      */
     void play(AnimState state, bool priority = false, bool forceLoop = false);    
+
+    /**
+     * @brief Play an animation exactly once, even if it is marked as looping
+     * Used for blinks and random actions that must end on their own.
+     * @param state AnimState to play
+     */
+    void playOnce(AnimState state);
     
     /**
      * @brief Stop current animation
@@ -103,12 +110,41 @@ public:
      * @return Frame index
      */
     uint8_t getCurrentFrame() const { return _currentFrame; }
+
+    /**
+     * @brief Get time at which the next frame is due
+     * @return Absolute millis() deadline (only meaningful while playing)
+     */
+    unsigned long getNextFrameTime() const { return _lastFrameTime + getFrameDelay(); }
+
+    /**
+     * @brief Check if the visible frame changed since last clearFrameDirty()
+     * @return true if the display needs to be redrawn
+     */
+    bool isFrameDirty() const { return _frameDirty; }
+
+    /**
+     * @brief Acknowledge that the current frame has been drawn
+     */
+    void clearFrameDirty() { _frameDirty = false; }
     
     /**
      * @brief Set global FPS (overrides individual animation FPS)
      * @param fps Frames per second (1-30)
      */
     void setGlobalFPS(uint8_t fps);
+
+    /**
+     * @brief Slow down or speed up playback (scales every frame delay)
+     * @param percent Playback speed in percent (25-200, 100 = normal)
+     */
+    void setTimeScale(uint8_t percent);
+
+    /**
+     * @brief Get playback speed
+     * @return Percent of normal speed
+     */
+    uint8_t getTimeScale() const { return _timeScale; }
     
     /**
      * @brief Enable/disable auto-return to idle
@@ -157,6 +193,11 @@ public:
      */
     void stopLoopingGracefully();
 
+    /**
+     * @brief Print flash use of the built-in frames, per frame
+     */
+    void printAssetReport() const;
+
 
 private:
     DisplayManager* _display;
@@ -170,6 +211,7 @@ private:
     uint8_t _currentFrame;
     unsigned long _lastFrameTime;
     uint8_t _globalFPS;
+    uint8_t _timeScale;     // Playback speed in percent
     bool _playing;
     bool _paused;
     bool _autoReturnToIdle;
@@ -181,9 +223,11 @@ private:
     const Animation* getAnimation(AnimState state);
     void advanceFrame();
     void onAnimationComplete();
-    uint16_t getFrameDelay();
+    uint16_t getFrameDelay() const;
     bool _forceLoop;
     bool _continuousLoop;  // Keep looping until explicitly stopped
+    bool _playOnce;        // Ignore the animation's loop flag for this run
+    bool _frameDirty;      // Visible frame changed since last draw
 };
 
 #endif // ANIMATION_ENGINE_H
\ No newline at end of file
@@ -12,104 +12,235 @@
 AnimationStateMachine::AnimationStateMachine(AnimationEngine* animator)
     : _animator(animator),
       _behaviorState(BehaviorState::IDLE_BASE),
-      _lastBlinkTime(0),
-      _nextBlinkDelay(0),
+      _nextBlinkTime(0),
       _blinkMinInterval(3),     // 3 seconds minimum
       _blinkMaxInterval(8),     // 8 seconds maximum
-      _lastRandomActionTime(0),
-      _nextRandomActionDelay(0),
+      _nextRandomActionTime(0),
       _randomActionMinInterval(15),  // 15 seconds minimum
       _randomActionMaxInterval(45),  // 45 seconds maximum
       _randomActionChance(30),       // 30% chance when interval hits
       _currentReaction(AnimState::IDLE),
       _reactionLooping(false),
       _isShaking(false),
+      _lastShakeTime(0),
+      _lastSoundReaction(0),
       _autoBlinkEnabled(true),
-      _randomActionsEnabled(true)
+      _randomActionsEnabled(true),
+      _showingSleepyFace(false),
+      _eventHead(0),
+      _eventCount(0)
 {
 }
 
 void AnimationStateMachine::init() {
     Serial.println("[STATE] Initializing animation state machine...");
-    
+
+    // Hardware-seeded on device; call seed() afterwards for reproducible runs
+    _planner.seed((uint32_t)random(1, 0x7FFFFFFF));
+
     // Start with base frame (idle frame 0)
-    _animator->play(AnimState::IDLE);
-    _animator->setPaused(true);  // Pause on first frame
-    _behaviorState = BehaviorState::IDLE_BASE;
-    
+    returnToBase();
+
     // Schedule first blink
-    scheduleNextBlink();
-    scheduleNextRandomAction();
-    
+    unsigned long now = millis();
+    scheduleNextBlink(now);
+    scheduleNextRandomAction(now);
+
     Serial.println("[STATE] State machine ready - showing base frame");
 }
 
+// ============================================================================
+// EVENT QUEUE
+// ============================================================================
+
+bool AnimationStateMachine::postEvent(BehaviorEvent event) {
+    // Coalesce back-to-back repeats (USER_INPUT comes with every button,
+    // encoder step and touch)
+    if (_eventCount > 0) {
+        uint8_t last = (_eventHead + _eventCount - 1) % EVENT_QUEUE_SIZE;
+        if (_events[last] == event) {
+            return true;
+        }
+    }
+
+    if (_eventCount >= EVENT_QUEUE_SIZE) {
+        Serial.println("[STATE] Event queue full, dropping event");
+        return false;
+    }
+
+    uint8_t tail = (_eventHead + _eventCount) % EVENT_QUEUE_SIZE;
+    _events[tail] = event;
+    _eventCount++;
+    return true;
+}
+
+void AnimationStateMachine::processEvent(BehaviorEvent event, unsigned long now) {
+    switch (event) {
+        case BehaviorEvent::USER_INPUT:
+            _planner.noteInteraction(now);
+            break;
+
+        case BehaviorEvent::TAP:
+            _planner.noteInteraction(now);
+            if (!_isShaking) {
+                triggerReaction(AnimState::SURPRISED);
+            }
+            break;
+
+        case BehaviorEvent::DOUBLE_TAP:
+            _planner.noteInteraction(now);
+            if (!_isShaking) {
+                triggerReaction(AnimState::WINK);
+            }
+            break;
+
+        case BehaviorEvent::SHAKE:
+            _planner.noteInteraction(now);
+            _lastShakeTime = now;
+            if (!_isShaking) {
+                _isShaking = true;
+                triggerReaction(AnimState::DIZZY, true);
+            }
+            break;
+
+        case BehaviorEvent::LOUD_SOUND:
+            // Only react from the resting face, and not every few seconds
+            if (_behaviorState == BehaviorState::IDLE_BASE && _planner.allowSoundReaction() &&
+                now - _lastSoundReaction >= SOUND_REACTION_COOLDOWN_MS) {
+                _lastSoundReaction = now;
+                triggerReaction(AnimState::SURPRISED);
+            }
+            break;
+
+        case BehaviorEvent::PICKED_UP:
+            _planner.noteInteraction(now);
+            if (_behaviorState == BehaviorState::IDLE_BASE) {
+                triggerReaction(AnimState::WINK);
+            }
+            break;
+
+        case BehaviorEvent::SLEEP:
+            _isShaking = false;
+            triggerReaction(AnimState::SLEEPING, true);
+            break;
+
+        case BehaviorEvent::RESUME:
+            _isShaking = false;
+            _reactionLooping = false;
+            returnToBase();
+            scheduleNextBlink(now);
+            scheduleNextRandomAction(now);
+            break;
+    }
+}
+
 // ============================================================================
 // UPDATE METHOD
 // ============================================================================
 
 void AnimationStateMachine::update() {
+    unsigned long now = millis();
+
+    while (_eventCount > 0) {
+        BehaviorEvent event = _events[_eventHead];
+        _eventHead = (_eventHead + 1) % EVENT_QUEUE_SIZE;
+        _eventCount--;
+        processEvent(event, now);
+    }
+
+    // Nothing scheduled yet - the face is static, no work to do
+    if ((long)(now - getNextWakeTime()) < 0) {
+        return;
+    }
+
     switch (_behaviorState) {
         case BehaviorState::IDLE_BASE:
-            updateIdleBase();
+            updateIdleBase(now);
             break;
-            
+
         case BehaviorState::BLINKING:
             updateBlinking();
             break;
-            
+
         case BehaviorState::RANDOM_ACTION:
             updateRandomAction();
             break;
-            
+
         case BehaviorState::REACTING:
-            updateReacting();
+            updateReacting(now);
             break;
-            
+
         case BehaviorState::TRANSITIONING:
             returnToBase();
             break;
     }
 }
 
+unsigned long AnimationStateMachine::getNextWakeTime() const {
+    switch (_behaviorState) {
+        case BehaviorState::IDLE_BASE: {
+            unsigned long wake = _nextBlinkTime;
+            if (_randomActionsEnabled &&
+                (!_autoBlinkEnabled || (long)(_nextRandomActionTime - wake) < 0)) {
+                wake = _nextRandomActionTime;
+            }
+            if (!_autoBlinkEnabled && !_randomActionsEnabled) {
+                // Far in the future, but still comparable with millis()
+                wake = millis() + 60000UL;
+            }
+            return wake;
+        }
+
+        case BehaviorState::REACTING:
+            if (_isShaking) {
+                // Dizzy keeps looping on its own until shaking stops
+                return _lastShakeTime + SHAKE_COOLDOWN_MS;
+            }
+            // Fall through - wait for the animation to finish
+        case BehaviorState::BLINKING:
+        case BehaviorState::RANDOM_ACTION:
+            return _animator->isPlaying() ? _animator->getNextFrameTime() : millis();
+
+        case BehaviorState::TRANSITIONING:
+        default:
+            return millis();
+    }
+}
+
+bool AnimationStateMachine::hasPendingWork(unsigned long now) const {
+    return _eventCount > 0 || (long)(now - getNextWakeTime()) >= 0;
+}
+
 // ============================================================================
 // STATE UPDATE METHODS
 // ============================================================================
 
-void AnimationStateMachine::updateIdleBase() {
-    unsigned long currentTime = millis();
-    
+void AnimationStateMachine::updateIdleBase(unsigned long now) {
     // Check for scheduled blink
-    if (_autoBlinkEnabled && (currentTime - _lastBlinkTime >= _nextBlinkDelay * 1000UL)) {
+    if (_autoBlinkEnabled && (long)(now - _nextBlinkTime) >= 0) {
         Serial.println("[STATE] Natural blink triggered");
-        _animator->play(AnimState::IDLE);
-        _animator->setPaused(false);
+        _animator->playOnce(AnimState::IDLE);
         _behaviorState = BehaviorState::BLINKING;
-        _lastBlinkTime = currentTime;
-        scheduleNextBlink();
+        scheduleNextBlink(now);
         return;
     }
-    
+
     // Check for random action
-    if (_randomActionsEnabled && 
-        (currentTime - _lastRandomActionTime >= _nextRandomActionDelay * 1000UL)) {
-        
-        // Random chance to trigger
-        if (random(100) < _randomActionChance) {
-            Serial.println("[STATE] Random wink triggered!");
-            _animator->play(AnimState::WINK);  // Using HAPPY for wink, change if you have separate wink state
+    if (_randomActionsEnabled && (long)(now - _nextRandomActionTime) >= 0) {
+        AnimState action = pickRandomAction(now);
+        if (action != AnimState::IDLE) {
+            Serial.printf("[STATE] Random action triggered: %d\n", (int)action);
+            _animator->playOnce(action);
             _behaviorState = BehaviorState::RANDOM_ACTION;
         }
-        
-        _lastRandomActionTime = currentTime;
-        scheduleNextRandomAction();
+
+        scheduleNextRandomAction(now);
     }
 }
 
 void AnimationStateMachine::updateBlinking() {
     // Check if blink animation finished
     if (!_animator->isPlaying()) {
-        Serial.println("[STATE] Blink complete, returning to base");
         returnToBase();
     }
 }
@@ -122,13 +253,20 @@ void AnimationStateMachine::updateRandomAction() {
     }
 }
 
-void AnimationStateMachine::updateReacting() {
+void AnimationStateMachine::updateReacting(unsigned long now) {
+    // Shaking stopped - let the dizzy loop finish its current cycle
+    if (_isShaking && now - _lastShakeTime >= SHAKE_COOLDOWN_MS) {
+        Serial.println("[STATE] Shaking stopped");
+        _isShaking = false;
+        stopReaction();
+    }
+
     // If we stopped the loop but animation is still finishing
     if (!_reactionLooping && !_animator->isPlaying()) {
         Serial.println("[STATE] Reaction finished, returning to base");
         returnToBase();
     }
-    
+
     // If looping, animation continues until stopReaction() is called
 }
 
@@ -139,24 +277,25 @@ void AnimationStateMachine::updateReacting() {
 
 void AnimationStateMachine::triggerReaction(AnimState state, bool loop) {
     // Don't restart if already playing the same looping reaction
-    if (_behaviorState == BehaviorState::REACTING && 
-        _currentReaction == state && 
+    if (_behaviorState == BehaviorState::REACTING &&
+        _currentReaction == state &&
         _reactionLooping &&
         loop) {
-        // Already playing this looping animation, don't restart
-        Serial.println("[STATE] Already reacting with this animation (no restart)");
         return;
     }
-    
-    Serial.printf("[STATE] Triggering reaction: %d (loop: %s)\n", 
+
+    Serial.printf("[STATE] Triggering reaction: %d (loop: %s)\n",
                   (int)state, loop ? "yes" : "no");
-    
+
     _currentReaction = state;
     _reactionLooping = loop;
     _behaviorState = BehaviorState::REACTING;
-    
-    // Use forceLoop parameter for animations that should loop during reaction
-    _animator->play(state, true, loop);  // ⭐ Pass loop to animator
+
+    if (loop) {
+        _animator->play(state, true, true);
+    } else {
+        _animator->playOnce(state);  // Ends even if the animation itself loops
+    }
 }
 
 void AnimationStateMachine::stopReaction() {
@@ -174,24 +313,53 @@ void AnimationStateMachine::stopReaction() {
 // ============================================================================
 
 void AnimationStateMachine::returnToBase() {
-    Serial.println("[STATE] Returning to base frame");
-    _animator->play(AnimState::IDLE);
-    _animator->setPaused(true);  // Pause on frame 0
+    _showingSleepyFace = _planner.isSleepy();
+    _animator->showStaticFrame(AnimState::IDLE, _showingSleepyFace ? SLEEPY_FRAME : 0);
     _behaviorState = BehaviorState::IDLE_BASE;
 }
 
+// ============================================================================
+// CONTEXT
+// ============================================================================
+
+void AnimationStateMachine::setContext(const PlannerInputs& inputs) {
+    _planner.update(inputs, millis());
+
+    // Slower playback at low activity means fewer redraws
+    _animator->setTimeScale(_planner.getAnimationTimeScale());
+
+    // Swap the resting face when sleepiness changes
+    if (_behaviorState == BehaviorState::IDLE_BASE &&
+        _planner.isSleepy() != _showingSleepyFace) {
+        Serial.printf("[STATE] %s\n", _planner.isSleepy() ? "Getting sleepy" : "Waking up");
+        returnToBase();
+    }
+}
+
+AnimState AnimationStateMachine::pickRandomAction(unsigned long now) {
+    switch (_planner.pickAction(_randomActionChance, now)) {
+        case PlannedAction::WINK:
+            return AnimState::WINK;
+        case PlannedAction::SURPRISED:
+            return AnimState::SURPRISED;
+        case PlannedAction::NONE:
+        default:
+            return AnimState::IDLE;
+    }
+}
+
 // ============================================================================
 // SCHEDULING
 // ============================================================================
 
-void AnimationStateMachine::scheduleNextBlink() {
-    _nextBlinkDelay = random(_blinkMinInterval, _blinkMaxInterval + 1);
-    Serial.printf("[STATE] Next blink scheduled in %d seconds\n", _nextBlinkDelay);
+void AnimationStateMachine::scheduleNextBlink(unsigned long now) {
+    _nextBlinkTime = now + _planner.nextBlinkDelay(_blinkMinInterval * 1000UL,
+                                                   _blinkMaxInterval * 1000UL);
 }
 
-void AnimationStateMachine::scheduleNextRandomAction() {
-    _nextRandomActionDelay = random(_randomActionMinInterval, _randomActionMaxInterval + 1);
-    Serial.printf("[STATE] Next random action check in %d seconds\n", _nextRandomActionDelay);
+void AnimationStateMachine::scheduleNextRandomAction(unsigned long now) {
+    _nextRandomActionTime = now + _planner.randomRange(_randomActionMinInterval * 1000UL,
+                                                       _randomActionMaxInterval * 1000UL + 1);
 }
 
 // ============================================================================
@@ -218,4 +386,4 @@ void AnimationStateMachine::enableAutoBlink(bool enabled) {
 
 void AnimationStateMachine::enableRandomActions(bool enabled) {
     _randomActionsEnabled = enabled;
-}
\ No newline at end of file
+}
@@ -1,7 +1,17 @@
 /**
  * @file AnimationStateMachine.h
  * @brief Intelligent animation state management with natural behaviors
- * @version 1.0.0
+ * @version 1.2.0
+ *
+ * Single owner of the idle face behaviors:
+ * - Scheduled blinks and random actions (wink, surprised)
+ * - Reactions to input, touch, motion, activity and sound events
+ * - Context weighting via BehaviorPlanner (sound, motion, clock, input)
+ * - Sleepy face at night, slower playback at low activity
+ *
+ * Events are queued from input callbacks and processed in update().
+ * Between scheduled deadlines update() returns immediately, so the
+ * idle face costs no CPU until the next blink is due.
  */
 
 #ifndef ANIMATION_STATE_MACHINE_H
@@ -9,6 +19,7 @@
 
 #include <Arduino.h>
 #include "AnimationEngine.h"
+#include "BehaviorPlanner.h"
 
 // ============================================================================
 // BEHAVIOR STATE
@@ -21,6 +32,20 @@ enum class BehaviorState {
     TRANSITIONING       // Returning to base
 };
 
+// ============================================================================
+// BEHAVIOR EVENTS (queued, processed in update())
+// ============================================================================
+enum class BehaviorEvent : uint8_t {
+    USER_INPUT,         // Button/encoder activity (interaction recency only)
+    TAP,                // Touch tap -> surprised
+    DOUBLE_TAP,         // Touch double tap -> wink
+    SHAKE,              // Shake detected -> dizzy loop while shaking
+    LOUD_SOUND,         // Ambient sound spike -> surprised
+    PICKED_UP,          // Lifted off the desk -> wink
+    SLEEP,              // Idle timeout -> sleeping loop until RESUME
+    RESUME              // Face view re-entered -> base frame, reschedule
+};
+
 // ============================================================================
 // ANIMATION STATE MACHINE CLASS
 // ============================================================================
@@ -31,87 +56,146 @@ public:
      * @param animator Pointer to AnimationEngine
      */
     AnimationStateMachine(AnimationEngine* animator);
-    
+
     /**
      * @brief Initialize state machine
      */
     void init();
-    
+
     /**
      * @brief Update state machine (call in loop)
+     * Drains the event queue, then returns immediately unless a
+     * scheduled deadline has passed or an animation is running.
      */
     void update();
-    
+
+    /**
+     * @brief Queue a behavior event (safe to call from input callbacks)
+     * @param event Event to queue
+     * @return false if the queue was full and the event was dropped
+     */
+    bool postEvent(BehaviorEvent event);
+
+    /**
+     * @brief Feed sensed context to the planner (call ~once per second)
+     * @param inputs Sound, motion and clock readings
+     */
+    void setContext(const PlannerInputs& inputs);
+
+    /**
+     * @brief Get the next time update() has work to do
+     * @return Absolute millis() deadline
+     */
+    unsigned long getNextWakeTime() const;
+
+    /**
+     * @brief Check if update() has work pending (queued event or deadline)
+     * @param now Current millis()
+     */
+    bool hasPendingWork(unsigned long now) const;
+
     /**
      * @brief Trigger a reaction animation (interrupts current state)
      * @param state Animation state to play
      * @param loop Whether to loop the animation
      */
     void triggerReaction(AnimState state, bool loop = false);
-    
+
     /**
      * @brief Stop current reaction and return to base
      */
     void stopReaction();
-    
+
     /**
      * @brief Check if currently reacting (for input blocking)
      * @return true if in reaction state
      */
     bool isReacting() const { return _behaviorState == BehaviorState::REACTING; }
-    
+
+    /**
+     * @brief Check if a shake reaction is active
+     */
+    bool isShaking() const { return _isShaking; }
+
     /**
      * @brief Set timing parameters
      */
     void setBlinkInterval(uint16_t minSeconds, uint16_t maxSeconds);
     void setRandomActionInterval(uint16_t minSeconds, uint16_t maxSeconds);
     void setRandomActionChance(uint8_t percent);
-    
+
     /**
      * @brief Enable/disable autonomous behaviors
      */
     void enableAutoBlink(bool enabled);
     void enableRandomActions(bool enabled);
-    
+
     /**
      * @brief Get current behavior state
      */
     BehaviorState getBehaviorState() const { return _behaviorState; }
 
-    
+    /**
+     * @brief Get behavior planner (activity level, loop delay)
+     */
+    const BehaviorPlanner& getPlanner() const { return _planner; }
+
+    /**
+     * @brief Seed the planner's RNG (fixed seed = reproducible behavior)
+     */
+    void seed(uint32_t seed) { _planner.seed(seed); }
+
+
 private:
     AnimationEngine* _animator;
     BehaviorState _behaviorState;
-    
-    // Timing
-    unsigned long _lastBlinkTime;
-    unsigned long _nextBlinkDelay;
+
+    // Timing (absolute millis() deadlines)
+    unsigned long _nextBlinkTime;
     uint16_t _blinkMinInterval;
     uint16_t _blinkMaxInterval;
-    
-    unsigned long _lastRandomActionTime;
-    unsigned long _nextRandomActionDelay;
+
+    unsigned long _nextRandomActionTime;
     uint16_t _randomActionMinInterval;
     uint16_t _randomActionMaxInterval;
     uint8_t _randomActionChance;
-    
+
     // Reaction tracking
     AnimState _currentReaction;
     bool _reactionLooping;
     bool _isShaking;
-    
+    unsigned long _lastShakeTime;
+    unsigned long _lastSoundReaction;
+
     // Autonomous behavior flags
     bool _autoBlinkEnabled;
     bool _randomActionsEnabled;
-    
+
+    // Context-aware scheduling
+    BehaviorPlanner _planner;
+    bool _showingSleepyFace;
+
+    // Event queue (ring buffer, single producer/consumer on the main loop)
+    static constexpr uint8_t EVENT_QUEUE_SIZE = 8;
+    BehaviorEvent _events[EVENT_QUEUE_SIZE];
+    uint8_t _eventHead;
+    uint8_t _eventCount;
+
+    // Reaction timing
+    static constexpr unsigned long SHAKE_COOLDOWN_MS = 1000;      // Stop dizzy 1s after last shake
+    static constexpr unsigned long SOUND_REACTION_COOLDOWN_MS = 10000;
+    static constexpr uint8_t SLEEPY_FRAME = 2;                    // Idle frame with half-closed eyes
+
     // Private methods
-    void updateIdleBase();
+    void processEvent(BehaviorEvent event, unsigned long now);
+    void updateIdleBase(unsigned long now);
     void updateBlinking();
     void updateRandomAction();
-    void updateReacting();
-    void scheduleNextBlink();
-    void scheduleNextRandomAction();
+    void updateReacting(unsigned long now);
+    void scheduleNextBlink(unsigned long now);
+    void scheduleNextRandomAction(unsigned long now);
     void returnToBase();
+    AnimState pickRandomAction(unsigned long now);
 };
 
-#endif // ANIMATION_STATE_MACHINE_H
\ No newline at end of file
+#endif // ANIMATION_STATE_MACHINE_H
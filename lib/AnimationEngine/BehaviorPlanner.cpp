@@ -0,0 +1,150 @@
+/**
+ * @file BehaviorPlanner.cpp
+ * @brief Implementation of BehaviorPlanner
+ */
+
+#include "BehaviorPlanner.h"
+
+// ============================================================================
+// CONSTRUCTOR & SEEDING
+// ============================================================================
+
+BehaviorPlanner::BehaviorPlanner()
+    : _rngState(0x9E3779B9u),
+      _soundEma(0),
+      _motionEma(0),
+      _activityEma(50u << EMA_SHIFT),   // Start at medium activity
+      _lastInteraction(0),
+      _hasInteraction(false),
+      _hourOfDay(-1),
+      _sleepy(false),
+      _lowActivity(false)
+{
+}
+
+void BehaviorPlanner::seed(uint32_t seed) {
+    _rngState = seed != 0 ? seed : 0x9E3779B9u;
+}
+
+// ============================================================================
+// SENSOR HISTORY
+// ============================================================================
+
+void BehaviorPlanner::emaStep(uint32_t& ema, uint8_t sample, uint8_t shift) {
+    // ema += (sample - ema) / 2^shift, in Q8
+    int32_t target = (int32_t)sample << EMA_SHIFT;
+    int32_t current = (int32_t)ema;
+    ema = (uint32_t)(current + ((target - current) >> shift));
+}
+
+void BehaviorPlanner::update(const PlannerInputs& inputs, unsigned long now) {
+    _hourOfDay = inputs.hourOfDay;
+
+    // Sound reacts within ~8 samples, motion within ~4
+    emaStep(_soundEma, inputs.soundPercent > 100 ? 100 : inputs.soundPercent, 3);
+    emaStep(_motionEma, inputs.motionPercent > 100 ? 100 : inputs.motionPercent, 2);
+
+    // Instantaneous activity: weighted mix of the three signals
+    uint32_t sound = _soundEma >> EMA_SHIFT;
+    uint32_t motion = _motionEma >> EMA_SHIFT;
+    uint32_t raw = (sound * 35 + motion * 35 + inputScore(now) * 30) / 100;
+
+    // Clock damping: quieter expectations at night
+    if (isNight()) {
+        raw /= 2;
+    }
+
+    // Activity level is slower still (~16 samples), so single spikes
+    // don't flip the low-power mode back and forth
+    emaStep(_activityEma, (uint8_t)raw, 4);
+
+    uint8_t activity = getActivityLevel();
+    _sleepy = isNight() && activity < SLEEPY_ACTIVITY && !hadRecentInteraction(now);
+    _lowActivity = activity < LOW_ACTIVITY && !hadRecentInteraction(now);
+}
+
+void BehaviorPlanner::noteInteraction(unsigned long now) {
+    _lastInteraction = now;
+    _hasInteraction = true;
+
+    // Wake up immediately instead of waiting for the averages
+    _sleepy = false;
+    _lowActivity = false;
+}
+
+uint8_t BehaviorPlanner::inputScore(unsigned long now) const {
+    if (!_hasInteraction) return 0;
+
+    unsigned long age = now - _lastInteraction;
+    if (age <= INPUT_FRESH_MS) return 100;
+    if (age >= INPUT_FADE_MS) return 0;
+    return (uint8_t)(100 - (age - INPUT_FRESH_MS) * 100 / (INPUT_FADE_MS - INPUT_FRESH_MS));
+}
+
+bool BehaviorPlanner::isNight() const {
+    return _hourOfDay >= 0 && (_hourOfDay >= 23 || _hourOfDay < 7);
+}
+
+bool BehaviorPlanner::hadRecentInteraction(unsigned long now) const {
+    return _hasInteraction && now - _lastInteraction < INPUT_FRESH_MS;
+}
+
+// ============================================================================
+// PLANNING
+// ============================================================================
+
+uint32_t BehaviorPlanner::nextBlinkDelay(uint32_t minMs, uint32_t maxMs) {
+    uint32_t delayMs = randomRange(minMs, maxMs + 1);
+
+    if (_sleepy) {
+        delayMs *= 2;               // Slow, heavy blinks
+    } else if (_lowActivity) {
+        delayMs = delayMs * 3 / 2;
+    } else if (getActivityLevel() > 60) {
+        delayMs = delayMs * 3 / 4;  // Lively when things are happening
+    }
+
+    return delayMs;
+}
+
+PlannedAction BehaviorPlanner::pickAction(uint8_t baseChance, unsigned long now) {
+    // Sleepy face stays calm, blinks only
+    if (_sleepy) {
+        return PlannedAction::NONE;
+    }
+
+    // Scale chance with activity: half at 0, double at 100
+    uint32_t chance = (uint32_t)baseChance * (50 + getActivityLevel() * 3 / 2) / 100;
+    if (chance > 100) chance = 100;
+
+    if (randomRange(0, 100) >= chance) {
+        return PlannedAction::NONE;
+    }
+
+    // Wink is friendlier after interaction, surprised likelier when noisy
+    uint32_t winkWeight = hadRecentInteraction(now) ? 6 : 3;
+    uint32_t surprisedWeight = 1 + (_soundEma >> EMA_SHIFT) / 20;
+
+    return randomRange(0, winkWeight + surprisedWeight) < winkWeight
+        ? PlannedAction::WINK
+        : PlannedAction::SURPRISED;
+}
+
+// ============================================================================
+// RANDOM
+// ============================================================================
+
+uint32_t BehaviorPlanner::nextRandom() {
+    // xorshift32
+    uint32_t x = _rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    _rngState = x;
+    return x;
+}
+
+uint32_t BehaviorPlanner::randomRange(uint32_t minValue, uint32_t maxValue) {
+    if (maxValue <= minValue) return minValue;
+    return minValue + nextRandom() % (maxValue - minValue);
+}
@@ -0,0 +1,153 @@
+/**
+ * @file BehaviorPlanner.h
+ * @brief Context-aware scheduling of idle face behaviors
+ * @version 1.0.0
+ *
+ * Derives an activity level (0-100) from sensor history using integer
+ * exponential moving averages:
+ * - Ambient sound (SensorHub)
+ * - Movement (MotionSensor, deviation from 1g)
+ * - Input recency (buttons, encoder, touch)
+ * - Local clock (night damping)
+ *
+ * The activity level drives blink intervals, random expression
+ * probabilities, the sleepy face at night and a low-power render mode.
+ *
+ * No Arduino dependencies and no millis() calls: time is passed in and
+ * randomness comes from a seeded xorshift generator, so a given seed and
+ * input sequence always produce the same plan (host testable).
+ */
+
+#ifndef BEHAVIOR_PLANNER_H
+#define BEHAVIOR_PLANNER_H
+
+#include <stdint.h>
+
+// ============================================================================
+// PLANNER TYPES
+// ============================================================================
+enum class PlannedAction : uint8_t {
+    NONE,
+    WINK,
+    SURPRISED
+};
+
+struct PlannerInputs {
+    uint8_t soundPercent = 0;       // Ambient sound (0-100)
+    uint8_t motionPercent = 0;      // Movement intensity (0-100)
+    int8_t hourOfDay = -1;          // Local hour 0-23, -1 if clock not set
+};
+
+// ============================================================================
+// BEHAVIOR PLANNER CLASS
+// ============================================================================
+class BehaviorPlanner {
+public:
+    BehaviorPlanner();
+
+    /**
+     * @brief Seed the planner's random generator
+     * @param seed Any value (0 is remapped, xorshift needs a non-zero state)
+     */
+    void seed(uint32_t seed);
+
+    /**
+     * @brief Feed one sensor sample (intended cadence: ~1 Hz)
+     * @param inputs Current sensor readings
+     * @param now Current time in ms
+     */
+    void update(const PlannerInputs& inputs, unsigned long now);
+
+    /**
+     * @brief Record a user interaction (button, encoder, touch, shake)
+     * @param now Current time in ms
+     */
+    void noteInteraction(unsigned long now);
+
+    /**
+     * @brief Get smoothed activity level
+     * @return 0 (nothing happening) - 100 (busy)
+     */
+    uint8_t getActivityLevel() const { return (uint8_t)(_activityEma >> EMA_SHIFT); }
+
+    /**
+     * @brief Check if the face should look sleepy (night and quiet)
+     */
+    bool isSleepy() const { return _sleepy; }
+
+    /**
+     * @brief Check if rendering should slow down to save power
+     */
+    bool isLowActivity() const { return _lowActivity; }
+
+    /**
+     * @brief Draw the delay until the next blink
+     * @param minMs Base minimum interval
+     * @param maxMs Base maximum interval
+     * @return Delay in ms, stretched when sleepy/quiet, shortened when busy
+     */
+    uint32_t nextBlinkDelay(uint32_t minMs, uint32_t maxMs);
+
+    /**
+     * @brief Decide whether to play a random expression, and which
+     * @param baseChance Base chance in percent at medium activity
+     * @param now Current time in ms
+     * @return NONE most of the time, WINK or SURPRISED otherwise
+     */
+    PlannedAction pickAction(uint8_t baseChance, unsigned long now);
+
+    /**
+     * @brief Check if a loud sound should trigger a reaction right now
+     */
+    bool allowSoundReaction() const { return !_sleepy; }
+
+    /**
+     * @brief Animation playback speed for current activity
+     * @return Percent of normal speed (100 = normal)
+     */
+    uint8_t getAnimationTimeScale() const { return _lowActivity ? LOW_ACTIVITY_TIME_SCALE : 100; }
+
+    /**
+     * @brief Main loop delay for current activity
+     * @return Delay in ms
+     */
+    uint16_t getLoopDelayMs() const { return _lowActivity ? LOW_ACTIVITY_LOOP_MS : NORMAL_LOOP_MS; }
+
+    /**
+     * @brief Draw a uniform random number in [minValue, maxValue)
+     */
+    uint32_t randomRange(uint32_t minValue, uint32_t maxValue);
+
+    // Tunables (public so host tests can reason about them)
+    static constexpr uint8_t EMA_SHIFT = 8;                 // Q8 fixed point
+    static constexpr uint8_t SLEEPY_ACTIVITY = 20;          // Below this at night -> sleepy
+    static constexpr uint8_t LOW_ACTIVITY = 12;             // Below this -> low power render
+    static constexpr uint8_t LOW_ACTIVITY_TIME_SCALE = 60;  // Percent of normal speed
+    static constexpr uint16_t NORMAL_LOOP_MS = 10;
+    static constexpr uint16_t LOW_ACTIVITY_LOOP_MS = 20;    // Encoder still decodes at this rate
+    static constexpr unsigned long INPUT_FRESH_MS = 30000;  // Full input score for 30s
+    static constexpr unsigned long INPUT_FADE_MS = 600000;  // Fades to zero over 10 minutes
+
+private:
+    uint32_t _rngState;
+
+    // Q8 moving averages (value << EMA_SHIFT)
+    uint32_t _soundEma;
+    uint32_t _motionEma;
+    uint32_t _activityEma;
+
+    unsigned long _lastInteraction;
+    bool _hasInteraction;
+    int8_t _hourOfDay;
+    bool _sleepy;
+    bool _lowActivity;
+
+    uint32_t nextRandom();
+    uint8_t inputScore(unsigned long now) const;
+    bool isNight() const;
+    bool hadRecentInteraction(unsigned long now) const;
+
+    static void emaStep(uint32_t& ema, uint8_t sample, uint8_t shift);
+};
+
+#endif // BEHAVIOR_PLANNER_H
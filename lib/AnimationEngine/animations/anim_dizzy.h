@@ -1,6 +1,9 @@
 /**
  * @file anim_dizzy.h
  * @brief Dizzy animation - confused/shaken (shake response)
+ *
+ * Row-major source frames, read only at compile time. anim_library.h
+ * transcodes them and defines the frame sequence.
  */
 
 #ifndef ANIM_DIZZY_H
@@ -8,7 +11,7 @@
 
 #include <Arduino.h>
 
-const uint8_t PROGMEM dizzy_frame0[] = {
+constexpr uint8_t dizzy_frame0[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -75,7 +78,7 @@ const uint8_t PROGMEM dizzy_frame0[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'dizzy_frame1', 128x64px
-const uint8_t PROGMEM dizzy_frame1[] = {
+constexpr uint8_t dizzy_frame1[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -142,7 +145,7 @@ const uint8_t PROGMEM dizzy_frame1[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'dizzy_frame2', 128x64px
-const uint8_t PROGMEM dizzy_frame2[] = {
+constexpr uint8_t dizzy_frame2[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -209,7 +212,7 @@ const uint8_t PROGMEM dizzy_frame2[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'dizzy_frame3', 128x64px
-const uint8_t PROGMEM dizzy_frame3[] = {
+constexpr uint8_t dizzy_frame3[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -276,7 +279,7 @@ const uint8_t PROGMEM dizzy_frame3[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'dizzy_frame4', 128x64px
-const uint8_t PROGMEM dizzy_frame4[] = {
+constexpr uint8_t dizzy_frame4[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -343,7 +346,7 @@ const uint8_t PROGMEM dizzy_frame4[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'dizzy_frame5', 128x64px
-const uint8_t PROGMEM dizzy_frame5[] = {
+constexpr uint8_t dizzy_frame5[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -410,7 +413,7 @@ const uint8_t PROGMEM dizzy_frame5[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'dizzy_frame6', 128x64px
-const uint8_t PROGMEM dizzy_frame6[] = {
+constexpr uint8_t dizzy_frame6[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -477,26 +480,6 @@ const uint8_t PROGMEM dizzy_frame6[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-
-
-
-// Frame pointers array
-const uint8_t* const dizzy_frames[] PROGMEM = {
-    dizzy_frame0,
-    dizzy_frame1,
-    dizzy_frame2,
-    dizzy_frame3,
-    dizzy_frame4,
-    dizzy_frame5,
-    dizzy_frame6,
-    dizzy_frame2,
-    dizzy_frame3,
-    dizzy_frame4,
-    dizzy_frame5,
-    dizzy_frame1,
-    dizzy_frame0,
-};
-
 const float dizzy_frame_delays[] PROGMEM = {
     0.500f,
     0.100f,
@@ -513,16 +496,4 @@ const float dizzy_frame_delays[] PROGMEM = {
     0.100f,
 };
 
-// Animation structure
-const Animation anim_dizzy = {
-    .frames = dizzy_frames,
-    .frameCount = 13,
-    .width = 128,
-    .height = 64,
-    .fps = 0,
-    .loop = false,
-    .name = "dizzy",
-    .frameDelays = dizzy_frame_delays
-};
-
 #endif // ANIM_DIZZY_H
\ No newline at end of file
@@ -1,6 +1,9 @@
 /**
  * @file anim_idle.h
  * @brief Idle animation - FULL SCREEN 128x64
+ *
+ * Row-major source frames, read only at compile time. anim_library.h
+ * transcodes them and defines the frame sequence.
  */
 
 #ifndef ANIM_IDLE_H
@@ -9,7 +12,7 @@
 #include <Arduino.h>
 
 // 'frame_0_delay-1', 128x64px
-const uint8_t PROGMEM idle_frame0[] = {
+constexpr uint8_t idle_frame0[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -76,7 +79,7 @@ const uint8_t PROGMEM idle_frame0[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'frame_1_delay-0', 128x64px
-const uint8_t PROGMEM idle_frame1[] = {
+constexpr uint8_t idle_frame1[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -143,7 +146,7 @@ const uint8_t PROGMEM idle_frame1[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'frame_2_delay-0', 128x64px
-const uint8_t PROGMEM idle_frame2[] = {
+constexpr uint8_t idle_frame2[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -210,7 +213,7 @@ const uint8_t PROGMEM idle_frame2[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'frame_3_delay-0', 128x64px
-const uint8_t PROGMEM idle_frame3[] = {
+constexpr uint8_t idle_frame3[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -277,17 +280,6 @@ const uint8_t PROGMEM idle_frame3[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-
-const uint8_t* const idle_frames[] PROGMEM = {
-    idle_frame0,
-    idle_frame1,
-    idle_frame2,
-    idle_frame3,
-    idle_frame2,
-    idle_frame1,
-    idle_frame0
-};
-
 const float idle_frame_delays[] PROGMEM = {
     1.2f,
     0.07f,
@@ -298,16 +290,4 @@ const float idle_frame_delays[] PROGMEM = {
     1.3f,
 };
 
-// Animation structure
-const Animation anim_idle = {
-    .frames = idle_frames,
-    .frameCount = 7,
-    .width = 128,           // Full screen width
-    .height = 64,           // Full screen height
-    .fps = 10,              // Fallback FPS (not used if frameDelays != NULL)
-    .loop = true,
-    .name = "idle",
-    .frameDelays = idle_frame_delays  // Use custom timing
-};
-
 #endif
\ No newline at end of file
@@ -0,0 +1,204 @@
+/**
+ * @file anim_library.h
+ * @brief Transcoded, deduplicated frames and the animation definitions
+ *
+ * All frames of one size go through a single table, so a frame that
+ * appears in several animations (the open-eye face starts idle, wink
+ * and dizzy) is stored once. Frame tables point into the pools; the
+ * row-major sources in the anim_*.h headers never reach flash.
+ */
+
+#ifndef ANIM_LIBRARY_H
+#define ANIM_LIBRARY_H
+
+#include "PageAsset.h"
+#include "anim_idle.h"
+#include "anim_wink.h"
+#include "anim_surprised.h"
+#include "anim_dizzy.h"
+#include "anim_sleeping.h"
+
+// ============================================================================
+// FULL-SCREEN FRAMES (128x64)
+// ============================================================================
+
+enum FaceFrame : uint8_t {
+    IDLE_0, IDLE_1, IDLE_2, IDLE_3,
+    WINK_0, WINK_1, WINK_2, WINK_3, WINK_4,
+    DIZZY_0, DIZZY_1, DIZZY_2, DIZZY_3, DIZZY_4, DIZZY_5, DIZZY_6,
+    SLEEPING_0, SLEEPING_1, SLEEPING_2, SLEEPING_3,
+    FACE_FRAME_COUNT
+};
+
+constexpr PageBitmap<128, 64> FACE_SOURCE[FACE_FRAME_COUNT] = {
+    transcodeAsset<128, 64>(idle_frame0),
+    transcodeAsset<128, 64>(idle_frame1),
+    transcodeAsset<128, 64>(idle_frame2),
+    transcodeAsset<128, 64>(idle_frame3),
+    transcodeAsset<128, 64>(wink_frame0),
+    transcodeAsset<128, 64>(wink_frame1),
+    transcodeAsset<128, 64>(wink_frame2),
+    transcodeAsset<128, 64>(wink_frame3),
+    transcodeAsset<128, 64>(wink_frame4),
+    transcodeAsset<128, 64>(dizzy_frame0),
+    transcodeAsset<128, 64>(dizzy_frame1),
+    transcodeAsset<128, 64>(dizzy_frame2),
+    transcodeAsset<128, 64>(dizzy_frame3),
+    transcodeAsset<128, 64>(dizzy_frame4),
+    transcodeAsset<128, 64>(dizzy_frame5),
+    transcodeAsset<128, 64>(dizzy_frame6),
+    transcodeAsset<128, 64>(sleeping_frame0),
+    transcodeAsset<128, 64>(sleeping_frame1),
+    transcodeAsset<128, 64>(sleeping_frame2),
+    transcodeAsset<128, 64>(sleeping_frame3)
+};
+
+const char* const FACE_FRAME_NAMES[FACE_FRAME_COUNT] = {
+    "idle0", "idle1", "idle2", "idle3",
+    "wink0", "wink1", "wink2", "wink3", "wink4",
+    "dizzy0", "dizzy1", "dizzy2", "dizzy3", "dizzy4", "dizzy5", "dizzy6",
+    "sleeping0", "sleeping1", "sleeping2", "sleeping3"
+};
+
+constexpr AssetDedup<FACE_FRAME_COUNT> FACE_DEDUP = dedupAssets(FACE_SOURCE);
+constexpr AssetPool<128, 64, FACE_DEDUP.unique> FACE_POOL =
+    buildPool<FACE_DEDUP.unique>(FACE_SOURCE, FACE_DEDUP);
+
+#define FACE_FRAME(frame) FACE_POOL[FACE_DEDUP.slot[frame]]
+
+// ============================================================================
+// SMALL FRAMES (32x32)
+// ============================================================================
+
+enum SmallFrame : uint8_t {
+    SURPRISED_0, SURPRISED_1, SURPRISED_2,
+    SMALL_FRAME_COUNT
+};
+
+constexpr PageBitmap<32, 32> SMALL_SOURCE[SMALL_FRAME_COUNT] = {
+    transcodeAsset<32, 32>(surprised_frame0),
+    transcodeAsset<32, 32>(surprised_frame1),
+    transcodeAsset<32, 32>(surprised_frame2)
+};
+
+const char* const SMALL_FRAME_NAMES[SMALL_FRAME_COUNT] = {
+    "surprised0", "surprised1", "surprised2"
+};
+
+constexpr AssetDedup<SMALL_FRAME_COUNT> SMALL_DEDUP = dedupAssets(SMALL_SOURCE);
+constexpr AssetPool<32, 32, SMALL_DEDUP.unique> SMALL_POOL =
+    buildPool<SMALL_DEDUP.unique>(SMALL_SOURCE, SMALL_DEDUP);
+
+#define SMALL_FRAME(frame) SMALL_POOL[SMALL_DEDUP.slot[frame]]
+
+// ============================================================================
+// ANIMATIONS
+// ============================================================================
+
+constexpr PageAsset idle_frames[] = {
+    FACE_FRAME(IDLE_0),
+    FACE_FRAME(IDLE_1),
+    FACE_FRAME(IDLE_2),
+    FACE_FRAME(IDLE_3),
+    FACE_FRAME(IDLE_2),
+    FACE_FRAME(IDLE_1),
+    FACE_FRAME(IDLE_0)
+};
+
+const Animation anim_idle = {
+    .frames = idle_frames,
+    .frameCount = 7,
+    .width = 128,           // Full screen width
+    .height = 64,           // Full screen height
+    .fps = 10,              // Fallback FPS (not used if frameDelays != NULL)
+    .loop = true,
+    .name = "idle",
+    .frameDelays = idle_frame_delays  // Use custom timing
+};
+
+constexpr PageAsset wink_frames[] = {
+    FACE_FRAME(WINK_0),
+    FACE_FRAME(WINK_1),
+    FACE_FRAME(WINK_2),
+    FACE_FRAME(WINK_3),
+    FACE_FRAME(WINK_4),
+    FACE_FRAME(WINK_3),
+    FACE_FRAME(WINK_2),
+    FACE_FRAME(WINK_1),
+    FACE_FRAME(WINK_0)
+};
+
+const Animation anim_wink = {
+    .frames = wink_frames,
+    .frameCount = 9,
+    .width = 128,
+    .height = 64,
+    .fps = 0,
+    .loop = true,
+    .name = "wink",
+    .frameDelays = wink_frame_delays
+};
+
+constexpr PageAsset surprised_frames[] = {
+    SMALL_FRAME(SURPRISED_0),
+    SMALL_FRAME(SURPRISED_1),
+    SMALL_FRAME(SURPRISED_2),
+    SMALL_FRAME(SURPRISED_1)
+};
+
+const Animation anim_surprised = {
+    .frames = surprised_frames,
+    .frameCount = 4,
+    .width = 32,
+    .height = 32,
+    .fps = 10,         // Quick reaction
+    .loop = false,     // Play once then return to idle
+    .name = "Surprised"
+};
+
+constexpr PageAsset dizzy_frames[] = {
+    FACE_FRAME(DIZZY_0),
+    FACE_FRAME(DIZZY_1),
+    FACE_FRAME(DIZZY_2),
+    FACE_FRAME(DIZZY_3),
+    FACE_FRAME(DIZZY_4),
+    FACE_FRAME(DIZZY_5),
+    FACE_FRAME(DIZZY_6),
+    FACE_FRAME(DIZZY_2),
+    FACE_FRAME(DIZZY_3),
+    FACE_FRAME(DIZZY_4),
+    FACE_FRAME(DIZZY_5),
+    FACE_FRAME(DIZZY_1),
+    FACE_FRAME(DIZZY_0)
+};
+
+const Animation anim_dizzy = {
+    .frames = dizzy_frames,
+    .frameCount = 13,
+    .width = 128,
+    .height = 64,
+    .fps = 0,
+    .loop = false,
+    .name = "dizzy",
+    .frameDelays = dizzy_frame_delays
+};
+
+constexpr PageAsset sleeping_frames[] = {
+    FACE_FRAME(SLEEPING_0),
+    FACE_FRAME(SLEEPING_1),
+    FACE_FRAME(SLEEPING_2),
+    FACE_FRAME(SLEEPING_3)
+};
+
+const Animation anim_sleeping = {
+    .frames = sleeping_frames,
+    .frameCount = 4,
+    .width = 128,           // Full screen width
+    .height = 64,           // Full screen height
+    .fps = 2,               // Fallback FPS (not used if frameDelays != NULL)
+    .loop = true,
+    .name = "sleeping",
+    .frameDelays = sleeping_frame_delays  // Use custom timing
+};
+
+#endif // ANIM_LIBRARY_H
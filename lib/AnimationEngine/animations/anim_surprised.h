@@ -1,6 +1,9 @@
 /**
  * @file anim_surprised.h
  * @brief Surprised animation - sudden reaction (tap response)
+ *
+ * Row-major source frames, read only at compile time. anim_library.h
+ * transcodes them and defines the frame sequence.
  */
 
 #ifndef ANIM_SURPRISED_H
@@ -9,7 +12,7 @@
 #include <Arduino.h>
 
 // Frame 0: Wide eyes, open mouth
-const uint8_t PROGMEM surprised_frame0[] = {
+constexpr uint8_t surprised_frame0[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x1f, 0xf8, 0x00, 
     0x00, 0x3f, 0xfc, 0x00, 0x00, 0x78, 0x1e, 0x00, 0x00, 0xf0, 0x0f, 0x00, 
     0x01, 0xe0, 0x07, 0x80, 0x03, 0xcf, 0xf3, 0xc0, 0x03, 0x9f, 0xf9, 0xc0, 
@@ -24,7 +27,7 @@ const uint8_t PROGMEM surprised_frame0[] = {
 };
 
 // Frame 1: Even wider (emphasis)
-const uint8_t PROGMEM surprised_frame1[] = {
+constexpr uint8_t surprised_frame1[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x1f, 0xf8, 0x00, 
     0x00, 0x3f, 0xfc, 0x00, 0x00, 0x78, 0x1e, 0x00, 0x00, 0xf0, 0x0f, 0x00, 
     0x01, 0xe0, 0x07, 0x80, 0x03, 0xdf, 0xfb, 0xc0, 0x07, 0xbf, 0xfd, 0xe0, 
@@ -39,7 +42,7 @@ const uint8_t PROGMEM surprised_frame1[] = {
 };
 
 // Frame 2: Hold wide expression
-const uint8_t PROGMEM surprised_frame2[] = {
+constexpr uint8_t surprised_frame2[] = {
     0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xe0, 0x00, 0x00, 0x1f, 0xf8, 0x00, 
     0x00, 0x3f, 0xfc, 0x00, 0x00, 0x78, 0x1e, 0x00, 0x00, 0xf0, 0x0f, 0x00, 
     0x01, 0xe0, 0x07, 0x80, 0x03, 0xcf, 0xf3, 0xc0, 0x03, 0x9f, 0xf9, 0xc0, 
@@ -53,23 +56,4 @@ const uint8_t PROGMEM surprised_frame2[] = {
     0x00, 0x07, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-// Frame pointers array
-const uint8_t* const surprised_frames[] PROGMEM = {
-    surprised_frame0,
-    surprised_frame1,
-    surprised_frame2,
-    surprised_frame1
-};
-
-// Animation structure
-const Animation anim_surprised = {
-    .frames = surprised_frames,
-    .frameCount = 4,
-    .width = 32,
-    .height = 32,
-    .fps = 10,         // Quick reaction
-    .loop = false,     // Play once then return to idle
-    .name = "Surprised"
-};
-
 #endif // ANIM_SURPRISED_H
\ No newline at end of file
@@ -1,6 +1,9 @@
 /**
  * @file anim_wink.h
  * @brief Wink animation - positive emotion
+ *
+ * Row-major source frames, read only at compile time. anim_library.h
+ * transcodes them and defines the frame sequence.
  */
 
 #ifndef ANIM_WINK_H
@@ -8,7 +11,7 @@
 
 #include <Arduino.h>
 
-const uint8_t PROGMEM wink_frame0[] = {
+constexpr uint8_t wink_frame0[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -75,7 +78,7 @@ const uint8_t PROGMEM wink_frame0[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'wink_frame1', 128x64px
-const uint8_t PROGMEM wink_frame1[] = {
+constexpr uint8_t wink_frame1[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -142,7 +145,7 @@ const uint8_t PROGMEM wink_frame1[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'wink_frame2', 128x64px
-const uint8_t PROGMEM wink_frame2[] = {
+constexpr uint8_t wink_frame2[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -209,7 +212,7 @@ const uint8_t PROGMEM wink_frame2[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'wink_frame3', 128x64px
-const uint8_t PROGMEM wink_frame3[] = {
+constexpr uint8_t wink_frame3[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -276,7 +279,7 @@ const uint8_t PROGMEM wink_frame3[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 // 'wink_frame4', 128x64px
-const uint8_t PROGMEM wink_frame4[] = {
+constexpr uint8_t wink_frame4[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
@@ -343,20 +346,6 @@ const uint8_t PROGMEM wink_frame4[] = {
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
 
-
-// Frame pointers array
-const uint8_t* const wink_frames[] PROGMEM = {
-    wink_frame0,
-    wink_frame1,
-    wink_frame2,
-    wink_frame3,
-    wink_frame4,
-    wink_frame3,
-    wink_frame2,
-    wink_frame1,
-    wink_frame0,
-};
-
 const float wink_frame_delays[] PROGMEM = {
     1.200f,
     0.040f,
@@ -369,16 +358,4 @@ const float wink_frame_delays[] PROGMEM = {
     1.200f,
 };
 
-// Animation structure
-const Animation anim_wink = {
-    .frames = wink_frames,
-    .frameCount = 9,
-    .width = 128,
-    .height = 64,
-    .fps = 0,
-    .loop = true,
-    .name = "wink",
-    .frameDelays = wink_frame_delays
-};
-
 #endif // ANIM_WINK_H
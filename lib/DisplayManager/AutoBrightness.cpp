@@ -0,0 +1,188 @@
+/**
+ * @file AutoBrightness.cpp
+ * @brief Implementation of AutoBrightness
+ */
+
+#include "AutoBrightness.h"
+#include <math.h>
+
+// ============================================================================
+// CONSTRUCTOR & CONFIGURATION
+// ============================================================================
+
+AutoBrightness::AutoBrightness(DisplayManager* display)
+    : _display(display),
+      _enabled(false),
+      _ceiling(255),
+      _target(255),
+      _current(255),
+      _ambient(100),
+      _activity(50),
+      _latitude(0.0f),
+      _longitude(0.0f),
+      _locationValid(false),
+      _lightPin(-1),
+      _lastTargetUpdate(0),
+      _lastRampStep(0),
+      _lastSavingsUpdate(0),
+      _savedMicroampHours(0.0f)
+{
+}
+
+void AutoBrightness::begin() {
+    _lastSavingsUpdate = millis();
+    _savedMicroampHours = 0.0f;
+}
+
+void AutoBrightness::setEnabled(bool enabled) {
+    if (enabled == _enabled) return;
+    _enabled = enabled;
+    _current = _display->getBrightness();
+
+    // Force a fresh estimate on the next update
+    _lastTargetUpdate = millis() - TARGET_INTERVAL_MS;
+
+    Serial.printf("[DISPLAY] Auto brightness %s\n", enabled ? "on" : "off");
+}
+
+void AutoBrightness::setUserCeiling(uint8_t level) {
+    _ceiling = level < MIN_LEVEL ? (uint8_t)MIN_LEVEL : level;
+    _lastTargetUpdate = millis() - TARGET_INTERVAL_MS;
+}
+
+void AutoBrightness::setLocation(float latitude, float longitude, bool valid) {
+    _latitude = latitude;
+    _longitude = longitude;
+    _locationValid = valid;
+}
+
+void AutoBrightness::setLightSensorPin(int8_t pin) {
+    _lightPin = pin;
+    if (pin >= 0) {
+        pinMode(pin, INPUT);
+    }
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+bool AutoBrightness::update(time_t utcNow, int8_t localHour) {
+    unsigned long now = millis();
+    accumulateSavings(now);
+
+    // Manual mode: whoever set the contrast owns it
+    if (!_enabled) {
+        _current = _display->getBrightness();
+        _target = _current;
+        return false;
+    }
+
+    // Re-estimate target occasionally - ambient light changes slowly
+    if (now - _lastTargetUpdate >= TARGET_INTERVAL_MS) {
+        _lastTargetUpdate = now;
+
+        _ambient = estimateAmbient(utcNow, localHour);
+
+        // Dark room -> MIN_LEVEL, daylight -> ceiling
+        uint16_t range = _ceiling - MIN_LEVEL;
+        uint16_t level = MIN_LEVEL + range * _ambient / 100;
+
+        // Quiet device -> up to 30% dimmer
+        level = level * (70 + 30 * _activity / 100) / 100;
+        uint8_t newTarget = constrain(level, MIN_LEVEL, _ceiling);
+
+        if (newTarget != _target) {
+            _target = newTarget;
+            Serial.printf("[DISPLAY] Brightness target %d (ambient %d%%, activity %d%%)\n",
+                          _target, _ambient, _activity);
+        }
+    }
+
+    // Ramp: at most one contrast write per RAMP_STEP_MS
+    if (_current == _target || now - _lastRampStep < RAMP_STEP_MS) {
+        return false;
+    }
+    _lastRampStep = now;
+
+    // Big gaps move faster, last few levels one at a time
+    int16_t diff = (int16_t)_target - (int16_t)_current;
+    int16_t step = diff / 8;
+    if (step == 0) step = diff > 0 ? 1 : -1;
+    _current = (uint8_t)(_current + step);
+
+    _display->setBrightness(_current);
+    return true;
+}
+
+uint8_t AutoBrightness::estimateAmbient(time_t utcNow, int8_t localHour) {
+    // 1. Light sensor, if fitted
+    if (_lightPin >= 0) {
+        return (uint8_t)(analogRead(_lightPin) * 100UL / 4095);
+    }
+
+    // 2. Sun position: full brightness above 10 deg, dark below -6 deg (civil dusk)
+    if (_locationValid && utcNow > 0) {
+        float elevation = solarElevation(_latitude, _longitude, utcNow);
+        if (elevation >= 10.0f) return 100;
+        if (elevation <= -6.0f) return 0;
+        return (uint8_t)((elevation + 6.0f) * 100.0f / 16.0f);
+    }
+
+    // 3. Clock only
+    if (localHour >= 0) {
+        if (localHour >= 8 && localHour < 19) return 100;
+        if (localHour == 7 || localHour == 19 || localHour == 20) return 50;
+        return 0;
+    }
+
+    // Nothing known - stay at the ceiling
+    return 100;
+}
+
+// ============================================================================
+// SOLAR POSITION
+// ============================================================================
+
+float AutoBrightness::solarElevation(float latitude, float longitude, time_t utc) {
+    struct tm t;
+    gmtime_r(&utc, &t);
+
+    // NOAA low-precision approximation (good to ~1 degree)
+    float dayAngle = 2.0f * PI / 365.0f * (t.tm_yday + (t.tm_hour - 12) / 24.0f);
+    float declination = 0.006918f - 0.399912f * cosf(dayAngle) + 0.070257f * sinf(dayAngle)
+                       - 0.006758f * cosf(2 * dayAngle) + 0.000907f * sinf(2 * dayAngle);
+    float eqTime = 229.18f * (0.000075f + 0.001868f * cosf(dayAngle) - 0.032077f * sinf(dayAngle)
+                   - 0.014615f * cosf(2 * dayAngle) - 0.040849f * sinf(2 * dayAngle));
+
+    float minutes = t.tm_hour * 60.0f + t.tm_min + t.tm_sec / 60.0f;
+    float solarMinutes = minutes + eqTime + 4.0f * longitude;
+    float hourAngle = (solarMinutes / 4.0f - 180.0f) * PI / 180.0f;
+
+    float lat = latitude * PI / 180.0f;
+    float cosZenith = sinf(lat) * sinf(declination) +
+                      cosf(lat) * cosf(declination) * cosf(hourAngle);
+    cosZenith = constrain(cosZenith, -1.0f, 1.0f);
+
+    return 90.0f - acosf(cosZenith) * 180.0f / PI;
+}
+
+// ============================================================================
+// SAVINGS ESTIMATE
+// ============================================================================
+
+void AutoBrightness::accumulateSavings(unsigned long now) {
+    unsigned long elapsed = now - _lastSavingsUpdate;
+    _lastSavingsUpdate = now;
+    if (!_display->isPowerOn() || _current >= _ceiling) return;
+
+    // OLED current ~ contrast x lit pixels
+    float litFraction = _display->getLitPixelCount() / (float)(_display->getWidth() * _display->getHeight());
+    float savedMa = PANEL_FULL_MA * litFraction * (_ceiling - _current) / 255.0f;
+    _savedMicroampHours += savedMa * 1000.0f * elapsed / 3600000.0f;
+}
+
+uint8_t AutoBrightness::getSavingsPercent() const {
+    if (_ceiling == 0 || _current >= _ceiling) return 0;
+    return (uint8_t)((_ceiling - _current) * 100 / _ceiling);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file AutoBrightness.h
+ * @brief Ambient-aware contrast control for the OLED
+ * @version 1.0.0
+ *
+ * Picks a contrast target from an ambient light estimate and ramps the
+ * panel there smoothly:
+ * - Light sensor on a spare ADC pin, if fitted
+ * - Otherwise solar elevation from location + UTC time
+ * - Otherwise local hour (day/night)
+ * - Scaled down further when nothing is happening (activity level)
+ *
+ * The user brightness setting is the ceiling. Contrast writes are rate
+ * limited, and the OLED current saved against the ceiling is estimated
+ * from contrast and lit pixel count.
+ */
+
+#ifndef AUTO_BRIGHTNESS_H
+#define AUTO_BRIGHTNESS_H
+
+#include <Arduino.h>
+#include <time.h>
+#include "DisplayManager.h"
+
+// ============================================================================
+// AUTO BRIGHTNESS CLASS
+// ============================================================================
+class AutoBrightness {
+public:
+    /**
+     * @brief Constructor
+     * @param display Pointer to DisplayManager
+     */
+    AutoBrightness(DisplayManager* display);
+
+    /**
+     * @brief Start the savings estimate (call once in setup)
+     */
+    void begin();
+
+    /**
+     * @brief Enable/disable automatic control
+     * When disabled, contrast is left to the caller (manual brightness).
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    /**
+     * @brief Set user brightness (maximum contrast auto mode will use)
+     * @param level Contrast (0-255)
+     */
+    void setUserCeiling(uint8_t level);
+
+    /**
+     * @brief Set location for the solar estimate
+     * @param valid false if location unknown
+     */
+    void setLocation(float latitude, float longitude, bool valid);
+
+    /**
+     * @brief Use a light sensor (LDR divider, brighter = higher reading)
+     * @param pin ADC pin, or -1 for none
+     */
+    void setLightSensorPin(int8_t pin);
+
+    /**
+     * @brief Set activity cue (0-100), quieter = dimmer
+     */
+    void setActivity(uint8_t activityPercent) { _activity = activityPercent > 100 ? 100 : activityPercent; }
+
+    /**
+     * @brief Recompute target and ramp (call in loop, cheap between steps)
+     * @param utcNow Current UTC time, or 0 if the clock is not set
+     * @param localHour Local hour 0-23, or -1 if unknown
+     * @return true if the panel contrast changed
+     */
+    bool update(time_t utcNow, int8_t localHour);
+
+    /**
+     * @brief Restart the savings clock after update() was not called
+     * Call on the way back to ACTIVE, so time spent asleep, dimmed or
+     * off is not counted as savings at the current contrast.
+     */
+    void resumeSavings() { _lastSavingsUpdate = millis(); }
+
+    /**
+     * @brief Get current and target contrast
+     */
+    uint8_t getCurrent() const { return _current; }
+    uint8_t getTarget() const { return _target; }
+
+    /**
+     * @brief Get last ambient estimate (0 = dark, 100 = daylight)
+     */
+    uint8_t getAmbientPercent() const { return _ambient; }
+
+    /**
+     * @brief Estimated OLED charge saved vs. running at the ceiling
+     * @return mAh since begin(), only while update() runs
+     */
+    float getSavedMilliampHours() const { return _savedMicroampHours / 1000.0f; }
+
+    /**
+     * @brief Estimated current saved right now
+     * @return Percent of panel current at the ceiling
+     */
+    uint8_t getSavingsPercent() const;
+
+    /**
+     * @brief Solar elevation for a location and time
+     * @return Degrees above the horizon (negative below)
+     */
+    static float solarElevation(float latitude, float longitude, time_t utc);
+
+private:
+    DisplayManager* _display;
+    bool _enabled;
+
+    uint8_t _ceiling;
+    uint8_t _target;
+    uint8_t _current;
+    uint8_t _ambient;
+    uint8_t _activity;
+
+    float _latitude;
+    float _longitude;
+    bool _locationValid;
+    int8_t _lightPin;
+
+    unsigned long _lastTargetUpdate;
+    unsigned long _lastRampStep;
+    unsigned long _lastSavingsUpdate;
+    float _savedMicroampHours;
+
+    static constexpr uint8_t MIN_LEVEL = 8;                  // Darkest usable contrast
+    static constexpr unsigned long TARGET_INTERVAL_MS = 15000; // Re-estimate ambient
+    static constexpr unsigned long RAMP_STEP_MS = 200;       // Max one contrast write per step
+    static constexpr float PANEL_FULL_MA = 25.0f;            // All pixels lit at contrast 255
+
+    uint8_t estimateAmbient(time_t utcNow, int8_t localHour);
+    void accumulateSavings(unsigned long now);
+};
+
+#endif // AUTO_BRIGHTNESS_H
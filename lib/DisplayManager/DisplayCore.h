@@ -0,0 +1,169 @@
+/**
+ * @file DisplayCore.h
+ * @brief Framebuffer primitives for a fixed panel geometry
+ *
+ * Width, height and controller are template parameters, so page counts,
+ * buffer size, clipping bounds and centering fold into constants, and
+ * pixels are written straight into the page-mode buffer (8 rows per
+ * byte, bit 0 on top) instead of going through Adafruit_GFX's virtual,
+ * rotation-aware drawPixel(). DisplayManager uses it for the panel it is
+ * built for and keeps the Adafruit path for any other geometry.
+ * tools/display_core_check.cpp compares it pixel for pixel against
+ * plain per-pixel drawing on the host.
+ */
+
+#ifndef DISPLAY_CORE_H
+#define DISPLAY_CORE_H
+
+#include "PageAsset.h"
+
+#ifndef ARDUINO
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))     // Host builds (tools/)
+#endif
+
+/**
+ * @brief SH1106 page-mode RAM layout
+ */
+struct SH1106Controller {
+    static constexpr uint8_t RAM_COLUMNS = 132;
+    static constexpr uint8_t COLUMN_OFFSET = 2;     // 128 visible columns centered in 132
+    static constexpr uint8_t I2C_CHUNK = 32;        // Data bytes per I2C transaction
+};
+
+template <uint8_t W, uint8_t H, typename Controller>
+class DisplayCore {
+public:
+    static_assert(H % 8 == 0, "Height must be a whole number of pages");
+    static_assert(W + 2 * Controller::COLUMN_OFFSET <= Controller::RAM_COLUMNS,
+                  "Panel wider than controller RAM");
+
+    typedef Controller ControllerType;
+
+    static constexpr uint8_t WIDTH = W;
+    static constexpr uint8_t HEIGHT = H;
+    static constexpr uint8_t PAGES = H / 8;
+    static constexpr uint16_t BUFFER_BYTES = (uint16_t)W * PAGES;
+
+    /**
+     * @brief Top-left x/y that centers an object of this size
+     */
+    static constexpr int16_t centerX(int16_t width) { return (W - width) / 2; }
+    static constexpr int16_t centerY(int16_t height) { return (H - height) / 2; }
+
+    static constexpr bool contains(int16_t x, int16_t y) {
+        return (uint16_t)x < W && (uint16_t)y < H;
+    }
+
+    static inline void setPixel(uint8_t* buffer, int16_t x, int16_t y, bool on) {
+        if (!contains(x, y)) return;
+        uint8_t* p = buffer + (y >> 3) * W + x;
+        uint8_t mask = 1 << (y & 7);
+        if (on) {
+            *p |= mask;
+        } else {
+            *p &= ~mask;
+        }
+    }
+
+    /**
+     * @brief Fill a clipped rectangle, one byte mask per page column
+     */
+    static void fillRect(uint8_t* buffer, int16_t x, int16_t y, int16_t w, int16_t h, bool on) {
+        if (x < 0) { w += x; x = 0; }
+        if (y < 0) { h += y; y = 0; }
+        if (x + w > W) w = W - x;
+        if (y + h > H) h = H - y;
+        if (w <= 0 || h <= 0) return;
+
+        int16_t bottom = y + h;     // Exclusive
+        for (uint8_t page = y >> 3; page <= (bottom - 1) >> 3; page++) {
+            int16_t top = page * 8;
+            uint8_t mask = 0xFF;
+            if (y > top) mask &= 0xFF << (y - top);
+            if (bottom < top + 8) mask &= 0xFF >> (top + 8 - bottom);
+
+            uint8_t* p = buffer + page * W + x;
+            if (on) {
+                for (int16_t i = 0; i < w; i++) p[i] |= mask;
+            } else {
+                for (int16_t i = 0; i < w; i++) p[i] &= ~mask;
+            }
+        }
+    }
+
+    static void drawRect(uint8_t* buffer, int16_t x, int16_t y, int16_t w, int16_t h, bool on) {
+        if (w <= 0 || h <= 0) return;
+        fillRect(buffer, x, y, w, 1, on);
+        fillRect(buffer, x, y + h - 1, w, 1, on);
+        fillRect(buffer, x, y + 1, 1, h - 2, on);
+        fillRect(buffer, x + w - 1, y + 1, 1, h - 2, on);
+    }
+
+    /**
+     * @brief Draw a row-major 1-bit bitmap (Adafruit_GFX layout, MSB left)
+     * Set bits are drawn, clear bits leave the buffer as is.
+     * @param bitmap PROGMEM data, (w + 7) / 8 bytes per row
+     */
+    static void drawBitmap(uint8_t* buffer, int16_t x, int16_t y,
+                           const uint8_t* bitmap, int16_t w, int16_t h, bool on) {
+        int16_t byteWidth = (w + 7) / 8;
+
+        for (int16_t row = 0; row < h; row++) {
+            int16_t py = y + row;
+            if ((uint16_t)py >= H) continue;
+
+            uint8_t* line = buffer + (py >> 3) * W;
+            uint8_t mask = 1 << (py & 7);
+            const uint8_t* src = bitmap + row * byteWidth;
+            uint8_t bits = 0;
+
+            for (int16_t col = 0; col < w; col++) {
+                if ((col & 7) == 0) bits = pgm_read_byte(src + (col >> 3));
+                if (bits & 0x80) {
+                    int16_t px = x + col;
+                    if ((uint16_t)px < W) {
+                        if (on) {
+                            line[px] |= mask;
+                        } else {
+                            line[px] &= ~mask;
+                        }
+                    }
+                }
+                bits <<= 1;
+            }
+        }
+    }
+
+    /**
+     * @brief OR the lit box of a page-major asset into the buffer
+     * Whole bytes are ORed in when y is a multiple of 8; otherwise each
+     * byte is split across two pages.
+     */
+    static void drawAsset(uint8_t* buffer, int16_t x, int16_t y, const PageAsset& asset) {
+        if (asset.boxW == 0) return;
+
+        uint8_t firstPage = asset.boxY >> 3;
+        uint8_t lastPage = (asset.boxY + asset.boxH - 1) >> 3;
+        uint8_t shift = y & 7;
+
+        for (uint8_t sourcePage = firstPage; sourcePage <= lastPage; sourcePage++) {
+            int16_t page = (y + sourcePage * 8) >> 3;   // Floor, also for negative y
+            bool upper = (uint16_t)page < PAGES;
+            bool lower = shift != 0 && (uint16_t)(page + 1) < PAGES;
+            if (!upper && !lower) continue;
+
+            const uint8_t* src = asset.data + sourcePage * asset.width;
+            for (uint8_t col = asset.boxX; col < asset.boxX + asset.boxW; col++) {
+                int16_t px = x + col;
+                if ((uint16_t)px >= W) continue;
+
+                uint8_t b = pgm_read_byte(src + col);
+                if (b == 0) continue;
+                if (upper) buffer[page * W + px] |= b << shift;
+                if (lower) buffer[(page + 1) * W + px] |= b >> (8 - shift);
+            }
+        }
+    }
+};
+
+#endif // DISPLAY_CORE_H
@@ -6,17 +6,39 @@
 #include "DisplayManager.h"
 #include "bitmaps.h"
 #include "Fonts/FreeMonoBold12pt7b.h"
+
+// Controller RAM layout of the native panel
+static const uint8_t RAM_COLUMNS = NativePanel::ControllerType::RAM_COLUMNS;
+static const uint8_t COLUMN_OFFSET = NativePanel::ControllerType::COLUMN_OFFSET;
+static const uint8_t I2C_CHUNK = NativePanel::ControllerType::I2C_CHUNK;
+
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
 // ============================================================================
 
-DisplayManager::DisplayManager(uint8_t width, uint8_t height, uint8_t i2c_address)
+DisplayManager::DisplayManager(uint8_t i2c_address)
     : _display(nullptr),
-      _width(width),
-      _height(height),
       _i2c_address(i2c_address),
       _initialized(false),
       _dirty(true),
+      _brightness(0xFF),
+      _powerOn(true),
+      _shiftEnabled(false),
+      _shiftAmplitude(1),
+      _shiftStep(0),
+      _shiftX(0),
+      _shiftY(0),
+      _shiftInterval(180000),
+      _lastShiftTime(0),
+      _lastWearUpdate(0),
+      _flushCount(0),
+      _snapshotClock(0),
+      _shownKey(0),
+      _shownFlushCount(0),
+      _offscreen(false),
+      _offscreenDirty(false),
+      _offscreenShownKey(0),
+      _overlay(nullptr),
       _currentFrame(0),
       _totalFrames(0),
       _animationFPS(10),
@@ -24,6 +46,11 @@ DisplayManager::DisplayManager(uint8_t width, uint8_t height, uint8_t i2c_addres
 {
     // Constructor intentionally lightweight
     // Actual hardware initialization happens in init()
+    memset(_cellLit, 0, sizeof(_cellLit));
+    memset(_cellPixelSec, 0, sizeof(_cellPixelSec));
+    memset(_cellPixelMs, 0, sizeof(_cellPixelMs));
+    memset(&_snapshotStats, 0, sizeof(_snapshotStats));
+    clearSnapshots();
 }
 
 bool DisplayManager::init(uint8_t sda_pin, uint8_t scl_pin, uint32_t frequency) {
@@ -34,7 +61,7 @@ bool DisplayManager::init(uint8_t sda_pin, uint8_t scl_pin, uint32_t frequency)
     Wire.setClock(frequency);
     
     // Create display object
-    _display = new Adafruit_SH1106G(_width, _height, &Wire, -1);
+    _display = new Adafruit_SH1106G(WIDTH, HEIGHT, &Wire, -1);
     
     // Initialize display
     if (!_display->begin(_i2c_address, true)) {
@@ -58,7 +85,7 @@ bool DisplayManager::init(uint8_t sda_pin, uint8_t scl_pin, uint32_t frequency)
     delay(1000);
     
     Serial.println("[DISPLAY] Initialization complete");
-    Serial.printf("[DISPLAY] Resolution: %dx%d px\n", _width, _height);
+    Serial.printf("[DISPLAY] Resolution: %dx%d px\n", WIDTH, HEIGHT);
     
     return true;
 }
@@ -71,11 +98,19 @@ void DisplayManager::clear() {
     if (!_initialized) return;
     _display->clearDisplay();
     _dirty = true;
+    _shownKey = 0;
 }
 
 void DisplayManager::update() {
     if (!_initialized || !_dirty) return;
-    _display->display();
+
+    // Status bar goes to the panel only; the buffer stays as drawn
+    uint8_t* buffer = _display->getBuffer();
+    bool overlay = NATIVE && _overlay != nullptr;
+    if (overlay) _overlay->composite(buffer);
+    flush();
+    if (overlay) _overlay->restore(buffer);
+
     _dirty = false;
 }
 
@@ -91,17 +126,19 @@ void DisplayManager::setBrightness(uint8_t level) {
     // Level: 0-255, where 255 is maximum brightness
     _display->oled_command(0x81);  // Set contrast control
     _display->oled_command(level);  // Contrast value
-
-    Serial.printf("[DISPLAY] Brightness set to %d\n", level);
+    _brightness = level;
 }
 
 void DisplayManager::setPower(bool on) {
     if (!_initialized) return;
     if (on) {
         _display->oled_command(SH110X_DISPLAYON);
+        _lastWearUpdate = millis();     // No wear while the panel was off
     } else {
+        accumulateWear(millis());
         _display->oled_command(SH110X_DISPLAYOFF);
     }
+    _powerOn = on;
 }
 
 void DisplayManager::markDirty() {
@@ -135,7 +172,7 @@ void DisplayManager::drawText(const char* text, int16_t x, int16_t y,
 }
 
 void DisplayManager::showTextCentered(const char* text, int16_t y, uint8_t size) {
-    drawText(text, _width / 2, y, size, TextAlign::CENTER);
+    drawText(text, WIDTH / 2, y, size, TextAlign::CENTER);
 }
 
 void DisplayManager::drawMultiLineText(const char* text, int16_t x, int16_t y,
@@ -172,17 +209,44 @@ void DisplayManager::drawMultiLineText(const char* text, int16_t x, int16_t y,
 void DisplayManager::drawBitmap(const uint8_t* bitmap, int16_t x, int16_t y,
                                 uint8_t width, uint8_t height, uint16_t color) {
     if (!_initialized || bitmap == nullptr) return;
+    if constexpr (NATIVE) {
+        if (color == SH110X_WHITE || color == SH110X_BLACK) {
+            NativePanel::drawBitmap(_display->getBuffer(), x, y, bitmap, width, height,
+                                    color == SH110X_WHITE);
+            _dirty = true;
+            return;
+        }
+    }
     _display->drawBitmap(x, y, bitmap, width, height, color);
     _dirty = true;
 }
 
 void DisplayManager::drawBitmapCentered(const uint8_t* bitmap, 
                                         uint8_t width, uint8_t height) {
-    int16_t x = (_width - width) / 2;
-    int16_t y = (_height - height) / 2;
-    drawBitmap(bitmap, x, y, width, height, SH110X_WHITE);
+    drawBitmap(bitmap, (WIDTH - width) / 2, (HEIGHT - height) / 2, width, height, SH110X_WHITE);
 }
 
+void DisplayManager::drawAsset(const PageAsset& asset, int16_t x, int16_t y) {
+    if (!_initialized) return;
+
+    if constexpr (NATIVE) {
+        NativePanel::drawAsset(_display->getBuffer(), x, y, asset);
+    } else {
+        for (uint8_t row = asset.boxY; row < asset.boxY + asset.boxH; row++) {
+            const uint8_t* page = asset.data + (row >> 3) * asset.width;
+            for (uint8_t col = asset.boxX; col < asset.boxX + asset.boxW; col++) {
+                if (pgm_read_byte(page + col) & (1 << (row & 7))) {
+                    _display->drawPixel(x + col, y + row, SH110X_WHITE);
+                }
+            }
+        }
+    }
+    _dirty = true;
+}
+
+void DisplayManager::drawAssetCentered(const PageAsset& asset) {
+    drawAsset(asset, (WIDTH - asset.width) / 2, (HEIGHT - asset.height) / 2);
+}
 
 // ============================================================================
 // UI ELEMENTS
@@ -195,12 +259,12 @@ void DisplayManager::drawProgressBar(int16_t x, int16_t y, uint8_t width,
     progress = constrain(progress, 0.0f, 1.0f);
 
     // Draw outline
-    _display->drawRect(x, y, width, height, SH110X_WHITE);
+    drawRect(x, y, width, height);
 
     // Fill progress
     uint8_t fillWidth = mapProgressToPixels(progress, width - 2);
     if (fillWidth > 0) {
-        _display->fillRect(x + 1, y + 1, fillWidth, height - 2, SH110X_WHITE);
+        fillRect(x + 1, y + 1, fillWidth, height - 2);
     }
     _dirty = true;
 }
@@ -209,14 +273,14 @@ void DisplayManager::drawBattery(int16_t x, int16_t y, uint8_t percentage) {
     if (!_initialized) return;
 
     // Battery body (20x10 pixels)
-    _display->drawRect(x, y, 20, 10, SH110X_WHITE);
+    drawRect(x, y, 20, 10);
     // Battery tip
-    _display->fillRect(x + 20, y + 3, 2, 4, SH110X_WHITE);
+    fillRect(x + 20, y + 3, 2, 4);
 
     // Fill level
     uint8_t fillWidth = map(percentage, 0, 100, 0, 18);
     if (fillWidth > 0) {
-        _display->fillRect(x + 1, y + 1, fillWidth, 8, SH110X_WHITE);
+        fillRect(x + 1, y + 1, fillWidth, 8);
     }
     _dirty = true;
 }
@@ -227,15 +291,31 @@ void DisplayManager::drawMenuBox(int16_t x, int16_t y, uint8_t width,
 
     if (selected) {
         // Highlighted selection: outline box with a solid left bar
-        _display->drawRect(x, y, width, height, SH110X_WHITE);
-        _display->fillRect(x, y, 3, height, SH110X_WHITE);
+        drawRect(x, y, width, height);
+        fillRect(x, y, 3, height);
     } else {
         // Outline only for unselected
-        _display->drawRect(x, y, width, height, SH110X_WHITE);
+        drawRect(x, y, width, height);
     }
     _dirty = true;
 }
 
+void DisplayManager::drawRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if constexpr (NATIVE) {
+        NativePanel::drawRect(_display->getBuffer(), x, y, w, h, true);
+    } else {
+        _display->drawRect(x, y, w, h, SH110X_WHITE);
+    }
+}
+
+void DisplayManager::fillRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+    if constexpr (NATIVE) {
+        NativePanel::fillRect(_display->getBuffer(), x, y, w, h, true);
+    } else {
+        _display->fillRect(x, y, w, h, SH110X_WHITE);
+    }
+}
+
 // ============================================================================
 // SCREEN TRANSITIONS
 // ============================================================================
@@ -251,6 +331,342 @@ void DisplayManager::fadeOut(uint16_t duration) {
     setPower(false);
 }
 
+// ============================================================================
+// BURN-IN MITIGATION
+// ============================================================================
+
+// Orbit around the origin; one step per interval, full cycle returns to 0,0
+static const int8_t SHIFT_ORBIT[][2] = {
+    { 0,  0}, { 1,  0}, { 1,  1}, { 0,  1}, {-1,  1},
+    {-1,  0}, {-1, -1}, { 0, -1}, { 1, -1}
+};
+static const uint8_t SHIFT_ORBIT_STEPS = sizeof(SHIFT_ORBIT) / sizeof(SHIFT_ORBIT[0]);
+
+void DisplayManager::setPixelShift(bool enabled, unsigned long intervalMs, uint8_t amplitude) {
+    _shiftEnabled = enabled;
+    _shiftInterval = intervalMs;
+    _shiftAmplitude = constrain(amplitude, 1, 2);
+    _lastShiftTime = millis();
+
+    if (!enabled && (_shiftX != 0 || _shiftY != 0)) {
+        _shiftStep = 0;
+        _shiftX = 0;
+        _shiftY = 0;
+        _dirty = true;
+    }
+}
+
+void DisplayManager::updatePixelShift() {
+    if (!_shiftEnabled || !_powerOn) return;
+
+    unsigned long now = millis();
+    if (now - _lastShiftTime < _shiftInterval) return;
+    _lastShiftTime = now;
+
+    _shiftStep = (_shiftStep + 1) % SHIFT_ORBIT_STEPS;
+    _shiftX = SHIFT_ORBIT[_shiftStep][0] * _shiftAmplitude;
+    _shiftY = SHIFT_ORBIT[_shiftStep][1] * _shiftAmplitude;
+
+    // One flush moves the current frame; callers don't need to redraw
+    _dirty = true;
+}
+
+void DisplayManager::flush() {
+    if constexpr (!NATIVE) {
+        _display->display();
+        return;
+    }
+
+    unsigned long now = millis();
+    accumulateWear(now);
+
+    const uint8_t* buffer = _display->getBuffer();
+    uint8_t row[RAM_COLUMNS];
+
+    for (uint8_t page = 0; page < NativePanel::PAGES; page++) {
+        // Horizontal shift via column placement in the 132-column RAM
+        memset(row, 0, sizeof(row));
+        for (uint8_t x = 0; x < NativePanel::WIDTH; x++) {
+            row[COLUMN_OFFSET + _shiftX + x] = shiftedColumn(buffer, page, x);
+        }
+
+        // Lit pixels per 8x8 cell of the visible area
+        for (uint8_t cell = 0; cell < WEAR_COLS; cell++) {
+            const uint8_t* p = row + COLUMN_OFFSET + cell * 8;
+            uint8_t lit = 0;
+            for (uint8_t i = 0; i < 8; i++) {
+                lit += __builtin_popcount(p[i]);
+            }
+            _cellLit[page * WEAR_COLS + cell] = lit;
+        }
+
+        sendPage(page, 0, row, RAM_COLUMNS);
+    }
+
+    _flushCount++;
+}
+
+void DisplayManager::flushColumns(uint8_t x0, uint8_t x1, uint8_t page) {
+    // Vertical shift moves part of the page into its neighbour
+    uint8_t first = page;
+    uint8_t last = page;
+    if (_shiftY > 0 && last < NativePanel::PAGES - 1) last++;
+    if (_shiftY < 0 && first > 0) first--;
+
+    accumulateWear(millis());
+
+    const uint8_t* buffer = _display->getBuffer();
+    uint8_t row[NativePanel::WIDTH];
+    uint8_t length = x1 - x0 + 1;
+
+    // Visible cells the segment lands in, for the wear counts
+    int16_t left = max<int16_t>(0, x0 + _shiftX) / 8;
+    int16_t right = min<int16_t>(NativePanel::WIDTH - 1, x1 + _shiftX) / 8;
+
+    for (uint8_t p = first; p <= last; p++) {
+        for (uint8_t i = 0; i < length; i++) {
+            row[i] = shiftedColumn(buffer, p, x0 + i);
+        }
+        sendPage(p, COLUMN_OFFSET + _shiftX + x0, row, length);
+
+        for (int16_t cell = left; cell <= right; cell++) {
+            uint8_t lit = 0;
+            for (uint8_t i = 0; i < 8; i++) {
+                lit += __builtin_popcount(shiftedColumn(buffer, p, cell * 8 + i - _shiftX));
+            }
+            _cellLit[p * WEAR_COLS + cell] = lit;
+        }
+    }
+}
+
+uint8_t DisplayManager::shiftedColumn(const uint8_t* buffer, uint8_t page, int16_t x) const {
+    if (x < 0 || x >= NativePanel::WIDTH) return 0;
+
+    // Vertical shift: bit 0 is the top row of the page
+    const uint8_t* cur = buffer + page * NativePanel::WIDTH;
+    uint8_t b = cur[x];
+    if (_shiftY > 0) {
+        b = (b << _shiftY) | (page > 0 ? cur[x - NativePanel::WIDTH] >> (8 - _shiftY) : 0);
+    } else if (_shiftY < 0) {
+        b = (b >> -_shiftY) | (page < NativePanel::PAGES - 1 ? cur[x + NativePanel::WIDTH] << (8 + _shiftY) : 0);
+    }
+    return b;
+}
+
+void DisplayManager::sendPage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length) {
+    _display->oled_command(0xB0 + page);               // Page address
+    _display->oled_command(0x00 | (column & 0x0F));    // Column low nibble
+    _display->oled_command(0x10 | (column >> 4));      // Column high nibble
+
+    for (uint8_t i = 0; i < length; i += I2C_CHUNK) {
+        uint8_t len = min<uint8_t>(I2C_CHUNK, length - i);
+        Wire.beginTransmission(_i2c_address);
+        Wire.write(0x40);                  // Data stream
+        Wire.write(data + i, len);
+        Wire.endTransmission();
+    }
+}
+
+void DisplayManager::accumulateWear(unsigned long now) {
+    unsigned long elapsed = now - _lastWearUpdate;
+    _lastWearUpdate = now;
+
+    if (!_powerOn || elapsed == 0 || _flushCount == 0) return;
+
+    for (uint8_t i = 0; i < WEAR_CELLS; i++) {
+        if (_cellLit[i] == 0) continue;
+        uint64_t pixelMs = (uint64_t)_cellLit[i] * elapsed + _cellPixelMs[i];
+        _cellPixelSec[i] += (uint32_t)(pixelMs / 1000);
+        _cellPixelMs[i] = (uint16_t)(pixelMs % 1000);
+    }
+}
+
+uint32_t DisplayManager::getCellPixelSeconds(uint8_t column, uint8_t page) const {
+    if (column >= WEAR_COLS || page >= WEAR_PAGES) return 0;
+    return _cellPixelSec[page * WEAR_COLS + column];
+}
+
+uint16_t DisplayManager::getLitPixelCount() const {
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < WEAR_CELLS; i++) {
+        total += _cellLit[i];
+    }
+    return total;
+}
+
+DisplayWearStats DisplayManager::getWearStats() const {
+    DisplayWearStats stats = {};
+    stats.minCellPixelSeconds = UINT32_MAX;
+
+    for (uint8_t i = 0; i < WEAR_CELLS; i++) {
+        uint32_t v = _cellPixelSec[i];
+        stats.totalPixelSeconds += v;
+        if (v > stats.maxCellPixelSeconds) stats.maxCellPixelSeconds = v;
+        if (v > 0 && v < stats.minCellPixelSeconds) stats.minCellPixelSeconds = v;
+    }
+    if (stats.minCellPixelSeconds == UINT32_MAX) stats.minCellPixelSeconds = 0;
+
+    stats.flushCount = _flushCount;
+    stats.shiftX = _shiftX;
+    stats.shiftY = _shiftY;
+    return stats;
+}
+
+void DisplayManager::printWearStats() const {
+    DisplayWearStats stats = getWearStats();
+
+    Serial.println("[DISPLAY] Wear map (pixel-seconds per 8x8 cell):");
+    for (uint8_t page = 0; page < WEAR_PAGES; page++) {
+        Serial.print("  ");
+        for (uint8_t col = 0; col < WEAR_COLS; col++) {
+            Serial.printf("%7lu", (unsigned long)_cellPixelSec[page * WEAR_COLS + col]);
+        }
+        Serial.println();
+    }
+    Serial.printf("[DISPLAY] Wear min=%lu max=%lu total=%lu flushes=%lu shift=(%d,%d)\n",
+                  (unsigned long)stats.minCellPixelSeconds,
+                  (unsigned long)stats.maxCellPixelSeconds,
+                  (unsigned long)stats.totalPixelSeconds,
+                  (unsigned long)stats.flushCount,
+                  stats.shiftX, stats.shiftY);
+}
+
+// ============================================================================
+// SNAPSHOT CACHE
+// ============================================================================
+
+bool DisplayManager::showSnapshot(uint32_t key) {
+    if (!NATIVE || !_initialized || key == 0) return false;
+
+    // Nothing flushed or drawn since this snapshot went out
+    if (key == _shownKey && _flushCount == _shownFlushCount && !_dirty) {
+        _snapshotStats.unchanged++;
+        return true;
+    }
+
+    for (uint8_t i = 0; i < SNAPSHOT_SLOTS; i++) {
+        Snapshot& snapshot = _snapshots[i];
+        if (snapshot.key != key) continue;
+
+        snapshot.lastUse = ++_snapshotClock;
+        memcpy(_display->getBuffer(), snapshot.frame, SNAPSHOT_BYTES);
+        _dirty = true;
+        update();
+
+        _shownKey = key;
+        _shownFlushCount = _flushCount;
+        _snapshotStats.restored++;
+        return true;
+    }
+    return false;
+}
+
+void DisplayManager::saveSnapshot(uint32_t key) {
+    if (!_initialized) return;
+    if (!NATIVE || key == 0) {
+        update();
+        return;
+    }
+
+    // Same key, else empty slot, else least recently used
+    uint8_t target = 0;
+    for (uint8_t i = 0; i < SNAPSHOT_SLOTS; i++) {
+        if (_snapshots[i].key == key) {
+            target = i;
+            break;
+        }
+        if (_snapshots[i].lastUse < _snapshots[target].lastUse) {
+            target = i;
+        }
+    }
+
+    Snapshot& snapshot = _snapshots[target];
+    snapshot.key = key;
+    snapshot.lastUse = ++_snapshotClock;
+    memcpy(snapshot.frame, _display->getBuffer(), SNAPSHOT_BYTES);
+
+    _dirty = true;
+    update();
+
+    _shownKey = key;
+    _shownFlushCount = _flushCount;
+    _snapshotStats.rendered++;
+}
+
+void DisplayManager::clearSnapshots() {
+    for (uint8_t i = 0; i < SNAPSHOT_SLOTS; i++) {
+        _snapshots[i].key = 0;
+        _snapshots[i].lastUse = 0;
+    }
+    _shownKey = 0;
+}
+
+uint32_t DisplayManager::snapshotKey(uint32_t seed, const char* text) {
+    uint32_t hash = seed ^ 2166136261UL;
+    if (text != nullptr) {
+        while (*text) {
+            hash = (hash ^ (uint8_t)*text++) * 16777619UL;
+        }
+    }
+    hash = (hash ^ 0xFF) * 16777619UL;    // Terminator, so "ab"+"c" != "a"+"bc"
+    return hash ? hash : 1;
+}
+
+uint32_t DisplayManager::snapshotKey(uint32_t seed, int32_t value) {
+    uint32_t hash = seed ^ 2166136261UL;
+    for (uint8_t i = 0; i < 4; i++) {
+        hash = (hash ^ (uint8_t)(value >> (i * 8))) * 16777619UL;
+    }
+    return hash ? hash : 1;
+}
+
+// ============================================================================
+// OFF-SCREEN PAGES
+// ============================================================================
+
+void DisplayManager::beginOffscreen() {
+    if (!NATIVE || !_initialized || _offscreen) return;
+
+    memcpy(_offscreenSave, _display->getBuffer(), SNAPSHOT_BYTES);
+    _offscreenDirty = _dirty;
+    _offscreenShownKey = _shownKey;
+    _offscreen = true;
+
+    _display->clearDisplay();
+}
+
+void DisplayManager::endOffscreen() {
+    if (!_offscreen) return;
+
+    memcpy(_display->getBuffer(), _offscreenSave, SNAPSHOT_BYTES);
+    _dirty = _offscreenDirty;
+    _shownKey = _offscreenShownKey;
+    _offscreen = false;
+}
+
+bool DisplayManager::storeFrame(FrameStore& store, uint8_t index) {
+    if (!NATIVE || !_initialized) return false;
+    return store.store(index, _display->getBuffer());
+}
+
+bool DisplayManager::showStoredFrame(const FrameStore& store, uint8_t index, uint32_t key) {
+    if (!_initialized || _offscreen || !store.has(index)) return false;
+
+    if (key != 0 && key == _shownKey && _flushCount == _shownFlushCount && !_dirty) {
+        _snapshotStats.unchanged++;
+        return true;
+    }
+
+    if (!store.load(index, _display->getBuffer())) return false;
+    _dirty = true;
+    update();
+
+    _shownKey = key;
+    _shownFlushCount = _flushCount;
+    _snapshotStats.restored++;
+    return true;
+}
+
 // ============================================================================
 // PRIVATE HELPER METHODS
 // ============================================================================
@@ -262,4 +678,79 @@ int16_t DisplayManager::getTextWidth(const char* text, uint8_t size) {
 
 uint8_t DisplayManager::mapProgressToPixels(float progress, uint8_t maxWidth) {
     return (uint8_t)(progress * maxWidth);
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// STATUS OVERLAY
+// ============================================================================
+
+void DisplayManager::setOverlay(StatusBar* overlay) {
+    if (overlay == _overlay) return;
+    _overlay = overlay;
+    _dirty = true;
+}
+
+void DisplayManager::updateOverlay() {
+    if (!NATIVE || !_initialized || _overlay == nullptr || _offscreen) return;
+
+    _overlay->update();
+    if (_dirty) return;     // Next update() composites the whole bar
+
+    uint8_t x0, x1;
+    if (!_overlay->getDirtyColumns(x0, x1)) return;
+
+    // Buffer still matches the panel, so only the bar's cells differ
+    uint8_t* buffer = _display->getBuffer();
+    _overlay->composite(buffer);
+    flushColumns(x0, x1, 0);
+    _overlay->restore(buffer);
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+#ifdef DISPLAY_BENCHMARK
+
+void DisplayManager::runBenchmark() {
+    if (!NATIVE || !_initialized) return;
+
+    static const uint16_t ITERATIONS = 500;
+    static const uint8_t ICON[] PROGMEM = {
+        0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99, 0x42, 0x3C
+    };
+    uint8_t* buffer = _display->getBuffer();
+    uint32_t gfxUs, coreUs;
+
+    Serial.println("[DISPLAY] Benchmark (us per call, Adafruit_GFX vs DisplayCore)");
+
+    #define DISPLAY_BENCH(name, gfxCall, coreCall)                          \
+        gfxUs = micros();                                                   \
+        for (uint16_t i = 0; i < ITERATIONS; i++) { gfxCall; }              \
+        gfxUs = micros() - gfxUs;                                           \
+        coreUs = micros();                                                  \
+        for (uint16_t i = 0; i < ITERATIONS; i++) { coreCall; }             \
+        coreUs = micros() - coreUs;                                         \
+        Serial.printf("[DISPLAY]   %-12s %7.2f %7.2f  x%.1f\n", name,       \
+                      gfxUs / (float)ITERATIONS, coreUs / (float)ITERATIONS, \
+                      coreUs ? gfxUs / (float)coreUs : 0.0f)
+
+    DISPLAY_BENCH("pixel",
+                  _display->drawPixel(i & 127, i & 63, SH110X_WHITE),
+                  NativePanel::setPixel(buffer, i & 127, i & 63, true));
+    DISPLAY_BENCH("fillRect",
+                  _display->fillRect(i & 63, 3, 40, 20, SH110X_WHITE),
+                  NativePanel::fillRect(buffer, i & 63, 3, 40, 20, true));
+    DISPLAY_BENCH("drawRect",
+                  _display->drawRect(i & 63, 3, 40, 20, SH110X_WHITE),
+                  NativePanel::drawRect(buffer, i & 63, 3, 40, 20, true));
+    DISPLAY_BENCH("bitmap 8x8",
+                  _display->drawBitmap(i & 119, i & 55, ICON, 8, 8, SH110X_WHITE),
+                  NativePanel::drawBitmap(buffer, i & 119, i & 55, ICON, 8, 8, true));
+
+    #undef DISPLAY_BENCH
+
+    clear();
+}
+
+#endif // DISPLAY_BENCHMARK
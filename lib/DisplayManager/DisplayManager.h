@@ -12,6 +12,9 @@
  * - Bitmap/animation support
  * - Screen transitions
  * - Power management
+ * - Burn-in mitigation (pixel-shift orbit, per-cell wear statistics)
+ * - Snapshot cache for static screens
+ * - Off-screen rendering into compressed page stores
  */
 
 #ifndef DISPLAY_MANAGER_H
@@ -22,6 +25,9 @@
 #include <Adafruit_GFX.h>
 #include <Adafruit_SH110X.h>
 #include "Fonts/FreeMonoBold12pt7b.h"
+#include "DisplayCore.h"
+#include "FrameStore.h"
+#include "StatusBar.h"
 
 // Forward declarations for bitmap data
 extern const unsigned char PROGMEM bitmap_idle[];
@@ -46,6 +52,48 @@ enum class Transition {
     SLIDE_RIGHT
 };
 
+/**
+ * @brief The panel DisplayCore drives
+ */
+typedef DisplayCore<128, 64, SH1106Controller> NativePanel;
+
+/**
+ * @brief Geometry of the attached panel, fixed at build time
+ * NativePanel by default; build with -DDISPLAY_WIDTH/-DDISPLAY_HEIGHT
+ * for another size, which then draws through the Adafruit driver. Set
+ * it only through build flags: NATIVE selects code in inline members,
+ * so every translation unit must see the same values.
+ */
+#ifndef DISPLAY_WIDTH
+#define DISPLAY_WIDTH 128
+#endif
+#ifndef DISPLAY_HEIGHT
+#define DISPLAY_HEIGHT 64
+#endif
+
+/**
+ * @brief Panel wear statistics (8x8 pixel cells, 16 columns x 8 pages)
+ *
+ * Cell on-time is in pixel-seconds: 64 lit pixels for one second = 64.
+ */
+struct DisplayWearStats {
+    uint32_t minCellPixelSeconds;   // Least used cell that was ever lit
+    uint32_t maxCellPixelSeconds;   // Most used cell
+    uint32_t totalPixelSeconds;     // Sum over all cells
+    uint32_t flushCount;            // Frames pushed to the panel
+    int8_t shiftX;                  // Current pixel-shift offset
+    int8_t shiftY;
+};
+
+/**
+ * @brief Snapshot cache counters
+ */
+struct DisplaySnapshotStats {
+    uint32_t unchanged;             // Frames skipped, panel already showed the snapshot
+    uint32_t restored;              // Frames blitted from a cached snapshot
+    uint32_t rendered;              // Frames drawn and stored as a new snapshot
+};
+
 /**
  * @brief Main display manager class
  * 
@@ -61,13 +109,20 @@ public:
     // CONSTRUCTOR & INITIALIZATION
     // ========================================================================
     
+    static constexpr uint8_t WIDTH = DISPLAY_WIDTH;
+    static constexpr uint8_t HEIGHT = DISPLAY_HEIGHT;
+
+    /**
+     * @brief Whether the panel is NativePanel; the drawing paths are
+     * chosen on this at compile time
+     */
+    static constexpr bool NATIVE = WIDTH == NativePanel::WIDTH && HEIGHT == NativePanel::HEIGHT;
+
     /**
      * @brief Constructor
-     * @param width Display width in pixels (default: 128)
-     * @param height Display height in pixels (default: 64)
      * @param i2c_address Display I2C address (default: 0x3C)
      */
-    DisplayManager(uint8_t width = 128, uint8_t height = 64, uint8_t i2c_address = 0x3C);
+    DisplayManager(uint8_t i2c_address = 0x3C);
     
     /**
      * @brief Initialize display hardware
@@ -110,6 +165,17 @@ public:
      */
     void setPower(bool on);
 
+    /**
+     * @brief Get last brightness written to the panel
+     * @return Brightness (0-255)
+     */
+    uint8_t getBrightness() const { return _brightness; }
+
+    /**
+     * @brief Check if the panel is switched on
+     */
+    bool isPowerOn() const { return _powerOn; }
+
     /**
      * @brief Mark display buffer as dirty (needs update)
      */
@@ -180,6 +246,19 @@ public:
      * @param height Bitmap height
      */
     void drawBitmapCentered(const uint8_t* bitmap, uint8_t width, uint8_t height);
+
+    /**
+     * @brief Draw a transcoded asset (lit bounding box only)
+     * @param asset Page-major bitmap from PageAsset.h
+     * @param x X coordinate of the asset's top-left corner
+     * @param y Y coordinate of the asset's top-left corner
+     */
+    void drawAsset(const PageAsset& asset, int16_t x, int16_t y);
+
+    /**
+     * @brief Draw a transcoded asset centered on the panel
+     */
+    void drawAssetCentered(const PageAsset& asset);
     
     
     // ========================================================================
@@ -232,6 +311,157 @@ public:
      */
     void fadeOut(uint16_t duration = 500);
     
+    // ========================================================================
+    // BURN-IN MITIGATION
+    // ========================================================================
+
+    /**
+     * @brief Enable pixel-shift orbit
+     * The whole frame is offset at flush time, so callers draw as usual.
+     * @param enabled Enable/disable (disabling returns to 0,0)
+     * @param intervalMs Time between orbit steps
+     * @param amplitude Offset in pixels per axis (1-2)
+     */
+    void setPixelShift(bool enabled, unsigned long intervalMs = 180000, uint8_t amplitude = 1);
+
+    /**
+     * @brief Advance the orbit when due (call in loop, cheap)
+     * Marks the display dirty when the offset changes.
+     */
+    void updatePixelShift();
+
+    /**
+     * @brief Get on-time of one 8x8 cell
+     * @param column Cell column (0-15)
+     * @param page Cell page (0-7)
+     * @return Pixel-seconds
+     */
+    uint32_t getCellPixelSeconds(uint8_t column, uint8_t page) const;
+
+    /**
+     * @brief Get number of lit pixels in the last flushed frame
+     */
+    uint16_t getLitPixelCount() const;
+
+    /**
+     * @brief Get wear summary for verifying wear leveling
+     */
+    DisplayWearStats getWearStats() const;
+
+    /**
+     * @brief Print wear map and summary to Serial
+     */
+    void printWearStats() const;
+
+    // ========================================================================
+    // SNAPSHOT CACHE
+    // ========================================================================
+
+    /**
+     * @brief Show a cached static screen if available
+     * Typical use:
+     * @code
+     * uint32_t key = DisplayManager::snapshotKey(VIEW_ID, ssid);
+     * if (display.showSnapshot(key)) return;
+     * display.clear(); ...draw...
+     * display.saveSnapshot(key);
+     * @endcode
+     * Does nothing at all if the panel still shows this snapshot,
+     * otherwise restores it from the LRU and flushes.
+     * @param key Content key of the screen (snapshotKey() of its inputs)
+     * @return true if the screen is shown, false if the caller must draw it
+     */
+    bool showSnapshot(uint32_t key);
+
+    /**
+     * @brief Store the drawn buffer under key and flush it
+     * Replaces the least recently used snapshot when the cache is full.
+     */
+    void saveSnapshot(uint32_t key);
+
+    /**
+     * @brief Drop all snapshots (e.g. after a font or layout change)
+     */
+    void clearSnapshots();
+
+    /**
+     * @brief Get snapshot cache counters
+     */
+    const DisplaySnapshotStats& getSnapshotStats() const { return _snapshotStats; }
+
+    /**
+     * @brief Build a snapshot key (FNV-1a) from a screen's inputs
+     * @param seed View identifier or previous key to chain inputs
+     * @param text Input string (nullptr is skipped)
+     */
+    static uint32_t snapshotKey(uint32_t seed, const char* text);
+
+    /**
+     * @brief Build a snapshot key from a numeric input
+     */
+    static uint32_t snapshotKey(uint32_t seed, int32_t value);
+
+    // ========================================================================
+    // OFF-SCREEN PAGES
+    // ========================================================================
+
+    /**
+     * @brief Start drawing a page that is not shown
+     * Saves the current buffer and starts from a cleared one; drawing
+     * calls work as usual. Nothing is flushed until endOffscreen().
+     */
+    void beginOffscreen();
+
+    /**
+     * @brief Restore the buffer saved by beginOffscreen()
+     */
+    void endOffscreen();
+
+    /**
+     * @brief Compress the current buffer into a page store
+     * @return false if the store is full or the panel is not native
+     */
+    bool storeFrame(FrameStore& store, uint8_t index);
+
+    /**
+     * @brief Show a stored page
+     * Skips everything if the panel still shows this page, otherwise
+     * expands it into the buffer and flushes once.
+     * @param key Content key of the page (see snapshotKey())
+     * @return false if the page is not in the store
+     */
+    bool showStoredFrame(const FrameStore& store, uint8_t index, uint32_t key);
+
+    // ========================================================================
+    // STATUS OVERLAY
+    // ========================================================================
+
+    /**
+     * @brief Composite a status bar over every flushed frame
+     * @param overlay Bar to draw, nullptr = none
+     */
+    void setOverlay(StatusBar* overlay);
+
+    /**
+     * @brief Push changed status cells without redrawing the screen
+     * Runs the bar's auto-hide timer, then sends only the columns of the
+     * cells whose icon changed. Does nothing while a full frame is
+     * pending, since update() composites the whole bar (call in loop).
+     */
+    void updateOverlay();
+
+#ifdef DISPLAY_BENCHMARK
+    // ========================================================================
+    // BENCHMARK (build with -DDISPLAY_BENCHMARK)
+    // ========================================================================
+
+    /**
+     * @brief Time each primitive through Adafruit_GFX and DisplayCore
+     * Prints microseconds per call over Serial and clears the buffer.
+     */
+    void runBenchmark();
+
+#endif
     // ========================================================================
     // GETTERS & UTILITIES
     // ========================================================================
@@ -240,13 +470,13 @@ public:
      * @brief Get display width
      * @return Width in pixels
      */
-    uint8_t getWidth() const { return _width; }
+    uint8_t getWidth() const { return WIDTH; }
     
     /**
      * @brief Get display height
      * @return Height in pixels
      */
-    uint8_t getHeight() const { return _height; }
+    uint8_t getHeight() const { return HEIGHT; }
     
     /**
      * @brief Check if display is initialized
@@ -268,11 +498,52 @@ private:
     
     Adafruit_SH1106G* _display;   // Pointer to Adafruit driver
     
-    uint8_t _width;               // Display width
-    uint8_t _height;              // Display height
     uint8_t _i2c_address;         // I2C address
     bool _initialized;            // Init status flag
     bool _dirty;                  // Track if buffer needs display update
+    uint8_t _brightness;          // Last contrast value sent
+    bool _powerOn;                // Panel on/off state
+
+    // Pixel shift
+    bool _shiftEnabled;
+    uint8_t _shiftAmplitude;
+    uint8_t _shiftStep;           // Index into orbit table
+    int8_t _shiftX;
+    int8_t _shiftY;
+    unsigned long _shiftInterval;
+    unsigned long _lastShiftTime;
+
+    // Wear statistics (per 8x8 cell of the physical panel)
+    static constexpr uint8_t WEAR_COLS = NativePanel::WIDTH / 8;
+    static constexpr uint8_t WEAR_PAGES = NativePanel::PAGES;
+    static constexpr uint8_t WEAR_CELLS = WEAR_COLS * WEAR_PAGES;
+    uint8_t _cellLit[WEAR_CELLS];       // Lit pixels in last flushed frame
+    uint32_t _cellPixelSec[WEAR_CELLS]; // Accumulated pixel-seconds
+    uint16_t _cellPixelMs[WEAR_CELLS];  // Sub-second remainder
+    unsigned long _lastWearUpdate;
+    uint32_t _flushCount;
+
+    // Snapshot cache (native panel only; one frame per slot)
+    static constexpr uint8_t SNAPSHOT_SLOTS = 4;
+    static constexpr uint16_t SNAPSHOT_BYTES = NativePanel::BUFFER_BYTES;
+    struct Snapshot {
+        uint32_t key;               // 0 = empty
+        uint32_t lastUse;           // _snapshotClock at last use
+        uint8_t frame[SNAPSHOT_BYTES];
+    };
+    Snapshot _snapshots[SNAPSHOT_SLOTS];
+    uint32_t _snapshotClock;
+    uint32_t _shownKey;           // Snapshot on the panel (0 = none)
+    uint32_t _shownFlushCount;    // _flushCount when it was flushed
+    DisplaySnapshotStats _snapshotStats;
+
+    // Off-screen rendering: buffer and panel state saved meanwhile
+    uint8_t _offscreenSave[SNAPSHOT_BYTES];
+    bool _offscreen;
+    bool _offscreenDirty;
+    uint32_t _offscreenShownKey;
+
+    StatusBar* _overlay;          // Composited at flush time (not owned)
 
     // Animation state
     uint8_t _currentFrame;        // Current animation frame
@@ -291,6 +562,40 @@ private:
      * @return Width in pixels
      */
     int16_t getTextWidth(const char* text, uint8_t size);
+
+    /**
+     * @brief Push buffer to the panel with the pixel-shift offset applied
+     * Falls back to the driver's display() for non-native panels.
+     */
+    void flush();
+
+    /**
+     * @brief White outline / filled rectangle via DisplayCore when native
+     */
+    void drawRect(int16_t x, int16_t y, int16_t w, int16_t h);
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h);
+
+    /**
+     * @brief Push columns x0..x1 of one buffer page (plus the page the
+     * vertical shift spills it into)
+     */
+    void flushColumns(uint8_t x0, uint8_t x1, uint8_t page);
+
+    /**
+     * @brief Buffer column x of a panel page with the vertical shift applied
+     * @return 0 outside the buffer
+     */
+    uint8_t shiftedColumn(const uint8_t* buffer, uint8_t page, int16_t x) const;
+
+    /**
+     * @brief Send one page segment starting at a RAM column
+     */
+    void sendPage(uint8_t page, uint8_t column, const uint8_t* data, uint8_t length);
+
+    /**
+     * @brief Credit the last flushed frame with on-time up to now
+     */
+    void accumulateWear(unsigned long now);
     
     /**
      * @brief Map progress value to pixel position
@@ -0,0 +1,69 @@
+/**
+ * @file FrameStore.cpp
+ * @brief Implementation of FrameStore class
+ */
+
+#include "FrameStore.h"
+
+FrameStore::FrameStore() {
+    clear();
+}
+
+void FrameStore::clear() {
+    memset(_offset, 0, sizeof(_offset));
+    memset(_length, 0, sizeof(_length));
+    _used = 0;
+}
+
+bool FrameStore::store(uint8_t index, const uint8_t* frame) {
+    if (index >= MAX_FRAMES) return false;
+    _length[index] = 0;
+
+    uint16_t out = _used;
+    uint16_t i = 0;
+    while (i < FRAME_BYTES) {
+        uint8_t b = frame[i];
+        if (b != 0x00) {
+            if (out + 1 > POOL_BYTES) return false;
+            _pool[out++] = b;
+            i++;
+            continue;
+        }
+
+        // Run of blank columns (max 255 per token)
+        uint16_t run = 1;
+        while (i + run < FRAME_BYTES && run < 255 && frame[i + run] == 0x00) {
+            run++;
+        }
+        if (out + 2 > POOL_BYTES) return false;
+        _pool[out++] = 0x00;
+        _pool[out++] = (uint8_t)run;
+        i += run;
+    }
+
+    _offset[index] = _used;
+    _length[index] = out - _used;
+    _used = out;
+    return true;
+}
+
+bool FrameStore::load(uint8_t index, uint8_t* frame) const {
+    if (!has(index)) return false;
+
+    const uint8_t* in = _pool + _offset[index];
+    const uint8_t* end = in + _length[index];
+    uint16_t o = 0;
+
+    while (in < end && o < FRAME_BYTES) {
+        uint8_t b = *in++;
+        if (b != 0x00) {
+            frame[o++] = b;
+            continue;
+        }
+        uint16_t run = in < end ? *in++ : 0;
+        if (run > FRAME_BYTES - o) run = FRAME_BYTES - o;
+        memset(frame + o, 0, run);
+        o += run;
+    }
+    return o == FRAME_BYTES;
+}
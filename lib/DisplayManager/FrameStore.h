@@ -0,0 +1,58 @@
+/**
+ * @file FrameStore.h
+ * @brief Pool of run-length compressed 128x64 frames
+ *
+ * Holds pre-rendered pages (e.g. the weather overview and day pages) in
+ * less RAM than raw framebuffers. Text pages are mostly blank columns,
+ * so only zero runs are coded: a 0x00 byte is followed by its run
+ * length, every other byte is stored as is. Frames are appended until
+ * the pool is full; clear() starts over.
+ */
+
+#ifndef FRAME_STORE_H
+#define FRAME_STORE_H
+
+#include <Arduino.h>
+
+class FrameStore {
+public:
+    static constexpr uint16_t FRAME_BYTES = 128 * 64 / 8;
+    static constexpr uint16_t POOL_BYTES = 4096;
+    static constexpr uint8_t MAX_FRAMES = 6;
+
+    FrameStore();
+
+    /**
+     * @brief Drop all frames
+     */
+    void clear();
+
+    /**
+     * @brief Compress a frame into the pool
+     * @param index Frame slot (0 to MAX_FRAMES-1)
+     * @param frame FRAME_BYTES of page-mode framebuffer
+     * @return false if the pool is full (slot left empty)
+     */
+    bool store(uint8_t index, const uint8_t* frame);
+
+    /**
+     * @brief Expand a stored frame
+     * @return false if the slot is empty
+     */
+    bool load(uint8_t index, uint8_t* frame) const;
+
+    bool has(uint8_t index) const { return index < MAX_FRAMES && _length[index] > 0; }
+
+    /**
+     * @brief Compressed bytes in use
+     */
+    uint16_t getUsedBytes() const { return _used; }
+
+private:
+    uint8_t _pool[POOL_BYTES];
+    uint16_t _offset[MAX_FRAMES];
+    uint16_t _length[MAX_FRAMES];   // 0 = empty
+    uint16_t _used;
+};
+
+#endif // FRAME_STORE_H
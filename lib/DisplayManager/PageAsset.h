@@ -0,0 +1,173 @@
+/**
+ * @file PageAsset.h
+ * @brief Compile-time transcoding of row-major bitmaps into panel layout
+ *
+ * Icons and animation frames are written as row-major literals (MSB
+ * left, as exported by image2cpp). transcodeAsset() turns them into the
+ * panel's page-major layout (one byte = 8 rows of a column, bit 0 on
+ * top) during compilation and records the bounding box of lit pixels,
+ * so drawing is a byte copy per column that skips empty margins.
+ *
+ * Assets of one size can be collected in a table; dedupAssets() and
+ * buildPool() then keep one copy of identical entries. The raw literals
+ * and the source table are only read by the compiler and never reach
+ * flash; only the pool does.
+ */
+
+#ifndef PAGE_ASSET_H
+#define PAGE_ASSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+/**
+ * @brief Type-erased view of a transcoded bitmap (what drawing code takes)
+ */
+struct PageAsset {
+    const uint8_t* data;    // (height + 7) / 8 pages of width bytes
+    uint8_t width;
+    uint8_t height;
+    uint8_t boxX;           // Bounding box of lit pixels,
+    uint8_t boxY;           // boxW == 0 for a blank asset
+    uint8_t boxW;
+    uint8_t boxH;
+};
+
+/**
+ * @brief Page-major bitmap of a fixed size
+ */
+template <uint8_t W, uint8_t H>
+struct PageBitmap {
+    static constexpr uint8_t PAGES = (H + 7) / 8;
+    static constexpr uint16_t BYTES = (uint16_t)W * PAGES;
+    static constexpr uint16_t ROW_BYTES = (W + 7) / 8;
+
+    uint8_t data[BYTES];
+    uint8_t boxX;
+    uint8_t boxY;
+    uint8_t boxW;
+    uint8_t boxH;
+
+    constexpr PageAsset asset() const {
+        return PageAsset{data, W, H, boxX, boxY, boxW, boxH};
+    }
+};
+
+/**
+ * @brief Transcode a row-major literal
+ * @param rows (W + 7) / 8 bytes per row, H rows
+ */
+template <uint8_t W, uint8_t H, size_t N>
+constexpr PageBitmap<W, H> transcodeAsset(const uint8_t (&rows)[N]) {
+    static_assert(N == PageBitmap<W, H>::ROW_BYTES * H, "Literal size does not match WxH");
+
+    PageBitmap<W, H> out{};
+    int16_t x0 = W, y0 = H, x1 = -1, y1 = -1;
+
+    for (uint16_t y = 0; y < H; y++) {
+        for (uint16_t x = 0; x < W; x++) {
+            if (!(rows[y * PageBitmap<W, H>::ROW_BYTES + x / 8] & (0x80 >> (x & 7)))) continue;
+
+            out.data[(y / 8) * W + x] |= 1 << (y & 7);
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            if (y > y1) y1 = y;
+        }
+    }
+
+    if (x1 >= 0) {
+        out.boxX = x0;
+        out.boxY = y0;
+        out.boxW = x1 - x0 + 1;
+        out.boxH = y1 - y0 + 1;
+    }
+    return out;
+}
+
+template <uint8_t W, uint8_t H>
+constexpr bool sameAsset(const PageBitmap<W, H>& a, const PageBitmap<W, H>& b) {
+    for (uint16_t i = 0; i < PageBitmap<W, H>::BYTES; i++) {
+        if (a.data[i] != b.data[i]) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Where each source entry ended up after deduplication
+ */
+template <size_t N>
+struct AssetDedup {
+    uint8_t slot[N];        // Pool index of each source entry
+    uint8_t firstSource[N]; // First source entry with the same content
+    uint8_t unique;         // Pool size
+};
+
+template <uint8_t W, uint8_t H, size_t N>
+constexpr AssetDedup<N> dedupAssets(const PageBitmap<W, H> (&source)[N]) {
+    static_assert(N < 256, "Too many assets in one table");
+
+    AssetDedup<N> map{};
+    for (size_t i = 0; i < N; i++) {
+        size_t first = i;
+        for (size_t j = 0; j < i; j++) {
+            if (map.firstSource[j] == j && sameAsset(source[i], source[j])) {
+                first = j;
+                break;
+            }
+        }
+        map.firstSource[i] = first;
+        map.slot[i] = first == i ? map.unique++ : map.slot[first];
+    }
+    return map;
+}
+
+template <uint8_t W, uint8_t H, size_t U>
+struct AssetPool {
+    PageBitmap<W, H> items[U];
+
+    constexpr PageAsset operator[](size_t slot) const { return items[slot].asset(); }
+};
+
+template <size_t U, uint8_t W, uint8_t H, size_t N>
+constexpr AssetPool<W, H, U> buildPool(const PageBitmap<W, H> (&source)[N],
+                                       const AssetDedup<N>& map) {
+    AssetPool<W, H, U> pool{};
+    for (size_t i = 0; i < N; i++) {
+        if (map.firstSource[i] == i) pool.items[map.slot[i]] = source[i];
+    }
+    return pool;
+}
+
+#ifdef ARDUINO
+
+/**
+ * @brief Print what a deduplicated table costs in flash, per source entry
+ * @param tag Log prefix, e.g. "ANIM"
+ * @param names Name of each source entry
+ */
+template <uint8_t W, uint8_t H, size_t N, size_t U>
+void printAssetReport(const char* tag, const char* const (&names)[N],
+                      const AssetDedup<N>& map, const AssetPool<W, H, U>& pool) {
+    const uint16_t bytes = PageBitmap<W, H>::BYTES;
+
+    for (size_t i = 0; i < N; i++) {
+        const PageBitmap<W, H>& item = pool.items[map.slot[i]];
+        if (map.firstSource[i] != i) {
+            Serial.printf("[%s] %-12s = %-12s saved %u B\n",
+                          tag, names[i], names[map.firstSource[i]], bytes);
+        } else {
+            Serial.printf("[%s] %-12s %ux%u box %u,%u %ux%u  %u B\n",
+                          tag, names[i], W, H, item.boxX, item.boxY, item.boxW, item.boxH, bytes);
+        }
+    }
+    Serial.printf("[%s] %u %ux%u assets in %u B (%u B saved by dedup)\n",
+                  tag, (unsigned)N, W, H, (unsigned)(U * bytes), (unsigned)((N - U) * bytes));
+}
+
+#endif // ARDUINO
+
+#endif // PAGE_ASSET_H
@@ -0,0 +1,94 @@
+/**
+ * @file StatusBar.cpp
+ * @brief Implementation of StatusBar class
+ */
+
+#include "StatusBar.h"
+
+StatusBar::StatusBar()
+    : _enabled(true),
+      _shown(true),
+      _autoHideMs(0),
+      _lastChangeMs(0)
+{
+    memset(_cells, 0, sizeof(_cells));
+}
+
+void StatusBar::setIcon(StatusElement element, const PageAsset* icon) {
+    uint8_t index = (uint8_t)element;
+    if (index >= ELEMENTS || _cells[index].icon == icon) return;
+
+    _cells[index].icon = icon;
+    poke();
+}
+
+void StatusBar::setEnabled(bool enabled) {
+    if (enabled && !_enabled) {
+        _lastChangeMs = millis();
+    }
+    _enabled = enabled;
+}
+
+void StatusBar::poke() {
+    _shown = true;
+    _lastChangeMs = millis();
+}
+
+void StatusBar::update() {
+    if (_autoHideMs == 0 || !_shown) return;
+    if (millis() - _lastChangeMs >= _autoHideMs) {
+        _shown = false;
+    }
+}
+
+// ============================================================================
+// COMPOSITING
+// ============================================================================
+
+void StatusBar::composite(uint8_t* buffer) {
+    for (uint8_t i = 0; i < ELEMENTS; i++) {
+        Cell& cell = _cells[i];
+        cell.drawn = wanted(i);
+        if (cell.drawn == nullptr) continue;
+
+        uint8_t* column = buffer + cellX(i);    // Page 0
+        memcpy(cell.under, column, CELL_SIZE);
+        drawIcon(column, cell.drawn);
+    }
+}
+
+void StatusBar::restore(uint8_t* buffer) {
+    for (uint8_t i = 0; i < ELEMENTS; i++) {
+        if (_cells[i].drawn == nullptr) continue;
+        memcpy(buffer + cellX(i), _cells[i].under, CELL_SIZE);
+    }
+}
+
+bool StatusBar::getDirtyColumns(uint8_t& x0, uint8_t& x1) const {
+    bool dirty = false;
+
+    for (uint8_t i = 0; i < ELEMENTS; i++) {
+        if (wanted(i) == _cells[i].drawn) continue;
+
+        uint8_t x = cellX(i);
+        if (!dirty || x < x0) x0 = x;
+        if (!dirty || x + CELL_SIZE - 1 > x1) x1 = x + CELL_SIZE - 1;
+        dirty = true;
+    }
+    return dirty;
+}
+
+const PageAsset* StatusBar::wanted(uint8_t index) const {
+    return isShown() ? _cells[index].icon : nullptr;
+}
+
+uint8_t StatusBar::cellX(uint8_t index) {
+    return RIGHT_X - index * SPACING;
+}
+
+// Page 0 of the icon is the cell's 8 rows; opaque cell
+void StatusBar::drawIcon(uint8_t* column, const PageAsset* icon) {
+    for (uint8_t x = 0; x < CELL_SIZE; x++) {
+        column[x] = x < icon->width ? pgm_read_byte(icon->data + x) : 0;
+    }
+}
@@ -0,0 +1,119 @@
+/**
+ * @file StatusBar.h
+ * @brief Status icon overlay composited on top of the current screen
+ *
+ * A row of 8x8 cells at the top-right of the panel (WiFi, battery,
+ * weather, pomodoro). DisplayManager draws the bar over every frame it
+ * flushes and takes it out of the framebuffer again afterwards, so
+ * screens never draw around it. Each cell is dirty while its icon
+ * differs from what the panel shows; a dirty cell is repainted and
+ * pushed on its own, leaving the screen below alone.
+ * The bar can hide itself after a quiet period to limit burn-in.
+ */
+
+#ifndef STATUS_BAR_H
+#define STATUS_BAR_H
+
+#include <Arduino.h>
+#include "PageAsset.h"
+
+/**
+ * @brief Status bar cells, right to left
+ */
+enum class StatusElement : uint8_t {
+    WIFI,
+    BATTERY,
+    WEATHER,
+    POMODORO,
+    COUNT
+};
+
+class StatusBar {
+public:
+    static constexpr uint8_t ELEMENTS = (uint8_t)StatusElement::COUNT;
+    static constexpr uint8_t CELL_SIZE = 8;
+    static constexpr uint8_t RIGHT_X = 120;     // x of the rightmost cell
+    static constexpr uint8_t SPACING = 9;       // Cell pitch (1 px gap)
+
+    StatusBar();
+
+    /**
+     * @brief Set an element's icon
+     * @param element Cell to set
+     * @param icon 8x8 transcoded icon, nullptr = empty
+     * A change shows the bar again if it was auto-hidden.
+     */
+    void setIcon(StatusElement element, const PageAsset* icon);
+
+    /**
+     * @brief Allow the bar on the current screen
+     * Screens that use the top row themselves turn it off.
+     */
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    /**
+     * @brief Hide the bar after this long without icon changes
+     * @param ms Quiet time, 0 = never hide
+     */
+    void setAutoHide(uint32_t ms) { _autoHideMs = ms; }
+
+    /**
+     * @brief Show the bar again (e.g. on user activity)
+     */
+    void poke();
+
+    /**
+     * @brief Run the auto-hide timer (DisplayManager::updateOverlay() calls it)
+     */
+    void update();
+
+    /**
+     * @brief Whether icons are currently drawn
+     */
+    bool isShown() const { return _enabled && _shown; }
+
+    // ========================================================================
+    // COMPOSITING (used by DisplayManager)
+    // ========================================================================
+
+    /**
+     * @brief Draw the shown cells over the framebuffer before a flush
+     * Saves the pixels under each cell for restore().
+     * @param buffer 128x64 page-mode framebuffer
+     */
+    void composite(uint8_t* buffer);
+
+    /**
+     * @brief Put back the pixels composite() covered
+     * Keeps the overlay out of the framebuffer callers draw into.
+     */
+    void restore(uint8_t* buffer);
+
+    /**
+     * @brief Columns of cells whose icon differs from the panel
+     * @param x0 First dirty column (out)
+     * @param x1 Last dirty column (out)
+     * @return true if any cell is dirty
+     */
+    bool getDirtyColumns(uint8_t& x0, uint8_t& x1) const;
+
+private:
+    struct Cell {
+        const PageAsset* icon;      // Wanted icon
+        const PageAsset* drawn;     // Icon on the panel (dirty if != icon)
+        uint8_t under[CELL_SIZE];   // Framebuffer pixels below it
+    };
+
+    Cell _cells[ELEMENTS];
+    bool _enabled;
+    bool _shown;
+    uint32_t _autoHideMs;
+    uint32_t _lastChangeMs;
+
+    const PageAsset* wanted(uint8_t index) const;
+    static uint8_t cellX(uint8_t index);
+    static void drawIcon(uint8_t* column, const PageAsset* icon);
+};
+
+#endif // STATUS_BAR_H
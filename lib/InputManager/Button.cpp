@@ -4,6 +4,7 @@
  */
 
 #include "Button.h"
+#include "SensorTrace.h"
 
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
@@ -28,7 +29,9 @@ Button::Button(uint8_t pin, bool activeLow, bool enablePullup)
       _releasedEdge(false),
       _longPressTriggered(false),
       _clickCount(0),
-      _callback(nullptr)
+      _callback(nullptr),
+      _trace(nullptr),
+      _traceBit(0)
 {
 }
 
@@ -51,7 +54,7 @@ void Button::begin() {
 
 void Button::update() {
     bool rawState = readRawState();
-    unsigned long currentTime = millis();
+    unsigned long currentTime = SensorTrace::clock(_trace);
     
     // Reset edge flags
     _pressedEdge = false;
@@ -137,7 +140,7 @@ ButtonEvent Button::getEvent() {
 
 unsigned long Button::getPressedDuration() const {
     if (_debouncedState) {
-        return millis() - _pressedTime;
+        return SensorTrace::clock(_trace) - _pressedTime;
     }
     return 0;
 }
@@ -150,6 +153,11 @@ void Button::setCallback(ButtonCallback callback) {
     _callback = callback;
 }
 
+void Button::setTrace(SensorTrace* trace, uint8_t bit) {
+    _trace = trace;
+    _traceBit = bit;
+}
+
 void Button::setTiming(uint16_t debounceMs, uint16_t longPressMs, uint16_t doubleClickMs) {
     _debounceDelay = debounceMs;
     _longPressThreshold = longPressMs;
@@ -172,12 +180,20 @@ void Button::reset() {
 // ============================================================================
 
 bool Button::readRawState() {
+    if (_trace != nullptr && _trace->isReplaying()) {
+        return _trace->getInput(_traceBit);
+    }
+
     bool state = digitalRead(_pin);
-    return _activeLow ? !state : state;
+    state = _activeLow ? !state : state;
+    if (_trace != nullptr) {
+        _trace->setInput(_traceBit, state);
+    }
+    return state;
 }
 
 void Button::detectEvents() {
-    unsigned long currentTime = millis();
+    unsigned long currentTime = SensorTrace::clock(_trace);
     unsigned long timeSinceLastClick = currentTime - _lastClickTime;
     
     if (timeSinceLastClick < _doubleClickWindow && _clickCount == 1) {
@@ -15,6 +15,8 @@
 
 #include <Arduino.h>
 
+class SensorTrace;
+
 // ============================================================================
 // BUTTON EVENT TYPES
 // ============================================================================
@@ -87,6 +89,13 @@ public:
      * @param callback Function to call when event occurs
      */
     void setCallback(ButtonCallback callback);
+
+    /**
+     * @brief Record the level into a trace, or read it from one while it replays
+     * @param trace nullptr to detach
+     * @param bit TRACE_INPUT_* bit of this button
+     */
+    void setTrace(SensorTrace* trace, uint8_t bit);
     
     /**
      * @brief Configure timing parameters
@@ -138,6 +147,10 @@ private:
     
     // Callback
     ButtonCallback _callback;
+
+    // Recording / replay
+    SensorTrace* _trace;
+    uint8_t _traceBit;
     
     // Private methods
     bool readRawState();
@@ -4,6 +4,7 @@
  */
 
 #include "InputManager.h"
+#include "SensorTrace.h"
 
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
@@ -15,7 +16,8 @@ InputManager::InputManager()
       _selectButton(nullptr),
       _backButton(nullptr),
       _selectConfigured(false),
-      _backConfigured(false)
+      _backConfigured(false),
+      _trace(nullptr)
 {
 }
 
@@ -87,6 +89,11 @@ void InputManager::update() {
     if (_backConfigured && _backButton != nullptr) {
         _backButton->update();
     }
+
+    // Levels read above go into the trace as one record
+    if (_trace != nullptr) {
+        _trace->flushInputs();
+    }
 }
 
 // ============================================================================
@@ -136,4 +143,17 @@ void InputManager::setEncoderCallback(EncoderCallback callback) {
 
 bool InputManager::isEncoderMode() const {
     return _encoderMode;
+}
+
+void InputManager::setTrace(SensorTrace* trace) {
+    _trace = trace;
+    if (_encoder != nullptr) {
+        _encoder->setTrace(trace);
+    }
+    if (_selectButton != nullptr) {
+        _selectButton->setTrace(trace, TRACE_INPUT_SELECT);
+    }
+    if (_backButton != nullptr) {
+        _backButton->setTrace(trace, TRACE_INPUT_BACK);
+    }
 }
\ No newline at end of file
@@ -94,6 +94,12 @@ public:
      */
     bool isEncoderMode() const;
 
+    /**
+     * @brief Record encoder/button levels into a trace, or read them from one while it replays
+     * Call after init; nullptr detaches.
+     */
+    void setTrace(SensorTrace* trace);
+
 private:
     // Rotary encoder
     RotaryEncoder* _encoder;
@@ -105,6 +111,9 @@ private:
 
     bool _selectConfigured;
     bool _backConfigured;
+
+    // Recording / replay
+    SensorTrace* _trace;
 };
 
 #endif // INPUT_MANAGER_H
\ No newline at end of file
@@ -4,6 +4,7 @@
  */
 
 #include "RotaryEncoder.h"
+#include "SensorTrace.h"
 
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
@@ -25,7 +26,8 @@ RotaryEncoder::RotaryEncoder(uint8_t clkPin, uint8_t dtPin, uint8_t swPin, uint8
       _lastRotationTime(0),
       _accelerationFactor(1),
       _button(nullptr),
-      _callback(nullptr)
+      _callback(nullptr),
+      _trace(nullptr)
 {
 }
 
@@ -58,9 +60,17 @@ void RotaryEncoder::update() {
 // ============================================================================
 
 uint8_t RotaryEncoder::getEncodedState() {
+    if (_trace != nullptr && _trace->isReplaying()) {
+        return (_trace->getInput(TRACE_INPUT_CLK) << 1) | _trace->getInput(TRACE_INPUT_DT);
+    }
+
     // Read both pins and encode as 2-bit value
     uint8_t clk = digitalRead(_clkPin);
     uint8_t dt = digitalRead(_dtPin);
+    if (_trace != nullptr) {
+        _trace->setInput(TRACE_INPUT_CLK, clk);
+        _trace->setInput(TRACE_INPUT_DT, dt);
+    }
     return (clk << 1) | dt;
 }
 
@@ -112,7 +122,7 @@ void RotaryEncoder::readEncoder() {
             // Calculate step size with acceleration
             uint8_t stepSize = 1;
             if (_accelerationEnabled) {
-                unsigned long currentTime = millis();
+                unsigned long currentTime = SensorTrace::clock(_trace);
                 unsigned long timeDelta = currentTime - _lastRotationTime;
 
                 if (timeDelta < _accelerationThreshold) {
@@ -231,6 +241,13 @@ void RotaryEncoder::setCallback(EncoderCallback callback) {
     _callback = callback;
 }
 
+void RotaryEncoder::setTrace(SensorTrace* trace) {
+    _trace = trace;
+    if (_button != nullptr) {
+        _button->setTrace(trace, TRACE_INPUT_SELECT);
+    }
+}
+
 void RotaryEncoder::setAcceleration(bool enabled, uint16_t threshold) {
     _accelerationEnabled = enabled;
     _accelerationThreshold = threshold;
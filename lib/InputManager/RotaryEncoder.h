@@ -123,6 +123,13 @@ public:
      */
     void setCallback(EncoderCallback callback);
 
+    /**
+     * @brief Record pin levels into a trace, or read them from one while it replays
+     * Call after begin() so the push button is attached as well.
+     * @param trace nullptr to detach
+     */
+    void setTrace(SensorTrace* trace);
+
     /**
      * @brief Enable/disable acceleration
      * When enabled, faster rotation = larger steps
@@ -160,6 +167,9 @@ private:
     // Callback
     EncoderCallback _callback;
 
+    // Recording / replay
+    SensorTrace* _trace;
+
     // Private methods
     void readEncoder();
     void updateButton();
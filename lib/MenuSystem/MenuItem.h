@@ -64,6 +64,7 @@ enum class MenuItemID : uint16_t {
     SETTING_BRIGHTNESS = 41,
     SETTING_SOUND = 42,
     SETTING_SENSITIVITY = 43,
+    SETTING_AUTO_BRIGHTNESS = 46,
 
     // WiFi items
     SETTING_WIFI = 44,
@@ -0,0 +1,74 @@
+/**
+ * @file ActivityBenchmark.h
+ * @brief Cost of the ActivityClassifier per reading
+ *
+ * Shared by the device (MotionSensor::runActivityBenchmark, build with
+ * -DSENSOR_BENCHMARK) and the host (tools/filter_bench.cpp), which pass
+ * their own microsecond clock and print function.
+ *
+ * Readings come every READING_MS, as from the main loop, so about seven
+ * are averaged per decimated sample and every READINGS_PER_WINDOW-th
+ * reading evaluates a window; the time per reading includes that share.
+ */
+
+#ifndef ACTIVITY_BENCHMARK_H
+#define ACTIVITY_BENCHMARK_H
+
+#include <math.h>
+#include "ActivityClassifier.h"
+
+namespace activity_bench {
+
+static const uint32_t READING_MS = 12;
+static const uint32_t READINGS_PER_WINDOW =
+    ActivityClassifier::WINDOW_SAMPLES * (1000 / ActivityClassifier::SAMPLE_HZ) / READING_MS;
+
+// Walking-like readings: 1.9 Hz bounce on gravity plus a little sway
+inline void reading(uint32_t i, float& ax, float& ay, float& az) {
+    float t = i * READING_MS / 1000.0f;
+    ax = 0.8f * sinf(5.969f * t);
+    ay = 0.1f * (float)(i % 7) - 0.3f;
+    az = 9.81f + 2.5f * sinf(11.938f * t);
+}
+
+/**
+ * @brief Percent of the CPU at one reading per READING_MS
+ */
+inline float cpuPercent(uint32_t nsPerReading) {
+    return nsPerReading / (READING_MS * 10000.0f);
+}
+
+/**
+ * @param nowUs uint32_t() returning microseconds
+ * @param report void(const char* name, uint32_t nsPerReading)
+ */
+template <typename Clock, typename Report>
+void run(Clock nowUs, Report report, uint32_t readings = 20000) {
+    ActivityClassifier classifier;
+
+    // Inputs are computed in both loops, so the difference is the classifier
+    volatile float sink = 0.0f;
+    float ax, ay, az;
+
+    uint32_t startUs = nowUs();
+    for (uint32_t i = 0; i < readings; i++) {
+        reading(i, ax, ay, az);
+        sink = ax + ay + az;
+    }
+    uint32_t inputUs = nowUs() - startUs;
+
+    startUs = nowUs();
+    for (uint32_t i = 0; i < readings; i++) {
+        reading(i, ax, ay, az);
+        classifier.addSample(ax, ay, az, i * READING_MS);
+    }
+    uint32_t elapsedUs = nowUs() - startUs;
+    (void)sink;
+
+    uint32_t classifierUs = elapsedUs > inputUs ? elapsedUs - inputUs : 0;
+    report("activity classifier", (uint32_t)((uint64_t)classifierUs * 1000 / readings));
+}
+
+} // namespace activity_bench
+
+#endif // ACTIVITY_BENCHMARK_H
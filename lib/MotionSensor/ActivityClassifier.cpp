@@ -0,0 +1,217 @@
+/**
+ * @file ActivityClassifier.cpp
+ * @brief Implementation of ActivityClassifier
+ */
+
+#include "ActivityClassifier.h"
+#include <math.h>
+#include <string.h>
+
+static const float TWO_PI_F = 6.28318531f;
+static const float DEG_PER_RAD = 57.2957795f;
+
+// ============================================================================
+// CONSTRUCTOR & INITIALIZATION
+// ============================================================================
+
+ActivityClassifier::ActivityClassifier()
+    : _callback(nullptr)
+{
+    for (uint8_t i = 0; i < BIN_COUNT; i++) {
+        _goertzelCoeff[i] = 2.0f * cosf(TWO_PI_F * (FIRST_BIN + i) / WINDOW_SAMPLES);
+    }
+    reset();
+}
+
+void ActivityClassifier::reset() {
+    _activity = Activity::STATIONARY;
+    _candidate = Activity::STATIONARY;
+    _candidateWindows = 0;
+    _features = {0.0f, 0.0f, 0.0f, 0.0f};
+
+    _lastTickMs = 0;
+    _started = false;
+    _sumX = _sumY = _sumZ = 0.0f;
+    _sumCount = 0;
+
+    _gravitySum[0] = _gravitySum[1] = _gravitySum[2] = 0.0f;
+    _windowFill = 0;
+    _hasLastGravity = false;
+
+#ifdef ARDUINO
+    _busyUs = 0;
+    _sinceMs = millis();
+#endif
+}
+
+// ============================================================================
+// SAMPLING
+// ============================================================================
+
+void ActivityClassifier::addSample(float ax, float ay, float az, uint32_t nowMs) {
+#ifdef ARDUINO
+    uint32_t startUs = micros();
+#endif
+
+    if (!_started) {
+        _started = true;
+        _lastTickMs = nowMs;
+    }
+
+    _sumX += ax;
+    _sumY += ay;
+    _sumZ += az;
+    _sumCount++;
+
+    if (nowMs - _lastTickMs >= SAMPLE_INTERVAL_MS) {
+        // Resync after a stall instead of emitting a burst of ticks
+        _lastTickMs = nowMs - _lastTickMs >= 2 * SAMPLE_INTERVAL_MS ? nowMs
+                                                                    : _lastTickMs + SAMPLE_INTERVAL_MS;
+        addDecimated(_sumX / _sumCount, _sumY / _sumCount, _sumZ / _sumCount);
+        _sumX = _sumY = _sumZ = 0.0f;
+        _sumCount = 0;
+    }
+
+#ifdef ARDUINO
+    _busyUs += micros() - startUs;
+#endif
+}
+
+void ActivityClassifier::addDecimated(float ax, float ay, float az) {
+    _magnitude[_windowFill++] = sqrtf(ax * ax + ay * ay + az * az);
+    _gravitySum[0] += ax;
+    _gravitySum[1] += ay;
+    _gravitySum[2] += az;
+
+    if (_windowFill == WINDOW_SAMPLES) {
+        evaluateWindow();
+        _windowFill = 0;
+        _gravitySum[0] = _gravitySum[1] = _gravitySum[2] = 0.0f;
+    }
+}
+
+// ============================================================================
+// FEATURES
+// ============================================================================
+
+void ActivityClassifier::evaluateWindow() {
+    float mean = 0.0f;
+    for (uint8_t i = 0; i < WINDOW_SAMPLES; i++) {
+        mean += _magnitude[i];
+    }
+    mean /= WINDOW_SAMPLES;
+
+    float energy = 0.0f;
+    for (uint8_t i = 0; i < WINDOW_SAMPLES; i++) {
+        _magnitude[i] -= mean;
+        energy += _magnitude[i] * _magnitude[i];
+    }
+    _features.stdDev = sqrtf(energy / WINDOW_SAMPLES);
+
+    // Goertzel per gait bin; a real signal splits a bin's energy over k and N-k
+    float bestPower = 0.0f;
+    uint8_t bestBin = 0;
+    for (uint8_t b = 0; b < BIN_COUNT; b++) {
+        float coeff = _goertzelCoeff[b];
+        float s1 = 0.0f, s2 = 0.0f;
+        for (uint8_t i = 0; i < WINDOW_SAMPLES; i++) {
+            float s = _magnitude[i] + coeff * s1 - s2;
+            s2 = s1;
+            s1 = s;
+        }
+        float power = s1 * s1 + s2 * s2 - coeff * s1 * s2;
+        if (power > bestPower) {
+            bestPower = power;
+            bestBin = FIRST_BIN + b;
+        }
+    }
+    _features.dominantHz = bestBin * (1000.0f / SAMPLE_INTERVAL_MS) / WINDOW_SAMPLES;
+    _features.periodicity = energy > 0.0f ? 2.0f * bestPower / (WINDOW_SAMPLES * energy) : 0.0f;
+
+    // Tilt change between the mean gravity directions of consecutive windows
+    float length = sqrtf(_gravitySum[0] * _gravitySum[0] +
+                         _gravitySum[1] * _gravitySum[1] +
+                         _gravitySum[2] * _gravitySum[2]);
+    _features.tiltChangeDeg = 0.0f;
+    if (length > 0.0f) {
+        float gravity[3] = {_gravitySum[0] / length, _gravitySum[1] / length, _gravitySum[2] / length};
+        if (_hasLastGravity) {
+            float dot = gravity[0] * _lastGravity[0] +
+                        gravity[1] * _lastGravity[1] +
+                        gravity[2] * _lastGravity[2];
+            _features.tiltChangeDeg = acosf(fminf(fmaxf(dot, -1.0f), 1.0f)) * DEG_PER_RAD;
+        }
+        memcpy(_lastGravity, gravity, sizeof(gravity));
+        _hasLastGravity = true;
+    }
+
+    Activity seen = classify();
+    if (seen == _activity) {
+        _candidateWindows = 0;
+        return;
+    }
+    if (seen != _candidate) {
+        _candidate = seen;
+        _candidateWindows = 0;
+    }
+    if (++_candidateWindows < CONFIRM_WINDOWS) return;
+
+    Activity from = _activity;
+    _activity = seen;
+    _candidateWindows = 0;
+#ifdef ARDUINO
+    Serial.printf("[MOTION] Activity %s -> %s (std %.2f, %.1f Hz x%.2f, tilt %.0f deg)\n",
+                  getActivityName(from), getActivityName(seen), _features.stdDev,
+                  _features.dominantHz, _features.periodicity, _features.tiltChangeDeg);
+#endif
+    if (_callback != nullptr) {
+        _callback(from, seen);
+    }
+}
+
+Activity ActivityClassifier::classify() const {
+    float stillStd = _activity == Activity::STATIONARY ? STILL_STAY_STD : STILL_ENTER_STD;
+    if (_features.stdDev < stillStd && _features.tiltChangeDeg < STILL_MAX_TILT) {
+        return Activity::STATIONARY;
+    }
+
+    if (_features.stdDev >= WALK_MIN_STD &&
+        _features.periodicity >= WALK_MIN_PERIODICITY &&
+        _features.dominantHz >= WALK_MIN_HZ && _features.dominantHz <= WALK_MAX_HZ) {
+        return Activity::WALKING;
+    }
+
+    if (_features.tiltChangeDeg >= HANDLED_MIN_TILT) {
+        return Activity::HANDLED;
+    }
+    return Activity::TRANSPORTED;
+}
+
+// ============================================================================
+// STATUS
+// ============================================================================
+
+#ifdef ARDUINO
+
+float ActivityClassifier::getCpuPercent() const {
+    uint32_t elapsedMs = millis() - _sinceMs;
+    return elapsedMs > 0 ? _busyUs / (elapsedMs * 10.0f) : 0.0f;
+}
+
+void ActivityClassifier::printStatus(Print& out) const {
+    out.printf("[MOTION] Activity %s: std %.2f m/s2, %.1f Hz x%.2f, tilt %.1f deg, CPU %.3f%%\n",
+               getActivityName(_activity), _features.stdDev, _features.dominantHz,
+               _features.periodicity, _features.tiltChangeDeg, getCpuPercent());
+}
+
+#endif // ARDUINO
+
+const char* ActivityClassifier::getActivityName(Activity activity) {
+    switch (activity) {
+        case Activity::STATIONARY:  return "stationary";
+        case Activity::HANDLED:     return "handled";
+        case Activity::WALKING:     return "walking";
+        case Activity::TRANSPORTED: return "transported";
+        default:                    return "?";
+    }
+}
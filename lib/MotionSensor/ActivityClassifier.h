@@ -0,0 +1,162 @@
+/**
+ * @file ActivityClassifier.h
+ * @brief Classify what the device is doing from the accelerometer
+ *
+ * Readings are box-averaged down to SAMPLE_HZ and collected into
+ * windows of WINDOW_SAMPLES (about 2.5 s). Each full window yields:
+ * - standard deviation of the acceleration magnitude (how much it moves)
+ * - dominant frequency and its share of the energy, from Goertzel
+ *   filters over the gait band (steps are periodic, handling is not)
+ * - tilt change: angle between this window's and the last window's
+ *   mean gravity direction (turned in the hand vs. riding along)
+ *
+ * A new activity is reported only after it was seen in CONFIRM_WINDOWS
+ * consecutive windows, and staying STATIONARY uses a looser threshold
+ * than entering it, so the state does not flicker at the boundaries.
+ * The work per reading is a few additions, and each window costs a few
+ * hundred multiplies. The SENSOR_BENCHMARK build times both
+ * (ActivityBenchmark.h). getCpuPercent() gives the share measured on
+ * the device.
+ *
+ * Arduino is only needed for the CPU accounting and logging, so
+ * tools/activity_check.cpp can run the classifier on the host.
+ */
+
+#ifndef ACTIVITY_CLASSIFIER_H
+#define ACTIVITY_CLASSIFIER_H
+
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+// ============================================================================
+// ACTIVITY
+// ============================================================================
+enum class Activity : uint8_t {
+    STATIONARY,     // Lying still (on the desk)
+    HANDLED,        // Held and turned, irregular movement
+    WALKING,        // Carried by someone walking (hand, pocket or bag)
+    TRANSPORTED     // Vibration without turning or steps (bag, vehicle)
+};
+
+static constexpr uint8_t ACTIVITY_COUNT = 4;
+
+/**
+ * @brief Features of the last complete window
+ */
+struct ActivityFeatures {
+    float stdDev;           // Of the acceleration magnitude (m/s²)
+    float dominantHz;       // Strongest frequency in the gait band
+    float periodicity;      // Share of the window's energy at dominantHz (0-1)
+    float tiltChangeDeg;    // Gravity direction change since the last window
+};
+
+// ============================================================================
+// ACTIVITY CALLBACK
+// ============================================================================
+typedef void (*ActivityCallback)(Activity from, Activity to);
+
+// ============================================================================
+// ACTIVITY CLASSIFIER CLASS
+// ============================================================================
+class ActivityClassifier {
+public:
+    static constexpr uint8_t SAMPLE_HZ = 12;
+    static constexpr uint8_t WINDOW_SAMPLES = 32;
+
+    ActivityClassifier();
+
+    /**
+     * @brief Feed one calibrated reading (every MotionSensor update)
+     * @param nowMs Reading time (SensorTrace::clock while replaying)
+     */
+    void addSample(float ax, float ay, float az, uint32_t nowMs);
+
+    /**
+     * @brief Set state change callback
+     */
+    void setCallback(ActivityCallback callback) { _callback = callback; }
+
+    /**
+     * @brief Get the confirmed activity (STATIONARY until the first windows)
+     */
+    Activity getActivity() const { return _activity; }
+
+    const ActivityFeatures& getFeatures() const { return _features; }
+
+#ifdef ARDUINO
+    /**
+     * @brief Share of the CPU spent in addSample() since reset()
+     * @return Percent
+     */
+    float getCpuPercent() const;
+
+    /**
+     * @brief Print activity, features and CPU share
+     */
+    void printStatus(Print& out) const;
+#endif
+
+    /**
+     * @brief Forget the window and return to STATIONARY (no callback)
+     */
+    void reset();
+
+    /**
+     * @brief Get activity name for logging
+     */
+    static const char* getActivityName(Activity activity);
+
+private:
+    static constexpr uint32_t SAMPLE_INTERVAL_MS = 1000 / SAMPLE_HZ;
+    static constexpr uint8_t FIRST_BIN = 2;         // ~0.75 Hz
+    static constexpr uint8_t LAST_BIN = 9;          // ~3.4 Hz
+    static constexpr uint8_t BIN_COUNT = LAST_BIN - FIRST_BIN + 1;
+    static constexpr uint8_t CONFIRM_WINDOWS = 2;
+
+    // Thresholds (m/s², degrees)
+    static constexpr float STILL_ENTER_STD = 0.10f;
+    static constexpr float STILL_STAY_STD = 0.20f;
+    static constexpr float STILL_MAX_TILT = 3.0f;
+    static constexpr float WALK_MIN_STD = 0.8f;
+    static constexpr float WALK_MIN_PERIODICITY = 0.35f;
+    static constexpr float WALK_MIN_HZ = 1.2f;
+    static constexpr float WALK_MAX_HZ = 2.8f;
+    static constexpr float HANDLED_MIN_TILT = 10.0f;
+
+    Activity _activity;
+    Activity _candidate;
+    uint8_t _candidateWindows;
+    ActivityCallback _callback;
+    ActivityFeatures _features;
+
+    // Decimation (box average between ticks)
+    uint32_t _lastTickMs;
+    bool _started;
+    float _sumX, _sumY, _sumZ;
+    uint16_t _sumCount;
+
+    // Current window
+    float _magnitude[WINDOW_SAMPLES];
+    float _gravitySum[3];
+    uint8_t _windowFill;
+
+    // Last window's mean gravity direction (unit vector)
+    float _lastGravity[3];
+    bool _hasLastGravity;
+
+    float _goertzelCoeff[BIN_COUNT];
+
+#ifdef ARDUINO
+    // CPU accounting
+    uint32_t _busyUs;
+    uint32_t _sinceMs;
+#endif
+
+    void addDecimated(float ax, float ay, float az);
+    void evaluateWindow();
+    Activity classify() const;
+};
+
+#endif // ACTIVITY_CLASSIFIER_H
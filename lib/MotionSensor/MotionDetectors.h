@@ -0,0 +1,73 @@
+/**
+ * @file MotionDetectors.h
+ * @brief Gesture detection on calibrated accelerometer readings
+ *
+ * The detection steps of MotionSensor::update(), without the MPU6050.
+ * No Arduino dependencies, so recorded sessions can be replayed through
+ * the same code on the host (tools/trace_replay.cpp).
+ */
+
+#ifndef MOTION_DETECTORS_H
+#define MOTION_DETECTORS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Shake: acceleration magnitude rising above a threshold
+ * Reported once per rise, and not again within COOLDOWN_MS.
+ */
+class ShakeDetector {
+public:
+    static constexpr uint32_t COOLDOWN_MS = 500;
+
+    ShakeDetector() : _threshold(20.0f) { reset(); }
+
+    /**
+     * @param threshold Magnitude in m/s² (default 20)
+     */
+    void setThreshold(float threshold) { _threshold = threshold; }
+    float getThreshold() const { return _threshold; }
+
+    /**
+     * @param magnitude Acceleration magnitude (m/s²)
+     * @param nowMs Reading time (SensorTrace::clock while replaying)
+     * @return true if this reading starts a shake
+     */
+    bool update(float magnitude, uint32_t nowMs) {
+        if (nowMs - _lastShakeMs < COOLDOWN_MS) return false;
+
+        if (magnitude > _threshold) {
+            if (!_shaking) {
+                _shaking = true;
+                _lastShakeMs = nowMs;
+                return true;
+            }
+        } else {
+            _shaking = false;
+        }
+        return false;
+    }
+
+    void reset() {
+        _lastShakeMs = 0;
+        _shaking = false;
+    }
+
+private:
+    float _threshold;
+    uint32_t _lastShakeMs;
+    bool _shaking;
+};
+
+/**
+ * @brief Any axis beyond SUDDEN_MOVEMENT_MS2 (not debounced, too noisy for callbacks)
+ */
+static constexpr float SUDDEN_MOVEMENT_MS2 = 12.0f;
+
+inline bool isSuddenMovement(float x, float y, float z) {
+    return x > SUDDEN_MOVEMENT_MS2 || x < -SUDDEN_MOVEMENT_MS2 ||
+           y > SUDDEN_MOVEMENT_MS2 || y < -SUDDEN_MOVEMENT_MS2 ||
+           z > SUDDEN_MOVEMENT_MS2 || z < -SUDDEN_MOVEMENT_MS2;
+}
+
+#endif // MOTION_DETECTORS_H
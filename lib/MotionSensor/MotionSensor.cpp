@@ -4,10 +4,14 @@
  */
 
 #include "MotionSensor.h"
+#include "SensorTrace.h"
+
+#ifdef SENSOR_BENCHMARK
+#include "ActivityBenchmark.h"
+#endif
 
 // Constants
 #define GRAVITY 9.81f           // Standard gravity (m/s²)
-#define SHAKE_COOLDOWN_MS 500   // Minimum time between shakes
 
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
@@ -20,12 +24,10 @@ MotionSensor::MotionSensor(uint8_t i2c_address)
       _lastAccelX(0), _lastAccelY(0), _lastAccelZ(0),
       _lastAccelMagnitude(0),
       _accelOffsetX(0), _accelOffsetY(0), _accelOffsetZ(0),
-      _shakeThreshold(20.0f),
       _tiltThreshold(30.0f),
       _lastEvent(MotionEvent::NONE),
-      _lastShakeTime(0),
-      _isShaking(false),
-      _callback(nullptr)
+      _callback(nullptr),
+      _trace(nullptr)
 {
 }
 
@@ -66,17 +68,13 @@ bool MotionSensor::init(TwoWire* wire) {
 // ============================================================================
 
 void MotionSensor::update() {
-    if (!_initialized || !_motionDetectionEnabled) return;
+    bool replaying = _trace != nullptr && _trace->isReplaying();
+    if ((!_initialized && !replaying) || !_motionDetectionEnabled) return;
     
     _lastEvent = MotionEvent::NONE;
+    uint32_t startUs = micros();
     
-    // Read sensor data
-    _mpu.getEvent(&_accel, &_gyro, &_temp);
-    
-    // Store previous values
-    _lastAccelX = _accel.acceleration.x - _accelOffsetX;
-    _lastAccelY = _accel.acceleration.y - _accelOffsetY;
-    _lastAccelZ = _accel.acceleration.z - _accelOffsetZ;
+    if (!readSample()) return;
     
     // Calculate magnitude
     _lastAccelMagnitude = sqrt(
@@ -90,6 +88,53 @@ void MotionSensor::update() {
         detectShake();
         detectSuddenMovement();
     }
+
+    _activity.addSample(_lastAccelX, _lastAccelY, _lastAccelZ, SensorTrace::clock(_trace));
+
+    if (replaying) {
+        _trace->noteProcessed(TraceChannel::IMU, micros() - startUs);
+    }
+}
+
+static int16_t toFixed(float value, float scale) {
+    float scaled = value * scale;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)lroundf(scaled);
+}
+
+// Calibrated reading from the MPU6050, or the next one from a replayed trace
+bool MotionSensor::readSample() {
+    if (_trace != nullptr && _trace->isReplaying()) {
+        ImuSample sample;
+        if (!_trace->takeImu(sample)) return false;
+
+        _lastAccelX = sample.accel[0] / TRACE_ACCEL_SCALE;
+        _lastAccelY = sample.accel[1] / TRACE_ACCEL_SCALE;
+        _lastAccelZ = sample.accel[2] / TRACE_ACCEL_SCALE;
+        _gyro.gyro.x = sample.gyro[0] / TRACE_GYRO_SCALE;
+        _gyro.gyro.y = sample.gyro[1] / TRACE_GYRO_SCALE;
+        _gyro.gyro.z = sample.gyro[2] / TRACE_GYRO_SCALE;
+        return true;
+    }
+
+    _mpu.getEvent(&_accel, &_gyro, &_temp);
+    
+    // Store previous values
+    _lastAccelX = _accel.acceleration.x - _accelOffsetX;
+    _lastAccelY = _accel.acceleration.y - _accelOffsetY;
+    _lastAccelZ = _accel.acceleration.z - _accelOffsetZ;
+
+    if (_trace != nullptr && _trace->isRecording()) {
+        ImuSample sample = {
+            {toFixed(_lastAccelX, TRACE_ACCEL_SCALE), toFixed(_lastAccelY, TRACE_ACCEL_SCALE),
+             toFixed(_lastAccelZ, TRACE_ACCEL_SCALE)},
+            {toFixed(_gyro.gyro.x, TRACE_GYRO_SCALE), toFixed(_gyro.gyro.y, TRACE_GYRO_SCALE),
+             toFixed(_gyro.gyro.z, TRACE_GYRO_SCALE)}
+        };
+        _trace->recordImu(sample);
+    }
+    return true;
 }
 
 // ============================================================================
@@ -97,34 +142,14 @@ void MotionSensor::update() {
 // ============================================================================
 
 void MotionSensor::detectShake() {
-    unsigned long currentTime = millis();
-    
-    // Cooldown period to avoid multiple shake detections
-    if ((currentTime - _lastShakeTime) < SHAKE_COOLDOWN_MS) {
-        return;
-    }
-    
-    // Check for rapid back-and-forth movement
-    if (_lastAccelMagnitude > _shakeThreshold) {
-        if (!_isShaking) {
-            _isShaking = true;
-            _lastShakeTime = currentTime;
-            _lastEvent = MotionEvent::SHAKE;
-            triggerCallback(MotionEvent::SHAKE);
-            // Serial.println("[MOTION] Shake detected!");
-        }
-    } else {
-        _isShaking = false;
+    if (_shake.update(_lastAccelMagnitude, SensorTrace::clock(_trace))) {
+        _lastEvent = MotionEvent::SHAKE;
+        triggerCallback(MotionEvent::SHAKE);
     }
 }
 
 void MotionSensor::detectSuddenMovement() {
-    // Check for rapid change in any axis
-    float deltaX = abs(_lastAccelX);
-    float deltaY = abs(_lastAccelY);
-    float deltaZ = abs(_lastAccelZ);
-    
-    if (deltaX > 12.0f || deltaY > 12.0f || deltaZ > 12.0f) {
+    if (isSuddenMovement(_lastAccelX, _lastAccelY, _lastAccelZ)) {
         _lastEvent = MotionEvent::SUDDEN_MOVEMENT;
         // Don't trigger callback for every sudden movement (too noisy)
     }
@@ -200,7 +225,7 @@ MotionEvent MotionSensor::getEvent() {
 // ============================================================================
 
 void MotionSensor::setShakeThreshold(float threshold) {
-    _shakeThreshold = threshold;
+    _shake.setThreshold(threshold);
 }
 
 void MotionSensor::setTiltThreshold(float degrees) {
@@ -251,12 +276,33 @@ bool MotionSensor::isStationary() const {
 
 void MotionSensor::reset() {
     _lastEvent = MotionEvent::NONE;
-    _isShaking = false;
-    _lastShakeTime = 0;
+    _shake.reset();
+    _activity.reset();
 }
 
 void MotionSensor::triggerCallback(MotionEvent event) {
+    if (_trace != nullptr && _trace->isReplaying()) {
+        _trace->noteDetection(TraceChannel::IMU);
+    }
     if (_callback != nullptr) {
         _callback(event);
     }
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+#ifdef SENSOR_BENCHMARK
+
+void MotionSensor::runActivityBenchmark() {
+    Serial.printf("[MOTION] Activity benchmark (ns per reading, one every %lu ms)\n",
+                  (unsigned long)activity_bench::READING_MS);
+    activity_bench::run([]() { return (uint32_t)micros(); },
+                        [](const char* name, uint32_t ns) {
+                            Serial.printf("[MOTION]   %-18s %6lu  (%.3f%% CPU)\n", name,
+                                          (unsigned long)ns, activity_bench::cpuPercent(ns));
+                        });
+}
+
+#endif // SENSOR_BENCHMARK
@@ -10,6 +10,7 @@
  * - Tilt/orientation detection
  * - Configurable sensitivity
  * - Event-driven callbacks
+ * - Activity classification (stationary, handled, walking, transported)
  */
 
 #ifndef MOTION_SENSOR_H
@@ -19,6 +20,10 @@
 #include <Wire.h>
 #include <Adafruit_MPU6050.h>
 #include <Adafruit_Sensor.h>
+#include "ActivityClassifier.h"
+#include "MotionDetectors.h"
+
+class SensorTrace;
 
 // ============================================================================
 // MOTION EVENT TYPES (Updated - No Tap Events)
@@ -93,6 +98,24 @@ public:
      * @param callback Function to call when event occurs
      */
     void setCallback(MotionCallback callback);
+
+    /**
+     * @brief Register callback for activity changes (ActivityClassifier)
+     */
+    void setActivityCallback(ActivityCallback callback) { _activity.setCallback(callback); }
+
+    /**
+     * @brief Get the current activity
+     */
+    Activity getActivity() const { return _activity.getActivity(); }
+
+    const ActivityClassifier& getActivityClassifier() const { return _activity; }
+
+    /**
+     * @brief Record readings into a trace, or read them from one while it replays
+     * @param trace nullptr to detach
+     */
+    void setTrace(SensorTrace* trace) { _trace = trace; }
     
     // ========================================================================
     // RAW SENSOR DATA ACCESS
@@ -175,6 +198,18 @@ public:
      */
     void reset();
 
+#ifdef SENSOR_BENCHMARK
+    // ========================================================================
+    // BENCHMARK (build with -DSENSOR_BENCHMARK)
+    // ========================================================================
+
+    /**
+     * @brief Time the activity classifier (ActivityBenchmark.h)
+     * Prints nanoseconds per reading and the CPU share over Serial.
+     */
+    static void runActivityBenchmark();
+#endif
+
 private:
     Adafruit_MPU6050 _mpu;
     
@@ -196,18 +231,23 @@ private:
     float _accelOffsetX, _accelOffsetY, _accelOffsetZ;
     
     // Thresholds
-    float _shakeThreshold;
     float _tiltThreshold;
     
     // Event detection state
     MotionEvent _lastEvent;
-    unsigned long _lastShakeTime;
-    bool _isShaking;
+    ShakeDetector _shake;
     
     // Callback
     MotionCallback _callback;
+
+    // Activity classification
+    ActivityClassifier _activity;
+
+    // Recording / replay
+    SensorTrace* _trace;
     
     // Private methods
+    bool readSample();
     void detectShake();
     void detectSuddenMovement();
     Orientation calculateOrientation();
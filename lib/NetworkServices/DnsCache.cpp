@@ -0,0 +1,354 @@
+#include "DnsCache.h"
+#include <WiFi.h>
+#include <lwip/sockets.h>
+#include <esp_netif.h>
+
+// DNS wire format
+#define DNS_PORT 53
+#define DNS_HEADER_SIZE 12
+#define DNS_TYPE_A 1
+#define DNS_TYPE_CNAME 5
+#define DNS_CLASS_IN 1
+#define DNS_MAX_MESSAGE 512
+#define DNS_MAX_NAME 255
+
+static uint16_t readU16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static uint32_t readU32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+// Advance past a (possibly compressed) name
+static bool skipName(const uint8_t* msg, size_t len, size_t& pos) {
+    while (pos < len) {
+        uint8_t label = msg[pos];
+        if ((label & 0xC0) == 0xC0) {
+            pos += 2;
+            return pos <= len;
+        }
+        pos++;
+        if (label == 0) {
+            return true;
+        }
+        pos += label;
+    }
+    return false;
+}
+
+DnsCache::DnsCache() : nextQueryId_(0) {
+    memset(entries_, 0, sizeof(entries_));
+    portMUX_INITIALIZE(&lock_);
+}
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+void DnsCache::setUpstream(const IPAddress& primary, const IPAddress& secondary) {
+    upstream_[0] = primary;
+    upstream_[1] = secondary;
+}
+
+void DnsCache::setUpstream(const char* primary, const char* secondary) {
+    IPAddress first;
+    IPAddress second;
+    if (primary != nullptr && primary[0] != '\0') first.fromString(primary);
+    if (secondary != nullptr && secondary[0] != '\0') second.fromString(secondary);
+    setUpstream(first, second);
+}
+
+void DnsCache::applyUpstream() {
+    esp_netif_t* netif = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+    if (netif == nullptr) {
+        return;
+    }
+
+    esp_netif_dns_type_t types[2] = {ESP_NETIF_DNS_MAIN, ESP_NETIF_DNS_BACKUP};
+    for (uint8_t i = 0; i < 2; ++i) {
+        if ((uint32_t)upstream_[i] == 0) continue;
+
+        esp_netif_dns_info_t dns;
+        memset(&dns, 0, sizeof(dns));
+        dns.ip.type = ESP_IPADDR_TYPE_V4;
+        dns.ip.u_addr.ip4.addr = (uint32_t)upstream_[i];
+        esp_netif_set_dns_info(netif, types[i], &dns);
+    }
+
+    Serial.printf("[DNS] Upstream %s, %s\n",
+                  upstream_[0].toString().c_str(), upstream_[1].toString().c_str());
+}
+
+// ============================================================================
+// RESOLVE
+// ============================================================================
+
+bool DnsCache::resolve(const char* host, IPAddress& ip, uint32_t* lookupMs) {
+    uint32_t start = millis();
+    uint32_t addr = 0;
+
+    // Literal IP: nothing to resolve
+    if (ip.fromString(host)) {
+        if (lookupMs) *lookupMs = 0;
+        return true;
+    }
+
+    if (lookupCached(host, addr)) {
+        ip = IPAddress(addr);
+        if (lookupMs) *lookupMs = 0;
+        return true;
+    }
+
+    // Miss: ask the upstream resolvers directly so we learn the TTL
+    uint32_t ttl = 0;
+    bool found = false;
+    for (uint8_t i = 0; i < 2 && !found; ++i) {
+        IPAddress server = upstream_[i];
+        if ((uint32_t)server == 0) {
+            server = WiFi.dnsIP(i);  // DHCP-provided
+        }
+        if ((uint32_t)server != 0) {
+            found = queryUpstream(server, host, addr, ttl);
+        }
+    }
+
+    bool fallback = false;
+    if (!found) {
+        IPAddress resolved;
+        if (WiFi.hostByName(host, resolved) == 1 && (uint32_t)resolved != 0) {
+            addr = (uint32_t)resolved;
+            ttl = FALLBACK_TTL_SECS;
+            found = true;
+            fallback = true;
+        }
+    }
+
+    uint32_t elapsed = millis() - start;
+    if (lookupMs) *lookupMs = elapsed;
+
+    portENTER_CRITICAL(&lock_);
+    stats_.lastLookupMs = elapsed;
+    if (found) {
+        stats_.misses++;
+        stats_.totalLookupMs += elapsed;
+        if (fallback) stats_.fallbacks++;
+    } else {
+        stats_.failures++;
+    }
+    portEXIT_CRITICAL(&lock_);
+
+    if (!found) {
+        Serial.printf("[DNS] Failed to resolve %s\n", host);
+        return false;
+    }
+
+    store(host, addr, ttl);
+    ip = IPAddress(addr);
+    Serial.printf("[DNS] %s -> %s (ttl %lus, %lu ms%s)\n", host, ip.toString().c_str(),
+                  (unsigned long)ttl, (unsigned long)elapsed, fallback ? ", lwIP" : "");
+    return true;
+}
+
+bool DnsCache::lookupCached(const char* host, uint32_t& ip) {
+    uint32_t now = millis();
+    bool hit = false;
+
+    portENTER_CRITICAL(&lock_);
+    for (size_t i = 0; i < CACHE_SIZE; ++i) {
+        Entry& e = entries_[i];
+        if (!e.used || strcmp(e.host, host) != 0) continue;
+
+        if ((int32_t)(e.expiresAtMs - now) > 0) {
+            e.lastUsedMs = now;
+            ip = e.ip;
+            hit = true;
+            stats_.hits++;
+        } else {
+            e.used = false;  // Expired
+        }
+        break;
+    }
+    portEXIT_CRITICAL(&lock_);
+
+    return hit;
+}
+
+void DnsCache::store(const char* host, uint32_t ip, uint32_t ttlSecs) {
+    if (ttlSecs < MIN_TTL_SECS) ttlSecs = MIN_TTL_SECS;
+    if (ttlSecs > MAX_TTL_SECS) ttlSecs = MAX_TTL_SECS;
+    if (strlen(host) >= sizeof(entries_[0].host)) return;  // Too long to cache
+
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&lock_);
+    // Same host, free slot, or least recently used
+    size_t slot = 0;
+    for (size_t i = 0; i < CACHE_SIZE; ++i) {
+        const Entry& e = entries_[i];
+        if (e.used && strcmp(e.host, host) == 0) { slot = i; break; }
+        if (!e.used) { slot = i; continue; }
+        if (entries_[slot].used && e.lastUsedMs < entries_[slot].lastUsedMs) slot = i;
+    }
+
+    Entry& e = entries_[slot];
+    strcpy(e.host, host);
+    e.ip = ip;
+    e.expiresAtMs = now + ttlSecs * 1000UL;
+    e.lastUsedMs = now;
+    e.used = true;
+    portEXIT_CRITICAL(&lock_);
+}
+
+void DnsCache::clear() {
+    portENTER_CRITICAL(&lock_);
+    for (size_t i = 0; i < CACHE_SIZE; ++i) {
+        entries_[i].used = false;
+    }
+    portEXIT_CRITICAL(&lock_);
+}
+
+// ============================================================================
+// UPSTREAM QUERY
+// ============================================================================
+
+bool DnsCache::queryUpstream(const IPAddress& server, const char* host, uint32_t& ip, uint32_t& ttlSecs) {
+    uint8_t query[DNS_HEADER_SIZE + DNS_MAX_NAME + 4];
+    uint8_t msg[DNS_MAX_MESSAGE];
+
+    portENTER_CRITICAL(&lock_);
+    uint16_t id = ++nextQueryId_ ^ (uint16_t)esp_random();
+    portEXIT_CRITICAL(&lock_);
+
+    // Header: id, recursion desired, one question
+    memset(query, 0, DNS_HEADER_SIZE);
+    query[0] = id >> 8;
+    query[1] = id & 0xFF;
+    query[2] = 0x01;
+    query[5] = 1;
+
+    // Question: labels, type A, class IN
+    size_t pos = DNS_HEADER_SIZE;
+    const char* label = host;
+    while (*label) {
+        const char* dot = strchr(label, '.');
+        size_t len = dot ? (size_t)(dot - label) : strlen(label);
+        if (len == 0 || len > 63 || pos + len + 6 > sizeof(query)) return false;
+        query[pos++] = (uint8_t)len;
+        memcpy(&query[pos], label, len);
+        pos += len;
+        label += len;
+        if (*label == '.') label++;
+    }
+    query[pos++] = 0;
+    query[pos++] = 0; query[pos++] = DNS_TYPE_A;
+    query[pos++] = 0; query[pos++] = DNS_CLASS_IN;
+    size_t queryLen = pos;
+
+    int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) return false;
+
+    struct timeval tv;
+    tv.tv_sec = QUERY_TIMEOUT_MS / 1000;
+    tv.tv_usec = (QUERY_TIMEOUT_MS % 1000) * 1000;
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(DNS_PORT);
+    addr.sin_addr.s_addr = (uint32_t)server;
+
+    int received = -1;
+    if (sendto(sock, query, queryLen, 0, (struct sockaddr*)&addr, sizeof(addr)) == (int)queryLen) {
+        received = recvfrom(sock, msg, sizeof(msg), 0, nullptr, nullptr);
+    }
+    close(sock);
+
+    size_t len = received > 0 ? (size_t)received : 0;
+    if (len < DNS_HEADER_SIZE || readU16(msg) != id || !(msg[2] & 0x80) || (msg[3] & 0x0F) != 0) {
+        return false;
+    }
+
+    // The reply must echo our question (name, type and class), or it
+    // answers something else and must not be cached under this host
+    uint16_t answers = readU16(&msg[6]);
+    if (readU16(&msg[4]) != 1 || len < queryLen) {
+        return false;
+    }
+    for (pos = DNS_HEADER_SIZE; pos < queryLen; ++pos) {
+        if (tolower(msg[pos]) != tolower(query[pos])) return false;
+    }
+
+    // First A record wins; TTL is the minimum along the CNAME chain
+    uint32_t minTtl = UINT32_MAX;
+    for (uint16_t i = 0; i < answers; ++i) {
+        if (!skipName(msg, len, pos) || pos + 10 > len) return false;
+        uint16_t type = readU16(&msg[pos]);
+        uint32_t ttl = readU32(&msg[pos + 4]);
+        uint16_t rdLength = readU16(&msg[pos + 8]);
+        pos += 10;
+        if (pos + rdLength > len) return false;
+
+        if (type == DNS_TYPE_CNAME || type == DNS_TYPE_A) {
+            if (ttl < minTtl) minTtl = ttl;
+        }
+        if (type == DNS_TYPE_A && rdLength == 4) {
+            memcpy(&ip, &msg[pos], 4);  // Already network byte order
+            ttlSecs = minTtl;
+            return true;
+        }
+        pos += rdLength;
+    }
+    return false;
+}
+
+// ============================================================================
+// STATISTICS
+// ============================================================================
+
+DnsCacheStats DnsCache::getStats() const {
+    portENTER_CRITICAL(const_cast<portMUX_TYPE*>(&lock_));
+    DnsCacheStats copy = stats_;
+    portEXIT_CRITICAL(const_cast<portMUX_TYPE*>(&lock_));
+    return copy;
+}
+
+void DnsCache::printStats() const {
+    DnsCacheStats s = getStats();
+    uint32_t avg = s.misses > 0 ? s.totalLookupMs / s.misses : 0;
+    Serial.printf("[DNS] Cache hits %lu, misses %lu (avg %lu ms), fallbacks %lu, failures %lu\n",
+                  (unsigned long)s.hits, (unsigned long)s.misses, (unsigned long)avg,
+                  (unsigned long)s.fallbacks, (unsigned long)s.failures);
+}
+
+// ============================================================================
+// CACHED DNS CLIENT
+// ============================================================================
+
+int CachedDnsClient::connect(const char* host, uint16_t port) {
+    if (cache_ == nullptr) {
+        return WiFiClientSecure::connect(host, port);
+    }
+
+    IPAddress ip;
+    if (!cache_->resolve(host, ip, &lookupMs_)) {
+        return 0;
+    }
+    // IP + hostname: skips the resolver, keeps SNI
+    return WiFiClientSecure::connect(ip, port, host, nullptr, nullptr, nullptr);
+}
+
+int CachedDnsClient::connect(const char* host, uint16_t port, int32_t timeout) {
+    if (cache_ == nullptr) {
+        return WiFiClientSecure::connect(host, port, timeout);
+    }
+
+    IPAddress ip;
+    if (!cache_->resolve(host, ip, &lookupMs_)) {
+        return 0;
+    }
+    // The IP + hostname overload has no timeout argument; it uses _timeout
+    _timeout = timeout;
+    return WiFiClientSecure::connect(ip, port, host, nullptr, nullptr, nullptr);
+}
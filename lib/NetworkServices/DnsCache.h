@@ -0,0 +1,89 @@
+#ifndef DNS_CACHE_H
+#define DNS_CACHE_H
+
+#include <Arduino.h>
+#include <WiFiClientSecure.h>
+#include <freertos/FreeRTOS.h>
+
+// DNS cache statistics
+struct DnsCacheStats {
+    uint32_t hits = 0;
+    uint32_t misses = 0;            // Answered by an upstream query
+    uint32_t failures = 0;          // Could not resolve at all
+    uint32_t fallbacks = 0;         // Upstream query failed, lwIP resolver used
+    uint32_t lastLookupMs = 0;
+    uint32_t totalLookupMs = 0;     // Sum over misses (hits cost ~0 ms)
+};
+
+// Small TTL-respecting DNS cache in front of lwIP lookups
+//
+// Misses are resolved with a direct A-record query to the configured
+// upstream resolvers so the record TTL is known; if that fails the lwIP
+// resolver is used with a short fixed TTL. Safe to use from several tasks.
+class DnsCache {
+public:
+    DnsCache();
+
+    // Upstream resolvers (unset = use the DHCP-provided servers)
+    void setUpstream(const IPAddress& primary, const IPAddress& secondary);
+    void setUpstream(const char* primary, const char* secondary);
+
+    // Call once when the station connects: hands the upstream resolvers to
+    // lwIP as well, without reconfiguring the interface (DHCP IP stays)
+    void applyUpstream();
+
+    // Resolve a hostname, from cache if possible
+    // lookupMs (optional) receives the time spent resolving
+    bool resolve(const char* host, IPAddress& ip, uint32_t* lookupMs = nullptr);
+
+    // Drop all entries (e.g. after a network change)
+    void clear();
+
+    DnsCacheStats getStats() const;
+    void printStats() const;
+
+private:
+    struct Entry {
+        char host[48];
+        uint32_t ip;
+        uint32_t expiresAtMs;
+        uint32_t lastUsedMs;
+        bool used;
+    };
+
+    static constexpr size_t CACHE_SIZE = 6;
+    static constexpr uint32_t MIN_TTL_SECS = 30;
+    static constexpr uint32_t MAX_TTL_SECS = 3600;
+    static constexpr uint32_t FALLBACK_TTL_SECS = 60;
+    static constexpr uint32_t QUERY_TIMEOUT_MS = 1500;
+
+    Entry entries_[CACHE_SIZE];
+    IPAddress upstream_[2];
+    DnsCacheStats stats_;
+    uint16_t nextQueryId_;
+    portMUX_TYPE lock_;
+
+    bool lookupCached(const char* host, uint32_t& ip);
+    void store(const char* host, uint32_t ip, uint32_t ttlSecs);
+    bool queryUpstream(const IPAddress& server, const char* host, uint32_t& ip, uint32_t& ttlSecs);
+};
+
+// TLS client that resolves hostnames through a DnsCache
+// Drop-in for WiFiClientSecure with HTTPClient; SNI still uses the hostname
+class CachedDnsClient : public WiFiClientSecure {
+public:
+    explicit CachedDnsClient(DnsCache* cache) : cache_(cache), lookupMs_(0) {}
+
+    int connect(const char* host, uint16_t port);
+    int connect(const char* host, uint16_t port, int32_t timeout);
+    using WiFiClientSecure::connect;
+
+    // Time spent resolving for the last connect()
+    uint32_t getLookupMs() const { return lookupMs_; }
+
+private:
+    DnsCache* cache_;
+    uint32_t lookupMs_;
+};
+
+#endif // DNS_CACHE_H
@@ -0,0 +1,292 @@
+#include "InflateStream.h"
+#include "rom/miniz.h"
+
+// gzip header (RFC 1952)
+#define GZIP_ID1 0x1F
+#define GZIP_ID2 0x8B
+#define GZIP_CM_DEFLATE 8
+#define GZIP_FHCRC 0x02
+#define GZIP_FEXTRA 0x04
+#define GZIP_FNAME 0x08
+#define GZIP_FCOMMENT 0x10
+
+static_assert(InflateStream::WINDOW_SIZE == TINFL_LZ_DICT_SIZE, "Window must match tinfl dictionary size");
+
+InflateStream::InflateStream()
+    : source_(nullptr),
+      decomp_(nullptr),
+      window_(nullptr),
+      input_(nullptr),
+      inPos_(0),
+      inLen_(0),
+      outPos_(0),
+      outEnd_(0),
+      windowOfs_(0),
+      contentLength_(-1),
+      wireBytes_(0),
+      decodedBytes_(0),
+      timeoutMs_(0),
+      gzip_(false),
+      headerDone_(false),
+      finished_(false),
+      error_(false) {
+}
+
+InflateStream::~InflateStream() {
+    end();
+}
+
+bool InflateStream::reserve() {
+    if (decomp_ == nullptr) {
+        decomp_ = (tinfl_decompressor*)malloc(sizeof(tinfl_decompressor));
+    }
+    if (window_ == nullptr) {
+        window_ = (uint8_t*)malloc(WINDOW_SIZE);
+    }
+    if (input_ == nullptr) {
+        input_ = (uint8_t*)malloc(INPUT_SIZE);
+    }
+
+    if (decomp_ == nullptr || window_ == nullptr || input_ == nullptr) {
+        end();
+        return false;
+    }
+    return true;
+}
+
+void InflateStream::begin(Client& source, bool gzip, int contentLength, uint32_t timeoutMs) {
+    source_ = &source;
+    contentLength_ = contentLength;
+    timeoutMs_ = timeoutMs;
+    inPos_ = inLen_ = 0;
+    outPos_ = outEnd_ = 0;
+    windowOfs_ = 0;
+    wireBytes_ = 0;
+    decodedBytes_ = 0;
+    finished_ = false;
+    error_ = false;
+    headerDone_ = false;
+
+    // gzip needs the buffers; identity only needs the input buffer
+    gzip_ = gzip && decomp_ != nullptr && window_ != nullptr;
+    if (gzip && !gzip_) {
+        error_ = true;  // Asked for gzip without reserve()
+    }
+    if (input_ == nullptr) {
+        input_ = (uint8_t*)malloc(INPUT_SIZE);
+        error_ = error_ || input_ == nullptr;
+    }
+
+    if (gzip_) {
+        tinfl_init(decomp_);
+    }
+}
+
+void InflateStream::end() {
+    free(decomp_);
+    free(window_);
+    free(input_);
+    decomp_ = nullptr;
+    window_ = nullptr;
+    input_ = nullptr;
+    source_ = nullptr;
+}
+
+// ============================================================================
+// STREAM INTERFACE
+// ============================================================================
+
+int InflateStream::available() {
+    if (outPos_ < outEnd_) {
+        return (int)(outEnd_ - outPos_);
+    }
+    if (!gzip_) {
+        return inPos_ < inLen_ ? (int)(inLen_ - inPos_) : (source_ ? source_->available() : 0);
+    }
+    return 0;
+}
+
+int InflateStream::peek() {
+    if (error_) return -1;
+
+    if (!gzip_) {
+        if (inPos_ >= inLen_ && !fillInput()) return -1;
+        return input_[inPos_];
+    }
+
+    if (outPos_ >= outEnd_ && !inflateMore()) return -1;
+    return window_[outPos_];
+}
+
+int InflateStream::read() {
+    int c = peek();
+    if (c < 0) return -1;
+
+    if (gzip_) {
+        outPos_++;
+    } else {
+        inPos_++;
+    }
+    decodedBytes_++;
+    return c;
+}
+
+size_t InflateStream::readBytes(char* buffer, size_t length) {
+    size_t copied = 0;
+    while (copied < length) {
+        const uint8_t* src;
+        size_t avail;
+        if (gzip_) {
+            if (outPos_ >= outEnd_ && (error_ || !inflateMore())) break;
+            src = window_ + outPos_;
+            avail = outEnd_ - outPos_;
+        } else {
+            if (inPos_ >= inLen_ && (error_ || !fillInput())) break;
+            src = input_ + inPos_;
+            avail = inLen_ - inPos_;
+        }
+
+        size_t take = length - copied;
+        if (take > avail) take = avail;
+        memcpy(buffer + copied, src, take);
+        copied += take;
+
+        if (gzip_) {
+            outPos_ += take;
+        } else {
+            inPos_ += take;
+        }
+    }
+    decodedBytes_ += copied;
+    return copied;
+}
+
+// ============================================================================
+// INPUT
+// ============================================================================
+
+bool InflateStream::fillInput() {
+    if (source_ == nullptr || input_ == nullptr) return false;
+
+    // End of body: Content-Length reached, or connection closed (HTTP/1.0)
+    size_t remaining = INPUT_SIZE;
+    if (contentLength_ >= 0) {
+        if (wireBytes_ >= (size_t)contentLength_) return false;
+        remaining = (size_t)contentLength_ - wireBytes_;
+    }
+
+    uint32_t start = millis();
+    int avail = source_->available();
+    while (avail <= 0) {
+        if (!source_->connected() || millis() - start >= timeoutMs_) return false;
+        delay(1);
+        avail = source_->available();
+    }
+
+    size_t want = remaining < INPUT_SIZE ? remaining : (size_t)INPUT_SIZE;
+    if ((size_t)avail < want) want = (size_t)avail;
+    size_t got = source_->readBytes((char*)input_, want);
+    inPos_ = 0;
+    inLen_ = got;
+    wireBytes_ += got;
+    return got > 0;
+}
+
+int InflateStream::nextInputByte() {
+    if (inPos_ >= inLen_ && !fillInput()) return -1;
+    return input_[inPos_++];
+}
+
+bool InflateStream::skipGzipHeader() {
+    uint8_t header[10];
+    for (size_t i = 0; i < sizeof(header); ++i) {
+        int c = nextInputByte();
+        if (c < 0) return false;
+        header[i] = (uint8_t)c;
+    }
+
+    if (header[0] != GZIP_ID1 || header[1] != GZIP_ID2 || header[2] != GZIP_CM_DEFLATE) {
+        return false;
+    }
+    uint8_t flags = header[3];
+
+    if (flags & GZIP_FEXTRA) {
+        int lo = nextInputByte();
+        int hi = nextInputByte();
+        if (lo < 0 || hi < 0) return false;
+        for (uint16_t n = (uint16_t)(lo | (hi << 8)); n > 0; --n) {
+            if (nextInputByte() < 0) return false;
+        }
+    }
+    if (flags & GZIP_FNAME) {
+        int c;
+        while ((c = nextInputByte()) > 0) {}
+        if (c < 0) return false;
+    }
+    if (flags & GZIP_FCOMMENT) {
+        int c;
+        while ((c = nextInputByte()) > 0) {}
+        if (c < 0) return false;
+    }
+    if (flags & GZIP_FHCRC) {
+        if (nextInputByte() < 0 || nextInputByte() < 0) return false;
+    }
+    return true;
+}
+
+// ============================================================================
+// INFLATE
+// ============================================================================
+
+bool InflateStream::inflateMore() {
+    if (finished_ || error_) return false;
+
+    if (!headerDone_) {
+        if (!skipGzipHeader()) {
+            Serial.println("[Inflate] Bad gzip header");
+            error_ = true;
+            return false;
+        }
+        headerDone_ = true;
+    }
+
+    // Loop until some output is produced, the stream ends, or input runs dry
+    while (true) {
+        if (inPos_ >= inLen_) {
+            fillInput();  // May leave inLen_ at 0 near the end of the body
+        }
+
+        size_t inBytes = inLen_ - inPos_;
+        size_t outBytes = WINDOW_SIZE - windowOfs_;
+        bool moreInput = inBytes > 0;
+
+        tinfl_status status = tinfl_decompress(
+            decomp_,
+            input_ + inPos_, &inBytes,
+            window_, window_ + windowOfs_, &outBytes,
+            moreInput ? TINFL_FLAG_HAS_MORE_INPUT : 0);
+
+        inPos_ += inBytes;
+        outPos_ = windowOfs_;
+        outEnd_ = windowOfs_ + outBytes;
+        windowOfs_ = (windowOfs_ + outBytes) & (WINDOW_SIZE - 1);
+
+        if (status < TINFL_STATUS_DONE) {
+            Serial.printf("[Inflate] Decode error %d\n", (int)status);
+            error_ = true;
+            return outBytes > 0;
+        }
+        if (status == TINFL_STATUS_DONE) {
+            finished_ = true;  // CRC32/ISIZE trailer left unread
+            return outBytes > 0;
+        }
+        if (outBytes > 0) {
+            return true;
+        }
+        if (status == TINFL_STATUS_NEEDS_MORE_INPUT && !moreInput) {
+            Serial.println("[Inflate] Body ended early");
+            error_ = true;
+            return false;
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef INFLATE_STREAM_H
+#define INFLATE_STREAM_H
+
+#include <Arduino.h>
+#include <Client.h>
+
+struct tinfl_decompressor_tag;
+
+// Read-only Stream that decodes an HTTP body on the fly
+//
+// gzip bodies are inflated with the ROM tinfl decoder into a circular
+// 32 KB window (the largest back-reference deflate allows), so consumers
+// such as deserializeJson() can read it chunk by chunk without holding
+// the whole payload. Identity bodies are passed through unchanged. Both
+// modes count the bytes that came off the wire.
+//
+// Fixed memory while active: 32 KB window + ~11 KB decoder state +
+// 512 B input buffer, allocated by begin() and released by end().
+class InflateStream : public Stream {
+public:
+    InflateStream();
+    ~InflateStream();
+
+    // Reserve the window and decoder state (call before advertising gzip)
+    bool reserve();
+
+    // Start decoding from source; gzip=false passes the body through
+    // contentLength: body size on the wire, or -1 to read until close
+    void begin(Client& source, bool gzip, int contentLength, uint32_t timeoutMs);
+
+    // Release buffers
+    void end();
+
+    // Stream interface
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t) override { return 0; }
+
+    // Bulk read straight out of the window / input buffer
+    size_t readBytes(char* buffer, size_t length) override;
+    using Stream::readBytes;
+
+    // Statistics
+    size_t getWireBytes() const { return wireBytes_; }
+    size_t getDecodedBytes() const { return decodedBytes_; }
+    bool isGzip() const { return gzip_; }
+    bool hasError() const { return error_; }
+
+    static constexpr size_t WINDOW_SIZE = 32768;  // TINFL_LZ_DICT_SIZE
+    static constexpr size_t INPUT_SIZE = 512;
+
+private:
+    Client* source_;
+    tinfl_decompressor_tag* decomp_;
+    uint8_t* window_;
+    uint8_t* input_;
+
+    size_t inPos_;
+    size_t inLen_;
+    size_t outPos_;
+    size_t outEnd_;
+    size_t windowOfs_;
+
+    int contentLength_;
+    size_t wireBytes_;
+    size_t decodedBytes_;
+    uint32_t timeoutMs_;
+
+    bool gzip_;
+    bool headerDone_;
+    bool finished_;
+    bool error_;
+
+    int nextInputByte();
+    bool fillInput();
+    bool skipGzipHeader();
+    bool inflateMore();
+};
+
+#endif // INFLATE_STREAM_H
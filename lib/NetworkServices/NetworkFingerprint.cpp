@@ -0,0 +1,90 @@
+#include "NetworkFingerprint.h"
+#include <WiFi.h>
+#include <lwip/etharp.h>
+#include <lwip/priv/tcpip_priv.h>
+
+// ARP table lookup, executed on the lwIP thread via tcpip_api_call()
+struct GatewayArpLookup {
+    struct tcpip_api_call_data call;  // Must be first
+    ip4_addr_t gateway;
+    uint8_t mac[6];
+    bool found;
+};
+
+static err_t lookupGatewayMac(struct tcpip_api_call_data* data) {
+    GatewayArpLookup* lookup = reinterpret_cast<GatewayArpLookup*>(data);
+
+    for (size_t i = 0; i < ARP_TABLE_SIZE; ++i) {
+        ip4_addr_t* ip = nullptr;
+        struct netif* netif = nullptr;
+        struct eth_addr* eth = nullptr;
+
+        if (etharp_get_entry(i, &ip, &netif, &eth) && ip4_addr_cmp(ip, &lookup->gateway)) {
+            memcpy(lookup->mac, eth->addr, sizeof(lookup->mac));
+            lookup->found = true;
+            break;
+        }
+    }
+    return ERR_OK;
+}
+
+NetworkFingerprint NetworkFingerprint::capture() {
+    NetworkFingerprint fp;
+
+    if (WiFi.status() != WL_CONNECTED) {
+        return fp;
+    }
+
+    const uint8_t* bssid = WiFi.BSSID();
+    if (bssid != nullptr) {
+        memcpy(fp.bssid, bssid, sizeof(fp.bssid));
+    }
+    fp.gatewayIp = (uint32_t)WiFi.gatewayIP();
+    fp.subnetMask = (uint32_t)WiFi.subnetMask();
+
+    // Gateway MAC comes from the ARP cache - present once any traffic has
+    // gone through the router, which is always the case after DHCP + NTP
+    GatewayArpLookup lookup;
+    memset(&lookup, 0, sizeof(lookup));
+    ip4_addr_set_u32(&lookup.gateway, fp.gatewayIp);
+    tcpip_api_call(lookupGatewayMac, &lookup.call);
+
+    if (lookup.found) {
+        memcpy(fp.gatewayMac, lookup.mac, sizeof(fp.gatewayMac));
+        fp.gatewayMacKnown = true;
+    }
+
+    fp.valid = fp.gatewayIp != 0;
+    return fp;
+}
+
+bool NetworkFingerprint::sameNetwork(const NetworkFingerprint& other) const {
+    if (!valid || !other.valid) {
+        return false;
+    }
+
+    if (gatewayMacKnown && other.gatewayMacKnown) {
+        return gatewayIp == other.gatewayIp &&
+               memcmp(gatewayMac, other.gatewayMac, sizeof(gatewayMac)) == 0;
+    }
+
+    return gatewayIp == other.gatewayIp &&
+           subnetMask == other.subnetMask &&
+           memcmp(bssid, other.bssid, sizeof(bssid)) == 0;
+}
+
+uint32_t NetworkFingerprint::hash() const {
+    // FNV-1a over the identifying fields
+    uint32_t h = 2166136261UL;
+    auto mix = [&h](const uint8_t* data, size_t len) {
+        for (size_t i = 0; i < len; ++i) {
+            h = (h ^ data[i]) * 16777619UL;
+        }
+    };
+
+    mix(bssid, sizeof(bssid));
+    mix(gatewayMac, sizeof(gatewayMac));
+    mix(reinterpret_cast<const uint8_t*>(&gatewayIp), sizeof(gatewayIp));
+    mix(reinterpret_cast<const uint8_t*>(&subnetMask), sizeof(subnetMask));
+    return h;
+}
@@ -0,0 +1,32 @@
+#ifndef NETWORK_FINGERPRINT_H
+#define NETWORK_FINGERPRINT_H
+
+#include <Arduino.h>
+
+// Identity of the network the station is attached to, used to tell whether
+// the device may have moved since the last IP geolocation.
+//
+// Two fingerprints describe the same network when:
+// - both know the gateway MAC: gateway MAC and gateway IP match
+//   (survives roaming between mesh/extender access points), or
+// - otherwise: AP BSSID, gateway IP and subnet all match
+struct NetworkFingerprint {
+    uint8_t bssid[6] = {0};
+    uint8_t gatewayMac[6] = {0};
+    uint32_t gatewayIp = 0;
+    uint32_t subnetMask = 0;
+    bool gatewayMacKnown = false;
+    bool valid = false;
+
+    // Capture the fingerprint of the current station connection
+    // Returns an invalid fingerprint when not connected
+    static NetworkFingerprint capture();
+
+    // Compare against a previously stored fingerprint
+    bool sameNetwork(const NetworkFingerprint& other) const;
+
+    // Short hash for logging
+    uint32_t hash() const;
+};
+
+#endif // NETWORK_FINGERPRINT_H
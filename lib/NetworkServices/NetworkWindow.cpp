@@ -0,0 +1,258 @@
+#include "NetworkWindow.h"
+#include <WiFi.h>
+#include "WiFiManager.h"
+
+// Wrap-safe "a is at or after b" for millis() timestamps
+static inline bool reached(uint32_t nowMs, uint32_t atMs) {
+    return (int32_t)(nowMs - atMs) >= 0;
+}
+
+NetworkWindow::NetworkWindow(WiFiManager* wifi)
+    : wifi_(wifi),
+      jobCount_(0),
+      state_(State::IDLE),
+      selected_(0),
+      forced_(0),
+      current_(0),
+      jobStarted_(false),
+      stateStartMs_(0),
+      jobStartMs_(0),
+      windowStartMs_(0),
+      retryAfterMs_(0),
+      lastCheckMs_(0),
+      backingOff_(false),
+      radioControl_(false),
+      hold_(false),
+      radioOn_(false),
+      radioSampleMs_(0),
+      dayIndex_(0) {
+}
+
+int8_t NetworkWindow::addJob(const NetJob& job) {
+    if (jobCount_ >= MAX_JOBS || job.due == nullptr || job.start == nullptr || job.finished == nullptr) {
+        return -1;
+    }
+    jobs_[jobCount_] = job;
+    return (int8_t)jobCount_++;
+}
+
+void NetworkWindow::requestNow(int8_t job) {
+    if (job < 0 || job >= (int8_t)jobCount_) return;
+    forced_ |= (uint8_t)(1 << job);
+    backingOff_ = false;
+    lastCheckMs_ = millis() - CHECK_INTERVAL_MS;  // Evaluate on the next update()
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+void NetworkWindow::update() {
+    uint32_t nowMs = millis();
+    trackRadio(nowMs);
+
+    // Captive portal, WiFi disabled or not configured: not ours to manage
+    if (wifi_ == nullptr || wifi_->isAPActive() || !wifi_->hasCredentials() ||
+        !wifi_->getDeviceConfig().wifiEnabled) {
+        if (state_ != State::IDLE) {
+            state_ = State::IDLE;
+            selected_ = 0;
+        }
+        return;
+    }
+
+    switch (state_) {
+        case State::IDLE: {
+            if (nowMs - lastCheckMs_ < CHECK_INTERVAL_MS) return;
+            lastCheckMs_ = nowMs;
+
+            uint32_t nextDeadlineMs = 0;
+            uint8_t selected = selectJobs(nowMs, &nextDeadlineMs);
+            bool deadlineReached = selected != 0 && reached(nowMs, nextDeadlineMs);
+            bool radioUp = wifi_->isConnected();
+            if (backingOff_ && reached(nowMs, retryAfterMs_)) {
+                backingOff_ = false;
+            }
+
+            if ((forced_ & selected) != 0 ||
+                (selected != 0 && radioUp) ||  // Radio is on anyway - use it
+                (deadlineReached && !backingOff_)) {
+                openWindow(selected, nowMs);
+            } else if (radioUp && radioControl_ && !hold_) {
+                Serial.println("[NetWindow] Nothing due, radio off");
+                wifi_->radioOff();
+            }
+            break;
+        }
+
+        case State::CONNECTING:
+            if (wifi_->isConnected()) {
+                Serial.printf("[NetWindow] Connected after %lu ms\n",
+                              (unsigned long)(nowMs - stateStartMs_));
+                state_ = State::RUNNING;
+                stateStartMs_ = nowMs;
+                runJobs(nowMs);
+            } else if (nowMs - stateStartMs_ >= CONNECT_TIMEOUT_MS) {
+                Serial.println("[NetWindow] Connect timed out");
+                stats_.failedConnects++;
+                retryAfterMs_ = nowMs + CONNECT_RETRY_MS;
+                backingOff_ = true;
+                closeWindow(false);
+            }
+            break;
+
+        case State::RUNNING:
+            if (!wifi_->isConnected()) {
+                Serial.println("[NetWindow] Connection lost during window");
+                retryAfterMs_ = nowMs + CONNECT_RETRY_MS;
+                backingOff_ = true;
+                closeWindow(false);
+                break;
+            }
+            runJobs(nowMs);
+            break;
+    }
+}
+
+uint32_t NetworkWindow::getMsUntilNextWindow() const {
+    uint32_t nowMs = millis();
+    uint32_t nextDeadlineMs = nowMs + UINT32_MAX / 2;
+    if (forced_ != 0 || state_ != State::IDLE) return 0;
+    selectJobs(nowMs, &nextDeadlineMs);
+    return reached(nowMs, nextDeadlineMs) ? 0 : nextDeadlineMs - nowMs;
+}
+
+// ============================================================================
+// WINDOW
+// ============================================================================
+
+// Jobs whose flexibility range has started, plus the earliest deadline
+uint8_t NetworkWindow::selectJobs(uint32_t nowMs, uint32_t* nextDeadlineMs) const {
+    uint8_t selected = forced_;
+    bool haveDeadline = false;
+
+    for (uint8_t i = 0; i < jobCount_; i++) {
+        uint32_t deadlineMs = 0;
+        if (!jobs_[i].due(deadlineMs)) continue;
+
+        if (!haveDeadline || (int32_t)(deadlineMs - *nextDeadlineMs) < 0) {
+            *nextDeadlineMs = deadlineMs;
+            haveDeadline = true;  // Caller's value only replaced by a real deadline
+        }
+        if (reached(nowMs, deadlineMs - jobs_[i].flexMs)) {
+            selected |= (uint8_t)(1 << i);
+        }
+    }
+    return selected;
+}
+
+void NetworkWindow::openWindow(uint8_t selected, uint32_t nowMs) {
+    selected_ = selected;
+    current_ = 0;
+    jobStarted_ = false;
+    windowStartMs_ = nowMs;
+    stateStartMs_ = nowMs;
+    stats_.windows++;
+
+    Serial.print("[NetWindow] Opening window:");
+    for (uint8_t i = 0; i < jobCount_; i++) {
+        if (selected_ & (1 << i)) {
+            Serial.printf(" %s", jobs_[i].name);
+        }
+    }
+    Serial.println();
+
+    if (wifi_->isConnected()) {
+        state_ = State::RUNNING;
+        runJobs(nowMs);
+    } else {
+        state_ = State::CONNECTING;
+        wifi_->connect();
+    }
+}
+
+// Start selected jobs in order, one at a time
+void NetworkWindow::runJobs(uint32_t nowMs) {
+    while (current_ < jobCount_) {
+        const NetJob& job = jobs_[current_];
+
+        if (!(selected_ & (1 << current_))) {
+            current_++;
+            continue;
+        }
+
+        if (!jobStarted_) {
+            jobStarted_ = true;
+            jobStartMs_ = nowMs;
+            if (!job.start()) {
+                Serial.printf("[NetWindow] %s: nothing to do\n", job.name);
+                current_++;
+                jobStarted_ = false;
+                continue;
+            }
+            stats_.jobsRun++;
+            return;
+        }
+
+        if (job.finished()) {
+            Serial.printf("[NetWindow] %s done in %lu ms\n", job.name,
+                          (unsigned long)(nowMs - jobStartMs_));
+        } else if (nowMs - jobStartMs_ >= job.timeoutMs) {
+            Serial.printf("[NetWindow] %s timed out\n", job.name);
+            stats_.jobsTimedOut++;
+        } else {
+            return;  // Still running
+        }
+        current_++;
+        jobStarted_ = false;
+    }
+
+    closeWindow(true);
+}
+
+void NetworkWindow::closeWindow(bool completed) {
+    forced_ &= (uint8_t)~selected_;
+    selected_ = 0;
+    state_ = State::IDLE;
+    lastCheckMs_ = millis();
+    stats_.lastWindowMs = lastCheckMs_ - windowStartMs_;
+
+    if (radioControl_ && !hold_ && !wifi_->isAPActive()) {
+        wifi_->radioOff();
+    }
+
+    Serial.printf("[NetWindow] Window %s after %lu ms\n",
+                  completed ? "closed" : "aborted", (unsigned long)stats_.lastWindowMs);
+    printStats();
+}
+
+// ============================================================================
+// RADIO-ON ACCOUNTING
+// ============================================================================
+
+void NetworkWindow::trackRadio(uint32_t nowMs) {
+    if (radioOn_) {
+        stats_.radioOnMsToday += nowMs - radioSampleMs_;
+    }
+    radioSampleMs_ = nowMs;
+    radioOn_ = WiFi.getMode() != WIFI_OFF;
+
+    // 24 h buckets of uptime (wall clock may not be set)
+    uint32_t day = nowMs / DAY_MS;
+    if (day != dayIndex_) {
+        stats_.radioOnMsYesterday = (day == dayIndex_ + 1) ? stats_.radioOnMsToday : 0;
+        stats_.radioOnMsToday = 0;
+        dayIndex_ = day;
+    }
+}
+
+void NetworkWindow::printStats() const {
+    Serial.printf("[NetWindow] Radio on %lu s today, %lu s yesterday | windows: %lu, "
+                  "connect failures: %lu, jobs: %lu (%lu timed out)\n",
+                  (unsigned long)(stats_.radioOnMsToday / 1000),
+                  (unsigned long)(stats_.radioOnMsYesterday / 1000),
+                  (unsigned long)stats_.windows,
+                  (unsigned long)stats_.failedConnects,
+                  (unsigned long)stats_.jobsRun,
+                  (unsigned long)stats_.jobsTimedOut);
+}
@@ -0,0 +1,110 @@
+#ifndef NETWORK_WINDOW_H
+#define NETWORK_WINDOW_H
+
+#include <Arduino.h>
+
+class WiFiManager;
+
+// Network job declared to the coordinator
+// due():      false = nothing pending; otherwise deadlineMs (millis()) is
+//             the latest time the job should run
+// start():    begin the job; false = nothing to do after all
+// finished(): polled until the job is done
+struct NetJob {
+    const char* name;
+    uint32_t flexMs;                        // May run this long before its deadline
+    uint32_t timeoutMs;                     // Given up after this long in a window
+    bool (*due)(uint32_t& deadlineMs);
+    bool (*start)();
+    bool (*finished)();
+};
+
+// Network window statistics
+struct NetWindowStats {
+    uint32_t windows = 0;           // Radio-on sessions run
+    uint32_t failedConnects = 0;
+    uint32_t jobsRun = 0;
+    uint32_t jobsTimedOut = 0;
+    uint32_t radioOnMsToday = 0;    // Current 24 h uptime bucket
+    uint32_t radioOnMsYesterday = 0;
+    uint32_t lastWindowMs = 0;
+};
+
+// Batches network jobs into as few radio-on windows as possible
+//
+// A window opens when the earliest job deadline is reached; every job whose
+// flexibility range has started by then runs in the same window, in
+// registration order. Afterwards the radio is switched off again (if radio
+// control is enabled) until the next deadline.
+class NetworkWindow {
+public:
+    explicit NetworkWindow(WiFiManager* wifi);
+
+    // Register a job; returns its index or -1 when full
+    int8_t addJob(const NetJob& job);
+
+    // Run a job in a window opened right away, whatever its deadline
+    void requestNow(int8_t job);
+
+    // Switch the radio off between windows
+    void setRadioControl(bool enabled) { radioControl_ = enabled; }
+    bool hasRadioControl() const { return radioControl_; }
+
+    // Keep the radio on after a window (e.g. while a network screen is shown)
+    void setHold(bool hold) { hold_ = hold; }
+
+    // Call from main loop
+    void update();
+
+    bool isWindowOpen() const { return state_ != State::IDLE; }
+    uint32_t getMsUntilNextWindow() const;
+    uint32_t getRadioOnSecsToday() const { return stats_.radioOnMsToday / 1000; }
+    const NetWindowStats& getStats() const { return stats_; }
+    void printStats() const;
+
+    static constexpr uint8_t MAX_JOBS = 4;
+
+private:
+    enum class State : uint8_t {
+        IDLE,         // Waiting for the next deadline
+        CONNECTING,   // Radio coming up
+        RUNNING,      // Jobs running one after another
+    };
+
+    static constexpr uint32_t CONNECT_TIMEOUT_MS = 20000;
+    static constexpr uint32_t CONNECT_RETRY_MS = 60000;    // After a failed window
+    static constexpr uint32_t CHECK_INTERVAL_MS = 1000;
+    static constexpr uint32_t DAY_MS = 24UL * 60UL * 60UL * 1000UL;
+
+    WiFiManager* wifi_;
+    NetJob jobs_[MAX_JOBS];
+    uint8_t jobCount_;
+
+    State state_;
+    uint8_t selected_;        // Bitmask of jobs in the current window
+    uint8_t forced_;          // Bitmask of jobs requested now
+    uint8_t current_;
+    bool jobStarted_;
+    uint32_t stateStartMs_;
+    uint32_t jobStartMs_;
+    uint32_t windowStartMs_;
+    uint32_t retryAfterMs_;
+    uint32_t lastCheckMs_;
+    bool backingOff_;         // Last window failed; wait for retryAfterMs_
+
+    bool radioControl_;
+    bool hold_;
+    bool radioOn_;
+    uint32_t radioSampleMs_;
+    uint32_t dayIndex_;
+
+    NetWindowStats stats_;
+
+    uint8_t selectJobs(uint32_t nowMs, uint32_t* nextDeadlineMs) const;
+    void openWindow(uint8_t selected, uint32_t nowMs);
+    void runJobs(uint32_t nowMs);
+    void closeWindow(bool connected);
+    void trackRadio(uint32_t nowMs);
+};
+
+#endif // NETWORK_WINDOW_H
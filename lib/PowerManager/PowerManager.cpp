@@ -0,0 +1,197 @@
+/**
+ * @file PowerManager.cpp
+ * @brief Implementation of PowerManager
+ */
+
+#include "PowerManager.h"
+
+// ============================================================================
+// CONSTRUCTOR & INITIALIZATION
+// ============================================================================
+
+PowerManager::PowerManager(DisplayManager* display)
+    : _display(display),
+      _state(PowerState::ACTIVE),
+      _callback(nullptr),
+      _lastActivity(0),
+      _lastWake(0),
+      _stateEnteredAt(0),
+      _idleTimeoutMs(300000),   // 5 minutes
+      _sleepAnimMs(60000),      // 1 minute
+      _dimDurationMs(8000),     // 8 seconds
+      _activeBrightness(255),
+      _lastDimLevel(255),
+      _inhibit(false),
+      _stowed(false)
+{
+    for (uint8_t i = 0; i < POWER_STATE_COUNT; i++) {
+        _timeInState[i] = 0;
+    }
+}
+
+void PowerManager::init() {
+    unsigned long now = millis();
+    _lastActivity = now;
+    _stateEnteredAt = now;
+    _state = PowerState::ACTIVE;
+
+    Serial.printf("[POWER] Idle pipeline ready (sleep after %lus)\n", _idleTimeoutMs / 1000);
+}
+
+// ============================================================================
+// UPDATE
+// ============================================================================
+
+void PowerManager::update() {
+    unsigned long now = millis();
+
+    if (_inhibit) {
+        _lastActivity = now;
+        return;
+    }
+
+    // Nobody is watching a stowed device
+    unsigned long idleMs = _stowed ? min(_idleTimeoutMs, STOWED_IDLE_MS) : _idleTimeoutMs;
+    unsigned long sleepAnimMs = _stowed ? min(_sleepAnimMs, STOWED_SLEEP_ANIM_MS) : _sleepAnimMs;
+
+    switch (_state) {
+        case PowerState::ACTIVE:
+            if (now - _lastActivity >= idleMs) {
+                enterState(PowerState::SLEEP_ANIM);
+            }
+            break;
+
+        case PowerState::SLEEP_ANIM:
+            if (now - _stateEnteredAt >= sleepAnimMs) {
+                enterState(PowerState::DIMMING);
+            }
+            break;
+
+        case PowerState::DIMMING:
+            updateDimming(now);
+            break;
+
+        case PowerState::DISPLAY_OFF:
+            // Nothing to do until activity
+            break;
+    }
+}
+
+void PowerManager::updateDimming(unsigned long now) {
+    unsigned long elapsed = now - _stateEnteredAt;
+
+    if (elapsed >= _dimDurationMs) {
+        _display->setPower(false);
+        enterState(PowerState::DISPLAY_OFF);
+        return;
+    }
+
+    // Stepped ramp: only DIM_STEPS contrast writes over the whole duration
+    uint8_t step = (uint8_t)(elapsed * DIM_STEPS / _dimDurationMs) + 1;
+    uint8_t level = _activeBrightness -
+                    (uint8_t)((uint16_t)(_activeBrightness - MIN_BRIGHTNESS) * step / DIM_STEPS);
+
+    if (level != _lastDimLevel) {
+        _lastDimLevel = level;
+        _display->setBrightness(level);
+    }
+}
+
+// ============================================================================
+// ACTIVITY & WAKE
+// ============================================================================
+
+bool PowerManager::notifyActivity() {
+    unsigned long now = millis();
+    _lastActivity = now;
+
+    if (_state == PowerState::ACTIVE) {
+        return _lastWake != 0 && now - _lastWake < WAKE_GUARD_MS;
+    }
+    _lastWake = now;
+
+    // Reverse the whole chain at once
+    if (!_display->isPowerOn()) {
+        _display->setPower(true);
+    }
+    if (_display->getBrightness() != _activeBrightness) {
+        _display->setBrightness(_activeBrightness);
+    }
+
+    PowerState wokeFrom = _state;
+    enterState(PowerState::ACTIVE);
+
+    Serial.printf("[POWER] Woke from %s (totals: sleep %lus, dim %lus, off %lus)\n",
+                  getStateName(wokeFrom),
+                  getTimeInState(PowerState::SLEEP_ANIM) / 1000,
+                  getTimeInState(PowerState::DIMMING) / 1000,
+                  getTimeInState(PowerState::DISPLAY_OFF) / 1000);
+    return true;
+}
+
+void PowerManager::setInhibit(bool inhibit) {
+    if (inhibit == _inhibit) return;
+    _inhibit = inhibit;
+
+    if (inhibit) {
+        notifyActivity();
+    } else {
+        _lastActivity = millis();
+    }
+}
+
+// ============================================================================
+// STATE TRANSITIONS
+// ============================================================================
+
+void PowerManager::enterState(PowerState newState) {
+    unsigned long now = millis();
+    PowerState oldState = _state;
+
+    _timeInState[(uint8_t)oldState] += now - _stateEnteredAt;
+    _stateEnteredAt = now;
+    _state = newState;
+
+    if (newState == PowerState::DIMMING) {
+        _lastDimLevel = _activeBrightness;
+    }
+
+    Serial.printf("[POWER] %s -> %s\n", getStateName(oldState), getStateName(newState));
+
+    if (_callback != nullptr) {
+        _callback(oldState, newState);
+    }
+}
+
+unsigned long PowerManager::getTimeInState(PowerState state) const {
+    unsigned long total = _timeInState[(uint8_t)state];
+    if (state == _state) {
+        total += millis() - _stateEnteredAt;
+    }
+    return total;
+}
+
+const char* PowerManager::getStateName(PowerState state) {
+    switch (state) {
+        case PowerState::ACTIVE:      return "ACTIVE";
+        case PowerState::SLEEP_ANIM:  return "SLEEP_ANIM";
+        case PowerState::DIMMING:     return "DIMMING";
+        case PowerState::DISPLAY_OFF: return "DISPLAY_OFF";
+        default:                      return "UNKNOWN";
+    }
+}
+
+// ============================================================================
+// CONFIGURATION
+// ============================================================================
+
+void PowerManager::setTimeouts(unsigned long idleMs, unsigned long sleepAnimMs, unsigned long dimMs) {
+    _idleTimeoutMs = idleMs;
+    _sleepAnimMs = sleepAnimMs;
+    _dimDurationMs = dimMs > 0 ? dimMs : 1;
+}
+
+void PowerManager::setActiveBrightness(uint8_t level) {
+    if (level < MIN_BRIGHTNESS) level = MIN_BRIGHTNESS;
+    _activeBrightness = level;
+}
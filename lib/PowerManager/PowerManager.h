@@ -0,0 +1,155 @@
+/**
+ * @file PowerManager.h
+ * @brief Idle power pipeline for the OLED display
+ * @version 1.0.0
+ *
+ * After a period without input or motion the display walks through:
+ *   ACTIVE -> SLEEP_ANIM -> DIMMING -> DISPLAY_OFF
+ *
+ * - SLEEP_ANIM: caller plays the SLEEPING animation
+ * - DIMMING:    contrast ramps down to the minimum
+ * - DISPLAY_OFF: panel switched off, caller skips draw()/update()
+ *
+ * Any activity reverses the chain in one step (power on, restore
+ * contrast, back to ACTIVE). While the device is stowed (carried in a
+ * bag or pocket, see ActivityClassifier) nobody is watching, so the
+ * chain starts after STOWED_IDLE_MS and the sleeping face is cut
+ * short. Time spent in each state is accumulated so the savings can be
+ * inspected.
+ */
+
+#ifndef POWER_MANAGER_H
+#define POWER_MANAGER_H
+
+#include <Arduino.h>
+#include "DisplayManager.h"
+
+// ============================================================================
+// POWER STATE
+// ============================================================================
+enum class PowerState : uint8_t {
+    ACTIVE,         // Normal operation
+    SLEEP_ANIM,     // Showing sleeping face
+    DIMMING,        // Ramping contrast down
+    DISPLAY_OFF     // Panel off, rendering stopped
+};
+
+static constexpr uint8_t POWER_STATE_COUNT = 4;
+
+// ============================================================================
+// POWER EVENT CALLBACK
+// ============================================================================
+typedef void (*PowerStateCallback)(PowerState from, PowerState to);
+
+// ============================================================================
+// POWER MANAGER CLASS
+// ============================================================================
+class PowerManager {
+public:
+    /**
+     * @brief Constructor
+     * @param display Pointer to DisplayManager
+     */
+    PowerManager(DisplayManager* display);
+
+    /**
+     * @brief Initialize (starts ACTIVE, idle timer reset)
+     */
+    void init();
+
+    /**
+     * @brief Advance the pipeline (call in loop)
+     */
+    void update();
+
+    /**
+     * @brief Record input or motion activity, waking the display if needed
+     * @return true if the device was asleep or woke moments ago, so the
+     *         caller can swallow the whole waking gesture (press + click)
+     */
+    bool notifyActivity();
+
+    /**
+     * @brief Hold the device awake (e.g. running timer, setup portal)
+     * @param inhibit true to keep ACTIVE regardless of idle time
+     */
+    void setInhibit(bool inhibit);
+
+    /**
+     * @brief Mark the device as carried around (walking, transported)
+     * @param stowed true to use the short stowed timeouts
+     */
+    void setStowed(bool stowed) { _stowed = stowed; }
+
+    /**
+     * @brief Set pipeline timing
+     * @param idleMs Inactivity before the sleeping face
+     * @param sleepAnimMs How long the sleeping face shows before dimming
+     * @param dimMs Duration of the contrast ramp
+     */
+    void setTimeouts(unsigned long idleMs, unsigned long sleepAnimMs, unsigned long dimMs);
+
+    /**
+     * @brief Set contrast restored on wake (follows brightness setting)
+     * @param level Brightness (0-255)
+     */
+    void setActiveBrightness(uint8_t level);
+
+    /**
+     * @brief Set state change callback
+     */
+    void setStateCallback(PowerStateCallback callback) { _callback = callback; }
+
+    /**
+     * @brief Get current state
+     */
+    PowerState getState() const { return _state; }
+
+    /**
+     * @brief Check if the caller should draw and push frames
+     * @return false while the panel is off
+     */
+    bool shouldRender() const { return _state != PowerState::DISPLAY_OFF; }
+
+    /**
+     * @brief Get total time spent in a state (including the current stint)
+     * @param state State to query
+     * @return Milliseconds
+     */
+    unsigned long getTimeInState(PowerState state) const;
+
+    /**
+     * @brief Get state name for logging
+     */
+    static const char* getStateName(PowerState state);
+
+private:
+    DisplayManager* _display;
+    PowerState _state;
+    PowerStateCallback _callback;
+
+    unsigned long _lastActivity;
+    unsigned long _lastWake;
+    unsigned long _stateEnteredAt;
+    unsigned long _timeInState[POWER_STATE_COUNT];
+
+    unsigned long _idleTimeoutMs;
+    unsigned long _sleepAnimMs;
+    unsigned long _dimDurationMs;
+
+    uint8_t _activeBrightness;
+    uint8_t _lastDimLevel;
+    bool _inhibit;
+    bool _stowed;
+
+    static constexpr uint8_t MIN_BRIGHTNESS = 1;    // Lowest contrast before power off
+    static constexpr uint8_t DIM_STEPS = 8;         // Contrast writes during the ramp
+    static constexpr unsigned long WAKE_GUARD_MS = 400; // Inputs swallowed after wake
+    static constexpr unsigned long STOWED_IDLE_MS = 30000;      // Idle timeout while stowed
+    static constexpr unsigned long STOWED_SLEEP_ANIM_MS = 5000; // Sleeping face while stowed
+
+    void enterState(PowerState newState);
+    void updateDimming(unsigned long now);
+};
+
+#endif // POWER_MANAGER_H
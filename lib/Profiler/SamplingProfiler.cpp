@@ -0,0 +1,240 @@
+/**
+ * @file SamplingProfiler.cpp
+ * @brief Implementation of SamplingProfiler
+ */
+
+#include "SamplingProfiler.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "soc/soc.h"
+
+#ifdef __riscv
+#include "riscv/rvruntime-frames.h"
+#endif
+
+static const uint8_t TIMER_NUM = 0;
+static const uint16_t TIMER_DIVIDER = 80;       // 80 MHz APB -> 1 us ticks
+
+SamplingProfiler* SamplingProfiler::_active = nullptr;
+
+// ============================================================================
+// ADDRESS CHECKS (ISR)
+// ============================================================================
+
+static inline bool IRAM_ATTR isStackAddress(uint32_t address) {
+    return (address & 3) == 0 && address >= SOC_DRAM_LOW + 8 && address <= SOC_DRAM_HIGH;
+}
+
+static inline bool IRAM_ATTR isCodeAddress(uint32_t address) {
+    return (address >= SOC_IROM_LOW && address < SOC_IROM_HIGH) ||
+           (address >= SOC_IRAM_LOW && address < SOC_IRAM_HIGH);
+}
+
+// ============================================================================
+// CONSTRUCTOR & CONTROL
+// ============================================================================
+
+SamplingProfiler::SamplingProfiler()
+    : _timer(nullptr),
+      _ring(nullptr),
+      _capacity(0),
+      _head(0),
+      _taken(0),
+      _missed(0),
+      _rateHz(0),
+      _depth(0)
+{
+}
+
+SamplingProfiler::~SamplingProfiler() {
+    release();
+}
+
+bool SamplingProfiler::start(uint32_t rateHz, uint8_t depth) {
+    stop();
+
+#ifndef __riscv
+    Serial.println("[PROF] PC sampling is only implemented for RISC-V targets");
+    return false;
+#endif
+
+    // One hardware timer, one profiler
+    if (_active != nullptr) {
+        Serial.println("[PROF] Another profiler is running");
+        return false;
+    }
+
+    if (_ring == nullptr) {
+        _ring = (uint32_t*)malloc(RING_BYTES);
+        if (_ring == nullptr) {
+            Serial.printf("[PROF] Can't allocate %u B ring\n", (unsigned)RING_BYTES);
+            return false;
+        }
+    }
+
+    if (rateHz < MIN_RATE_HZ) rateHz = MIN_RATE_HZ;
+    if (rateHz > MAX_RATE_HZ) rateHz = MAX_RATE_HZ;
+    if (depth > MAX_DEPTH) depth = MAX_DEPTH;
+
+    _rateHz = rateHz;
+    _depth = depth;
+    _capacity = RING_BYTES / sizeof(uint32_t) / (1 + depth);
+    _head = 0;
+    _taken = 0;
+    _missed = 0;
+
+    _timer = timerBegin(TIMER_NUM, TIMER_DIVIDER, true);
+    if (_timer == nullptr) {
+        Serial.println("[PROF] Hardware timer unavailable");
+        return false;
+    }
+
+    _active = this;
+    timerAttachInterrupt(_timer, &SamplingProfiler::onTimer, false);
+    timerAlarmWrite(_timer, 1000000UL / rateHz, true);
+    timerAlarmEnable(_timer);
+
+    Serial.printf("[PROF] Sampling at %lu Hz, depth %u, room for %lu samples\n",
+                  (unsigned long)_rateHz, _depth, (unsigned long)_capacity);
+    return true;
+}
+
+void SamplingProfiler::stop() {
+    if (_timer == nullptr) return;
+
+    timerAlarmDisable(_timer);
+    timerDetachInterrupt(_timer);
+    timerEnd(_timer);
+    _timer = nullptr;
+    _active = nullptr;
+
+    Serial.printf("[PROF] Stopped after %lu samples\n", (unsigned long)_taken);
+}
+
+void SamplingProfiler::release() {
+    stop();
+    free(_ring);
+    _ring = nullptr;
+    _capacity = 0;
+    _head = 0;
+    _taken = 0;
+}
+
+// ============================================================================
+// SAMPLING (ISR)
+// ============================================================================
+
+void IRAM_ATTR SamplingProfiler::onTimer() {
+    SamplingProfiler* profiler = _active;
+    if (profiler != nullptr) {
+        profiler->sample();
+    }
+}
+
+void IRAM_ATTR SamplingProfiler::sample() {
+#ifdef __riscv
+    // On the first interrupt level the port saves the interrupted context
+    // on the task stack and stores its address in the TCB's first member
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    if (task == nullptr) {
+        _missed++;
+        return;
+    }
+    const RvExcFrame* frame = *(const RvExcFrame* const*)task;
+
+    uint32_t* record = _ring + _head * (1 + _depth);
+    record[0] = frame->mepc;
+    if (_depth > 0) {
+        uint8_t found = walkFrames(frame->s0, frame->ra, record + 1);
+        for (uint8_t i = found; i < _depth; i++) {
+            record[1 + i] = 0;
+        }
+    }
+
+    _head = _head + 1 == _capacity ? 0 : _head + 1;
+    _taken++;
+#else
+    _missed++;
+#endif
+}
+
+// Frame-pointer chain: s0 points just above the frame, the return address
+// is saved at s0-4 and the caller's s0 at s0-8
+uint8_t IRAM_ATTR SamplingProfiler::walkFrames(uint32_t fp, uint32_t ra, uint32_t* callers) const {
+    uint8_t found = 0;
+
+    while (found < _depth && isStackAddress(fp)) {
+        const uint32_t* slot = (const uint32_t*)fp;
+        uint32_t savedRa = slot[-1];
+        uint32_t savedFp = slot[-2];
+
+        // A leaf function saves only s0 (in the first slot); its caller is still in ra
+        if (found == 0 && !isCodeAddress(savedRa) && isStackAddress(savedRa)) {
+            savedFp = savedRa;
+            savedRa = ra;
+        }
+
+        if (!isCodeAddress(savedRa)) break;
+        callers[found++] = savedRa;
+
+        if (savedFp <= fp) break;       // Callers are higher up the stack
+        fp = savedFp;
+    }
+    return found;
+}
+
+// ============================================================================
+// OUTPUT
+// ============================================================================
+
+uint32_t SamplingProfiler::getSampleCount() const {
+    return _taken < _capacity ? _taken : _capacity;
+}
+
+size_t SamplingProfiler::formatHeader(char* out, size_t size) const {
+    if (size == 0) return 0;
+
+    int n = snprintf(out, size, "# profile rate=%lu depth=%u samples=%lu taken=%lu missed=%lu",
+                     (unsigned long)_rateHz, _depth, (unsigned long)getSampleCount(),
+                     (unsigned long)_taken, (unsigned long)_missed);
+    if (n < 0) return 0;
+    return (size_t)n < size ? (size_t)n : size - 1;
+}
+
+size_t SamplingProfiler::formatSample(uint32_t index, char* out, size_t size) const {
+    if (index >= getSampleCount() || size == 0) return 0;
+
+    // Oldest record is at _head once the ring has wrapped
+    uint32_t oldest = _taken > _capacity ? _head : 0;
+    uint32_t slot = (oldest + index) % _capacity;
+    const uint32_t* record = _ring + slot * (1 + _depth);
+
+    size_t length = snprintf(out, size, "@prof 0x%08lx", (unsigned long)record[0]);
+    for (uint8_t i = 0; i < _depth && record[1 + i] != 0 && length < size; i++) {
+        length += snprintf(out + length, size - length, " 0x%08lx", (unsigned long)record[1 + i]);
+    }
+    return length < size ? length : size - 1;
+}
+
+void SamplingProfiler::dump(Print& out) {
+    stop();
+
+    char line[LINE_BYTES > 96 ? LINE_BYTES : 96];
+    formatHeader(line, sizeof(line));
+    out.println(line);
+
+    uint32_t count = getSampleCount();
+    for (uint32_t i = 0; i < count; i++) {
+        formatSample(i, line, sizeof(line));
+        out.println(line);
+    }
+    out.println("# end");
+}
+
+void SamplingProfiler::printStatus(Print& out) const {
+    out.printf("[PROF] %s, %lu Hz, depth %u, %lu/%lu samples (%lu taken, %lu missed)\n",
+               isRunning() ? "running" : "stopped",
+               (unsigned long)_rateHz, _depth,
+               (unsigned long)getSampleCount(), (unsigned long)_capacity,
+               (unsigned long)_taken, (unsigned long)_missed);
+}
@@ -0,0 +1,115 @@
+/**
+ * @file SamplingProfiler.h
+ * @brief Timer-interrupt PC sampler for finding uninstrumented hot spots
+ *
+ * A hardware timer interrupts the CPU at a fixed rate; the ISR records
+ * the program counter of whatever was running (plus, optionally, a few
+ * return addresses from the frame-pointer chain) into a RAM ring. The
+ * ring is dumped as text and symbolized on the host against the firmware
+ * ELF (tools/symbolize_profile.py), which folds the samples into
+ * flame-graph stacks.
+ *
+ * The interrupted context is read from the exception frame the FreeRTOS
+ * port saves on the task stack (RISC-V / ESP32-C3). Consequences:
+ * - Time spent in other ISRs is charged to the task they interrupted
+ * - Code running with interrupts masked is charged to where it unmasks
+ * - Backtraces need -fno-omit-frame-pointer (env:esp32c3_profile) and
+ *   stop at the first frame built without it (precompiled IDF libs)
+ *
+ * The ring is allocated on start() and kept for dumping until release().
+ */
+
+#ifndef SAMPLING_PROFILER_H
+#define SAMPLING_PROFILER_H
+
+#include <Arduino.h>
+
+class SamplingProfiler {
+public:
+    static constexpr uint8_t MAX_DEPTH = 4;             // Return addresses per sample
+    static constexpr uint32_t MIN_RATE_HZ = 10;
+    static constexpr uint32_t MAX_RATE_HZ = 5000;
+    static constexpr uint32_t DEFAULT_RATE_HZ = 500;
+    static constexpr size_t RING_BYTES = 16384;         // 4096 PC-only samples
+
+    SamplingProfiler();
+    ~SamplingProfiler();
+
+    /**
+     * @brief Clear the ring and start sampling
+     * @param rateHz Samples per second (clamped to MIN/MAX_RATE_HZ)
+     * @param depth Return addresses per sample, 0 for PC only
+     * @return false if the ring can't be allocated or the timer is unavailable
+     */
+    bool start(uint32_t rateHz = DEFAULT_RATE_HZ, uint8_t depth = 0);
+
+    /**
+     * @brief Stop sampling; the ring is kept for dumping
+     */
+    void stop();
+
+    /**
+     * @brief Stop and free the ring
+     */
+    void release();
+
+    bool isRunning() const { return _timer != nullptr; }
+    uint32_t getRateHz() const { return _rateHz; }
+    uint8_t getDepth() const { return _depth; }
+
+    /**
+     * @brief Samples held in the ring (the newest ones once it wrapped)
+     */
+    uint32_t getSampleCount() const;
+
+    /**
+     * @brief Samples taken since start(), including overwritten ones
+     */
+    uint32_t getTotalSamples() const { return _taken; }
+
+    uint32_t getCapacity() const { return _capacity; }
+
+    /**
+     * @brief Header line describing the capture ("# profile rate=... ")
+     * @return Characters written (without NUL)
+     */
+    size_t formatHeader(char* out, size_t size) const;
+
+    /**
+     * @brief One sample as "@prof <pc> <caller> ..." in hex, oldest first
+     * Only meaningful while stopped.
+     * @return Characters written (without NUL), 0 if index is out of range
+     */
+    size_t formatSample(uint32_t index, char* out, size_t size) const;
+
+    /**
+     * @brief Stop sampling and print header and all samples
+     */
+    void dump(Print& out);
+
+    /**
+     * @brief Print status on one line
+     */
+    void printStatus(Print& out) const;
+
+    // Longest formatSample() line, including NUL
+    static constexpr size_t LINE_BYTES = 6 + (1 + MAX_DEPTH) * 11 + 1;
+
+private:
+    hw_timer_t* _timer;
+    uint32_t* _ring;                // _capacity records of (1 + _depth) words
+    uint32_t _capacity;
+    volatile uint32_t _head;        // Next record to write
+    volatile uint32_t _taken;
+    volatile uint32_t _missed;      // Ticks without a task frame (scheduler not running)
+    uint32_t _rateHz;
+    uint8_t _depth;
+
+    static SamplingProfiler* _active;
+
+    static void onTimer();
+    void sample();
+    uint8_t walkFrames(uint32_t fp, uint32_t ra, uint32_t* callers) const;
+};
+
+#endif // SAMPLING_PROFILER_H
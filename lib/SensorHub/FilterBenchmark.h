@@ -0,0 +1,108 @@
+/**
+ * @file FilterBenchmark.h
+ * @brief Cost per sample of the SensorHub filter chains
+ *
+ * Shared by the device (SensorHub::runFilterBenchmark, build with
+ * -DSENSOR_BENCHMARK) and the host (tools/filter_bench.cpp), which pass
+ * their own microsecond clock and print function.
+ */
+
+#ifndef FILTER_BENCHMARK_H
+#define FILTER_BENCHMARK_H
+
+#include "SensorFilters.h"
+
+namespace filter_bench {
+
+static const uint16_t INPUT_COUNT = 256;    // Power of two
+
+/**
+ * @brief The sound averaging SensorHub used before the chains (sum of a 16-entry ring)
+ */
+class RingSum16 {
+public:
+    typedef uint16_t SampleType;
+
+    RingSum16() : _index(0) {
+        for (uint8_t i = 0; i < 16; i++) _samples[i] = 0;
+    }
+
+    bool push(uint16_t in, uint16_t& out) {
+        _samples[_index] = in;
+        _index = (_index + 1) % 16;
+        uint32_t sum = 0;
+        for (uint8_t i = 0; i < 16; i++) sum += _samples[i];
+        out = sum / 16;
+        return true;
+    }
+
+private:
+    uint16_t _samples[16];
+    uint8_t _index;
+};
+
+// Noisy 12-bit readings with an occasional spike
+inline void fillInputs(uint16_t* inputs) {
+    uint32_t state = 0x2545F491;
+    for (uint16_t i = 0; i < INPUT_COUNT; i++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        inputs[i] = (i % 37 == 0) ? 4000 : 1800 + (state & 0x1FF);
+    }
+}
+
+/**
+ * @return Nanoseconds per sample
+ */
+template <typename Chain, typename Clock>
+uint32_t timeChain(Chain& chain, const uint16_t* inputs, uint32_t samples, Clock nowUs) {
+    typedef typename Chain::SampleType T;
+    volatile T sink = T();
+    T out = T();
+
+    uint32_t startUs = nowUs();
+    for (uint32_t i = 0; i < samples; i++) {
+        if (chain.push((T)inputs[i & (INPUT_COUNT - 1)], out)) sink = out;
+    }
+    uint32_t elapsedUs = nowUs() - startUs;
+    (void)sink;
+
+    return (uint32_t)((uint64_t)elapsedUs * 1000 / samples);
+}
+
+/**
+ * @param nowUs uint32_t() returning microseconds
+ * @param report void(const char* name, uint32_t nsPerSample)
+ */
+template <typename Clock, typename Report>
+void run(Clock nowUs, Report report, uint32_t samples = 20000) {
+    uint16_t inputs[INPUT_COUNT];
+    fillInputs(inputs);
+
+    RingSum16 ring;
+    report("ring sum16 (old)", timeChain(ring, inputs, samples, nowUs));
+
+    SoundFilter sound;
+    report("sound avg16", timeChain(sound, inputs, samples, nowUs));
+
+    TemperatureFilter temperature;
+    report("dht median3", timeChain(temperature, inputs, samples, nowUs));
+
+    FilterChain<uint16_t, MedianFilter<uint16_t, 5>> median5;
+    report("median5 u16", timeChain(median5, inputs, samples, nowUs));
+
+    FilterChain<uint16_t, Ema<uint16_t, 1, 8>> emaFixed;
+    report("ema 1/8 u16", timeChain(emaFixed, inputs, samples, nowUs));
+
+    FilterChain<float, Ema<float, 1, 8>> emaFloat;
+    report("ema 1/8 float", timeChain(emaFloat, inputs, samples, nowUs));
+
+    FilterChain<uint16_t, MedianFilter<uint16_t, 3>, Decimator<uint16_t, 4>,
+                MovingAverage<uint16_t, 16, uint32_t>> decimated;
+    report("med3>dec4>avg16", timeChain(decimated, inputs, samples, nowUs));
+}
+
+} // namespace filter_bench
+
+#endif // FILTER_BENCHMARK_H
@@ -0,0 +1,106 @@
+/**
+ * @file SensorFilters.h
+ * @brief Filter pipeline of each SensorHub channel
+ *
+ * Kept apart from SensorHub.h (no Arduino dependencies) so the host
+ * benchmark times exactly the chains the device runs.
+ */
+
+#ifndef SENSOR_FILTERS_H
+#define SENSOR_FILTERS_H
+
+#include "SignalFilters.h"
+
+/**
+ * @brief Sound: 16-sample mean (1.6 s at the 100 ms analog interval)
+ */
+typedef FilterChain<uint16_t,
+                    MovingAverage<uint16_t, 16, uint32_t>> SoundFilter;
+
+/**
+ * @brief DHT11: median of 3 drops the occasional one-reading spike
+ */
+typedef FilterChain<float, MedianFilter<float, 3>> TemperatureFilter;
+typedef FilterChain<float, MedianFilter<float, 3>> HumidityFilter;
+
+/**
+ * @brief Loud-sound detection on the filtered level
+ * Rises above the threshold, falls again 1/8 below it.
+ */
+class SoundTrigger : public Hysteresis<uint16_t> {
+public:
+    void setThreshold(uint16_t threshold) {
+        setThresholds(threshold - threshold / 8, threshold);
+    }
+};
+
+// ============================================================================
+// SOUND LEVEL IN DB
+// ============================================================================
+
+/**
+ * @brief Output stage of the sound pipeline: filtered level to dB
+ *
+ * The module output is taken as proportional to sound pressure, so
+ * dB = 20 log10(level), offset so full scale (4095) reads
+ * SOUND_DB_FULL_SCALE and clamped at SOUND_DB_FLOOR (same range as the
+ * old linear 30-90 dB map, but a doubling of the level is now +6 dB at
+ * any loudness). log2(level) is the position of the top bit plus a
+ * 32-entry table for the next five bits, built at compile time; the
+ * result is within 0.15 dB of the exact value.
+ */
+namespace sound_db {
+
+static constexpr float SOUND_DB_FULL_SCALE = 90.0f;
+static constexpr float SOUND_DB_FLOOR = 30.0f;
+static constexpr uint8_t MANTISSA_BITS = 5;
+
+// Natural log for the table (atanh series, x > 0)
+constexpr double ln(double x) {
+    int octaves = 0;
+    while (x >= 2.0) { x /= 2.0; octaves++; }
+    while (x < 1.0) { x *= 2.0; octaves--; }
+
+    double y = (x - 1.0) / (x + 1.0);
+    double term = y;
+    double sum = 0.0;
+    for (int n = 1; n < 41; n += 2) {
+        sum += term / n;
+        term *= y * y;
+    }
+    return 2.0 * sum + octaves * 0.69314718055994531;
+}
+
+// 20 log10 of each mantissa bucket's midpoint, in centi-dB
+struct MantissaTable {
+    uint16_t centiDb[1 << MANTISSA_BITS];
+};
+
+constexpr MantissaTable buildMantissaTable() {
+    MantissaTable table{};
+    for (int i = 0; i < (1 << MANTISSA_BITS); i++) {
+        double mantissa = 1.0 + (i + 0.5) / (1 << MANTISSA_BITS);
+        table.centiDb[i] = (uint16_t)(2000.0 * ln(mantissa) / ln(10.0) + 0.5);
+    }
+    return table;
+}
+
+static constexpr MantissaTable MANTISSA = buildMantissaTable();
+static constexpr float DB_PER_OCTAVE = (float)(20.0 * ln(2.0) / ln(10.0));
+static constexpr float FULL_SCALE_OFFSET = SOUND_DB_FULL_SCALE - (float)(20.0 * ln(4095.0) / ln(10.0));
+
+inline float fromLevel(uint16_t level) {
+    if (level == 0) return SOUND_DB_FLOOR;
+
+    uint8_t octave = 31 - __builtin_clz(level);
+    uint8_t mantissa = octave >= MANTISSA_BITS ? (level >> (octave - MANTISSA_BITS))
+                                               : (level << (MANTISSA_BITS - octave));
+    mantissa &= (1 << MANTISSA_BITS) - 1;
+
+    float db = FULL_SCALE_OFFSET + octave * DB_PER_OCTAVE + MANTISSA.centiDb[mantissa] / 100.0f;
+    return db < SOUND_DB_FLOOR ? SOUND_DB_FLOOR : db;
+}
+
+} // namespace sound_db
+
+#endif // SENSOR_FILTERS_H
@@ -4,6 +4,11 @@
  */
 
 #include "SensorHub.h"
+#include "SensorTrace.h"
+
+#ifdef SENSOR_BENCHMARK
+#include "FilterBenchmark.h"
+#endif
 
 // ============================================================================
 // CONSTRUCTOR & INITIALIZATION
@@ -20,11 +25,11 @@ SensorHub::SensorHub()
       _soundEnabled(false),
       _lastAnalogRead(0),
       _analogInterval(100),  // 10 Hz for analog
-      _soundSampleIndex(0),
       _soundThreshold(2000),
       _soundCallback(nullptr),
       _tempDelta(1.0f),
-      _tempCallback(nullptr)
+      _tempCallback(nullptr),
+      _trace(nullptr)
 {
     // Initialize sensor data
     _data.temperature = 0;
@@ -35,11 +40,8 @@ SensorHub::SensorHub()
     _data.soundDB = 0;
     _data.batteryLevel = 0;
     _data.batteryPercent = 0;
-    
-    // Initialize sound samples
-    for (uint8_t i = 0; i < 16; i++) {
-        _soundSamples[i] = 0;
-    }
+
+    _soundTrigger.setThreshold(_soundThreshold);
 }
 
 bool SensorHub::init(uint8_t dhtPin, uint8_t soundPin) {
@@ -84,6 +86,17 @@ bool SensorHub::init(uint8_t dhtPin, uint8_t soundPin) {
 // ============================================================================
 
 void SensorHub::update(bool forceUpdate) {
+    // Replayed readings already carry the recorded interval
+    if (_trace != nullptr && _trace->isReplaying()) {
+        uint16_t rawSound;
+        if (_trace->takeSound(rawSound)) {
+            uint32_t startUs = micros();
+            updateSound(rawSound);
+            _trace->noteProcessed(TraceChannel::SOUND, micros() - startUs);
+        }
+        return;
+    }
+
     unsigned long currentTime = millis();
     
     // Update DHT (slow, 2+ second interval)
@@ -113,6 +126,9 @@ void SensorHub::updateDHT() {
         return;
     }
     
+    _temperatureFilter.push(temp, temp);
+    _humidityFilter.push(hum, hum);
+
     _data.temperature = temp;
     _data.humidity = hum;
     _data.dhtValid = true;
@@ -130,38 +146,32 @@ void SensorHub::updateAnalogSensors() {
     // Read sound sensor
     if (_soundEnabled) {
         uint16_t rawSound = analogRead(_soundPin);
-        processSoundLevel(rawSound);
-        _data.soundLevel = getAverageSoundLevel();
-        
-        // Update peak
-        if (_data.soundLevel > _data.soundPeak) {
-            _data.soundPeak = _data.soundLevel;
-        }
-        
-        // Approximate dB (very rough estimate)
-        // 0 dB = threshold of hearing, 120 dB = threshold of pain
-        // Map 0-4095 to roughly 30-90 dB
-        _data.soundDB = map(_data.soundLevel, 0, 4095, 30, 90);
-        
-        // Check threshold callback
-        if (_soundCallback != nullptr && _data.soundLevel > _soundThreshold) {
-            _soundCallback(_data.soundLevel);
+        if (_trace != nullptr) {
+            _trace->recordSound(rawSound);
         }
+        updateSound(rawSound);
     }
 }
 
-void SensorHub::processSoundLevel(uint16_t rawValue) {
-    // Add to ring buffer
-    _soundSamples[_soundSampleIndex] = rawValue;
-    _soundSampleIndex = (_soundSampleIndex + 1) % 16;
-}
-
-uint16_t SensorHub::getAverageSoundLevel() {
-    uint32_t sum = 0;
-    for (uint8_t i = 0; i < 16; i++) {
-        sum += _soundSamples[i];
+void SensorHub::updateSound(uint16_t rawSound) {
+    _soundFilter.push(rawSound, _data.soundLevel);
+    
+    // Update peak
+    if (_data.soundLevel > _data.soundPeak) {
+        _data.soundPeak = _data.soundLevel;
+    }
+    
+    // Approximate dB (uncalibrated, 30-90 dB over the ADC range)
+    _data.soundDB = sound_db::fromLevel(_data.soundLevel);
+    
+    // Check threshold callback
+    _soundTrigger.update(_data.soundLevel);
+    if (_soundCallback != nullptr && _soundTrigger.rose()) {
+        if (_trace != nullptr && _trace->isReplaying()) {
+            _trace->noteDetection(TraceChannel::SOUND);
+        }
+        _soundCallback(_data.soundLevel);
     }
-    return sum / 16;
 }
 
 // ============================================================================
@@ -180,6 +190,7 @@ void SensorHub::setAnalogInterval(uint16_t intervalMs) {
 void SensorHub::setSoundThreshold(uint16_t threshold, SoundThresholdCallback callback) {
     _soundThreshold = threshold;
     _soundCallback = callback;
+    _soundTrigger.setThreshold(threshold);
 }
 
 void SensorHub::setTemperatureCallback(float deltaTemp, TemperatureChangeCallback callback) {
@@ -197,4 +208,20 @@ void SensorHub::enableSound(bool enabled) {
 
 void SensorHub::resetSoundPeak() {
     _data.soundPeak = 0;
-}
\ No newline at end of file
+}
+
+// ============================================================================
+// BENCHMARK
+// ============================================================================
+
+#ifdef SENSOR_BENCHMARK
+
+void SensorHub::runFilterBenchmark() {
+    Serial.println("[SENSOR] Filter benchmark (ns per sample)");
+    filter_bench::run([]() { return (uint32_t)micros(); },
+                      [](const char* name, uint32_t ns) {
+                          Serial.printf("[SENSOR]   %-18s %6lu\n", name, (unsigned long)ns);
+                      });
+}
+
+#endif // SENSOR_BENCHMARK
@@ -7,6 +7,9 @@
  * - DHT11 (temperature/humidity)
  * - HW-484 sound sensor
  * - Battery monitoring (future)
+ *
+ * Each channel runs its readings through a compile-time filter chain
+ * (SensorFilters.h) before they reach SensorData and the callbacks.
  */
 
 #ifndef SENSOR_HUB_H
@@ -14,6 +17,9 @@
 
 #include <Arduino.h>
 #include <DHT.h>
+#include "SensorFilters.h"
+
+class SensorTrace;
 
 // ============================================================================
 // SENSOR CONFIGURATION
@@ -129,6 +135,8 @@ public:
     
     /**
      * @brief Set sound threshold for callback
+     * Fires once when the filtered level rises above threshold, then
+     * again only after it dropped 1/8 below it.
      * @param threshold Level that triggers callback
      * @param callback Function to call
      */
@@ -140,6 +148,13 @@ public:
      * @param callback Function to call
      */
     void setTemperatureCallback(float deltaTemp, TemperatureChangeCallback callback);
+
+    /**
+     * @brief Record sound readings into a trace, or read them from one while it replays
+     * The DHT11 is not traced (and not read during replay).
+     * @param trace nullptr to detach
+     */
+    void setTrace(SensorTrace* trace) { _trace = trace; }
     
     /**
      * @brief Enable/disable specific sensors
@@ -158,6 +173,18 @@ public:
      */
     void resetSoundPeak();
 
+#ifdef SENSOR_BENCHMARK
+    // ========================================================================
+    // BENCHMARK (build with -DSENSOR_BENCHMARK)
+    // ========================================================================
+
+    /**
+     * @brief Time the filter chains (FilterBenchmark.h)
+     * Prints nanoseconds per sample over Serial.
+     */
+    static void runFilterBenchmark();
+
+#endif
 private:
     // DHT sensor
     DHT* _dht;
@@ -166,6 +193,8 @@ private:
     unsigned long _lastDHTRead;
     uint16_t _dhtInterval;
     float _lastTemperature;
+    TemperatureFilter _temperatureFilter;
+    HumidityFilter _humidityFilter;
     
     // Analog sensors
     uint8_t _soundPin;
@@ -177,20 +206,22 @@ private:
     SensorData _data;
     
     // Sound processing
-    uint16_t _soundSamples[16];  // Ring buffer for averaging
-    uint8_t _soundSampleIndex;
+    SoundFilter _soundFilter;
+    SoundTrigger _soundTrigger;
     uint16_t _soundThreshold;
     SoundThresholdCallback _soundCallback;
     
     // Temperature monitoring
     float _tempDelta;
     TemperatureChangeCallback _tempCallback;
+
+    // Recording / replay
+    SensorTrace* _trace;
     
     // Private methods
     void updateDHT();
     void updateAnalogSensors();
-    void processSoundLevel(uint16_t rawValue);
-    uint16_t getAverageSoundLevel();
+    void updateSound(uint16_t rawSound);
 };
 
 #endif // SENSOR_HUB_H
\ No newline at end of file
@@ -0,0 +1,275 @@
+/**
+ * @file SignalFilters.h
+ * @brief Allocation-free streaming filters, chained at compile time
+ *
+ * Each stage takes one sample and may produce one:
+ *
+ *     bool push(T in, T& out);   // false = no output for this sample
+ *     void reset();
+ *
+ * FilterChain<T, Stages...> runs a sample through its stages in order,
+ * stopping at a stage that produces nothing (a decimator between
+ * outputs). Stages are stored by value in a tuple and called directly,
+ * so a chain is a plain struct with no virtual calls and no heap; each
+ * SensorHub channel declares its own chain as a type.
+ *
+ * No Arduino dependencies, so chains can be benchmarked on the host
+ * (see FilterBenchmark.h).
+ */
+
+#ifndef SIGNAL_FILTERS_H
+#define SIGNAL_FILTERS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+
+/**
+ * @brief Mean of the last N samples from a running sum (O(1) per sample)
+ * Starts from N zeros, like a zero-filled ring.
+ * @tparam Acc Sum type, wide enough for N * max(T)
+ */
+template <typename T, size_t N, typename Acc = T>
+class MovingAverage {
+public:
+    static_assert(N > 0, "Window must not be empty");
+
+    MovingAverage() { reset(); }
+
+    bool push(T in, T& out) {
+        _sum += (Acc)in - (Acc)_window[_index];
+        _window[_index] = in;
+        _index = _index + 1 == N ? 0 : _index + 1;
+        out = (T)(_sum / (Acc)N);
+        return true;
+    }
+
+    void reset() {
+        for (size_t i = 0; i < N; i++) _window[i] = T();
+        _sum = Acc();
+        _index = 0;
+    }
+
+private:
+    T _window[N];
+    Acc _sum;
+    size_t _index;
+};
+
+/**
+ * @brief Exponential moving average, y += (x - y) * NUM / DEN
+ * Integer types keep y scaled by DEN so small steps are not lost, and
+ * round both the step and the output to nearest (half away from zero),
+ * so a constant input settles on itself for either sign.
+ * The first sample initializes y.
+ */
+template <typename T, uint16_t NUM, uint16_t DEN>
+class Ema {
+public:
+    static_assert(NUM > 0 && NUM <= DEN, "Alpha must be in (0, 1]");
+
+    Ema() { reset(); }
+
+    bool push(T in, T& out) {
+        if constexpr (std::is_floating_point<T>::value) {
+            _state = _primed ? _state + (in - _state) * NUM / DEN : in;
+            out = _state;
+        } else {
+            int64_t scaled = (int64_t)in * DEN;
+            _state = _primed ? _state + divRound((scaled - _state) * NUM) : scaled;
+            out = (T)divRound(_state);
+        }
+        _primed = true;
+        return true;
+    }
+
+    void reset() {
+        _state = 0;
+        _primed = false;
+    }
+
+private:
+    static int64_t divRound(int64_t n) {
+        return n >= 0 ? (n + DEN / 2) / DEN : (n - DEN / 2) / DEN;
+    }
+
+    typename std::conditional<std::is_floating_point<T>::value, T, int64_t>::type _state;
+    bool _primed;
+};
+
+/**
+ * @brief Median of the last N samples (N odd), rejects single-sample spikes
+ * Keeps a sorted copy of the window; O(N) per sample. Until N samples
+ * arrived, the median of those seen so far is used.
+ */
+template <typename T, size_t N>
+class MedianFilter {
+public:
+    static_assert(N % 2 == 1, "Median window must be odd");
+
+    MedianFilter() { reset(); }
+
+    bool push(T in, T& out) {
+        if (_count == N) {
+            remove(_window[_index]);
+        } else {
+            _count++;
+        }
+        _window[_index] = in;
+        _index = _index + 1 == N ? 0 : _index + 1;
+        insert(in);
+
+        out = _sorted[(_count - 1) / 2];
+        return true;
+    }
+
+    void reset() {
+        _count = 0;
+        _index = 0;
+    }
+
+private:
+    T _window[N];       // Arrival order
+    T _sorted[N];       // First _count entries sorted
+    size_t _count;
+    size_t _index;
+
+    void remove(T value) {
+        size_t i = 0;
+        while (i + 1 < _count && _sorted[i] != value) i++;
+        for (; i + 1 < _count; i++) _sorted[i] = _sorted[i + 1];
+    }
+
+    // _count already includes the new sample
+    void insert(T value) {
+        size_t i = _count - 1;
+        while (i > 0 && _sorted[i - 1] > value) {
+            _sorted[i] = _sorted[i - 1];
+            i--;
+        }
+        _sorted[i] = value;
+    }
+};
+
+/**
+ * @brief Pass every Nth sample, drop the rest
+ */
+template <typename T, size_t N>
+class Decimator {
+public:
+    static_assert(N > 0, "Factor must not be zero");
+
+    Decimator() { reset(); }
+
+    bool push(T in, T& out) {
+        if (++_phase < N) return false;
+        _phase = 0;
+        out = in;
+        return true;
+    }
+
+    void reset() { _phase = 0; }
+
+private:
+    size_t _phase;
+};
+
+/**
+ * @brief Two-threshold switch (Schmitt trigger) for a filtered level
+ * Turns on above the high threshold and off only below the low one, so
+ * a level hovering at a single threshold doesn't toggle every sample.
+ * Thresholds are set at runtime; not a chain stage (its output is a state).
+ */
+template <typename T>
+class Hysteresis {
+public:
+    Hysteresis() : _low(T()), _high(T()), _on(false), _rose(false) {}
+
+    void setThresholds(T low, T high) {
+        _low = low;
+        _high = high;
+    }
+
+    /**
+     * @return Current state
+     */
+    bool update(T level) {
+        bool was = _on;
+        if (_on) {
+            _on = !(level < _low);
+        } else {
+            _on = level > _high;
+        }
+        _rose = _on && !was;
+        return _on;
+    }
+
+    bool isOn() const { return _on; }
+
+    /**
+     * @brief True if the last update() switched on
+     */
+    bool rose() const { return _rose; }
+
+    void reset() {
+        _on = false;
+        _rose = false;
+    }
+
+private:
+    T _low;
+    T _high;
+    bool _on;
+    bool _rose;
+};
+
+/**
+ * @brief Stages applied in order to samples of type T
+ */
+template <typename T, typename... Stages>
+class FilterChain {
+public:
+    typedef T SampleType;
+    static constexpr size_t STAGES = sizeof...(Stages);
+
+    /**
+     * @return false if a stage produced no output for this sample
+     */
+    bool push(T in, T& out) { return pushFrom<0>(in, out); }
+
+    void reset() { resetFrom<0>(); }
+
+    /**
+     * @brief Access a stage, e.g. to configure it
+     */
+    template <size_t I>
+    typename std::tuple_element<I, std::tuple<Stages...>>::type& stage() {
+        return std::get<I>(_stages);
+    }
+
+private:
+    std::tuple<Stages...> _stages;
+
+    template <size_t I>
+    bool pushFrom(T in, T& out) {
+        if constexpr (I == STAGES) {
+            out = in;
+            return true;
+        } else {
+            T next;
+            if (!std::get<I>(_stages).push(in, next)) return false;
+            return pushFrom<I + 1>(next, out);
+        }
+    }
+
+    template <size_t I>
+    void resetFrom() {
+        if constexpr (I < STAGES) {
+            std::get<I>(_stages).reset();
+            resetFrom<I + 1>();
+        }
+    }
+};
+
+#endif // SIGNAL_FILTERS_H
@@ -0,0 +1,348 @@
+/**
+ * @file SensorTrace.cpp
+ * @brief Implementation of SensorTrace and TraceHexPrint
+ */
+
+#include "SensorTrace.h"
+
+static const char* const CHANNEL_NAMES[TRACE_CHANNELS] = {"IMU", "sound", "input"};
+
+SensorTrace::SensorTrace()
+    : _mode(Mode::IDLE),
+      _realtime(false),
+      _sink(nullptr),
+      _recordedInputs(0),
+      _inputsRecorded(false),
+      _source(nullptr),
+      _data(nullptr),
+      _dataLength(0),
+      _dataPos(0),
+      _hasPending(false),
+      _exhausted(false),
+      _startMs(0),
+      _firstRecordMs(0),
+      _nowMs(0),
+      _sound(0),
+      _released(0),
+      _bufferLength(0),
+      _inputs(0)
+{
+    memset(&_pending, 0, sizeof(_pending));
+    memset(&_imu, 0, sizeof(_imu));
+    memset(&_stats, 0, sizeof(_stats));
+}
+
+// ============================================================================
+// RECORDING
+// ============================================================================
+
+bool SensorTrace::startRecording(Print* sink) {
+    if (_mode != Mode::IDLE || sink == nullptr) return false;
+
+    _sink = sink;
+    _encoder.reset();
+    _inputs = 0;
+    _inputsRecorded = false;
+    memset(&_stats, 0, sizeof(_stats));
+
+    _bufferLength = _encoder.writeHeader(_buffer);
+    _mode = Mode::RECORDING;
+    Serial.println("[TRACE] Recording");
+    return true;
+}
+
+void SensorTrace::stopRecording() {
+    if (_mode != Mode::RECORDING) return;
+
+    flush();
+    _sink = nullptr;
+    _mode = Mode::IDLE;
+    printStats(Serial);
+}
+
+void SensorTrace::recordImu(const ImuSample& sample) {
+    if (_mode != Mode::RECORDING) return;
+
+    TraceRecord record;
+    record.channel = TraceChannel::IMU;
+    record.timeMs = millis();
+    record.imu = sample;
+    write(record);
+}
+
+void SensorTrace::recordSound(uint16_t raw) {
+    if (_mode != Mode::RECORDING) return;
+
+    TraceRecord record;
+    record.channel = TraceChannel::SOUND;
+    record.timeMs = millis();
+    record.sound = raw;
+    write(record);
+}
+
+void SensorTrace::setInput(uint8_t bit, bool level) {
+    if (_mode != Mode::RECORDING) return;
+
+    if (level) {
+        _inputs |= bit;
+    } else {
+        _inputs &= ~bit;
+    }
+}
+
+void SensorTrace::flushInputs() {
+    if (_mode != Mode::RECORDING) return;
+    if (_inputsRecorded && _inputs == _recordedInputs) return;
+
+    TraceRecord record;
+    record.channel = TraceChannel::INPUTS;
+    record.timeMs = millis();
+    record.inputs = _inputs;
+    write(record);
+
+    _recordedInputs = _inputs;
+    _inputsRecorded = true;
+}
+
+void SensorTrace::write(const TraceRecord& record) {
+    if (_bufferLength + TraceEncoder::MAX_RECORD_BYTES > BUFFER_BYTES) {
+        flush();
+    }
+    _bufferLength += _encoder.encode(record, _buffer + _bufferLength);
+    _stats.samples[(uint8_t)record.channel]++;
+}
+
+void SensorTrace::flush() {
+    if (_bufferLength == 0) return;
+
+    _stats.bytes += _sink->write(_buffer, _bufferLength);
+    _bufferLength = 0;
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+bool SensorTrace::startReplay(Stream* source, bool realtime) {
+    if (_mode != Mode::IDLE || source == nullptr) return false;
+
+    _source = source;
+    _data = nullptr;
+    return beginReplay(realtime);
+}
+
+bool SensorTrace::startReplay(const uint8_t* data, size_t length, bool realtime) {
+    if (_mode != Mode::IDLE || data == nullptr) return false;
+
+    _source = nullptr;
+    _data = data;
+    _dataLength = length;
+    _dataPos = 0;
+    return beginReplay(realtime);
+}
+
+bool SensorTrace::beginReplay(bool realtime) {
+    _realtime = realtime;
+    _decoder.reset();
+    _bufferLength = 0;
+    _hasPending = false;
+    _exhausted = false;
+    _released = 0;
+    _inputs = 0;
+    memset(&_stats, 0, sizeof(_stats));
+
+    fill();
+    if (!TraceDecoder::checkHeader(_buffer, _bufferLength)) {
+        Serial.println("[TRACE] Not a sensor trace");
+        return false;
+    }
+    consume(TraceEncoder::HEADER_BYTES);
+
+    if (!readRecord(_pending)) {
+        Serial.println("[TRACE] Trace is empty");
+        return false;
+    }
+    _hasPending = true;
+    _firstRecordMs = _pending.timeMs;
+    _nowMs = _pending.timeMs;
+    _startMs = millis();
+
+    _mode = Mode::REPLAYING;
+    Serial.printf("[TRACE] Replaying (%s)\n", realtime ? "realtime" : "fast");
+    return true;
+}
+
+void SensorTrace::stopReplay() {
+    if (_mode == Mode::REPLAYING) {
+        finishReplay("stopped");
+    }
+}
+
+void SensorTrace::update() {
+    if (_mode != Mode::REPLAYING) return;
+
+    if (_exhausted) {
+        finishReplay(_decoder.hasError() ? "corrupt trace" : "end of trace");
+        return;
+    }
+
+    if (_realtime) {
+        _nowMs = _firstRecordMs + (millis() - _startMs);
+    }
+
+    uint8_t applied = 0;
+    while (true) {
+        if (!_hasPending) {
+            if (!readRecord(_pending)) {
+                _exhausted = true;
+                return;
+            }
+            _hasPending = true;
+        }
+
+        uint8_t bit = 1 << (uint8_t)_pending.channel;
+        if (applied & bit) return;
+
+        // Fast mode: the clock jumps to the first sample of this loop
+        if (!_realtime && applied == 0 && _pending.timeMs > _nowMs) {
+            _nowMs = _pending.timeMs;
+        }
+        if (_pending.timeMs > _nowMs) return;
+
+        switch (_pending.channel) {
+            case TraceChannel::IMU:
+                _imu = _pending.imu;
+                _released |= bit;
+                break;
+            case TraceChannel::SOUND:
+                _sound = _pending.sound;
+                _released |= bit;
+                break;
+            default:
+                _inputs = _pending.inputs;
+                break;
+        }
+
+        _stats.samples[(uint8_t)_pending.channel]++;
+        applied |= bit;
+        _hasPending = false;
+    }
+}
+
+bool SensorTrace::takeImu(ImuSample& sample) {
+    uint8_t bit = 1 << (uint8_t)TraceChannel::IMU;
+    if ((_released & bit) == 0) return false;
+
+    sample = _imu;
+    _released &= ~bit;
+    return true;
+}
+
+bool SensorTrace::takeSound(uint16_t& raw) {
+    uint8_t bit = 1 << (uint8_t)TraceChannel::SOUND;
+    if ((_released & bit) == 0) return false;
+
+    raw = _sound;
+    _released &= ~bit;
+    return true;
+}
+
+void SensorTrace::noteProcessed(TraceChannel channel, uint32_t busyUs) {
+    _stats.busyUs[(uint8_t)channel] += busyUs;
+}
+
+void SensorTrace::noteDetection(TraceChannel channel) {
+    _stats.detections[(uint8_t)channel]++;
+}
+
+bool SensorTrace::readRecord(TraceRecord& record) {
+    while (true) {
+        size_t used = _decoder.decode(_buffer, _bufferLength, record);
+        if (used > 0) {
+            consume(used);
+            return true;
+        }
+
+        // A full buffer always holds a whole record
+        if (_decoder.hasError() || _bufferLength == BUFFER_BYTES) return false;
+        if (fill() == 0) return false;
+    }
+}
+
+size_t SensorTrace::fill() {
+    size_t room = BUFFER_BYTES - _bufferLength;
+    size_t got = 0;
+
+    if (_source != nullptr) {
+        got = _source->readBytes((char*)_buffer + _bufferLength, room);
+    } else if (_data != nullptr) {
+        got = min(room, _dataLength - _dataPos);
+        memcpy(_buffer + _bufferLength, _data + _dataPos, got);
+        _dataPos += got;
+    }
+
+    _bufferLength += got;
+    return got;
+}
+
+void SensorTrace::consume(size_t bytes) {
+    memmove(_buffer, _buffer + bytes, _bufferLength - bytes);
+    _bufferLength -= bytes;
+}
+
+void SensorTrace::finishReplay(const char* reason) {
+    _mode = Mode::IDLE;
+    _source = nullptr;
+    _data = nullptr;
+    _released = 0;
+    _inputs = 0;
+
+    Serial.printf("[TRACE] Replay finished (%s) after %lu ms of trace\n",
+                  reason, (unsigned long)(_nowMs - _firstRecordMs));
+    printStats(Serial);
+}
+
+// ============================================================================
+// STATUS
+// ============================================================================
+
+void SensorTrace::printStats(Print& out) const {
+    for (uint8_t i = 0; i < TRACE_CHANNELS; i++) {
+        uint32_t samples = _stats.samples[i];
+        out.printf("[TRACE] %-5s %6lu samples, %4lu detections, %lu us/sample\n",
+                   CHANNEL_NAMES[i], (unsigned long)samples, (unsigned long)_stats.detections[i],
+                   (unsigned long)(samples > 0 ? _stats.busyUs[i] / samples : 0));
+    }
+    if (_stats.bytes > 0) {
+        out.printf("[TRACE] %lu bytes written\n", (unsigned long)_stats.bytes);
+    }
+}
+
+// ============================================================================
+// HEX OUTPUT
+// ============================================================================
+
+size_t TraceHexPrint::write(uint8_t byte) {
+    static const char HEX_DIGITS[] = "0123456789abcdef";
+
+    if (_column == 0) _out.print("@trace ");
+    _out.write(HEX_DIGITS[byte >> 4]);
+    _out.write(HEX_DIGITS[byte & 0x0F]);
+
+    if (++_column == BYTES_PER_LINE) endLine();
+    return 1;
+}
+
+size_t TraceHexPrint::write(const uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+        write(buffer[i]);
+    }
+    endLine();
+    return size;
+}
+
+void TraceHexPrint::endLine() {
+    if (_column == 0) return;
+    _out.println();
+    _column = 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * @file SensorTrace.h
+ * @brief Record sensor sessions and replay them in place of the hardware
+ *
+ * While recording, MotionSensor, SensorHub and InputManager hand every
+ * reading they take to the trace, which encodes it (TraceCodec) into a
+ * sink: a LittleFS file, or the serial console as "@trace <hex>" lines
+ * (tools/trace_from_log.py turns a captured log back into a file).
+ *
+ * While replaying, the same classes take their readings from the trace
+ * instead of the hardware and read time from clock(), so thresholds,
+ * cooldowns and debouncing see the recorded timing:
+ * - realtime: samples are released as the recorded time passes
+ * - fast: the clock jumps to the next sample every loop, so a session
+ *   replays as fast as the loop runs, with the same detections
+ * At most one sample per channel is released per update(), as on the
+ * device where each loop reads every sensor once.
+ *
+ * Replay statistics count samples, detections and the microseconds the
+ * consumers spent per sample, for comparing thresholds and detector cost
+ * on a fixed set of sessions.
+ */
+
+#ifndef SENSOR_TRACE_H
+#define SENSOR_TRACE_H
+
+#include <Arduino.h>
+#include "TraceCodec.h"
+
+struct TraceStats {
+    uint32_t samples[TRACE_CHANNELS];
+    uint32_t detections[TRACE_CHANNELS];
+    uint32_t busyUs[TRACE_CHANNELS];    // Time consumers spent on the samples
+    uint32_t bytes;                     // Encoded size (recording)
+};
+
+class SensorTrace {
+public:
+    enum class Mode : uint8_t {
+        IDLE,
+        RECORDING,
+        REPLAYING
+    };
+
+    SensorTrace();
+
+    // ========================================================================
+    // RECORDING
+    // ========================================================================
+
+    /**
+     * @brief Start a trace into sink (a File, or a TraceHexPrint over Serial)
+     * The sink must stay valid until stopRecording().
+     */
+    bool startRecording(Print* sink);
+
+    void stopRecording();
+
+    bool isRecording() const { return _mode == Mode::RECORDING; }
+
+    /**
+     * @brief Called by the sensors with each reading while recording
+     */
+    void recordImu(const ImuSample& sample);
+    void recordSound(uint16_t raw);
+
+    /**
+     * @brief Report one input level; flushInputs() records the set if it changed
+     */
+    void setInput(uint8_t bit, bool level);
+    void flushInputs();
+
+    // ========================================================================
+    // REPLAY
+    // ========================================================================
+
+    /**
+     * @brief Replay a trace read from source (e.g. a LittleFS file)
+     */
+    bool startReplay(Stream* source, bool realtime);
+
+    /**
+     * @brief Replay a trace held in memory
+     */
+    bool startReplay(const uint8_t* data, size_t length, bool realtime);
+
+    void stopReplay();
+
+    bool isReplaying() const { return _mode == Mode::REPLAYING; }
+    bool isRealtime() const { return _realtime; }
+
+    /**
+     * @brief Advance the replay clock and release the next samples
+     * Call once per loop, before the sensors update.
+     */
+    void update();
+
+    /**
+     * @brief Take the sample released for a channel this loop
+     * @return false if there is none
+     */
+    bool takeImu(ImuSample& sample);
+    bool takeSound(uint16_t& raw);
+
+    /**
+     * @brief Current replayed input level
+     */
+    bool getInput(uint8_t bit) const { return (_inputs & bit) != 0; }
+
+    /**
+     * @brief Replayed time in ms (recorder's millis())
+     */
+    uint32_t now() const { return _nowMs; }
+
+    /**
+     * @brief millis(), or replayed time while trace is replaying
+     */
+    static uint32_t clock(const SensorTrace* trace) {
+        return trace != nullptr && trace->isReplaying() ? trace->now() : millis();
+    }
+
+    /**
+     * @brief Called by consumers while replaying
+     * @param busyUs Time spent processing the sample
+     */
+    void noteProcessed(TraceChannel channel, uint32_t busyUs);
+    void noteDetection(TraceChannel channel);
+
+    // ========================================================================
+    // STATUS
+    // ========================================================================
+
+    Mode getMode() const { return _mode; }
+    const TraceStats& getStats() const { return _stats; }
+    void printStats(Print& out) const;
+
+private:
+    static constexpr size_t BUFFER_BYTES = 64;
+
+    Mode _mode;
+    bool _realtime;
+
+    // Recording
+    Print* _sink;
+    TraceEncoder _encoder;
+    uint8_t _recordedInputs;
+    bool _inputsRecorded;
+
+    // Replay
+    Stream* _source;
+    const uint8_t* _data;
+    size_t _dataLength;
+    size_t _dataPos;
+    TraceDecoder _decoder;
+    TraceRecord _pending;
+    bool _hasPending;
+    bool _exhausted;            // Source ran dry; finish on the next update()
+    uint32_t _startMs;          // millis() at replay start (realtime)
+    uint32_t _firstRecordMs;
+    uint32_t _nowMs;
+    ImuSample _imu;
+    uint16_t _sound;
+    uint8_t _released;          // Channel bits with a sample waiting to be taken
+
+    // Shared: encode buffer while recording, read-ahead while replaying
+    uint8_t _buffer[BUFFER_BYTES];
+    size_t _bufferLength;
+
+    uint8_t _inputs;            // Levels being collected / replayed
+    TraceStats _stats;
+
+    void write(const TraceRecord& record);
+    void flush();
+    bool beginReplay(bool realtime);
+    bool readRecord(TraceRecord& record);
+    size_t fill();
+    void consume(size_t bytes);
+    void finishReplay(const char* reason);
+};
+
+/**
+ * @brief Print adapter that writes bytes as "@trace <hex>" lines
+ * Each buffer write ends its last line, so log output printed between
+ * two flushes of the trace never lands inside a line.
+ */
+class TraceHexPrint : public Print {
+public:
+    explicit TraceHexPrint(Print& out) : _out(out), _column(0) {}
+
+    size_t write(uint8_t byte) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    void endLine();
+
+private:
+    static constexpr uint8_t BYTES_PER_LINE = 32;
+
+    Print& _out;
+    uint8_t _column;
+};
+
+#endif // SENSOR_TRACE_H
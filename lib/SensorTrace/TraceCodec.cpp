@@ -0,0 +1,163 @@
+/**
+ * @file TraceCodec.cpp
+ * @brief Implementation of TraceEncoder and TraceDecoder
+ */
+
+#include "TraceCodec.h"
+#include <string.h>
+
+static const uint8_t MAGIC[TraceEncoder::HEADER_BYTES] = {'C', 'T', 'R', '1'};
+
+// ============================================================================
+// VARINTS
+// ============================================================================
+
+static uint32_t zigzag(int32_t value) {
+    return ((uint32_t)value << 1) ^ (uint32_t)(value >> 31);
+}
+
+static int32_t unzigzag(uint32_t value) {
+    return (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+}
+
+static size_t putVarint(uint8_t* out, uint32_t value) {
+    size_t length = 0;
+    while (value >= 0x80) {
+        out[length++] = (uint8_t)value | 0x80;
+        value >>= 7;
+    }
+    out[length++] = (uint8_t)value;
+    return length;
+}
+
+// Returns bytes read, 0 if the varint runs past the end or is too long
+static size_t getVarint(const uint8_t* in, size_t length, uint32_t& value) {
+    value = 0;
+    for (size_t i = 0; i < length && i < 5; i++) {
+        value |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0) return i + 1;
+    }
+    return 0;
+}
+
+// ============================================================================
+// ENCODER
+// ============================================================================
+
+TraceEncoder::TraceEncoder() {
+    reset();
+}
+
+void TraceEncoder::reset() {
+    _lastTimeMs = 0;
+    memset(&_lastImu, 0, sizeof(_lastImu));
+    _lastSound = 0;
+}
+
+size_t TraceEncoder::writeHeader(uint8_t* out) const {
+    memcpy(out, MAGIC, HEADER_BYTES);
+    return HEADER_BYTES;
+}
+
+size_t TraceEncoder::encode(const TraceRecord& record, uint8_t* out) {
+    size_t length = 0;
+    out[length++] = (uint8_t)record.channel;
+    length += putVarint(out + length, record.timeMs - _lastTimeMs);
+    _lastTimeMs = record.timeMs;
+
+    switch (record.channel) {
+        case TraceChannel::IMU:
+            for (uint8_t i = 0; i < 3; i++) {
+                length += putVarint(out + length, zigzag(record.imu.accel[i] - _lastImu.accel[i]));
+            }
+            for (uint8_t i = 0; i < 3; i++) {
+                length += putVarint(out + length, zigzag(record.imu.gyro[i] - _lastImu.gyro[i]));
+            }
+            _lastImu = record.imu;
+            break;
+
+        case TraceChannel::SOUND:
+            length += putVarint(out + length, zigzag((int32_t)record.sound - _lastSound));
+            _lastSound = record.sound;
+            break;
+
+        default:
+            out[length++] = record.inputs;
+            break;
+    }
+    return length;
+}
+
+// ============================================================================
+// DECODER
+// ============================================================================
+
+TraceDecoder::TraceDecoder() {
+    reset();
+}
+
+void TraceDecoder::reset() {
+    _lastTimeMs = 0;
+    memset(&_lastImu, 0, sizeof(_lastImu));
+    _lastSound = 0;
+    _error = false;
+}
+
+bool TraceDecoder::checkHeader(const uint8_t* in, size_t length) {
+    return length >= TraceEncoder::HEADER_BYTES &&
+           memcmp(in, MAGIC, TraceEncoder::HEADER_BYTES) == 0;
+}
+
+size_t TraceDecoder::decode(const uint8_t* in, size_t length, TraceRecord& record) {
+    if (_error || length < 2) return 0;
+
+    if (in[0] >= TRACE_CHANNELS) {
+        _error = true;
+        return 0;
+    }
+    record.channel = (TraceChannel)in[0];
+
+    size_t pos = 1;
+    uint32_t value;
+    size_t used = getVarint(in + pos, length - pos, value);
+    if (used == 0) return 0;
+    pos += used;
+    uint32_t timeMs = _lastTimeMs + value;
+
+    // Values are committed only once the whole record is there
+    ImuSample imu = _lastImu;
+    uint16_t sound = _lastSound;
+
+    switch (record.channel) {
+        case TraceChannel::IMU:
+            for (uint8_t i = 0; i < 6; i++) {
+                used = getVarint(in + pos, length - pos, value);
+                if (used == 0) return 0;
+                pos += used;
+
+                int16_t& field = i < 3 ? imu.accel[i] : imu.gyro[i - 3];
+                field = (int16_t)(field + unzigzag(value));
+            }
+            break;
+
+        case TraceChannel::SOUND:
+            used = getVarint(in + pos, length - pos, value);
+            if (used == 0) return 0;
+            pos += used;
+            sound = (uint16_t)(sound + unzigzag(value));
+            break;
+
+        default:
+            if (pos >= length) return 0;
+            record.inputs = in[pos++];
+            break;
+    }
+
+    _lastTimeMs = timeMs;
+    _lastImu = imu;
+    _lastSound = sound;
+    record.timeMs = timeMs;
+    record.imu = imu;
+    record.sound = sound;
+    return pos;
+}
@@ -0,0 +1,112 @@
+/**
+ * @file TraceCodec.h
+ * @brief Compact binary format for recorded sensor sessions
+ *
+ * A trace is a 4-byte magic followed by records in time order. Each
+ * record is a channel tag, the milliseconds since the previous record
+ * and the channel's values, stored as zigzag varints of the difference
+ * to that channel's previous record (input levels are one raw byte).
+ * Slowly changing IMU and sound readings mostly fit in one byte per
+ * value: 8.4 bytes per IMU sample instead of 28 on the synthetic
+ * session of tools/trace_replay.cpp.
+ *
+ * Plain C++ without Arduino dependencies, so traces can be written and
+ * read by host-side tools as well as on the device.
+ */
+
+#ifndef TRACE_CODEC_H
+#define TRACE_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class TraceChannel : uint8_t {
+    IMU,        // Calibrated accelerometer and gyro
+    SOUND,      // Raw sound ADC reading
+    INPUTS,     // Encoder/button levels (TRACE_INPUT_* bits)
+    COUNT
+};
+
+static const uint8_t TRACE_CHANNELS = (uint8_t)TraceChannel::COUNT;
+
+// Input level bits (logical: 1 = pressed / high)
+static const uint8_t TRACE_INPUT_CLK = 0x01;
+static const uint8_t TRACE_INPUT_DT = 0x02;
+static const uint8_t TRACE_INPUT_SELECT = 0x04;
+static const uint8_t TRACE_INPUT_BACK = 0x08;
+
+/**
+ * @brief One IMU reading in fixed point
+ */
+struct ImuSample {
+    int16_t accel[3];       // cm/s² (±327 m/s², the MPU6050 at 8 g reaches 78)
+    int16_t gyro[3];        // mrad/s (±32 rad/s, 500 °/s is 8.7)
+};
+
+// ImuSample units per m/s² and per rad/s
+static const float TRACE_ACCEL_SCALE = 100.0f;
+static const float TRACE_GYRO_SCALE = 1000.0f;
+
+struct TraceRecord {
+    TraceChannel channel;
+    uint32_t timeMs;        // Recorder's millis()
+    ImuSample imu;          // IMU records
+    uint16_t sound;         // SOUND records
+    uint8_t inputs;         // INPUTS records
+};
+
+class TraceEncoder {
+public:
+    static constexpr size_t HEADER_BYTES = 4;
+    static constexpr size_t MAX_RECORD_BYTES = 1 + 5 + 6 * 3;
+
+    TraceEncoder();
+
+    /**
+     * @brief Forget previous values (start of a new trace)
+     */
+    void reset();
+
+    /**
+     * @brief Write the magic that starts every trace
+     * @return HEADER_BYTES
+     */
+    size_t writeHeader(uint8_t* out) const;
+
+    /**
+     * @brief Append one record
+     * @param out At least MAX_RECORD_BYTES
+     * @return Bytes written
+     */
+    size_t encode(const TraceRecord& record, uint8_t* out);
+
+private:
+    uint32_t _lastTimeMs;
+    ImuSample _lastImu;
+    uint16_t _lastSound;
+};
+
+class TraceDecoder {
+public:
+    TraceDecoder();
+
+    void reset();
+
+    static bool checkHeader(const uint8_t* in, size_t length);
+
+    /**
+     * @brief Decode the record at the front of in
+     * @return Bytes consumed, 0 if in holds no complete record (or the data is bad, see hasError())
+     */
+    size_t decode(const uint8_t* in, size_t length, TraceRecord& record);
+
+    bool hasError() const { return _error; }
+
+private:
+    uint32_t _lastTimeMs;
+    ImuSample _lastImu;
+    uint16_t _lastSound;
+    bool _error;
+};
+
+#endif // TRACE_CODEC_H
@@ -0,0 +1,177 @@
+#include "ForecastCache.h"
+
+// MET Norway base symbol codes (index + 1 = symbol id)
+static const char* const SYMBOLS[] = {
+    "clearsky", "cloudy", "fair", "fog",
+    "heavyrain", "heavyrainandthunder", "heavyrainshowers", "heavyrainshowersandthunder",
+    "heavysleet", "heavysleetandthunder", "heavysleetshowers", "heavysleetshowersandthunder",
+    "heavysnow", "heavysnowandthunder", "heavysnowshowers", "heavysnowshowersandthunder",
+    "lightrain", "lightrainandthunder", "lightrainshowers", "lightrainshowersandthunder",
+    "lightsleet", "lightsleetandthunder", "lightsleetshowers",
+    "lightsnow", "lightsnowandthunder", "lightsnowshowers",
+    "lightssleetshowersandthunder", "lightssnowshowersandthunder",
+    "partlycloudy", "rain", "rainandthunder", "rainshowers", "rainshowersandthunder",
+    "sleet", "sleetandthunder", "sleetshowers", "sleetshowersandthunder",
+    "snow", "snowandthunder", "snowshowers", "snowshowersandthunder",
+};
+static constexpr uint8_t SYMBOL_COUNT = sizeof(SYMBOLS) / sizeof(SYMBOLS[0]);
+static_assert(SYMBOL_COUNT < 64, "Symbol id must fit in 6 bits");
+
+static const char* const VARIANTS[] = {"", "_day", "_night", "_polartwilight"};
+
+ForecastCache::ForecastCache() {
+    clear();
+}
+
+void ForecastCache::clear() {
+    memset(slots_, 0, sizeof(slots_));
+}
+
+int8_t ForecastCache::find(uint8_t locationId) const {
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        if (slots_[i].used && slots_[i].locationId == locationId) {
+            return (int8_t)i;
+        }
+    }
+    return -1;
+}
+
+void ForecastCache::store(uint8_t locationId, const WeatherForecast& forecast, uint32_t fetchTimeSecs) {
+    int8_t index = find(locationId);
+
+    // Free slot, else least recently used
+    if (index < 0) {
+        index = 0;
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            if (!slots_[i].used) {
+                index = (int8_t)i;
+                break;
+            }
+            if ((int32_t)(slots_[i].lastUsedMs - slots_[index].lastUsedMs) < 0) {
+                index = (int8_t)i;
+            }
+        }
+        if (slots_[index].used) {
+            Serial.printf("[ForecastCache] Evicting location %u\n", slots_[index].locationId);
+        }
+    }
+
+    Slot& slot = slots_[index];
+    pack(forecast, slot.forecast);
+    slot.fetchTimeSecs = fetchTimeSecs;
+    slot.lastUsedMs = millis();
+    slot.locationId = locationId;
+    slot.used = true;
+}
+
+bool ForecastCache::load(uint8_t locationId, WeatherForecast& forecast) {
+    int8_t index = find(locationId);
+    if (index < 0) {
+        forecast.valid = false;
+        forecast.dayCount = 0;
+        return false;
+    }
+    slots_[index].lastUsedMs = millis();
+    unpack(slots_[index].forecast, forecast);
+    return true;
+}
+
+bool ForecastCache::getFetchTime(uint8_t locationId, uint32_t& fetchTimeSecs) const {
+    int8_t index = find(locationId);
+    if (index < 0) return false;
+    fetchTimeSecs = slots_[index].fetchTimeSecs;
+    return true;
+}
+
+// ============================================================================
+// PACKING
+// ============================================================================
+
+static int16_t toTenths(float value) {
+    float scaled = value * 10.0f;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)lroundf(scaled);
+}
+
+void ForecastCache::pack(const WeatherForecast& forecast, CompactForecast& compact) {
+    memset(&compact, 0, sizeof(compact));
+    compact.dayCount = forecast.valid ? forecast.dayCount : 0;
+    if (compact.dayCount > 4) compact.dayCount = 4;
+
+    for (uint8_t i = 0; i < compact.dayCount; i++) {
+        const DailyForecast& src = forecast.days[i];
+        CompactDay& dst = compact.days[i];
+
+        // date is YYYY-MM-DD
+        int year = 0, month = 0, day = 0;
+        sscanf(src.date, "%d-%d-%d", &year, &month, &day);
+        if (i == 0) compact.year = (uint16_t)year;
+        dst.month = (uint8_t)month;
+        dst.day = (uint8_t)day;
+
+        dst.tempMin = toTenths(src.tempMin);
+        dst.tempMax = toTenths(src.tempMax);
+        float humidity = src.humidity < 0.0f ? 0.0f : (src.humidity > 100.0f ? 100.0f : src.humidity);
+        dst.humidity = (uint8_t)lroundf(humidity);
+        dst.symbol = encodeSymbol(src.symbolCode);
+    }
+}
+
+void ForecastCache::unpack(const CompactForecast& compact, WeatherForecast& forecast) {
+    uint16_t year = compact.year;
+    uint8_t prevMonth = 0;
+
+    forecast.dayCount = compact.dayCount;
+    for (uint8_t i = 0; i < compact.dayCount; i++) {
+        const CompactDay& src = compact.days[i];
+        DailyForecast& dst = forecast.days[i];
+
+        if (src.month < prevMonth) year++;  // Dec -> Jan
+        prevMonth = src.month;
+
+        snprintf(dst.date, sizeof(dst.date), "%04u-%02u-%02u", year, src.month, src.day);
+        dst.tempMin = src.tempMin / 10.0f;
+        dst.tempMax = src.tempMax / 10.0f;
+        dst.humidity = src.humidity;
+        decodeSymbol(src.symbol, dst.symbolCode, sizeof(dst.symbolCode));
+        dst.valid = true;
+    }
+    for (uint8_t i = compact.dayCount; i < 4; i++) {
+        forecast.days[i].valid = false;
+    }
+    forecast.valid = compact.dayCount > 0;
+}
+
+uint8_t ForecastCache::encodeSymbol(const char* symbolCode) {
+    if (symbolCode == nullptr || symbolCode[0] == '\0') return 0;
+
+    // Split off the _day/_night/_polartwilight suffix
+    const char* underscore = strchr(symbolCode, '_');
+    size_t baseLen = underscore ? (size_t)(underscore - symbolCode) : strlen(symbolCode);
+    uint8_t variant = 0;
+    if (underscore != nullptr) {
+        for (uint8_t v = 1; v < 4; v++) {
+            if (strcmp(underscore, VARIANTS[v]) == 0) {
+                variant = v;
+                break;
+            }
+        }
+    }
+
+    for (uint8_t i = 0; i < SYMBOL_COUNT; i++) {
+        if (strlen(SYMBOLS[i]) == baseLen && strncmp(SYMBOLS[i], symbolCode, baseLen) == 0) {
+            return (uint8_t)((i + 1) | (variant << 6));
+        }
+    }
+    return 0;
+}
+
+void ForecastCache::decodeSymbol(uint8_t symbol, char* out, size_t size) {
+    uint8_t id = symbol & 0x3F;
+    if (id == 0 || id > SYMBOL_COUNT) {
+        out[0] = '\0';
+        return;
+    }
+    snprintf(out, size, "%s%s", SYMBOLS[id - 1], VARIANTS[symbol >> 6]);
+}
@@ -0,0 +1,66 @@
+#ifndef FORECAST_CACHE_H
+#define FORECAST_CACHE_H
+
+#include <Arduino.h>
+#include "WeatherClient.h"
+
+// One forecast day packed into 8 bytes
+struct CompactDay {
+    uint8_t month;
+    uint8_t day;
+    int16_t tempMin;    // 0.1 °C
+    int16_t tempMax;    // 0.1 °C
+    uint8_t humidity;   // %
+    uint8_t symbol;     // Bits 0-5: base symbol id (0 = none), bits 6-7: variant
+};
+
+// 4-day forecast, 36 bytes (vs ~230 bytes for WeatherForecast)
+struct CompactForecast {
+    uint16_t year;      // Year of the first day (later days may roll over)
+    uint8_t dayCount;
+    CompactDay days[4];
+};
+
+// Fixed-size LRU cache of compact forecasts keyed by a small location id
+//
+// RAM: SLOTS x 48 bytes (compact forecast + id + fetch time + LRU stamp).
+// The least recently read entry is replaced when a new location is stored.
+// Not thread-safe; the owner serializes access.
+class ForecastCache {
+public:
+    static constexpr uint8_t SLOTS = 3;
+
+    ForecastCache();
+
+    // Store (or replace) a location's forecast
+    void store(uint8_t locationId, const WeatherForecast& forecast, uint32_t fetchTimeSecs);
+
+    // Expand a cached forecast; counts as a use for LRU
+    bool load(uint8_t locationId, WeatherForecast& forecast);
+
+    // Fetch time of a cached forecast without touching LRU order
+    bool getFetchTime(uint8_t locationId, uint32_t& fetchTimeSecs) const;
+
+    void clear();
+
+    // Packing helpers
+    static void pack(const WeatherForecast& forecast, CompactForecast& compact);
+    static void unpack(const CompactForecast& compact, WeatherForecast& forecast);
+    static uint8_t encodeSymbol(const char* symbolCode);
+    static void decodeSymbol(uint8_t symbol, char* out, size_t size);
+
+private:
+    struct Slot {
+        CompactForecast forecast;
+        uint32_t fetchTimeSecs;
+        uint32_t lastUsedMs;
+        uint8_t locationId;
+        bool used;
+    };
+
+    Slot slots_[SLOTS];
+
+    int8_t find(uint8_t locationId) const;
+};
+
+#endif // FORECAST_CACHE_H
@@ -2,18 +2,90 @@
 #include <HTTPClient.h>
 #include <ArduinoJson.h>
 #include <WiFiClientSecure.h>
+#include "DnsCache.h"
+#include <Preferences.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+#include <new>
 
-#define TIMEOUT_MS 10000  // HTTP timeout
-
-// Geo providers (primary + fallback)
+// Geo providers (ranked at runtime by latency and success score)
 const char* GEO_PROVIDERS[] = {
     "https://ipwho.is/",
-    "https://ipapi.co/json/"  // fallback
+    "https://ipapi.co/json/"
 };
 const size_t GEO_PROVIDER_COUNT = sizeof(GEO_PROVIDERS) / sizeof(GEO_PROVIDERS[0]);
 
+// At most two requests in flight: best provider + one hedge/fallback
+#define GEO_MAX_ATTEMPTS 2
+
+// Shared between fetchLocation() and the attempt tasks. Whoever drops the
+// last reference frees it, so a losing request can finish after the caller
+// has already returned.
+struct GeoRequest {
+    portMUX_TYPE lock;
+    SemaphoreHandle_t finished;     // Given once per completed attempt
+    uint8_t refs;
+    int8_t winner;                  // Slot whose answer was taken, -1 if none
+    bool cancelled;                 // Caller is done; attempts close their connection
+    GeoLocation result;
+
+    struct Attempt {
+        size_t provider;
+        uint32_t latencyMs;
+        int httpCode;
+        bool launched;
+        bool done;
+        bool ok;
+    } attempts[GEO_MAX_ATTEMPTS];
+};
+
+struct GeoAttemptArgs {
+    GeoLocationClient* client;
+    GeoRequest* request;
+    uint8_t slot;
+};
+
+// Persisted statistics blob
+struct GeoStatsBlob {
+    uint8_t version;
+    uint8_t count;
+    uint32_t providerHash;          // Invalidates stats if the provider list changes
+    GeoProviderStats stats[GEO_PROVIDER_COUNT];
+};
+
+static void releaseRequest(GeoRequest* request) {
+    portENTER_CRITICAL(&request->lock);
+    uint8_t refs = --request->refs;
+    portEXIT_CRITICAL(&request->lock);
+
+    if (refs == 0) {
+        vSemaphoreDelete(request->finished);
+        delete request;
+    }
+}
+
+static bool isCancelled(GeoRequest* request) {
+    portENTER_CRITICAL(&request->lock);
+    bool cancelled = request->cancelled;
+    portEXIT_CRITICAL(&request->lock);
+    return cancelled;
+}
+
+static uint32_t hashProviders() {
+    // FNV-1a over all provider URLs
+    uint32_t hash = 2166136261UL;
+    for (size_t i = 0; i < GEO_PROVIDER_COUNT; ++i) {
+        for (const char* c = GEO_PROVIDERS[i]; *c; ++c) {
+            hash = (hash ^ (uint8_t)*c) * 16777619UL;
+        }
+    }
+    return hash;
+}
+
 GeoLocationClient::GeoLocationClient() : lastHttpCode_(0) {
-    // Constructor
+    static_assert(sizeof(GEO_PROVIDERS) / sizeof(GEO_PROVIDERS[0]) <= MAX_PROVIDERS,
+                  "Too many geolocation providers");
 }
 
 bool GeoLocationClient::fetchLocation(GeoLocation& location) {
@@ -33,58 +105,118 @@ bool GeoLocationClient::fetchLocation(GeoLocation& location) {
         return false;
     }
 
-    // Optional: Force reliable DNS (Google DNS)
-    WiFi.config(
-        WiFi.localIP(),
-        WiFi.gatewayIP(),
-        WiFi.subnetMask(),
-        IPAddress(8, 8, 8, 8),
-        IPAddress(8, 8, 4, 4)
-    );
+    if (!statsLoaded_) {
+        loadStats();
+    }
 
-    WiFiClientSecure client;
-    client.setInsecure();  // Skip TLS verification for simplicity
+    size_t order[MAX_PROVIDERS];
+    rankProviders(order);
 
-    HTTPClient http;
-    http.setTimeout(TIMEOUT_MS);
+    GeoRequest* request = new (std::nothrow) GeoRequest();
+    if (request == nullptr) {
+        Serial.println("[GeoLocation] Out of memory");
+        return false;
+    }
+    portMUX_INITIALIZE(&request->lock);
+    request->finished = xSemaphoreCreateCounting(GEO_MAX_ATTEMPTS, 0);
+    request->refs = 1;  // Caller's reference
+    request->winner = -1;
+    request->cancelled = false;
+    if (request->finished == nullptr) {
+        delete request;
+        Serial.println("[GeoLocation] Out of memory");
+        return false;
+    }
 
-    bool success = false;
+    uint8_t maxAttempts = GEO_PROVIDER_COUNT < GEO_MAX_ATTEMPTS ? GEO_PROVIDER_COUNT : GEO_MAX_ATTEMPTS;
+    uint8_t launched = 0;
+    bool hedged = false;
 
-    // Try all providers until one succeeds
-    for (size_t i = 0; i < GEO_PROVIDER_COUNT; ++i) {
-        const char* url = GEO_PROVIDERS[i];
-        Serial.printf("[GeoLocation] Trying provider: %s\n", url);
+    uint32_t startedAt = millis();
+    uint32_t hedgeAt = getP90Ms(order[0]);
+    uint32_t deadline = 2UL * TIMEOUT_MS + 2000;  // Best case sequential fallback
 
-        if (!http.begin(client, url)) {
-            Serial.println("[GeoLocation] Failed to initialize HTTP client");
-            continue;
+    if (startAttempt(request, 0, order[0])) {
+        launched = 1;
+    }
+
+    while (launched > 0) {
+        uint32_t elapsed = millis() - startedAt;
+
+        portENTER_CRITICAL(&request->lock);
+        bool haveWinner = request->winner >= 0;
+        bool firstFailed = request->attempts[0].done && !request->attempts[0].ok;
+        bool allDone = true;
+        for (uint8_t i = 0; i < launched; ++i) {
+            allDone = allDone && request->attempts[i].done;
         }
+        portEXIT_CRITICAL(&request->lock);
+
+        if (haveWinner) break;
 
-        int httpCode = http.GET();
-        lastHttpCode_ = httpCode;
-        if (httpCode != HTTP_CODE_OK) {
-            Serial.printf("[GeoLocation] HTTP error: %d\n", httpCode);
-            if (httpCode == 429) {
-                Serial.println("[GeoLocation] Rate limited!");
+        // Runner-up: immediately if the best failed, as a hedge once it is past its p90
+        if (launched < maxAttempts && (firstFailed || elapsed >= hedgeAt)) {
+            if (firstFailed || ESP.getFreeHeap() >= HEDGE_MIN_FREE_HEAP) {
+                if (!firstFailed) {
+                    Serial.printf("[GeoLocation] No answer after %lu ms, hedging\n", (unsigned long)elapsed);
+                }
+                if (startAttempt(request, 1, order[1])) {
+                    launched = 2;
+                    hedged = !firstFailed;
+                    if (hedged) hedgeCount_++;
+                    continue;
+                }
             }
-            http.end();
-            continue;
+            // Not enough memory to hedge: fall back only once the first fails
+            hedgeAt = UINT32_MAX;
         }
 
-        String payload = http.getString();
-        http.end();
+        if (allDone && (launched == maxAttempts || hedgeAt == UINT32_MAX)) break;
+        if (elapsed >= deadline) {
+            Serial.println("[GeoLocation] Fetch deadline reached");
+            break;
+        }
+
+        uint32_t wait = deadline - elapsed;
+        if (launched < maxAttempts && hedgeAt > elapsed && hedgeAt - elapsed < wait) {
+            wait = hedgeAt - elapsed;
+        }
+        xSemaphoreTake(request->finished, pdMS_TO_TICKS(wait));
+    }
 
-        Serial.printf("[GeoLocation] Response length: %d bytes\n", payload.length());
-        Serial.printf("[GeoLocation] Free heap after HTTP: %u bytes\n", ESP.getFreeHeap());
+    // Snapshot the outcome; losers still in flight drop their connection at the next check
+    portENTER_CRITICAL(&request->lock);
+    request->cancelled = true;
+    int8_t winner = request->winner;
+    GeoRequest::Attempt attempts[GEO_MAX_ATTEMPTS];
+    memcpy(attempts, request->attempts, sizeof(attempts));
+    if (winner >= 0) {
+        location = request->result;
+    }
+    portEXIT_CRITICAL(&request->lock);
+    releaseRequest(request);
 
-        if (parseResponse(payload, location)) {
-            success = true;
-            break;  // Stop on first success
+    for (uint8_t i = 0; i < launched; ++i) {
+        const GeoRequest::Attempt& attempt = attempts[i];
+        if (attempt.done) {
+            recordResult(attempt.provider, attempt.ok, attempt.latencyMs);
+            lastHttpCode_ = attempt.httpCode;
+        } else if (winner < 0) {
+            // Never answered at all: counts as a failure
+            recordResult(attempt.provider, false, millis() - startedAt);
         }
+        // Unfinished loser: outcome unknown, leave its stats alone
     }
 
+    bool success = winner >= 0;
     if (success) {
-        Serial.printf("[GeoLocation] Success: %.4f, %.4f (%s, %s)\n",
+        lastHttpCode_ = attempts[winner].httpCode;
+        if (hedged && winner == 1) {
+            stats_[attempts[winner].provider].hedgeWins++;
+        }
+        Serial.printf("[GeoLocation] Success via %s in %lu ms: %.4f, %.4f (%s, %s)\n",
+                      GEO_PROVIDERS[attempts[winner].provider],
+                      (unsigned long)attempts[winner].latencyMs,
                       location.latitude,
                       location.longitude,
                       location.city,
@@ -93,9 +225,271 @@ bool GeoLocationClient::fetchLocation(GeoLocation& location) {
         Serial.println("[GeoLocation] All providers failed");
     }
 
+    // Stats are written in batches, not after every fetch
+    unsavedFetches_++;
+    if (unsavedFetches_ >= STATS_SAVE_FETCHES ||
+        millis() - lastStatsSaveMs_ >= STATS_SAVE_INTERVAL_MS) {
+        saveStats();
+    }
+    printStats();
     return success;
 }
 
+// ============================================================================
+// ATTEMPTS
+// ============================================================================
+
+bool GeoLocationClient::startAttempt(GeoRequest* request, uint8_t slot, size_t provider) {
+    GeoAttemptArgs* args = new (std::nothrow) GeoAttemptArgs{this, request, slot};
+    if (args == nullptr) return false;
+
+    portENTER_CRITICAL(&request->lock);
+    request->attempts[slot].provider = provider;
+    request->attempts[slot].launched = true;
+    request->refs++;
+    portEXIT_CRITICAL(&request->lock);
+
+    Serial.printf("[GeoLocation] Trying provider: %s\n", GEO_PROVIDERS[provider]);
+
+    if (xTaskCreate(attemptTask, "GeoAttempt", ATTEMPT_TASK_STACK_SIZE,
+                    args, 1, nullptr) != pdPASS) {
+        Serial.println("[GeoLocation] Failed to create request task");
+        portENTER_CRITICAL(&request->lock);
+        request->attempts[slot].launched = false;
+        portEXIT_CRITICAL(&request->lock);
+        releaseRequest(request);
+        delete args;
+        return false;
+    }
+    return true;
+}
+
+void GeoLocationClient::attemptTask(void* param) {
+    GeoAttemptArgs* args = static_cast<GeoAttemptArgs*>(param);
+    GeoRequest* request = args->request;
+    uint8_t slot = args->slot;
+
+    portENTER_CRITICAL(&request->lock);
+    size_t provider = request->attempts[slot].provider;
+    portEXIT_CRITICAL(&request->lock);
+
+    GeoLocation parsed;
+    int httpCode = 0;
+    uint32_t start = millis();
+    bool ok = args->client->requestProvider(GEO_PROVIDERS[provider], request, parsed, httpCode);
+    uint32_t latency = millis() - start;
+
+    portENTER_CRITICAL(&request->lock);
+    GeoRequest::Attempt& attempt = request->attempts[slot];
+    attempt.latencyMs = latency;
+    attempt.httpCode = httpCode;
+    attempt.ok = ok;
+    attempt.done = true;
+    if (ok && request->winner < 0) {
+        request->winner = slot;
+        request->result = parsed;
+    }
+    portEXIT_CRITICAL(&request->lock);
+
+    xSemaphoreGive(request->finished);
+    releaseRequest(request);
+    delete args;
+    vTaskDelete(nullptr);
+}
+
+bool GeoLocationClient::requestProvider(const char* url, GeoRequest* request,
+                                        GeoLocation& location, int& httpCode) {
+    CachedDnsClient client(dnsCache_);
+    client.setInsecure();  // Skip TLS verification for simplicity
+    httpCode = 0;
+
+    // Connect first so a losing attempt can give up before the request
+    // goes out; HTTPClient reuses the open connection
+    char host[64];
+    const char* start = strstr(url, "://");
+    start = start ? start + 3 : url;
+    size_t hostLen = strcspn(start, "/:");
+    if (hostLen == 0 || hostLen >= sizeof(host)) {
+        return false;
+    }
+    memcpy(host, start, hostLen);
+    host[hostLen] = '\0';
+
+    if (!client.connect(host, 443, TIMEOUT_MS)) {
+        Serial.printf("[GeoLocation] %s connect failed\n", url);
+        return false;
+    }
+    if (isCancelled(request)) {
+        client.stop();
+        return false;
+    }
+
+    HTTPClient http;
+    http.setTimeout(TIMEOUT_MS);
+
+    if (!http.begin(client, url)) {
+        Serial.println("[GeoLocation] Failed to initialize HTTP client");
+        client.stop();
+        return false;
+    }
+
+    httpCode = http.GET();
+    if (isCancelled(request)) {
+        // Answer no longer needed: free the TLS session instead of reading the body
+        http.end();
+        client.stop();
+        return false;
+    }
+    if (httpCode != HTTP_CODE_OK) {
+        Serial.printf("[GeoLocation] %s HTTP error: %d\n", url, httpCode);
+        if (httpCode == 429) {
+            Serial.println("[GeoLocation] Rate limited!");
+        }
+        http.end();
+        return false;
+    }
+
+    String payload = http.getString();
+    http.end();
+
+    Serial.printf("[GeoLocation] %s response length: %d bytes (DNS %lu ms)\n",
+                  url, payload.length(), (unsigned long)client.getLookupMs());
+    return parseResponse(payload, location);
+}
+
+// ============================================================================
+// PROVIDER STATISTICS
+// ============================================================================
+
+size_t GeoLocationClient::getProviderCount() const {
+    return GEO_PROVIDER_COUNT;
+}
+
+const char* GeoLocationClient::getProviderUrl(size_t index) const {
+    return index < GEO_PROVIDER_COUNT ? GEO_PROVIDERS[index] : "";
+}
+
+const GeoProviderStats& GeoLocationClient::getProviderStats(size_t index) const {
+    return stats_[index < GEO_PROVIDER_COUNT ? index : 0];
+}
+
+uint32_t GeoLocationClient::getP90Ms(size_t index) const {
+    const GeoProviderStats& s = getProviderStats(index);
+    if (s.successes == 0) return DEFAULT_P90_MS;
+
+    // Mean + 2 x mean deviation is a slightly generous p90 for skewed latencies
+    uint32_t p90 = s.latencyMs + 2 * s.latencyDevMs;
+    if (p90 < MIN_HEDGE_DELAY_MS) p90 = MIN_HEDGE_DELAY_MS;
+    if (p90 > (uint32_t)TIMEOUT_MS) p90 = TIMEOUT_MS;
+    return p90;
+}
+
+void GeoLocationClient::rankProviders(size_t* order) const {
+    // Expected cost = latency / success rate; ties keep configured order
+    uint32_t cost[MAX_PROVIDERS];
+    for (size_t i = 0; i < GEO_PROVIDER_COUNT; ++i) {
+        const GeoProviderStats& s = stats_[i];
+        uint32_t latency = DEFAULT_P90_MS;
+        if (s.successes > 0) latency = s.latencyMs;
+        uint8_t score = s.score < 5 ? 5 : s.score;
+        cost[i] = latency * 100 / score;
+        order[i] = i;
+    }
+
+    // Insertion sort (stable, tiny list)
+    for (size_t i = 1; i < GEO_PROVIDER_COUNT; ++i) {
+        size_t current = order[i];
+        size_t j = i;
+        while (j > 0 && cost[order[j - 1]] > cost[current]) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = current;
+    }
+}
+
+void GeoLocationClient::recordResult(size_t provider, bool ok, uint32_t latencyMs) {
+    GeoProviderStats& s = stats_[provider];
+
+    // Score moves a quarter of the way towards 0 or 100, at least one point
+    int16_t diff = (ok ? 100 : 0) - (int16_t)s.score;
+    int16_t step = diff / 4;
+    if (step == 0 && diff != 0) step = diff > 0 ? 1 : -1;
+    s.score = (uint8_t)(s.score + step);
+
+    if (!ok) {
+        if (s.failures < UINT16_MAX) s.failures++;
+        return;
+    }
+
+    // Latency smoothing as in TCP RTT estimation (gain 1/8, deviation 1/4)
+    if (s.successes == 0) {
+        s.latencyMs = latencyMs;
+        s.latencyDevMs = latencyMs / 2;
+    } else {
+        int32_t err = (int32_t)latencyMs - (int32_t)s.latencyMs;
+        int32_t absErr = err < 0 ? -err : err;
+        s.latencyMs = (uint32_t)((int32_t)s.latencyMs + err / 8);
+        s.latencyDevMs = (uint32_t)((int32_t)s.latencyDevMs + (absErr - (int32_t)s.latencyDevMs) / 4);
+    }
+    if (s.successes < UINT16_MAX) s.successes++;
+}
+
+void GeoLocationClient::loadStats() {
+    statsLoaded_ = true;
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, true)) {
+        return;  // Namespace not created yet
+    }
+
+    GeoStatsBlob blob;
+    size_t len = prefs.getBytes(KEY_STATS, &blob, sizeof(blob));
+    prefs.end();
+
+    if (len != sizeof(blob) || blob.version != STATS_VERSION ||
+        blob.count != GEO_PROVIDER_COUNT || blob.providerHash != hashProviders()) {
+        Serial.println("[GeoLocation] No saved provider stats");
+        return;
+    }
+
+    for (size_t i = 0; i < GEO_PROVIDER_COUNT; ++i) {
+        stats_[i] = blob.stats[i];
+    }
+    Serial.println("[GeoLocation] Loaded provider stats");
+}
+
+void GeoLocationClient::saveStats() {
+    unsavedFetches_ = 0;
+    lastStatsSaveMs_ = millis();
+
+    GeoStatsBlob blob;
+    blob.version = STATS_VERSION;
+    blob.count = GEO_PROVIDER_COUNT;
+    blob.providerHash = hashProviders();
+    for (size_t i = 0; i < GEO_PROVIDER_COUNT; ++i) {
+        blob.stats[i] = stats_[i];
+    }
+
+    Preferences prefs;
+    if (!prefs.begin(NVS_NAMESPACE, false)) {
+        Serial.println("[GeoLocation] Failed to open NVS for stats");
+        return;
+    }
+    prefs.putBytes(KEY_STATS, &blob, sizeof(blob));
+    prefs.end();
+}
+
+void GeoLocationClient::printStats() const {
+    for (size_t i = 0; i < GEO_PROVIDER_COUNT; ++i) {
+        const GeoProviderStats& s = stats_[i];
+        Serial.printf("[GeoLocation] %s: score %u, avg %lu ms, p90 %lu ms, ok %u, fail %u, hedge wins %u\n",
+                      GEO_PROVIDERS[i], s.score,
+                      (unsigned long)s.latencyMs, (unsigned long)getP90Ms(i),
+                      s.successes, s.failures, s.hedgeWins);
+    }
+}
+
 bool GeoLocationClient::parseResponse(const String& json, GeoLocation& location) {
     StaticJsonDocument<1024> doc;
     DeserializationError error = deserializeJson(doc, json);
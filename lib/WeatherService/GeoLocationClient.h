@@ -13,7 +13,26 @@ struct GeoLocation {
     bool valid = false;
 };
 
+// Running statistics for one geolocation provider (persisted in NVS)
+struct GeoProviderStats {
+    uint32_t latencyMs = 0;     // Smoothed response time of successful requests
+    uint32_t latencyDevMs = 0;  // Smoothed absolute deviation of response time
+    uint16_t successes = 0;
+    uint16_t failures = 0;
+    uint16_t hedgeWins = 0;     // Answers won as the hedged (second) request
+    uint8_t score = 50;         // Smoothed success rate, 0-100
+};
+
+// Shared state of one fetch, owned jointly by the caller and attempt tasks
+struct GeoRequest;
+class DnsCache;
+
 // Client for fetching approximate location using IP address
+//
+// Providers are ranked by expected latency weighted by success score. The
+// best one is tried first; if it has not answered within its p90 latency,
+// a hedged request to the runner-up is started on its own connection and
+// the first valid answer wins.
 class GeoLocationClient {
 public:
     GeoLocationClient();
@@ -26,17 +45,64 @@ public:
     // Get last HTTP response code (for error diagnostics)
     int getLastHttpCode() const { return lastHttpCode_; }
 
+    // Resolve hostnames through a shared DNS cache (nullptr = lwIP directly)
+    void setDnsCache(DnsCache* cache) { dnsCache_ = cache; }
+
+    // Provider statistics
+    size_t getProviderCount() const;
+    const char* getProviderUrl(size_t index) const;
+    const GeoProviderStats& getProviderStats(size_t index) const;
+    uint32_t getP90Ms(size_t index) const;
+    uint16_t getHedgeCount() const { return hedgeCount_; }
+    void printStats() const;
+
 private:
     int lastHttpCode_ = 0;
+    DnsCache* dnsCache_ = nullptr;
+    uint16_t hedgeCount_ = 0;
+    bool statsLoaded_ = false;
+    uint8_t unsavedFetches_ = 0;
+    uint32_t lastStatsSaveMs_ = 0;
+
+    static constexpr size_t MAX_PROVIDERS = 4;
+    GeoProviderStats stats_[MAX_PROVIDERS];
+
     // Parse JSON response from geolocation API
     bool parseResponse(const String& json, GeoLocation& location);
 
+    // Single blocking request to one provider (runs in an attempt task)
+    // Gives up and closes its connection once the request is cancelled
+    bool requestProvider(const char* url, GeoRequest* request, GeoLocation& location, int& httpCode);
+
+    // Attempt tasks
+    static void attemptTask(void* param);
+    bool startAttempt(GeoRequest* request, uint8_t slot, size_t provider);
+
+    // Ranking and statistics
+    void rankProviders(size_t* order) const;
+    void recordResult(size_t provider, bool ok, uint32_t latencyMs);
+    void loadStats();
+    void saveStats();
+
     // API endpoint (no key required) - using ipwho.is
     // Automatically uses client's public IP when no IP is specified
     static constexpr const char* API_URL = "https://ipwho.is/";
 
     // HTTP timeout in milliseconds
     static constexpr int TIMEOUT_MS = 10000;
+
+    // Hedging
+    static constexpr uint32_t DEFAULT_P90_MS = 3000;       // Before any samples
+    static constexpr uint32_t MIN_HEDGE_DELAY_MS = 800;    // Never hedge sooner
+    static constexpr uint32_t HEDGE_MIN_FREE_HEAP = 60000; // Second TLS session + task
+    static constexpr size_t ATTEMPT_TASK_STACK_SIZE = 8192;
+
+    // NVS persistence
+    static constexpr const char* NVS_NAMESPACE = "geo";
+    static constexpr const char* KEY_STATS = "stats";
+    static constexpr uint8_t STATS_VERSION = 1;
+    static constexpr uint8_t STATS_SAVE_FETCHES = 4;                    // Save after this many fetches
+    static constexpr uint32_t STATS_SAVE_INTERVAL_MS = 6UL * 3600000UL; // ...or this long since the last save
 };
 
 #endif // GEO_LOCATION_CLIENT_H
@@ -0,0 +1,438 @@
+#include "MetForecastScanner.h"
+#include <string.h>
+
+static inline bool isJsonSpace(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Bytes that matter while skipping a container
+static inline bool isStructural(char c) {
+    switch (c) {
+        case '"': case '{': case '}': case '[': case ']':
+            return true;
+        default:
+            return false;
+    }
+}
+
+MetForecastScanner::MetForecastScanner() {
+    reset(nullptr, nullptr);
+}
+
+void MetForecastScanner::reset(MetSampleCallback callback, void* context) {
+    callback_ = callback;
+    context_ = context;
+    state_ = State::EXPECT_VALUE;
+    depth_ = 0;
+    pendingNode_ = Node::ROOT;
+    pendingField_ = Field::NONE;
+    keyLen_ = 0;
+    keyTooLong_ = false;
+    capture_ = nullptr;
+    captureSize_ = 0;
+    captureLen_ = 0;
+    escape_ = false;
+    numNegative_ = false;
+    numValid_ = false;
+    numDot_ = false;
+    numInt_ = 0;
+    numFracDigits_ = 0;
+    numFrac_[0] = numFrac_[1] = 0;
+    skipDepth_ = 0;
+    sample_ = MetSample();
+    entries_ = 0;
+    bytes_ = 0;
+}
+
+bool MetForecastScanner::feed(const char* data, size_t len) {
+    size_t pos = 0;
+    while (pos < len && state_ != State::DONE && state_ != State::ERROR) {
+        pos = step(data, pos, len);
+    }
+    bytes_ += pos;
+    return state_ != State::DONE && state_ != State::ERROR;
+}
+
+// ============================================================================
+// STATE MACHINE
+// ============================================================================
+
+size_t MetForecastScanner::step(const char* data, size_t pos, size_t len) {
+    char c = data[pos];
+
+    switch (state_) {
+        case State::EXPECT_VALUE:
+        case State::EXPECT_ELEMENT_OR_END:
+            if (isJsonSpace(c)) return pos + 1;
+            if (c == ']' && state_ == State::EXPECT_ELEMENT_OR_END) {
+                closeContainer();
+                return pos + 1;
+            }
+            beginValue(c);
+            // Numbers and literals read their first byte themselves
+            return (state_ == State::IN_NUMBER || state_ == State::IN_LITERAL) ? pos : pos + 1;
+
+        case State::EXPECT_KEY_OR_END:
+        case State::EXPECT_KEY:
+            if (isJsonSpace(c)) return pos + 1;
+            if (c == '}' && state_ == State::EXPECT_KEY_OR_END) {
+                closeContainer();
+                return pos + 1;
+            }
+            if (c != '"') {
+                state_ = State::ERROR;
+                return pos;
+            }
+            keyLen_ = 0;
+            keyTooLong_ = false;
+            escape_ = false;
+            state_ = State::IN_KEY;
+            return pos + 1;
+
+        case State::IN_KEY:
+            for (; pos < len; ++pos) {
+                c = data[pos];
+                if (escape_) {
+                    escape_ = false;
+                } else if (c == '\\') {
+                    escape_ = true;
+                    continue;
+                } else if (c == '"') {
+                    key_[keyLen_] = '\0';
+                    state_ = State::EXPECT_COLON;
+                    return pos + 1;
+                }
+                if (keyLen_ + 1 < KEY_SIZE) {
+                    key_[keyLen_++] = c;
+                } else {
+                    keyTooLong_ = true;
+                }
+            }
+            return pos;
+
+        case State::EXPECT_COLON:
+            if (isJsonSpace(c)) return pos + 1;
+            if (c != ':') {
+                state_ = State::ERROR;
+                return pos;
+            }
+            resolveKey();
+            state_ = State::EXPECT_VALUE;
+            return pos + 1;
+
+        case State::AFTER_VALUE:
+            if (isJsonSpace(c)) return pos + 1;
+            if (c == ',') {
+                if (top() == Node::TIMESERIES) {
+                    pendingNode_ = Node::ENTRY;
+                    pendingField_ = Field::NONE;
+                    state_ = State::EXPECT_VALUE;
+                } else {
+                    state_ = State::EXPECT_KEY;
+                }
+            } else if ((c == '}' && top() != Node::TIMESERIES) ||
+                       (c == ']' && top() == Node::TIMESERIES)) {
+                closeContainer();
+            } else {
+                state_ = State::ERROR;
+            }
+            return pos + 1;
+
+        case State::IN_STRING: {
+            if (capture_ == nullptr) {
+                bool closed = false;
+                pos = scanString(data, pos, len, closed);
+                if (closed) endValue();
+                return pos;
+            }
+            for (; pos < len; ++pos) {
+                c = data[pos];
+                if (escape_) {
+                    escape_ = false;
+                } else if (c == '\\') {
+                    escape_ = true;
+                    continue;
+                } else if (c == '"') {
+                    capture_[captureLen_] = '\0';
+                    if (pendingField_ == Field::SYMBOL) {
+                        sample_.hasSymbol = true;
+                    }
+                    endValue();
+                    return pos + 1;
+                }
+                if (captureLen_ + 1 < captureSize_) {
+                    capture_[captureLen_++] = c;
+                }
+            }
+            return pos;
+        }
+
+        case State::IN_NUMBER:
+            for (; pos < len; ++pos) {
+                c = data[pos];
+                if (c >= '0' && c <= '9') {
+                    if (!numDot_) {
+                        if (numInt_ < 100000) {
+                            numInt_ = numInt_ * 10 + (c - '0');
+                        } else {
+                            numValid_ = false;
+                        }
+                    } else if (numFracDigits_ < 2) {
+                        numFrac_[numFracDigits_++] = (uint8_t)(c - '0');
+                    }
+                } else if (c == '-') {
+                    numNegative_ = true;
+                } else if (c == '.') {
+                    numDot_ = true;
+                } else if (c == 'e' || c == 'E' || c == '+') {
+                    numValid_ = false;  // Exponents never appear in this feed
+                } else {
+                    finishNumber();
+                    endValue();
+                    return pos;  // Delimiter handled by AFTER_VALUE
+                }
+            }
+            return pos;
+
+        case State::IN_LITERAL:
+            for (; pos < len; ++pos) {
+                c = data[pos];
+                if (c < 'a' || c > 'z') {
+                    endValue();
+                    return pos;
+                }
+            }
+            return pos;
+
+        case State::SKIP_CONTAINER:
+            for (; pos < len; ++pos) {
+                c = data[pos];
+                if (!isStructural(c)) continue;
+
+                if (c == '"') {
+                    escape_ = false;
+                    state_ = State::SKIP_CONTAINER_STRING;
+                    return pos + 1;
+                }
+                if (c == '{' || c == '[') {
+                    skipDepth_++;
+                } else if (--skipDepth_ == 0) {
+                    endValue();
+                    return pos + 1;
+                }
+            }
+            return pos;
+
+        case State::SKIP_CONTAINER_STRING: {
+            bool closed = false;
+            pos = scanString(data, pos, len, closed);
+            if (closed) state_ = State::SKIP_CONTAINER;
+            return pos;
+        }
+
+        case State::DONE:
+        case State::ERROR:
+        default:
+            return len;
+    }
+}
+
+// Skip string contents with memchr; returns position after the closing quote
+size_t MetForecastScanner::scanString(const char* data, size_t pos, size_t len, bool& closed) {
+    closed = false;
+    while (pos < len) {
+        if (escape_) {
+            escape_ = false;
+            pos++;
+            continue;
+        }
+
+        const char* start = data + pos;
+        const char* quote = (const char*)memchr(start, '"', len - pos);
+        size_t span = quote ? (size_t)(quote - start) : len - pos;
+        const char* backslash = (const char*)memchr(start, '\\', span);
+
+        if (backslash) {
+            pos = (size_t)(backslash - data) + 1;
+            escape_ = true;
+            continue;
+        }
+        if (!quote) {
+            return len;
+        }
+        closed = true;
+        return (size_t)(quote - data) + 1;
+    }
+    return pos;
+}
+
+void MetForecastScanner::beginValue(char c) {
+    Node node = pendingNode_;
+    Field field = pendingField_;
+
+    // A forecast document is an object; any other root has no path to track
+    if (depth_ == 0 && c != '{') {
+        state_ = State::ERROR;
+        return;
+    }
+
+    switch (c) {
+        case '{':
+            if (node != Node::NONE && node != Node::TIMESERIES) {
+                if (!push(node)) return;
+                if (node == Node::ENTRY) {
+                    sample_ = MetSample();
+                }
+                state_ = State::EXPECT_KEY_OR_END;
+            } else {
+                skipDepth_ = 1;
+                state_ = State::SKIP_CONTAINER;
+            }
+            break;
+
+        case '[':
+            if (node == Node::TIMESERIES) {
+                if (!push(node)) return;
+                pendingNode_ = Node::ENTRY;
+                pendingField_ = Field::NONE;
+                state_ = State::EXPECT_ELEMENT_OR_END;
+            } else {
+                skipDepth_ = 1;
+                state_ = State::SKIP_CONTAINER;
+            }
+            break;
+
+        case '"':
+            escape_ = false;
+            captureLen_ = 0;
+            if (field == Field::TIME) {
+                capture_ = sample_.time;
+                captureSize_ = sizeof(sample_.time);
+            } else if (field == Field::SYMBOL) {
+                capture_ = sample_.symbol;
+                captureSize_ = sizeof(sample_.symbol);
+            } else {
+                capture_ = nullptr;
+                captureSize_ = 0;
+            }
+            state_ = State::IN_STRING;
+            break;
+
+        case '-':
+        case '0': case '1': case '2': case '3': case '4':
+        case '5': case '6': case '7': case '8': case '9':
+            numNegative_ = false;
+            numValid_ = (field == Field::TEMPERATURE || field == Field::HUMIDITY);
+            numDot_ = false;
+            numInt_ = 0;
+            numFracDigits_ = 0;
+            numFrac_[0] = numFrac_[1] = 0;
+            state_ = State::IN_NUMBER;
+            break;
+
+        case 't':
+        case 'f':
+        case 'n':
+            state_ = State::IN_LITERAL;
+            break;
+
+        default:
+            state_ = State::ERROR;
+            break;
+    }
+}
+
+void MetForecastScanner::endValue() {
+    pendingNode_ = Node::NONE;
+    pendingField_ = Field::NONE;
+    capture_ = nullptr;
+    state_ = State::AFTER_VALUE;
+}
+
+void MetForecastScanner::closeContainer() {
+    Node closed = top();
+    pop();
+
+    if (closed == Node::ENTRY) {
+        entries_++;
+        if (callback_ != nullptr && !callback_(sample_, context_)) {
+            state_ = State::DONE;  // Caller has what it needs
+            return;
+        }
+    }
+
+    if (depth_ == 0) {
+        state_ = State::DONE;
+    } else {
+        endValue();
+    }
+}
+
+void MetForecastScanner::finishNumber() {
+    if (!numValid_) return;
+
+    // Tenths, rounded on the second decimal
+    int32_t value = numInt_ * 10 + numFrac_[0] + (numFrac_[1] >= 5 ? 1 : 0);
+    if (numNegative_) value = -value;
+    if (value > INT16_MAX) value = INT16_MAX;
+    if (value < INT16_MIN) value = INT16_MIN;
+
+    if (pendingField_ == Field::TEMPERATURE) {
+        sample_.temperature = (int16_t)value;
+        sample_.hasTemperature = true;
+    } else if (pendingField_ == Field::HUMIDITY) {
+        sample_.humidity = (int16_t)value;
+        sample_.hasHumidity = true;
+    }
+}
+
+void MetForecastScanner::resolveKey() {
+    pendingNode_ = Node::NONE;
+    pendingField_ = Field::NONE;
+    if (keyTooLong_) return;
+
+    switch (top()) {
+        case Node::ROOT:
+            if (strcmp(key_, "properties") == 0) pendingNode_ = Node::PROPERTIES;
+            break;
+        case Node::PROPERTIES:
+            if (strcmp(key_, "timeseries") == 0) pendingNode_ = Node::TIMESERIES;
+            break;
+        case Node::ENTRY:
+            if (strcmp(key_, "time") == 0) pendingField_ = Field::TIME;
+            else if (strcmp(key_, "data") == 0) pendingNode_ = Node::DATA;
+            break;
+        case Node::DATA:
+            if (strcmp(key_, "instant") == 0) pendingNode_ = Node::INSTANT;
+            else if (strcmp(key_, "next_1_hours") == 0) pendingNode_ = Node::NEXT_1H;
+            break;
+        case Node::INSTANT:
+            if (strcmp(key_, "details") == 0) pendingNode_ = Node::DETAILS;
+            break;
+        case Node::DETAILS:
+            if (strcmp(key_, "air_temperature") == 0) pendingField_ = Field::TEMPERATURE;
+            else if (strcmp(key_, "relative_humidity") == 0) pendingField_ = Field::HUMIDITY;
+            break;
+        case Node::NEXT_1H:
+            if (strcmp(key_, "summary") == 0) pendingNode_ = Node::SUMMARY;
+            break;
+        case Node::SUMMARY:
+            if (strcmp(key_, "symbol_code") == 0) pendingField_ = Field::SYMBOL;
+            break;
+        default:
+            break;
+    }
+}
+
+bool MetForecastScanner::push(Node node) {
+    if (depth_ >= MAX_DEPTH) {
+        state_ = State::ERROR;
+        return false;
+    }
+    stack_[depth_++] = node;
+    return true;
+}
+
+void MetForecastScanner::pop() {
+    if (depth_ > 0) depth_--;
+}
@@ -0,0 +1,124 @@
+#ifndef MET_FORECAST_SCANNER_H
+#define MET_FORECAST_SCANNER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// One entry of properties.timeseries[] with only the fields we use
+struct MetSample {
+    char time[21] = {0};        // ISO8601, e.g. 2024-05-01T12:00:00Z
+    char symbol[32] = {0};      // next_1_hours.summary.symbol_code
+    int16_t temperature = 0;    // air_temperature, 0.1 °C
+    int16_t humidity = 0;       // relative_humidity, 0.1 %
+    bool hasTemperature = false;
+    bool hasHumidity = false;
+    bool hasSymbol = false;
+};
+
+// Called once per timeseries entry; return false to stop scanning
+typedef bool (*MetSampleCallback)(const MetSample& sample, void* context);
+
+// Streaming scanner for the MET Norway locationforecast (compact) format
+//
+// Fed arbitrary chunks of the response body. Only the path
+//   properties.timeseries[].{time, data.instant.details.{air_temperature,
+//   relative_humidity}, data.next_1_hours.summary.symbol_code}
+// is tracked; every other object, array and string is skipped by scanning
+// for the next structural byte (memchr for strings), numbers are parsed
+// straight into fixed point, and no document tree is built.
+//
+// No Arduino dependency so it can run on the host as well.
+class MetForecastScanner {
+public:
+    MetForecastScanner();
+
+    // Start a new document
+    void reset(MetSampleCallback callback, void* context);
+
+    // Feed the next chunk; returns false once scanning stopped (done, error
+    // or the callback asked to stop) - further input is ignored
+    bool feed(const char* data, size_t len);
+
+    bool isDone() const { return state_ == State::DONE; }
+    bool hasError() const { return state_ == State::ERROR; }
+    uint16_t getEntryCount() const { return entries_; }
+    size_t getBytesScanned() const { return bytes_; }
+
+private:
+    // Nodes along the tracked path; anything else is skipped wholesale
+    enum class Node : uint8_t {
+        ROOT, PROPERTIES, TIMESERIES, ENTRY, DATA, INSTANT, DETAILS, NEXT_1H, SUMMARY, NONE
+    };
+
+    enum class Field : uint8_t { NONE, TIME, TEMPERATURE, HUMIDITY, SYMBOL };
+
+    enum class State : uint8_t {
+        EXPECT_VALUE,
+        EXPECT_ELEMENT_OR_END,  // After '['
+        EXPECT_KEY_OR_END,      // After '{'
+        EXPECT_KEY,             // After ',' in an object
+        IN_KEY,
+        EXPECT_COLON,
+        AFTER_VALUE,
+        IN_STRING,
+        IN_NUMBER,
+        IN_LITERAL,
+        SKIP_CONTAINER,
+        SKIP_CONTAINER_STRING,
+        DONE,
+        ERROR
+    };
+
+    static constexpr uint8_t MAX_DEPTH = 8;
+    static constexpr uint8_t KEY_SIZE = 24;
+
+    MetSampleCallback callback_;
+    void* context_;
+
+    State state_;
+    Node stack_[MAX_DEPTH];
+    uint8_t depth_;
+
+    // Value about to start
+    Node pendingNode_;
+    Field pendingField_;
+
+    // Key being read
+    char key_[KEY_SIZE];
+    uint8_t keyLen_;
+    bool keyTooLong_;
+
+    // String value being read (captured only for TIME/SYMBOL)
+    char* capture_;
+    uint8_t captureSize_;
+    uint8_t captureLen_;
+    bool escape_;
+
+    // Number being read (fixed point, 0.1 units)
+    bool numNegative_;
+    bool numValid_;
+    bool numDot_;
+    int32_t numInt_;
+    uint8_t numFracDigits_;
+    uint8_t numFrac_[2];
+
+    // Skipped container depth
+    uint16_t skipDepth_;
+
+    MetSample sample_;
+    uint16_t entries_;
+    size_t bytes_;
+
+    size_t step(const char* data, size_t pos, size_t len);
+    void beginValue(char c);
+    void endValue();
+    void closeContainer();
+    void resolveKey();
+    void finishNumber();
+    bool push(Node node);
+    void pop();
+    Node top() const { return depth_ > 0 ? stack_[depth_ - 1] : Node::NONE; }
+    size_t scanString(const char* data, size_t pos, size_t len, bool& closed);
+};
+
+#endif // MET_FORECAST_SCANNER_H
@@ -1,9 +1,12 @@
 #include "WeatherClient.h"
 #include <HTTPClient.h>
-#include <ArduinoJson.h>
 #include <WiFiClientSecure.h>
-#include <map>
-#include <vector>
+#include "DnsCache.h"
+#include "InflateStream.h"
+#include "MetForecastScanner.h"
+#ifdef WEATHER_USE_ARDUINOJSON
+#include <ArduinoJson.h>
+#endif
 
 WeatherClient::WeatherClient() : lastHttpCode_(0) {
     // Constructor
@@ -36,24 +39,37 @@ bool WeatherClient::fetchForecast(float latitude, float longitude, WeatherForeca
     char url[256];
     snprintf(url, sizeof(url), "%s?lat=%.4f&lon=%.4f", API_URL, latitude, longitude);
 
-    WiFiClientSecure client;
+    CachedDnsClient client(dnsCache_);
     client.setInsecure();  // Skip TLS verification
 
     HTTPClient http;
     http.setTimeout(TIMEOUT_MS);
+    http.useHTTP10(true);  // No chunked framing - body is decoded straight off the socket
 
     if (!http.begin(client, url)) {
         Serial.println("[Weather] Failed to initialize HTTP client");
         return false;
     }
 
-    // Set required User-Agent header
-    http.addHeader("User-Agent", USER_AGENT);
+    // Set required User-Agent header (addHeader() drops User-Agent)
+    http.setUserAgent(USER_AGENT);
+
+    // Only ask for gzip if the inflate window fits in the heap right now
+    InflateStream body;
+    bool gzipReady = body.reserve();
+    if (gzipReady) {
+        http.addHeader("Accept-Encoding", "gzip");
+    }
+    const char* headerKeys[] = {"Content-Encoding", "Expires"};
+    http.collectHeaders(headerKeys, 2);
 
     Serial.printf("[Weather] GET %s\n", url);
 
+    uint32_t requestStart = millis();
     int httpCode = http.GET();
     lastHttpCode_ = httpCode;
+    Serial.printf("[Weather] Response after %lu ms (DNS %lu ms)\n",
+                  (unsigned long)(millis() - requestStart), (unsigned long)client.getLookupMs());
 
     if (httpCode != HTTP_CODE_OK) {
         Serial.printf("[Weather] HTTP error: %d\n", httpCode);
@@ -66,17 +82,32 @@ bool WeatherClient::fetchForecast(float latitude, float longitude, WeatherForeca
         return false;
     }
 
-    String payload = http.getString();
+    bool gzip = http.header("Content-Encoding").equalsIgnoreCase("gzip");
+    uint32_t expires = parseHttpDate(http.header("Expires").c_str());
+    if (!gzip) {
+        body.end();  // Server sent identity - free the window before parsing
+    }
+
+    // Parse while downloading - no full copy of the payload is kept
+    body.begin(http.getStream(), gzip, http.getSize(), TIMEOUT_MS);
+    bool success = parseResponse(body, forecast) && !body.hasError();
     http.end();
 
-    Serial.printf("[Weather] Response length: %d bytes\n", payload.length());
-    Serial.printf("[Weather] Free heap after HTTP: %u bytes\n", ESP.getFreeHeap());
+    lastWireBytes_ = body.getWireBytes();
+    lastBodyBytes_ = body.getDecodedBytes();
+    lastFetchMs_ = millis() - requestStart;
+    lastGzip_ = gzip;
+    body.end();
 
-    // Parse the JSON response
-    bool success = parseResponse(payload, forecast);
+    Serial.printf("[Weather] Body: %u bytes on the wire, %u decoded (%s), %lu ms total\n",
+                  (unsigned)lastWireBytes_, (unsigned)lastBodyBytes_,
+                  gzip ? "gzip" : "identity", (unsigned long)lastFetchMs_);
+    Serial.printf("[Weather] Free heap after HTTP: %u bytes\n", ESP.getFreeHeap());
 
     if (success) {
-        Serial.printf("[Weather] Success! Parsed %d days\n", forecast.dayCount);
+        lastExpires_ = expires;
+        Serial.printf("[Weather] Success! Parsed %d days (expires %lu)\n",
+                      forecast.dayCount, (unsigned long)expires);
         for (int i = 0; i < forecast.dayCount; i++) {
             Serial.printf("[Weather] Day %d: %s | %.1f-%.1f°C | %.0f%% | %s\n",
                           i,
@@ -93,9 +124,204 @@ bool WeatherClient::fetchForecast(float latitude, float longitude, WeatherForeca
     return success;
 }
 
-bool WeatherClient::parseResponse(const String& json, WeatherForecast& forecast) {
-    // MET Norway API returns large JSON (~40KB)
-    // Use filter to only extract needed fields for memory efficiency
+uint32_t WeatherClient::parseHttpDate(const char* date) {
+    static const char* const MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+
+    int day, year, hour, minute, second;
+    char month[4] = {0};
+    if (date == nullptr ||
+        sscanf(date, "%*3s, %d %3s %d %d:%d:%d", &day, month, &year, &hour, &minute, &second) != 6) {
+        return 0;
+    }
+
+    const char* found = strstr(MONTHS, month);
+    if (found == nullptr || strlen(month) != 3 || (found - MONTHS) % 3 != 0 || year < 1970) {
+        return 0;
+    }
+    int mon = (int)(found - MONTHS) / 3 + 1;
+
+    // Days since 1970-01-01 (proleptic Gregorian, no timegm() dependency)
+    int y = year - (mon <= 2 ? 1 : 0);
+    int era = y / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (mon + (mon > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    int32_t days = era * 146097 + doe - 719468;
+
+    return (uint32_t)days * 86400UL + hour * 3600UL + minute * 60UL + second;
+}
+
+// ============================================================================
+// DAILY AGGREGATION
+// ============================================================================
+
+namespace {
+
+// Per-day running totals, fixed size (no heap)
+struct DayAccumulator {
+    static constexpr uint8_t MAX_SYMBOLS = 8;
+
+    char date[11];
+    int16_t tempMin;          // 0.1 °C
+    int16_t tempMax;
+    int32_t humiditySum;      // 0.1 %
+    uint16_t humidityCount;
+    uint16_t sampleCount;
+    char symbols[MAX_SYMBOLS][32];
+    uint8_t symbolCounts[MAX_SYMBOLS];
+    uint8_t symbolCount;
+};
+
+// Folds timeseries samples into at most 4 days
+class ForecastBuilder {
+public:
+    ForecastBuilder() : dayCount_(0), entries_(0) {}
+
+    // Returns false once a 5th date shows up (nothing more is needed)
+    bool add(const MetSample& sample) {
+        if (sample.time[0] == '\0') return true;
+        entries_++;
+
+        DayAccumulator* day = findDay(sample.time);
+        if (day == nullptr) {
+            if (dayCount_ >= 4) return false;
+            day = &days_[dayCount_++];
+            memset(day, 0, sizeof(*day));
+            memcpy(day->date, sample.time, 10);
+            day->tempMin = INT16_MAX;
+            day->tempMax = INT16_MIN;
+        }
+
+        if (sample.hasTemperature || sample.hasHumidity) {
+            day->sampleCount++;
+        }
+        if (sample.hasTemperature) {
+            if (sample.temperature < day->tempMin) day->tempMin = sample.temperature;
+            if (sample.temperature > day->tempMax) day->tempMax = sample.temperature;
+        }
+        if (sample.hasHumidity) {
+            day->humiditySum += sample.humidity;
+            day->humidityCount++;
+        }
+        if (sample.hasSymbol) {
+            addSymbol(*day, sample.symbol);
+        }
+        return true;
+    }
+
+    void finish(WeatherForecast& forecast) const {
+        forecast.dayCount = 0;
+        for (uint8_t i = 0; i < dayCount_; i++) {
+            const DayAccumulator& acc = days_[i];
+            if (acc.sampleCount == 0) continue;
+
+            DailyForecast& day = forecast.days[forecast.dayCount];
+            strncpy(day.date, acc.date, sizeof(day.date) - 1);
+            day.date[sizeof(day.date) - 1] = '\0';
+
+            if (acc.tempMin <= acc.tempMax) {
+                day.tempMin = acc.tempMin / 10.0f;
+                day.tempMax = acc.tempMax / 10.0f;
+            }
+            if (acc.humidityCount > 0) {
+                day.humidity = acc.humiditySum / (10.0f * acc.humidityCount);
+            }
+
+            // Most common symbol; ties go to the alphabetically first
+            int best = -1;
+            for (uint8_t s = 0; s < acc.symbolCount; s++) {
+                if (best < 0 || acc.symbolCounts[s] > acc.symbolCounts[best] ||
+                    (acc.symbolCounts[s] == acc.symbolCounts[best] &&
+                     strcmp(acc.symbols[s], acc.symbols[best]) < 0)) {
+                    best = s;
+                }
+            }
+            if (best >= 0) {
+                strncpy(day.symbolCode, acc.symbols[best], sizeof(day.symbolCode) - 1);
+                day.symbolCode[sizeof(day.symbolCode) - 1] = '\0';
+            }
+
+            day.valid = true;
+            forecast.dayCount++;
+        }
+        forecast.valid = (forecast.dayCount > 0);
+    }
+
+    uint16_t getEntryCount() const { return entries_; }
+
+    static bool onSample(const MetSample& sample, void* context) {
+        return static_cast<ForecastBuilder*>(context)->add(sample);
+    }
+
+private:
+    DayAccumulator days_[4];
+    uint8_t dayCount_;
+    uint16_t entries_;
+
+    DayAccumulator* findDay(const char* timestamp) {
+        for (uint8_t i = 0; i < dayCount_; i++) {
+            if (strncmp(days_[i].date, timestamp, 10) == 0) return &days_[i];
+        }
+        return nullptr;
+    }
+
+    static void addSymbol(DayAccumulator& day, const char* symbol) {
+        for (uint8_t s = 0; s < day.symbolCount; s++) {
+            if (strcmp(day.symbols[s], symbol) == 0) {
+                if (day.symbolCounts[s] < UINT8_MAX) day.symbolCounts[s]++;
+                return;
+            }
+        }
+        if (day.symbolCount >= DayAccumulator::MAX_SYMBOLS) return;  // Rare; drop
+        strncpy(day.symbols[day.symbolCount], symbol, sizeof(day.symbols[0]) - 1);
+        day.symbolCounts[day.symbolCount++] = 1;
+    }
+};
+
+} // namespace
+
+// ============================================================================
+// PARSING
+// ============================================================================
+
+#ifndef WEATHER_USE_ARDUINOJSON
+
+bool WeatherClient::parseResponse(InflateStream& body, WeatherForecast& forecast) {
+    // Dedicated scanner: skips everything outside the four fields we use and
+    // stops reading once the 4th day is complete
+    ForecastBuilder builder;
+    MetForecastScanner scanner;
+    scanner.reset(ForecastBuilder::onSample, &builder);
+
+    uint32_t parseStart = micros();
+    char chunk[256];
+    size_t got;
+    while ((got = body.readBytes(chunk, sizeof(chunk))) > 0) {
+        if (!scanner.feed(chunk, got)) break;
+    }
+    lastParseUs_ = micros() - parseStart;
+
+    Serial.printf("[Weather] Scanner: %u entries, %u bytes in %lu us%s\n",
+                  (unsigned)scanner.getEntryCount(), (unsigned)scanner.getBytesScanned(),
+                  (unsigned long)lastParseUs_, scanner.isDone() ? "" : " (incomplete)");
+
+    if (scanner.hasError()) {
+        Serial.println("[Weather] JSON parse error: unexpected token");
+        return false;
+    }
+    if (builder.getEntryCount() == 0) {
+        Serial.println("[Weather] Missing timeseries data");
+        return false;
+    }
+
+    builder.finish(forecast);
+    return forecast.valid;
+}
+
+#else
+
+bool WeatherClient::parseResponse(InflateStream& body, WeatherForecast& forecast) {
+    // Generic path: filtered ArduinoJson document, kept for comparison
     StaticJsonDocument<256> filter;
     filter["properties"]["timeseries"][0]["time"] = true;
     filter["properties"]["timeseries"][0]["data"]["instant"]["details"]["air_temperature"] = true;
@@ -107,7 +333,8 @@ bool WeatherClient::parseResponse(const String& json, WeatherForecast& forecast)
     const size_t capacity = 50000;  // 50KB should be enough for filtered data
     DynamicJsonDocument doc(capacity);
 
-    DeserializationError error = deserializeJson(doc, json, DeserializationOption::Filter(filter));
+    uint32_t parseStart = micros();
+    DeserializationError error = deserializeJson(doc, body, DeserializationOption::Filter(filter));
 
     if (error) {
         Serial.printf("[Weather] JSON parse error: %s\n", error.c_str());
@@ -122,115 +349,40 @@ bool WeatherClient::parseResponse(const String& json, WeatherForecast& forecast)
         return false;
     }
 
-    Serial.printf("[Weather] Timeseries entries: %d\n", timeseries.size());
-
-    // Use maps to aggregate data by date
-    struct DayData {
-        float tempMin = 999.0f;
-        float tempMax = -999.0f;
-        std::vector<float> humidityValues;
-        std::map<String, int> symbolCounts;
-        int sampleCount = 0;
-    };
-
-    std::map<String, DayData> dailyData;
-    String dates[4];
-    int dateCount = 0;
-
-    // Process timeseries entries
+    ForecastBuilder builder;
     for (JsonObject entry : timeseries) {
+        MetSample sample;
         const char* timeStr = entry["time"];
         if (!timeStr) continue;
+        strncpy(sample.time, timeStr, sizeof(sample.time) - 1);
 
-        // Extract date (YYYY-MM-DD) from ISO8601 timestamp
-        String timestamp(timeStr);
-        String date = timestamp.substring(0, 10);
-
-        // Only process first 4 unique dates
-        bool dateExists = false;
-        for (int i = 0; i < dateCount; i++) {
-            if (dates[i] == date) {
-                dateExists = true;
-                break;
-            }
-        }
-
-        if (!dateExists) {
-            if (dateCount >= 4) {
-                break;  // Already have 4 days
-            }
-            dates[dateCount++] = date;
-        }
-
-        // Get instant data
         JsonObject instant = entry["data"]["instant"]["details"];
         if (instant) {
-            float temp = instant["air_temperature"];
-            float humidity = instant["relative_humidity"];
-
-            DayData& day = dailyData[date];
-            day.sampleCount++;
-
-            if (temp < day.tempMin) day.tempMin = temp;
-            if (temp > day.tempMax) day.tempMax = temp;
-            day.humidityValues.push_back(humidity);
-        }
-
-        // Get next_1_hours symbol (most relevant for daily summary)
-        JsonObject next1h = entry["data"]["next_1_hours"];
-        if (next1h) {
-            const char* symbol = next1h["summary"]["symbol_code"];
-            if (symbol) {
-                String symbolStr(symbol);
-                dailyData[date].symbolCounts[symbolStr]++;
-            }
+            sample.temperature = (int16_t)lroundf(instant["air_temperature"].as<float>() * 10.0f);
+            sample.humidity = (int16_t)lroundf(instant["relative_humidity"].as<float>() * 10.0f);
+            sample.hasTemperature = sample.hasHumidity = true;
         }
-    }
-
-    // Convert aggregated data to forecast structure
-    forecast.dayCount = 0;
-    for (int i = 0; i < dateCount && i < 4; i++) {
-        String& date = dates[i];
-        DayData& dayData = dailyData[date];
-
-        if (dayData.sampleCount == 0) continue;
-
-        DailyForecast& day = forecast.days[forecast.dayCount];
-
-        // Copy date
-        strncpy(day.date, date.c_str(), sizeof(day.date) - 1);
 
-        // Temperature
-        day.tempMin = dayData.tempMin;
-        day.tempMax = dayData.tempMax;
-
-        // Average humidity
-        float humiditySum = 0.0f;
-        for (float h : dayData.humidityValues) {
-            humiditySum += h;
-        }
-        day.humidity = humiditySum / dayData.humidityValues.size();
-
-        // Most common symbol
-        String mostCommonSymbol;
-        int maxCount = 0;
-        for (const auto& pair : dayData.symbolCounts) {
-            if (pair.second > maxCount) {
-                maxCount = pair.second;
-                mostCommonSymbol = pair.first;
-            }
+        const char* symbol = entry["data"]["next_1_hours"]["summary"]["symbol_code"];
+        if (symbol) {
+            strncpy(sample.symbol, symbol, sizeof(sample.symbol) - 1);
+            sample.hasSymbol = true;
         }
-        strncpy(day.symbolCode, mostCommonSymbol.c_str(), sizeof(day.symbolCode) - 1);
 
-        day.valid = true;
-        forecast.dayCount++;
+        if (!builder.add(sample)) break;
     }
+    lastParseUs_ = micros() - parseStart;
 
-    forecast.valid = (forecast.dayCount > 0);
+    Serial.printf("[Weather] ArduinoJson: %d entries in %lu us\n",
+                  timeseries.size(), (unsigned long)lastParseUs_);
+
+    builder.finish(forecast);
     return forecast.valid;
 }
 
+#endif // WEATHER_USE_ARDUINOJSON
+
 void WeatherClient::aggregateDailyData(WeatherForecast& forecast) {
     // This method is reserved for future use if additional aggregation is needed
-    // Currently, aggregation is done directly in parseResponse
+    // Currently, aggregation is done by ForecastBuilder while parsing
 }
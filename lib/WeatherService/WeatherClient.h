@@ -3,6 +3,9 @@
 
 #include <Arduino.h>
 
+class DnsCache;
+class InflateStream;
+
 // Daily weather forecast data
 struct DailyForecast {
     char date[11];           // YYYY-MM-DD format
@@ -36,10 +39,39 @@ public:
     // Check if last error was rate limiting (HTTP 429)
     bool wasRateLimited() const { return lastHttpCode_ == 429; }
 
+    // Last download: bytes on the wire, decoded body size, total duration
+    size_t getLastWireBytes() const { return lastWireBytes_; }
+    size_t getLastBodyBytes() const { return lastBodyBytes_; }
+    uint32_t getLastFetchMs() const { return lastFetchMs_; }
+    bool wasLastGzip() const { return lastGzip_; }
+
+    // Expires header of the last successful response (UTC epoch, 0 = none)
+    // MET asks clients not to refetch before this time
+    uint32_t getLastExpires() const { return lastExpires_; }
+
+    // Time spent parsing the last body (µs, includes waiting on the socket)
+    uint32_t getLastParseUs() const { return lastParseUs_; }
+
+    // Resolve hostnames through a shared DNS cache (nullptr = lwIP directly)
+    void setDnsCache(DnsCache* cache) { dnsCache_ = cache; }
+
 private:
     int lastHttpCode_ = 0;
-    // Parse JSON response from MET Norway API
-    bool parseResponse(const String& json, WeatherForecast& forecast);
+    DnsCache* dnsCache_ = nullptr;
+    size_t lastWireBytes_ = 0;
+    size_t lastBodyBytes_ = 0;
+    uint32_t lastFetchMs_ = 0;
+    bool lastGzip_ = false;
+    uint32_t lastParseUs_ = 0;
+    uint32_t lastExpires_ = 0;
+
+    // Parse an RFC 1123 HTTP date ("Tue, 07 May 2024 12:34:56 GMT"); 0 on failure
+    static uint32_t parseHttpDate(const char* date);
+
+    // Parse JSON response from MET Norway API (read incrementally)
+    // Uses MetForecastScanner; build with -DWEATHER_USE_ARDUINOJSON for the
+    // generic ArduinoJson path (same aggregation, for comparison)
+    bool parseResponse(InflateStream& body, WeatherForecast& forecast);
 
     // Aggregate hourly data into daily summaries
     void aggregateDailyData(WeatherForecast& forecast);
@@ -2,10 +2,12 @@
 #define WEATHER_ICONS_H
 
 #include <Arduino.h>
+#include "PageAsset.h"
 
 // ============================================================================
 // Weather Icons (8x8 pixels) for OLED display
 // Based on MET Norway / yr.no symbol codes
+// Row-major sources; only the transcoded icons below reach flash
 // ============================================================================
 
 // Clear sky - Sun icon
@@ -17,7 +19,7 @@
 //   ░░░█░░░░
 //   ░░█░░█░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_clearsky_day[] = {
+constexpr uint8_t icon_clearsky_day_rows[] = {
     0b00100100,
     0b00010000,
     0b10111110,
@@ -37,7 +39,7 @@ const uint8_t PROGMEM icon_clearsky_day[] = {
 //   ░███░░░░
 //   ░░██░░░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_clearsky_night[] = {
+constexpr uint8_t icon_clearsky_night_rows[] = {
     0b00000000,
     0b00110000,
     0b01110000,
@@ -57,7 +59,7 @@ const uint8_t PROGMEM icon_clearsky_night[] = {
 //   ░████████
 //   ░░██████░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_partlycloudy_day[] = {
+constexpr uint8_t icon_partlycloudy_day_rows[] = {
     0b01000000,
     0b10000000,
     0b00011000,
@@ -77,7 +79,7 @@ const uint8_t PROGMEM icon_partlycloudy_day[] = {
 //   ░████████
 //   ░░██████░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_partlycloudy_night[] = {
+constexpr uint8_t icon_partlycloudy_night_rows[] = {
     0b00100000,
     0b01000000,
     0b00011000,
@@ -97,7 +99,7 @@ const uint8_t PROGMEM icon_partlycloudy_night[] = {
 //   ████████
 //   ░██████░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_cloudy[] = {
+constexpr uint8_t icon_cloudy_rows[] = {
     0b00000000,
     0b00011000,
     0b00111100,
@@ -117,7 +119,7 @@ const uint8_t PROGMEM icon_cloudy[] = {
 //   ░░░██████
 //   ░░░██████
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_fair_day[] = {
+constexpr uint8_t icon_fair_day_rows[] = {
     0b00100000,
     0b10100000,
     0b01110000,
@@ -137,7 +139,7 @@ const uint8_t PROGMEM icon_fair_day[] = {
 //   ░░░██████
 //   ░░░██████
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_fair_night[] = {
+constexpr uint8_t icon_fair_night_rows[] = {
     0b00110000,
     0b01110000,
     0b00110000,
@@ -157,7 +159,7 @@ const uint8_t PROGMEM icon_fair_night[] = {
 //   ░█░█░█░░
 //   █░█░█░░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_rain[] = {
+constexpr uint8_t icon_rain_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -177,7 +179,7 @@ const uint8_t PROGMEM icon_rain[] = {
 //   ░░█░░█░░
 //   ░░░░░░░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_lightrain[] = {
+constexpr uint8_t icon_lightrain_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -197,7 +199,7 @@ const uint8_t PROGMEM icon_lightrain[] = {
 //   ░█░█░█░█
 //   █░█░█░█░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_heavyrain[] = {
+constexpr uint8_t icon_heavyrain_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -217,7 +219,7 @@ const uint8_t PROGMEM icon_heavyrain[] = {
 //   ░█░░░█░░
 //   ░░░█░░░░
 //   ░█░░░█░░
-const uint8_t PROGMEM icon_snow[] = {
+constexpr uint8_t icon_snow_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -237,7 +239,7 @@ const uint8_t PROGMEM icon_snow[] = {
 //   ░░█░░░░░
 //   ░░░░░█░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_lightsnow[] = {
+constexpr uint8_t icon_lightsnow_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -257,7 +259,7 @@ const uint8_t PROGMEM icon_lightsnow[] = {
 //   ░█░█░█░█
 //   █░█░█░█░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_heavysnow[] = {
+constexpr uint8_t icon_heavysnow_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -277,7 +279,7 @@ const uint8_t PROGMEM icon_heavysnow[] = {
 //   ░█░░█░░░
 //   ░░█░░░█░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_sleet[] = {
+constexpr uint8_t icon_sleet_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -297,7 +299,7 @@ const uint8_t PROGMEM icon_sleet[] = {
 //   ████████
 //   ░░░░░░░░
 //   ░██████░
-const uint8_t PROGMEM icon_fog[] = {
+constexpr uint8_t icon_fog_rows[] = {
     0b00000000,
     0b11111111,
     0b00000000,
@@ -317,7 +319,7 @@ const uint8_t PROGMEM icon_fog[] = {
 //   ░░░█░░░░
 //   ░░██░░░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_thunder[] = {
+constexpr uint8_t icon_thunder_rows[] = {
     0b00011000,
     0b00111100,
     0b11111111,
@@ -337,7 +339,7 @@ const uint8_t PROGMEM icon_thunder[] = {
 //   ░░░░░░░░
 //   ░░░█░░░░
 //   ░░░░░░░░
-const uint8_t PROGMEM icon_unknown[] = {
+constexpr uint8_t icon_unknown_rows[] = {
     0b00111100,
     0b01000010,
     0b00000100,
@@ -348,14 +350,83 @@ const uint8_t PROGMEM icon_unknown[] = {
     0b00000000
 };
 
+// ============================================================================
+// Page-major icons, transcoded and deduplicated at compile time
+// ============================================================================
+
+enum WeatherIconId : uint8_t {
+    ICON_CLEARSKY_DAY,
+    ICON_CLEARSKY_NIGHT,
+    ICON_PARTLYCLOUDY_DAY,
+    ICON_PARTLYCLOUDY_NIGHT,
+    ICON_CLOUDY,
+    ICON_FAIR_DAY,
+    ICON_FAIR_NIGHT,
+    ICON_RAIN,
+    ICON_LIGHTRAIN,
+    ICON_HEAVYRAIN,
+    ICON_SNOW,
+    ICON_LIGHTSNOW,
+    ICON_HEAVYSNOW,
+    ICON_SLEET,
+    ICON_FOG,
+    ICON_THUNDER,
+    ICON_UNKNOWN,
+    WEATHER_ICON_COUNT
+};
+
+constexpr PageBitmap<8, 8> WEATHER_ICON_SOURCE[WEATHER_ICON_COUNT] = {
+    transcodeAsset<8, 8>(icon_clearsky_day_rows),
+    transcodeAsset<8, 8>(icon_clearsky_night_rows),
+    transcodeAsset<8, 8>(icon_partlycloudy_day_rows),
+    transcodeAsset<8, 8>(icon_partlycloudy_night_rows),
+    transcodeAsset<8, 8>(icon_cloudy_rows),
+    transcodeAsset<8, 8>(icon_fair_day_rows),
+    transcodeAsset<8, 8>(icon_fair_night_rows),
+    transcodeAsset<8, 8>(icon_rain_rows),
+    transcodeAsset<8, 8>(icon_lightrain_rows),
+    transcodeAsset<8, 8>(icon_heavyrain_rows),
+    transcodeAsset<8, 8>(icon_snow_rows),
+    transcodeAsset<8, 8>(icon_lightsnow_rows),
+    transcodeAsset<8, 8>(icon_heavysnow_rows),
+    transcodeAsset<8, 8>(icon_sleet_rows),
+    transcodeAsset<8, 8>(icon_fog_rows),
+    transcodeAsset<8, 8>(icon_thunder_rows),
+    transcodeAsset<8, 8>(icon_unknown_rows)
+};
+
+constexpr AssetDedup<WEATHER_ICON_COUNT> WEATHER_ICON_DEDUP = dedupAssets(WEATHER_ICON_SOURCE);
+constexpr AssetPool<8, 8, WEATHER_ICON_DEDUP.unique> WEATHER_ICON_POOL =
+    buildPool<WEATHER_ICON_DEDUP.unique>(WEATHER_ICON_SOURCE, WEATHER_ICON_DEDUP);
+
+#define WEATHER_ICON(id) WEATHER_ICON_POOL[WEATHER_ICON_DEDUP.slot[id]]
+
+constexpr PageAsset icon_clearsky_day = WEATHER_ICON(ICON_CLEARSKY_DAY);
+constexpr PageAsset icon_clearsky_night = WEATHER_ICON(ICON_CLEARSKY_NIGHT);
+constexpr PageAsset icon_partlycloudy_day = WEATHER_ICON(ICON_PARTLYCLOUDY_DAY);
+constexpr PageAsset icon_partlycloudy_night = WEATHER_ICON(ICON_PARTLYCLOUDY_NIGHT);
+constexpr PageAsset icon_cloudy = WEATHER_ICON(ICON_CLOUDY);
+constexpr PageAsset icon_fair_day = WEATHER_ICON(ICON_FAIR_DAY);
+constexpr PageAsset icon_fair_night = WEATHER_ICON(ICON_FAIR_NIGHT);
+constexpr PageAsset icon_rain = WEATHER_ICON(ICON_RAIN);
+constexpr PageAsset icon_lightrain = WEATHER_ICON(ICON_LIGHTRAIN);
+constexpr PageAsset icon_heavyrain = WEATHER_ICON(ICON_HEAVYRAIN);
+constexpr PageAsset icon_snow = WEATHER_ICON(ICON_SNOW);
+constexpr PageAsset icon_lightsnow = WEATHER_ICON(ICON_LIGHTSNOW);
+constexpr PageAsset icon_heavysnow = WEATHER_ICON(ICON_HEAVYSNOW);
+constexpr PageAsset icon_sleet = WEATHER_ICON(ICON_SLEET);
+constexpr PageAsset icon_fog = WEATHER_ICON(ICON_FOG);
+constexpr PageAsset icon_thunder = WEATHER_ICON(ICON_THUNDER);
+constexpr PageAsset icon_unknown = WEATHER_ICON(ICON_UNKNOWN);
+
 // ============================================================================
 // Icon lookup function
 // Returns pointer to appropriate icon based on MET Norway symbol code
 // ============================================================================
 
-inline const uint8_t* getWeatherIcon(const char* symbolCode) {
+inline const PageAsset* getWeatherIcon(const char* symbolCode) {
     if (symbolCode == nullptr || symbolCode[0] == '\0') {
-        return icon_unknown;
+        return &icon_unknown;
     }
 
     // Check for specific patterns in symbol code
@@ -363,80 +434,80 @@ inline const uint8_t* getWeatherIcon(const char* symbolCode) {
 
     // Thunder variants (check first as they may contain rain/snow)
     if (strstr(symbolCode, "thunder")) {
-        return icon_thunder;
+        return &icon_thunder;
     }
 
     // Fog
     if (strstr(symbolCode, "fog")) {
-        return icon_fog;
+        return &icon_fog;
     }
 
     // Heavy rain variants
     if (strstr(symbolCode, "heavyrain")) {
-        return icon_heavyrain;
+        return &icon_heavyrain;
     }
 
     // Light rain variants
     if (strstr(symbolCode, "lightrain")) {
-        return icon_lightrain;
+        return &icon_lightrain;
     }
 
     // Rain variants (check after heavy/light)
     if (strstr(symbolCode, "rain")) {
-        return icon_rain;
+        return &icon_rain;
     }
 
     // Heavy snow variants
     if (strstr(symbolCode, "heavysnow")) {
-        return icon_heavysnow;
+        return &icon_heavysnow;
     }
 
     // Light snow variants
     if (strstr(symbolCode, "lightsnow")) {
-        return icon_lightsnow;
+        return &icon_lightsnow;
     }
 
     // Snow variants (check after heavy/light)
     if (strstr(symbolCode, "snow")) {
-        return icon_snow;
+        return &icon_snow;
     }
 
     // Sleet variants
     if (strstr(symbolCode, "sleet")) {
-        return icon_sleet;
+        return &icon_sleet;
     }
 
     // Clear sky
     if (strstr(symbolCode, "clearsky")) {
         if (strstr(symbolCode, "night") || strstr(symbolCode, "polartwilight")) {
-            return icon_clearsky_night;
+            return &icon_clearsky_night;
         }
-        return icon_clearsky_day;
+        return &icon_clearsky_day;
     }
 
     // Fair (slightly cloudy)
     if (strstr(symbolCode, "fair")) {
         if (strstr(symbolCode, "night") || strstr(symbolCode, "polartwilight")) {
-            return icon_fair_night;
+            return &icon_fair_night;
         }
-        return icon_fair_day;
+        return &icon_fair_day;
     }
 
     // Partly cloudy
     if (strstr(symbolCode, "partlycloudy")) {
         if (strstr(symbolCode, "night") || strstr(symbolCode, "polartwilight")) {
-            return icon_partlycloudy_night;
+            return &icon_partlycloudy_night;
         }
-        return icon_partlycloudy_day;
+        return &icon_partlycloudy_day;
     }
 
     // Cloudy (check last as other conditions contain cloud references)
     if (strstr(symbolCode, "cloudy")) {
-        return icon_cloudy;
+        return &icon_cloudy;
     }
 
     // Default to unknown
-    return icon_unknown;
+    return &icon_unknown;
 }
 
 #endif // WEATHER_ICONS_H
@@ -1,5 +1,7 @@
 #include "WeatherService.h"
 #include <WiFi.h>
+#include <time.h>
+#include "DnsCache.h"
 
 WeatherService::WeatherService()
     : state_(WeatherState::IDLE),
@@ -10,6 +12,15 @@ WeatherService::WeatherService()
       lastAttemptTime_(0),
       nextUpdateTime_(0),
       wifiConnectedTimeMs_(0),
+      locationEpoch_(0),
+      locationSkips_(0),
+      dnsCache_(nullptr),
+      externalScheduling_(false),
+      lastViewMs_(0),
+      viewedStale_(false),
+      expiresEpoch_(0),
+      placeCount_(0),
+      placeCursor_(0),
       retryCount_(0),
       wasConnected_(false),
       lastError_(WeatherError::NONE),
@@ -20,6 +31,12 @@ WeatherService::WeatherService()
       dataMutex_(nullptr) {
     location_.valid = false;
     forecast_.valid = false;
+    memset(viewHistogram_, 0, sizeof(viewHistogram_));
+    memset(places_, 0, sizeof(places_));
+    memset(placeAttempt_, 0, sizeof(placeAttempt_));
+    for (uint8_t i = 0; i < MAX_PLACES; i++) {
+        placeWanted_[i] = false;
+    }
 }
 
 const char* WeatherService::getErrorString() const {
@@ -79,8 +96,8 @@ void WeatherService::update() {
         return;
     }
 
-    // Skip if fetch already in progress
-    if (fetchInProgress_) {
+    // Skip if fetch already in progress or fetches are scheduled externally
+    if (fetchInProgress_ || externalScheduling_) {
         return;
     }
 
@@ -112,7 +129,7 @@ void WeatherService::update() {
     }
 
     // Check what needs updating
-    bool needsLocation = !isLocationCacheValid();
+    bool needsLocation = needsLocationRefresh();
     bool needsWeather = !isWeatherCacheValid();
 
     if (!needsLocation && !needsWeather) {
@@ -145,11 +162,257 @@ bool WeatherService::forceUpdate() {
         return false;
     }
 
-    // Start background fetch with location refresh
-    startBackgroundFetch(true);
+    // Start background fetch (location only if the network changed)
+    lastAttemptTime_ = millis() / 1000;
+    startBackgroundFetch(needsLocationRefresh());
+    return true;
+}
+
+bool WeatherService::getNextDeadline(uint32_t& deadlineMs) const {
+    if (!enabled_ || fetchInProgress_) {
+        return false;
+    }
+
+    // A place without cached data is being looked at
+    for (uint8_t i = 0; i < placeCount_; i++) {
+        if (placeWanted_[i]) {
+            deadlineMs = millis();
+            return true;
+        }
+    }
+
+    uint32_t now = millis() / 1000;
+
+    // Same rules as update(): scheduled time, cache lifetime...
+    uint32_t dueSecs = nextUpdateTime_;
+    if (isWeatherCacheValid() && weatherFetchTime_ + WEATHER_CACHE_SECS > dueSecs) {
+        dueSecs = weatherFetchTime_ + WEATHER_CACHE_SECS;
+    }
+
+    // ...unless someone is looking at old data, or views are predictable
+    uint32_t predicted = 0;
+    if (viewedStale_) {
+        dueSecs = now;
+    } else if (retryCount_ == 0 && forecast_.valid && weatherFetchTime_ != 0 &&
+               predictDeadline(now, predicted)) {
+        dueSecs = predicted;
+    }
+
+    // Never ask before MET says the data changes
+    time_t epoch = time(nullptr);
+    if (expiresEpoch_ != 0 && (uint32_t)epoch >= MIN_VALID_EPOCH && expiresEpoch_ > (uint32_t)epoch) {
+        uint32_t expiresSecs = now + (expiresEpoch_ - (uint32_t)epoch);
+        if (expiresSecs > dueSecs) dueSecs = expiresSecs;
+    }
+
+    // Minimum interval between attempts
+    if (lastAttemptTime_ != 0 && lastAttemptTime_ + MIN_UPDATE_INTERVAL_SECS > dueSecs) {
+        dueSecs = lastAttemptTime_ + MIN_UPDATE_INTERVAL_SECS;
+    }
+
+    deadlineMs = dueSecs * 1000UL;
+    return true;
+}
+
+// ============================================================================
+// EXTRA PLACES
+// ============================================================================
+
+bool WeatherService::addPlace(const char* name, float latitude, float longitude) {
+    if (placeCount_ >= MAX_PLACES || name == nullptr) {
+        return false;
+    }
+
+    WeatherPlace& place = places_[placeCount_++];
+    strncpy(place.name, name, sizeof(place.name) - 1);
+    place.name[sizeof(place.name) - 1] = '\0';
+    place.latitude = latitude;
+    place.longitude = longitude;
+
+    Serial.printf("[WeatherService] Place %u: %s (%.4f, %.4f)\n",
+                 placeCount_, place.name, latitude, longitude);
     return true;
 }
 
+bool WeatherService::getPlaceForecast(uint8_t index, WeatherForecast& forecast, char* name, size_t nameSize) {
+    if (index == 0) {
+        forecast = forecast_;
+        strncpy(name, location_.city, nameSize - 1);
+        name[nameSize - 1] = '\0';
+        return forecast_.valid;
+    }
+
+    uint8_t i = index - 1;
+    if (i >= placeCount_) {
+        forecast.valid = false;
+        return false;
+    }
+    strncpy(name, places_[i].name, nameSize - 1);
+    name[nameSize - 1] = '\0';
+
+    bool cached = false;
+    if (dataMutex_ != nullptr && xSemaphoreTake(dataMutex_, pdMS_TO_TICKS(50)) == pdTRUE) {
+        cached = placeCache_.load(index, forecast);
+        xSemaphoreGive(dataMutex_);
+    }
+
+    // Queue a fetch (not more often than the minimum interval)
+    uint32_t now = millis() / 1000;
+    if (!cached && enabled_ && !placeWanted_[i] &&
+        (placeAttempt_[i] == 0 || now - placeAttempt_[i] >= MIN_UPDATE_INTERVAL_SECS)) {
+        placeWanted_[i] = true;
+    }
+    return cached;
+}
+
+bool WeatherService::placeNeedsFetch(uint8_t index, uint32_t nowSecs) {
+    if (placeWanted_[index]) {
+        return true;
+    }
+
+    // Cached places are kept fresh; evicted ones wait until viewed again
+    uint32_t fetchTime = 0;
+    bool cached = false;
+    if (xSemaphoreTake(dataMutex_, portMAX_DELAY) == pdTRUE) {
+        cached = placeCache_.getFetchTime(index + 1, fetchTime);
+        xSemaphoreGive(dataMutex_);
+    }
+    return cached && nowSecs - fetchTime >= updateIntervalSecs_;
+}
+
+void WeatherService::fetchPlaces() {
+    uint32_t now = millis() / 1000;
+    uint8_t fetched = 0;
+
+    for (uint8_t n = 0; n < placeCount_ && fetched < PLACE_FETCHES_PER_RUN; n++) {
+        uint8_t i = placeCursor_;
+        placeCursor_ = (uint8_t)((placeCursor_ + 1) % placeCount_);
+
+        if (!placeNeedsFetch(i, now)) continue;
+        if (WiFi.status() != WL_CONNECTED) break;
+
+        placeAttempt_[i] = now;
+        placeWanted_[i] = false;
+        fetched++;
+
+        Serial.printf("[WeatherService] Fetching place %s...\n", places_[i].name);
+        WeatherForecast forecast;
+        if (!weatherClient_.fetchForecast(places_[i].latitude, places_[i].longitude, forecast)) {
+            Serial.printf("[WeatherService] Place %s failed\n", places_[i].name);
+            continue;
+        }
+
+        if (xSemaphoreTake(dataMutex_, portMAX_DELAY) == pdTRUE) {
+            placeCache_.store(i + 1, forecast, millis() / 1000);
+            xSemaphoreGive(dataMutex_);
+        }
+        triggerEvent(WeatherEvent::WEATHER_UPDATED);
+    }
+}
+
+// ============================================================================
+// VIEW-TIME PREDICTION
+// ============================================================================
+
+void WeatherService::noteView() {
+    uint32_t nowMs = millis();
+    if (lastViewMs_ != 0 && nowMs - lastViewMs_ < VIEW_DEBOUNCE_MS) {
+        return;  // Same viewing session
+    }
+    lastViewMs_ = nowMs;
+
+    // How fresh was what the user saw?
+    prefetchStats_.views++;
+    if (forecast_.valid && weatherFetchTime_ != 0) {
+        uint32_t age = nowMs / 1000 - weatherFetchTime_;
+        prefetchStats_.viewAgeTotalSecs += age;
+        if (age > updateIntervalSecs_) {
+            prefetchStats_.staleViews++;
+            viewedStale_ = enabled_;
+        }
+    } else {
+        viewedStale_ = enabled_;
+    }
+
+    // Learn the hour (needs the clock)
+    time_t epoch = time(nullptr);
+    if ((uint32_t)epoch < MIN_VALID_EPOCH) {
+        return;
+    }
+    struct tm local;
+    localtime_r(&epoch, &local);
+
+    if (viewHistogram_[local.tm_hour] == UINT8_MAX) {
+        for (uint8_t h = 0; h < 24; h++) {
+            viewHistogram_[h] /= 2;  // Old habits fade
+        }
+    }
+    viewHistogram_[local.tm_hour]++;
+
+    Preferences prefs;
+    if (prefs.begin(NVS_NAMESPACE, false)) {
+        prefs.putBytes(KEY_VIEW_HIST, viewHistogram_, sizeof(viewHistogram_));
+        prefs.end();
+    }
+}
+
+bool WeatherService::isLikelyViewHour(uint8_t hour, uint16_t totalViews) const {
+    // At least 2 views and ~8% of all views
+    uint8_t count = viewHistogram_[hour];
+    return count >= 2 && (uint32_t)count * 12 >= totalViews;
+}
+
+// Time (seconds since boot) by which to fetch so the data is no older than
+// the update interval during the next likely viewing hour
+bool WeatherService::predictDeadline(uint32_t nowSecs, uint32_t& dueSecs) const {
+    time_t epoch = time(nullptr);
+    if ((uint32_t)epoch < MIN_VALID_EPOCH) {
+        return false;
+    }
+
+    uint16_t total = 0;
+    for (uint8_t h = 0; h < 24; h++) {
+        total += viewHistogram_[h];
+    }
+    if (total < MIN_VIEWS_FOR_PREDICTION) {
+        return false;
+    }
+
+    struct tm local;
+    localtime_r(&epoch, &local);
+    int32_t intoHour = local.tm_min * 60 + local.tm_sec;
+    uint32_t age = nowSecs - weatherFetchTime_;
+
+    // Unviewed stretches are skipped, but not beyond a day
+    dueSecs = weatherFetchTime_ + MAX_UNVIEWED_AGE_SECS;
+
+    for (uint8_t k = 0; k < 24; k++) {
+        uint8_t hour = (uint8_t)((local.tm_hour + k) % 24);
+        if (!isLikelyViewHour(hour, total)) continue;
+
+        int32_t hourStart = (int32_t)k * 3600 - intoHour;
+        if (age + (uint32_t)(hourStart + 3600) <= updateIntervalSecs_) {
+            continue;  // Current data is still fresh at the end of that hour
+        }
+
+        int32_t due = hourStart - (int32_t)PREFETCH_LEAD_SECS;
+        uint32_t candidate = due > 0 ? nowSecs + (uint32_t)due : nowSecs;
+        if (candidate < dueSecs) dueSecs = candidate;
+        break;
+    }
+    return true;
+}
+
+void WeatherService::printPrefetchStats() const {
+    const WeatherPrefetchStats& st = prefetchStats_;
+    uint32_t avgAgeMin = st.views > 0 ? st.viewAgeTotalSecs / st.views / 60 : 0;
+    Serial.printf("[WeatherService] Prefetch: %lu fetches, %lu skipped, %lu views "
+                  "(avg age %lu min, %lu stale)\n",
+                  (unsigned long)st.fetches, (unsigned long)st.skippedFetches,
+                  (unsigned long)st.views, (unsigned long)avgAgeMin,
+                  (unsigned long)st.staleViews);
+}
+
 // Static wrapper for FreeRTOS task
 void WeatherService::fetchTaskWrapper(void* param) {
     WeatherService* self = static_cast<WeatherService*>(param);
@@ -166,6 +429,12 @@ void WeatherService::startBackgroundFetch(bool includeLocation) {
     fetchInProgress_ = true;
     fetchNeedsLocation_ = includeLocation;
 
+    if (!includeLocation && !isLocationCacheValid()) {
+        locationSkips_++;
+        Serial.printf("[WeatherService] Network unchanged, reusing location (%u requests skipped)\n",
+                     locationSkips_);
+    }
+
     if (includeLocation) {
         setState(WeatherState::FETCHING_LOCATION);
     } else {
@@ -201,6 +470,15 @@ void WeatherService::fetchTask() {
     bool success = true;
     uint32_t now = millis() / 1000;
 
+    // Only an extra place was asked for: leave the fresh local forecast alone
+    bool placesOnly = !fetchNeedsLocation_ && !viewedStale_ && isWeatherCacheValid();
+    if (placesOnly) {
+        placesOnly = false;
+        for (uint8_t i = 0; i < placeCount_; i++) {
+            placesOnly = placesOnly || placeWanted_[i];
+        }
+    }
+
     // Fetch location if needed
     if (fetchNeedsLocation_) {
         if (!fetchLocation()) {
@@ -219,7 +497,7 @@ void WeatherService::fetchTask() {
     }
 
     // Fetch weather if location succeeded or wasn't needed
-    if (success) {
+    if (success && !placesOnly) {
         setState(WeatherState::FETCHING_WEATHER);
 
         if (!fetchWeather()) {
@@ -237,15 +515,25 @@ void WeatherService::fetchTask() {
         }
     }
 
+    // Extra places ride along in the same connection
+    if (success && placeCount_ > 0) {
+        fetchPlaces();
+    }
+
     // Update state based on result
     if (success) {
         setState(WeatherState::CACHED);
-        nextUpdateTime_ = now + updateIntervalSecs_;
+        if (!placesOnly) {
+            nextUpdateTime_ = now + updateIntervalSecs_;
+        }
     }
 
     size_t heapAfter = ESP.getFreeHeap();
     Serial.printf("[WeatherService] Free heap after: %u bytes\n", heapAfter);
     Serial.printf("[WeatherService] Heap used: %d bytes\n", (int)(heapBefore - heapAfter));
+    if (dnsCache_ != nullptr) {
+        dnsCache_->printStats();
+    }
 
     fetchTaskHandle_ = nullptr;
     fetchInProgress_ = false;
@@ -277,6 +565,9 @@ bool WeatherService::fetchLocation() {
                  location_.city, location_.country);
 
     locationFetchTime_ = millis() / 1000;
+    time_t nowEpoch = time(nullptr);
+    locationEpoch_ = (uint32_t)nowEpoch >= MIN_VALID_EPOCH ? (uint32_t)nowEpoch : 0;
+    locationNetwork_ = NetworkFingerprint::capture();
     saveLocationToNVS();
     triggerEvent(WeatherEvent::LOCATION_UPDATED);
 
@@ -317,8 +608,19 @@ bool WeatherService::fetchWeather() {
                      forecast_.days[i].symbolCode);
     }
 
-    weatherFetchTime_ = millis() / 1000;
+    // Fixed-interval fetches the schedule avoided since the previous one
+    uint32_t now = millis() / 1000;
+    if (weatherFetchTime_ != 0 && updateIntervalSecs_ > 0) {
+        uint32_t intervals = (now - weatherFetchTime_) / updateIntervalSecs_;
+        if (intervals > 1) prefetchStats_.skippedFetches += intervals - 1;
+    }
+    prefetchStats_.fetches++;
+    viewedStale_ = false;
+    expiresEpoch_ = weatherClient_.getLastExpires();
+
+    weatherFetchTime_ = now;
     saveWeatherToNVS();
+    printPrefetchStats();
     triggerEvent(WeatherEvent::WEATHER_UPDATED);
 
     return true;
@@ -336,6 +638,12 @@ void WeatherService::triggerEvent(WeatherEvent event) {
     }
 }
 
+void WeatherService::setDnsCache(DnsCache* cache) {
+    dnsCache_ = cache;
+    geoClient_.setDnsCache(cache);
+    weatherClient_.setDnsCache(cache);
+}
+
 void WeatherService::setEnabled(bool enabled) {
     enabled_ = enabled;
 
@@ -372,6 +680,46 @@ bool WeatherService::isLocationCacheValid() const {
     return age < LOCATION_CACHE_SECS;
 }
 
+bool WeatherService::needsLocationRefresh() {
+    if (!location_.valid) {
+        return true;
+    }
+
+    // Location cached before fingerprinting, or fingerprint unavailable: age only
+    NetworkFingerprint current = NetworkFingerprint::capture();
+    if (!locationNetwork_.valid || !current.valid) {
+        return !isLocationCacheValid();
+    }
+
+    if (!current.sameNetwork(locationNetwork_)) {
+        Serial.printf("[WeatherService] Network changed (%08lx -> %08lx), location refresh needed\n",
+                     (unsigned long)locationNetwork_.hash(), (unsigned long)current.hash());
+        return true;
+    }
+
+    // Same network: refresh only after the long safety interval. Fetched
+    // before SNTP synced there is no date to age it by, so use the
+    // uptime-based cache instead
+    uint32_t nowEpoch = (uint32_t)time(nullptr);
+    if (locationEpoch_ == 0) {
+        if (!isLocationCacheValid()) {
+            return true;
+        }
+    } else if (nowEpoch >= MIN_VALID_EPOCH && nowEpoch - locationEpoch_ >= LOCATION_MAX_AGE_SECS) {
+        Serial.println("[WeatherService] Location older than 30 days, refresh needed");
+        return true;
+    }
+
+    // Gateway MAC learned since the last fetch - store it so roaming between
+    // access points of the same network is recognised
+    if (current.gatewayMacKnown && !locationNetwork_.gatewayMacKnown) {
+        locationNetwork_ = current;
+        saveLocationToNVS();
+    }
+
+    return false;
+}
+
 bool WeatherService::isWeatherCacheValid() const {
     if (!forecast_.valid || weatherFetchTime_ == 0) {
         return false;
@@ -397,6 +745,8 @@ void WeatherService::saveLocationToNVS() {
     prefs.putString(KEY_CITY, location_.city);
     prefs.putString(KEY_COUNTRY, location_.country);
     prefs.putULong(KEY_LOC_TIME, locationFetchTime_);
+    prefs.putULong(KEY_LOC_EPOCH, locationEpoch_);
+    prefs.putBytes(KEY_LOC_NET, &locationNetwork_, sizeof(locationNetwork_));
 
     prefs.end();
     Serial.println("[WeatherService] Location saved");
@@ -413,6 +763,7 @@ void WeatherService::saveWeatherToNVS() {
 
     prefs.putUChar(KEY_FC_COUNT, forecast_.dayCount);
     prefs.putULong(KEY_FC_TIME, weatherFetchTime_);
+    prefs.putULong(KEY_FC_EXPIRES, expiresEpoch_);
 
     // Save each day using fixed keys
     if (forecast_.dayCount > 0) {
@@ -464,6 +815,11 @@ void WeatherService::loadCacheFromNVS() {
     enabled_ = prefs.getBool(KEY_ENABLED, false);  // Default off - opt-in required
     updateIntervalSecs_ = prefs.getULong(KEY_INTERVAL, DEFAULT_UPDATE_INTERVAL);
 
+    // Viewing pattern (24 bytes)
+    if (prefs.getBytes(KEY_VIEW_HIST, viewHistogram_, sizeof(viewHistogram_)) != sizeof(viewHistogram_)) {
+        memset(viewHistogram_, 0, sizeof(viewHistogram_));
+    }
+
     // Load location
     if (prefs.isKey(KEY_LAT) && prefs.isKey(KEY_LON)) {
         location_.latitude = prefs.getFloat(KEY_LAT, 0.0f);
@@ -485,6 +841,10 @@ void WeatherService::loadCacheFromNVS() {
         }
 
         locationFetchTime_ = prefs.getULong(KEY_LOC_TIME, 0);
+        locationEpoch_ = prefs.getULong(KEY_LOC_EPOCH, 0);
+        if (prefs.getBytes(KEY_LOC_NET, &locationNetwork_, sizeof(locationNetwork_)) != sizeof(locationNetwork_)) {
+            locationNetwork_ = NetworkFingerprint();
+        }
         location_.valid = true;
 
         Serial.printf("[WeatherService] Loaded location: %.4f, %.4f (%s)\n",
@@ -496,6 +856,7 @@ void WeatherService::loadCacheFromNVS() {
     if (dayCount > 0 && dayCount <= 4) {
         forecast_.dayCount = dayCount;
         weatherFetchTime_ = prefs.getULong(KEY_FC_TIME, 0);
+        expiresEpoch_ = prefs.getULong(KEY_FC_EXPIRES, 0);   // Epoch, valid across reboots
 
         char dateBuffer[16];
         char symBuffer[32];
@@ -591,8 +952,17 @@ void WeatherService::clearCache() {
     location_.valid = false;
     forecast_.valid = false;
     locationFetchTime_ = 0;
+    locationEpoch_ = 0;
+    locationNetwork_ = NetworkFingerprint();
     weatherFetchTime_ = 0;
     retryCount_ = 0;
+    expiresEpoch_ = 0;
+    viewedStale_ = false;
+    memset(viewHistogram_, 0, sizeof(viewHistogram_));  // Viewing habits are personal data too
+    if (dataMutex_ != nullptr && xSemaphoreTake(dataMutex_, portMAX_DELAY) == pdTRUE) {
+        placeCache_.clear();
+        xSemaphoreGive(dataMutex_);
+    }
     setState(WeatherState::IDLE);
 
     Serial.println("[WeatherService] Cache cleared");
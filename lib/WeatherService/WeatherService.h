@@ -8,6 +8,10 @@
 #include <freertos/semphr.h>
 #include "GeoLocationClient.h"
 #include "WeatherClient.h"
+#include "NetworkFingerprint.h"
+#include "ForecastCache.h"
+
+class DnsCache;
 
 // Weather service states
 enum class WeatherState {
@@ -49,15 +53,37 @@ enum class WeatherError {
 
 using WeatherEventCallback = void (*)(WeatherEvent event);
 
+// Additional forecast location (configured, not geolocated)
+struct WeatherPlace {
+    char name[16];
+    float latitude;
+    float longitude;
+};
+
+// Prefetch effectiveness (since boot)
+struct WeatherPrefetchStats {
+    uint32_t fetches = 0;           // Successful forecast fetches
+    uint32_t skippedFetches = 0;    // Fixed-interval fetches not made
+    uint32_t views = 0;             // Weather view openings
+    uint32_t staleViews = 0;        // Views of data older than the update interval
+    uint32_t viewAgeTotalSecs = 0;  // Sum of data age at view time
+};
+
 /**
  * WeatherService - Coordinator for geolocation and weather forecast
  *
  * Features:
  * - Combines GeoLocationClient and WeatherClient
  * - Smart caching with NVS persistence
- * - Scheduled updates (4 hours for weather, 7 days for location)
+ * - Scheduled updates (4 hours for weather; location only when the
+ *   network fingerprint changes, or after 30 days on the same network)
+ * - Fetches timed before the hours the forecast is usually viewed
+ *   (24-byte view histogram in NVS), respecting MET's Expires
  * - Non-blocking update() for main loop integration
  * - Graceful degradation on network failure
+ * - Up to MAX_PLACES extra places, fetched round-robin by the same task.
+ *   Memory: 24 B per configured place + ForecastCache::SLOTS x 48 B for
+ *   their compact forecasts (least recently viewed place is evicted).
  */
 class WeatherService {
 public:
@@ -72,6 +98,27 @@ public:
     // Force immediate update regardless of cache validity (non-blocking)
     bool forceUpdate();
 
+    // Let a network window coordinator decide when to fetch: update() then
+    // no longer starts fetches or waits for WiFi to settle on its own
+    void setExternalScheduling(bool external) { externalScheduling_ = external; }
+
+    // Latest time (millis) the next fetch should start; false if none pending
+    // Once enough views are recorded, fetches are timed shortly before the
+    // hours the forecast is usually looked at, and never before Expires
+    bool getNextDeadline(uint32_t& deadlineMs) const;
+
+    // Places: index 0 is the geolocated location, then addPlace() order
+    bool addPlace(const char* name, float latitude, float longitude);
+    uint8_t getPlaceCount() const { return 1 + placeCount_; }
+
+    // Copy a place's forecast; false if not cached yet (a fetch is queued)
+    bool getPlaceForecast(uint8_t index, WeatherForecast& forecast, char* name, size_t nameSize);
+
+    // Record that the weather view was opened (learns viewing hours)
+    void noteView();
+    const WeatherPrefetchStats& getPrefetchStats() const { return prefetchStats_; }
+    void printPrefetchStats() const;
+
     // Check if background fetch is in progress
     bool isFetching() const { return fetchInProgress_; }
 
@@ -85,6 +132,8 @@ public:
     WeatherError getLastError() const { return lastError_; }
     uint8_t getRetryCount() const { return retryCount_; }
     const char* getErrorString() const;
+    const GeoLocationClient& getGeoClient() const { return geoClient_; }
+    uint16_t getLocationSkipCount() const { return locationSkips_; }
 
     // Configuration
     void setEnabled(bool enabled);
@@ -98,6 +147,9 @@ public:
     // Event callback
     void setEventCallback(WeatherEventCallback callback) { eventCallback_ = callback; }
 
+    // Shared DNS cache for all HTTP requests
+    void setDnsCache(DnsCache* cache);
+
 private:
     // State management
     void setState(WeatherState newState);
@@ -117,8 +169,17 @@ private:
     void saveWeatherToNVS();
     void loadCacheFromNVS();
     bool isLocationCacheValid() const;
+    bool needsLocationRefresh();
     bool isWeatherCacheValid() const;
 
+    // Extra places (called from background task)
+    void fetchPlaces();
+    bool placeNeedsFetch(uint8_t index, uint32_t nowSecs);
+
+    // View-time prediction
+    bool predictDeadline(uint32_t nowSecs, uint32_t& dueSecs) const;
+    bool isLikelyViewHour(uint8_t hour, uint16_t totalViews) const;
+
     // NVS namespace
     static constexpr const char* NVS_NAMESPACE = "weather";
 
@@ -130,8 +191,12 @@ private:
     static constexpr const char* KEY_CITY = "city";
     static constexpr const char* KEY_COUNTRY = "country";
     static constexpr const char* KEY_LOC_TIME = "loc_time";
+    static constexpr const char* KEY_LOC_EPOCH = "loc_epoch";
+    static constexpr const char* KEY_LOC_NET = "loc_net";
     static constexpr const char* KEY_FC_COUNT = "fc_count";
     static constexpr const char* KEY_FC_TIME = "fc_time";
+    static constexpr const char* KEY_FC_EXPIRES = "fc_expires";
+    static constexpr const char* KEY_VIEW_HIST = "view_hist";
 
     // Forecast day 0 keys
     static constexpr const char* KEY_FC0_DATE = "fc0_date";
@@ -163,15 +228,25 @@ private:
 
     // Timing constants
     static constexpr uint32_t LOCATION_CACHE_SECS = 7UL * 24UL * 60UL * 60UL;  // 7 days
+    static constexpr uint32_t LOCATION_MAX_AGE_SECS = 30UL * 24UL * 60UL * 60UL; // 30 days, same network
+    static constexpr uint32_t MIN_VALID_EPOCH = 1600000000UL;                  // Clock set by NTP
     static constexpr uint32_t WEATHER_CACHE_SECS = 4UL * 60UL * 60UL;          // 4 hours
     static constexpr uint32_t MIN_UPDATE_INTERVAL_SECS = 5UL * 60UL;           // 5 minutes
     static constexpr uint32_t RETRY_DELAY_SECS = 30UL;                         // 30 seconds
     static constexpr uint32_t DEFAULT_UPDATE_INTERVAL = 4UL * 60UL * 60UL;     // 4 hours
     static constexpr uint32_t WIFI_STABILIZE_MS = 5000UL;                       // Wait 5s after WiFi connects
+    static constexpr uint32_t PREFETCH_LEAD_SECS = 10UL * 60UL;                // Fetch 10 min before a likely view
+    static constexpr uint32_t MAX_UNVIEWED_AGE_SECS = 24UL * 60UL * 60UL;      // Refresh daily even if unseen
+    static constexpr uint32_t VIEW_DEBOUNCE_MS = 10UL * 60UL * 1000UL;         // One view per 10 min
+    static constexpr uint16_t MIN_VIEWS_FOR_PREDICTION = 8;
 
     // Retry tracking
     static constexpr uint8_t MAX_RETRIES = 3;
 
+    // Extra places
+    static constexpr uint8_t MAX_PLACES = 4;
+    static constexpr uint8_t PLACE_FETCHES_PER_RUN = 2;
+
     // Task settings
     static constexpr size_t FETCH_TASK_STACK_SIZE = 8192;  // 8KB stack for HTTP/JSON
     static constexpr UBaseType_t FETCH_TASK_PRIORITY = 1;  // Low priority
@@ -195,6 +270,30 @@ private:
     uint32_t lastAttemptTime_;
     uint32_t nextUpdateTime_;
     uint32_t wifiConnectedTimeMs_;  // When WiFi connection was detected (millis)
+    uint32_t locationEpoch_;        // UTC time of last geolocation (0 if clock was unset)
+
+    // Network the cached location was fetched on
+    NetworkFingerprint locationNetwork_;
+    uint16_t locationSkips_;        // Geolocation requests avoided (network unchanged)
+
+    // Shared resolver cache (not owned)
+    DnsCache* dnsCache_;
+    bool externalScheduling_;
+
+    // Viewing pattern: views per local hour (halved when a bucket saturates)
+    uint8_t viewHistogram_[24];
+    uint32_t lastViewMs_;
+    bool viewedStale_;              // Opened with old data - fetch soon
+    uint32_t expiresEpoch_;         // MET Expires of the current forecast (0 = unknown)
+    WeatherPrefetchStats prefetchStats_;
+
+    // Extra places and their compact forecasts (guarded by dataMutex_)
+    WeatherPlace places_[MAX_PLACES];
+    uint8_t placeCount_;
+    uint8_t placeCursor_;                   // Round-robin position
+    volatile bool placeWanted_[MAX_PLACES]; // Viewed but not cached
+    uint32_t placeAttempt_[MAX_PLACES];     // Last fetch attempt (secs since boot)
+    ForecastCache placeCache_;
 
     // Retry tracking
     uint8_t retryCount_;
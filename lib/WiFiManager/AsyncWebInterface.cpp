@@ -0,0 +1,248 @@
+#include "AsyncWebInterface.h"
+#include "WiFiManager.h"
+#include "CaptiveDns.h"
+#include "SamplingProfiler.h"
+#include <ESPAsyncWebServer.h>
+#include <WiFi.h>
+
+static_assert(SamplingProfiler::LINE_BYTES <= WebBackend::PROFILE_SAMPLE_BYTES,
+              "Profiler sample lines must fit the /profile page slots");
+
+// ============================================================================
+// ASYNC WEB SERVER ADAPTER
+// ============================================================================
+
+namespace {
+
+// WebRequest over an AsyncWebServerRequest; the body is the String
+// collected into _tempObject by collectBody()
+class AsyncRequestAdapter : public WebRequest {
+public:
+    explicit AsyncRequestAdapter(AsyncWebServerRequest* request)
+        : request_(request) {}
+
+    WebMethod method() const override {
+        return request_->method() == HTTP_POST ? WebMethod::POST : WebMethod::GET;
+    }
+
+    const char* path() const override {
+        return request_->url().c_str();
+    }
+
+    const char* body() const override {
+        String* body = (String*)request_->_tempObject;
+        return body ? body->c_str() : nullptr;
+    }
+
+    void send(int code, const char* contentType, const char* content) override {
+        request_->send(code, contentType, content);
+    }
+
+    void sendFlash(int code, const char* contentType, const char* content) override {
+        request_->send_P(code, contentType, content);
+    }
+
+    void redirect(const char* location) override {
+        request_->redirect(location);
+    }
+
+private:
+    AsyncWebServerRequest* request_;
+};
+
+void collectBody(AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+    const size_t limit = WebInterface::MAX_BODY_SIZE;
+
+    // Low heap: drop the body, dispatch() sheds the request anyway
+    if (index == 0 && ESP.getFreeHeap() < WebAdmission::MIN_FREE_HEAP) return;
+
+    if (index == 0) {
+        String* body = new String();
+        body->reserve(total < limit ? total : limit);
+        request->_tempObject = body;
+    }
+    String* body = (String*)request->_tempObject;
+    if (body == nullptr || index >= limit) return;
+
+    size_t room = limit - index;
+    body->concat((const char*)data, len < room ? len : room);
+}
+
+}  // namespace
+
+AsyncWebInterface::AsyncWebInterface(WiFiManager* wifiManager)
+    : _wifiManager(wifiManager), _backend(wifiManager), _interface(&_backend) {
+}
+
+void AsyncWebInterface::setupRoutes(AsyncWebServer* server) {
+    if (server == nullptr) return;
+
+    uint8_t routeCount = WebInterface::getRouteCount();
+    for (uint8_t i = 0; i < routeCount; i++) {
+        const WebInterface::WebRoute& route = WebInterface::getRoute(i);
+        ArRequestHandlerFunction onRequest = [this](AsyncWebServerRequest *request){
+            dispatch(request);
+        };
+
+        if (route.method == WebMethod::POST) {
+            server->on(route.path, HTTP_POST, onRequest, NULL, collectBody);
+        } else {
+            server->on(route.path, HTTP_GET, onRequest);
+        }
+    }
+
+    // Catch-all for other requests
+    server->onNotFound([this](AsyncWebServerRequest *request){
+        dispatch(request);
+    });
+
+    server->begin();
+    Serial.printf("[WebInterface] %u routes configured and server started\n", routeCount);
+}
+
+void AsyncWebInterface::dispatch(AsyncWebServerRequest* request) {
+    WebMethod method = request->method() == HTTP_POST ? WebMethod::POST : WebMethod::GET;
+    bool probe = WebInterface::isProbe(WebInterface::findRoute(method, request->url().c_str()));
+
+    WebAdmission& admission = _wifiManager->getWebAdmission();
+    uint32_t clientIp = (uint32_t)request->client()->remoteIP();
+
+    switch (admission.admit(clientIp, probe, ESP.getFreeHeap(), millis())) {
+        case WebAdmit::ACCEPT: {
+            // Slot is held until the response has gone out
+            WebAdmission* slot = &admission;
+            request->onDisconnect([slot](){
+                slot->release();
+            });
+
+            AsyncRequestAdapter adapter(request);
+            _interface.handle(adapter);
+            break;
+        }
+
+        case WebAdmit::PROBE: {
+            // The library allocates the response (see WebAdmission.h)
+            uint32_t heapBefore = ESP.getFreeHeap();
+            request->redirect("/");
+            admission.noteProbeHeap(heapBefore, ESP.getFreeHeap());
+            break;
+        }
+
+        case WebAdmit::SHED_RATE:
+            request->send(429, "text/plain", "Too many requests");
+            break;
+
+        case WebAdmit::SHED_BUSY:
+        case WebAdmit::SHED_HEAP:
+            request->send(503, "text/plain", "Busy");
+            break;
+    }
+
+    // Free the body here; the server would release _tempObject with free()
+    String* body = (String*)request->_tempObject;
+    if (body != nullptr) {
+        delete body;
+        request->_tempObject = nullptr;
+    }
+}
+
+// ============================================================================
+// DEVICE BACKEND
+// ============================================================================
+
+int DeviceWebBackend::scanNetworks() {
+    Serial.println("[WebInterface] Scanning for networks...");
+    int numNetworks = WiFi.scanNetworks();
+    Serial.printf("[WebInterface] Found %d networks\n", numNetworks);
+    return numNetworks;
+}
+
+bool DeviceWebBackend::getNetwork(int index, WebNetwork& network) {
+    String ssid = WiFi.SSID(index);
+    strncpy(network.ssid, ssid.c_str(), sizeof(network.ssid) - 1);
+    network.ssid[sizeof(network.ssid) - 1] = '\0';
+    network.rssi = (int8_t)WiFi.RSSI(index);
+    network.encrypted = WiFi.encryptionType(index) != WIFI_AUTH_OPEN;
+    return true;
+}
+
+void DeviceWebBackend::saveCredentials(const char* ssid, const char* password) {
+    Serial.printf("[WebInterface] Connection request for: %s\n", ssid);
+    _wifiManager->saveCredentials(ssid, password);
+}
+
+void DeviceWebBackend::getStatus(WebStatus& status) {
+    status.connected = _wifiManager->isConnected();
+    status.state = (int)_wifiManager->getState();
+    if (status.connected) {
+        strncpy(status.ssid, _wifiManager->getSSID(), sizeof(status.ssid) - 1);
+        strncpy(status.ip, _wifiManager->getIPAddress().c_str(), sizeof(status.ip) - 1);
+        status.rssi = _wifiManager->getSignalStrength();
+    }
+    status.freeHeap = ESP.getFreeHeap();
+
+    const CaptiveDns* dns = _wifiManager->getCaptiveDns();
+    if (dns != nullptr) {
+        const CaptiveDnsStats& dnsStats = dns->getStats();
+        status.hasDns = true;
+        status.dnsQueries = dnsStats.queries;
+        status.dnsAnswered = dnsStats.answered;
+        status.dnsRejected = dnsStats.rejected;
+        status.dnsPeakPerSec = dnsStats.peakPerSec;
+        status.dnsMaxUs = dnsStats.maxHandleUs;
+    }
+}
+
+const WebAdmissionStats& DeviceWebBackend::getWebStats() {
+    return _wifiManager->getWebStats();
+}
+
+const DeviceConfig& DeviceWebBackend::getDeviceConfig() {
+    return _wifiManager->getDeviceConfig();
+}
+
+void DeviceWebBackend::saveDeviceConfig(const DeviceConfig& config) {
+    _wifiManager->saveDeviceConfig(config);
+}
+
+void DeviceWebBackend::restart() {
+    Serial.println("[WebInterface] Configuration saved, restarting...");
+
+    // Restart device after a delay to allow response to be sent
+    delay(500);
+    ESP.restart();
+}
+
+bool DeviceWebBackend::getProfileStatus(WebProfileStatus& status) {
+    SamplingProfiler* profiler = _wifiManager->getProfiler();
+    if (profiler == nullptr) return false;
+
+    status.running = profiler->isRunning();
+    status.rateHz = profiler->getRateHz();
+    status.depth = profiler->getDepth();
+    status.samples = profiler->getSampleCount();
+    status.taken = profiler->getTotalSamples();
+    status.capacity = profiler->getCapacity();
+    return true;
+}
+
+bool DeviceWebBackend::startProfiler(uint32_t rateHz, uint8_t depth) {
+    SamplingProfiler* profiler = _wifiManager->getProfiler();
+    if (profiler == nullptr) return false;
+    return profiler->start(rateHz > 0 ? rateHz : SamplingProfiler::DEFAULT_RATE_HZ, depth);
+}
+
+void DeviceWebBackend::stopProfiler() {
+    SamplingProfiler* profiler = _wifiManager->getProfiler();
+    if (profiler != nullptr) profiler->stop();
+}
+
+size_t DeviceWebBackend::formatProfileHeader(char* out, size_t size) {
+    SamplingProfiler* profiler = _wifiManager->getProfiler();
+    return profiler != nullptr ? profiler->formatHeader(out, size) : 0;
+}
+
+size_t DeviceWebBackend::formatProfileSample(uint32_t index, char* out, size_t size) {
+    SamplingProfiler* profiler = _wifiManager->getProfiler();
+    return profiler != nullptr ? profiler->formatSample(index, out, size) : 0;
+}
@@ -0,0 +1,61 @@
+#ifndef ASYNC_WEB_INTERFACE_H
+#define ASYNC_WEB_INTERFACE_H
+
+#include <Arduino.h>
+#include "WebBackend.h"
+#include "WebInterface.h"
+
+class WiFiManager;
+class AsyncWebServer;
+class AsyncWebServerRequest;
+
+// WebBackend over WiFiManager, the WiFi driver and the sampling profiler
+class DeviceWebBackend : public WebBackend {
+public:
+    explicit DeviceWebBackend(WiFiManager* wifiManager) : _wifiManager(wifiManager) {}
+
+    int scanNetworks() override;
+    bool getNetwork(int index, WebNetwork& network) override;
+
+    void saveCredentials(const char* ssid, const char* password) override;
+    void getStatus(WebStatus& status) override;
+    const WebAdmissionStats& getWebStats() override;
+
+    const DeviceConfig& getDeviceConfig() override;
+    void saveDeviceConfig(const DeviceConfig& config) override;
+
+    void restart() override;
+    uint32_t uptimeMs() override { return millis(); }
+
+    bool getProfileStatus(WebProfileStatus& status) override;
+    bool startProfiler(uint32_t rateHz, uint8_t depth) override;
+    void stopProfiler() override;
+    size_t formatProfileHeader(char* out, size_t size) override;
+    size_t formatProfileSample(uint32_t index, char* out, size_t size) override;
+
+private:
+    WiFiManager* _wifiManager;
+};
+
+// Serves WebInterface on AsyncWebServer
+//
+// Registers every route of the table, runs each request through
+// WebAdmission first and collects POST bodies (capped at MAX_BODY_SIZE)
+// before the handler runs.
+class AsyncWebInterface {
+public:
+    AsyncWebInterface(WiFiManager* wifiManager);
+
+    // Setup all web server routes
+    void setupRoutes(AsyncWebServer* server);
+
+private:
+    WiFiManager* _wifiManager;
+    DeviceWebBackend _backend;
+    WebInterface _interface;
+
+    // Admission control, then WebInterface::handle()
+    void dispatch(AsyncWebServerRequest* request);
+};
+
+#endif // ASYNC_WEB_INTERFACE_H
@@ -0,0 +1,97 @@
+#include "CaptiveDns.h"
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <AsyncUDP.h>
+
+CaptiveDns::CaptiveDns()
+    : _udp(nullptr), _running(false), _secondStartMs(0), _queriesThisSecond(0) {
+    memset(_answer, 0, sizeof(_answer));
+}
+
+CaptiveDns::~CaptiveDns() {
+    stop();
+    delete _udp;
+}
+
+bool CaptiveDns::start(const IPAddress& apIP, uint16_t port) {
+    stop();
+
+    const uint8_t address[4] = {apIP[0], apIP[1], apIP[2], apIP[3]};
+    buildAnswer(address, _answer);
+
+    if (_udp == nullptr) {
+        _udp = new AsyncUDP();
+    }
+    if (!_udp->listen(port)) {
+        Serial.println("[CaptiveDns] Failed to listen");
+        return false;
+    }
+
+    _udp->onPacket([this](AsyncUDPPacket& packet){
+        handlePacket(packet);
+    });
+
+    _running = true;
+    Serial.printf("[CaptiveDns] Answering on port %u with %s\n", port, apIP.toString().c_str());
+    return true;
+}
+
+void CaptiveDns::stop() {
+    if (!_running) return;
+    _udp->close();
+    _running = false;
+}
+
+// Runs in the AsyncUDP task
+void CaptiveDns::handlePacket(AsyncUDPPacket& packet) {
+    uint32_t startUs = micros();
+    uint32_t nowMs = millis();
+
+    _stats.queries++;
+    if (nowMs - _secondStartMs >= 1000) {
+        _secondStartMs = nowMs;
+        _queriesThisSecond = 0;
+    }
+    if (++_queriesThisSecond > _stats.peakPerSec) {
+        _stats.peakPerSec = _queriesThisSecond;
+    }
+
+    bool isAddress = false;
+    size_t length = buildResponse(packet.data(), packet.length(), _answer,
+                                  _response, sizeof(_response), &isAddress);
+    if (length == 0) {
+        _stats.rejected++;
+        return;
+    }
+
+    packet.write(_response, length);
+
+    if (length == HEADER_SIZE) {
+        _stats.rejected++;  // Error reply
+        return;
+    }
+    if (isAddress) {
+        _stats.answered++;
+    } else {
+        _stats.empty++;
+    }
+
+    uint32_t elapsedUs = micros() - startUs;
+    _stats.totalHandleUs += elapsedUs;
+    if (elapsedUs > _stats.maxHandleUs) {
+        _stats.maxHandleUs = elapsedUs;
+    }
+}
+
+void CaptiveDns::printStats() const {
+    uint32_t handled = _stats.answered + _stats.empty;
+    Serial.printf("[CaptiveDns] %lu queries (%lu A, %lu empty, %lu rejected), peak %u/s, "
+                  "handle avg %lu us max %lu us\n",
+                  (unsigned long)_stats.queries,
+                  (unsigned long)_stats.answered,
+                  (unsigned long)_stats.empty,
+                  (unsigned long)_stats.rejected,
+                  _stats.peakPerSec,
+                  (unsigned long)(handled ? _stats.totalHandleUs / handled : 0),
+                  (unsigned long)_stats.maxHandleUs);
+}
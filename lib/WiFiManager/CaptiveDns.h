@@ -0,0 +1,70 @@
+#ifndef CAPTIVE_DNS_H
+#define CAPTIVE_DNS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+class IPAddress;
+class AsyncUDP;
+class AsyncUDPPacket;
+
+// Captive DNS counters
+struct CaptiveDnsStats {
+    uint32_t queries = 0;       // Packets received
+    uint32_t answered = 0;      // A records returned
+    uint32_t empty = 0;         // Other query types (AAAA, HTTPS...) answered with no records
+    uint32_t rejected = 0;      // Malformed or not a standard query
+    uint16_t peakPerSec = 0;    // Most queries seen in one second
+    uint32_t maxHandleUs = 0;   // Slowest parse + build + send
+    uint32_t totalHandleUs = 0;
+};
+
+// Captive portal DNS responder on AsyncUDP
+//
+// Every query is answered from the AsyncUDP task as soon as it arrives,
+// independent of the main loop: A queries for any name resolve to the AP
+// address, other types get an empty NOERROR answer so phones don't wait
+// for an AAAA timeout. Responses are built in a static buffer from a
+// precomputed answer record; nothing is allocated per query.
+class CaptiveDns {
+public:
+    CaptiveDns();
+    ~CaptiveDns();
+
+    bool start(const IPAddress& apIP, uint16_t port = 53);
+    void stop();
+    bool isRunning() const { return _running; }
+
+    const CaptiveDnsStats& getStats() const { return _stats; }
+    void printStats() const;
+
+    // Build the response to a query into out; returns its length, or 0 to
+    // drop the packet. answer is the precomputed A record (ANSWER_SIZE bytes).
+    // Packet code lives in CaptiveDnsPacket.cpp, which needs no Arduino
+    // headers (tools/dns_burst_check.cpp runs it on the host).
+    static size_t buildResponse(const uint8_t* query, size_t length,
+                                const uint8_t* answer, uint8_t* out, size_t outSize,
+                                bool* isAddress = nullptr);
+
+    // Precompute the A record answering with address (4 bytes, network order)
+    static void buildAnswer(const uint8_t* address, uint8_t* answer);
+
+    static constexpr size_t HEADER_SIZE = 12;
+    static constexpr size_t ANSWER_SIZE = 16;
+    static constexpr size_t MAX_PACKET = 512;
+    static constexpr uint32_t TTL_SECS = 60;
+
+private:
+    AsyncUDP* _udp;
+    bool _running;
+    uint8_t _answer[ANSWER_SIZE];
+    uint8_t _response[MAX_PACKET];
+
+    CaptiveDnsStats _stats;
+    uint32_t _secondStartMs;
+    uint16_t _queriesThisSecond;
+
+    void handlePacket(AsyncUDPPacket& packet);
+};
+
+#endif // CAPTIVE_DNS_H
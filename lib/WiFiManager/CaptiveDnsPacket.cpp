@@ -0,0 +1,95 @@
+#include "CaptiveDns.h"
+#include <string.h>
+
+// DNS header flags (RFC 1035 4.1.1)
+static constexpr uint8_t FLAG_QR = 0x80;        // Byte 2: response
+static constexpr uint8_t FLAG_AA = 0x04;        // Byte 2: authoritative
+static constexpr uint8_t FLAG_RD = 0x01;        // Byte 2: recursion desired (echoed)
+static constexpr uint8_t FLAG_RA = 0x80;        // Byte 3: recursion available
+static constexpr uint8_t RCODE_FORMERR = 1;
+static constexpr uint8_t RCODE_NOTIMP = 4;
+
+static constexpr uint16_t TYPE_A = 1;
+static constexpr uint16_t TYPE_ANY = 255;
+static constexpr uint16_t CLASS_IN = 1;
+
+size_t CaptiveDns::buildResponse(const uint8_t* query, size_t length,
+                                 const uint8_t* answer, uint8_t* out, size_t outSize,
+                                 bool* isAddress) {
+    if (isAddress) *isAddress = false;
+    if (length < HEADER_SIZE || outSize < HEADER_SIZE) return 0;
+    if (query[2] & FLAG_QR) return 0;  // Never answer a response
+
+    uint8_t opcode = (query[2] >> 3) & 0x0F;
+    uint16_t questions = (query[4] << 8) | query[5];
+
+    // Header-only error reply for anything but a single standard question
+    uint8_t rcode = 0;
+    if (opcode != 0) {
+        rcode = RCODE_NOTIMP;
+    } else if (questions != 1) {
+        rcode = RCODE_FORMERR;
+    }
+
+    // Question name: plain labels up to the root label. A question that
+    // doesn't parse (truncated, compressed) is dropped: a reply could only
+    // echo garbage, and the client retries anyway
+    size_t pos = HEADER_SIZE;
+    while (rcode == 0) {
+        if (pos >= length) return 0;
+        uint8_t label = query[pos];
+        if (label == 0) {
+            pos++;
+            break;
+        }
+        if (label & 0xC0) return 0;  // No compression in a question
+        pos += 1 + label;
+    }
+
+    size_t questionEnd = pos + 4;  // QTYPE + QCLASS
+    if (rcode == 0 && questionEnd > length) return 0;
+
+    if (rcode != 0) {
+        memcpy(out, query, HEADER_SIZE);
+        out[2] = FLAG_QR | (query[2] & 0x78) | (query[2] & FLAG_RD);
+        out[3] = FLAG_RA | rcode;
+        memset(out + 4, 0, 8);
+        return HEADER_SIZE;
+    }
+
+    uint16_t qtype = (query[pos] << 8) | query[pos + 1];
+    uint16_t qclass = (query[pos + 2] << 8) | query[pos + 3];
+    bool address = (qtype == TYPE_A || qtype == TYPE_ANY) && qclass == CLASS_IN;
+
+    const size_t answerSize = ANSWER_SIZE;
+    size_t total = questionEnd + (address ? answerSize : 0);
+    if (total > outSize) return 0;
+
+    // Header + question echoed; EDNS and other records after it dropped
+    memcpy(out, query, questionEnd);
+    out[2] = FLAG_QR | FLAG_AA | (query[2] & FLAG_RD);
+    out[3] = FLAG_RA;
+    out[6] = 0;
+    out[7] = address ? 1 : 0;      // ANCOUNT
+    memset(out + 8, 0, 4);         // NSCOUNT, ARCOUNT
+
+    if (address) {
+        memcpy(out + questionEnd, answer, answerSize);
+    }
+
+    if (isAddress) *isAddress = address;
+    return total;
+}
+
+void CaptiveDns::buildAnswer(const uint8_t* address, uint8_t* answer) {
+    // Pointer to the question name, A, IN, TTL, 4-byte address
+    const uint8_t record[ANSWER_SIZE] = {
+        0xC0, 0x0C,
+        0x00, TYPE_A,
+        0x00, CLASS_IN,
+        (uint8_t)(TTL_SECS >> 24), (uint8_t)(TTL_SECS >> 16), (uint8_t)(TTL_SECS >> 8), (uint8_t)TTL_SECS,
+        0x00, 0x04,
+        address[0], address[1], address[2], address[3]
+    };
+    memcpy(answer, record, ANSWER_SIZE);
+}
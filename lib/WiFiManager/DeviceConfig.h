@@ -0,0 +1,19 @@
+#ifndef DEVICE_CONFIG_H
+#define DEVICE_CONFIG_H
+
+#include <stdint.h>
+
+// Device configuration (setup wizard settings)
+struct DeviceConfig {
+    bool setupComplete = false;       // Has wizard been completed?
+    bool wifiEnabled = true;          // Allow WiFi connection
+    bool geolocationEnabled = true;   // Allow IP geolocation
+    bool weatherEnabled = true;       // Allow weather fetching
+    bool ntpEnabled = true;           // Allow NTP time sync
+    int32_t manualTimezoneOffset = 0; // Manual timezone (seconds from UTC)
+    bool termsAccepted = false;       // Legal terms accepted
+    bool privacyAccepted = false;     // Privacy policy accepted
+    uint32_t consentTimestamp = 0;    // When consent was given (epoch)
+};
+
+#endif // DEVICE_CONFIG_H
@@ -0,0 +1,81 @@
+#ifndef MEMORY_WEB_REQUEST_H
+#define MEMORY_WEB_REQUEST_H
+
+#include <string.h>
+#include "WebRequest.h"
+
+// WebRequest that lives entirely in memory
+//
+// Feeds a fixed method/path/body to WebInterface::handle() and records the
+// response, so handlers can be timed or driven in a loop without a phone,
+// an access point or AsyncTCP. The first RESPONSE_CAPTURE bytes of the
+// response are kept; the full length is always reported.
+class MemoryWebRequest : public WebRequest {
+public:
+    static constexpr size_t RESPONSE_CAPTURE = 256;
+
+    MemoryWebRequest(WebMethod method, const char* path, const char* body = nullptr)
+        : method_(method), path_(path), body_(body) {
+        reset();
+    }
+
+    // Clear the recorded response to reuse the request
+    void reset() {
+        status_ = 0;
+        contentType_ = nullptr;
+        location_ = nullptr;
+        responseLength_ = 0;
+        responses_ = 0;
+        response_[0] = '\0';
+    }
+
+    WebMethod method() const override { return method_; }
+    const char* path() const override { return path_; }
+    const char* body() const override { return body_; }
+
+    void send(int code, const char* contentType, const char* content) override {
+        record(code, contentType, content);
+    }
+
+    void sendFlash(int code, const char* contentType, const char* content) override {
+        record(code, contentType, content);  // Flash is memory-mapped on the ESP32
+    }
+
+    void redirect(const char* location) override {
+        record(302, nullptr, "");
+        location_ = location;
+    }
+
+    // Recorded response
+    int status() const { return status_; }
+    const char* contentType() const { return contentType_; }
+    const char* location() const { return location_; }
+    const char* response() const { return response_; }
+    size_t responseLength() const { return responseLength_; }
+    uint8_t responseCount() const { return responses_; }  // >1 means a handler answered twice
+
+private:
+    WebMethod method_;
+    const char* path_;
+    const char* body_;
+
+    int status_;
+    const char* contentType_;
+    const char* location_;
+    size_t responseLength_;
+    uint8_t responses_;
+    char response_[RESPONSE_CAPTURE];
+
+    void record(int code, const char* contentType, const char* content) {
+        status_ = code;
+        contentType_ = contentType;
+        responseLength_ = strlen(content);
+        responses_++;
+
+        size_t keep = responseLength_ < RESPONSE_CAPTURE - 1 ? responseLength_ : RESPONSE_CAPTURE - 1;
+        memcpy(response_, content, keep);
+        response_[keep] = '\0';
+    }
+};
+
+#endif // MEMORY_WEB_REQUEST_H
@@ -0,0 +1,103 @@
+#include "WebAdmission.h"
+#include <Arduino.h>
+
+WebAdmission::WebAdmission()
+    : _clientCount(0) {
+    memset(_clients, 0, sizeof(_clients));
+}
+
+WebAdmit WebAdmission::admit(uint32_t clientIp, bool isProbe, uint32_t freeHeap, uint32_t nowMs) {
+    if (freeHeap < _stats.minFreeHeap) {
+        _stats.minFreeHeap = freeHeap;
+    }
+
+    if (freeHeap < MIN_FREE_HEAP) {
+        _stats.shedHeap++;
+        return WebAdmit::SHED_HEAP;
+    }
+
+    if (!takeToken(clientIp, nowMs)) {
+        _stats.shedRate++;
+        return WebAdmit::SHED_RATE;
+    }
+
+    if (isProbe) {
+        _stats.probes++;
+        return WebAdmit::PROBE;
+    }
+
+    if (_stats.active >= MAX_ACTIVE) {
+        _stats.shedBusy++;
+        return WebAdmit::SHED_BUSY;
+    }
+
+    _stats.active++;
+    if (_stats.active > _stats.peakActive) {
+        _stats.peakActive = _stats.active;
+    }
+    _stats.served++;
+    return WebAdmit::ACCEPT;
+}
+
+void WebAdmission::release() {
+    if (_stats.active > 0) {
+        _stats.active--;
+    }
+}
+
+void WebAdmission::noteProbeHeap(uint32_t heapBefore, uint32_t heapAfter) {
+    if (heapAfter < heapBefore && heapBefore - heapAfter > _stats.probeHeapBytes) {
+        _stats.probeHeapBytes = heapBefore - heapAfter;
+    }
+}
+
+bool WebAdmission::takeToken(uint32_t clientIp, uint32_t nowMs) {
+    Client* client = nullptr;
+    for (uint8_t i = 0; i < _clientCount; i++) {
+        if (_clients[i].ip == clientIp) {
+            client = &_clients[i];
+            break;
+        }
+    }
+
+    // New client: free entry, else the one idle the longest
+    if (client == nullptr) {
+        if (_clientCount < MAX_CLIENTS) {
+            client = &_clients[_clientCount++];
+        } else {
+            client = &_clients[0];
+            for (uint8_t i = 1; i < MAX_CLIENTS; i++) {
+                if ((int32_t)(_clients[i].lastRefillMs - client->lastRefillMs) < 0) {
+                    client = &_clients[i];
+                }
+            }
+        }
+        client->ip = clientIp;
+        client->tokens = BURST;
+        client->lastRefillMs = nowMs;
+    }
+
+    uint32_t refill = (nowMs - client->lastRefillMs) / REFILL_MS;
+    if (refill > 0) {
+        uint32_t tokens = client->tokens + refill;
+        client->tokens = tokens > BURST ? (uint8_t)BURST : (uint8_t)tokens;
+        client->lastRefillMs += refill * REFILL_MS;
+    }
+
+    if (client->tokens == 0) return false;
+    client->tokens--;
+    return true;
+}
+
+void WebAdmission::printStats() const {
+    Serial.printf("[WebAdmission] Served %lu, probes %lu, shed busy/rate/heap %lu/%lu/%lu, "
+                  "peak active %u, min heap %lu, probe response %lu bytes\n",
+                  (unsigned long)_stats.served,
+                  (unsigned long)_stats.probes,
+                  (unsigned long)_stats.shedBusy,
+                  (unsigned long)_stats.shedRate,
+                  (unsigned long)_stats.shedHeap,
+                  _stats.peakActive,
+                  (unsigned long)(_stats.minFreeHeap == UINT32_MAX ? 0 : _stats.minFreeHeap),
+                  (unsigned long)_stats.probeHeapBytes);
+}
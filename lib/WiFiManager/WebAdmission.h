@@ -0,0 +1,81 @@
+#ifndef WEB_ADMISSION_H
+#define WEB_ADMISSION_H
+
+#include <stdint.h>
+
+// Admission decision for one incoming request
+enum class WebAdmit : uint8_t {
+    ACCEPT,        // Run the handler (holds a slot until release())
+    PROBE,         // Captive portal probe: answer with the redirect to "/"
+    SHED_BUSY,     // Too many requests in flight -> 503
+    SHED_RATE,     // Client over its rate limit -> 429
+    SHED_HEAP      // Heap below the reserve -> 503
+};
+
+// Web server counters
+struct WebAdmissionStats {
+    uint32_t served = 0;        // Handlers run
+    uint32_t probes = 0;        // Probes answered without taking a slot
+    uint32_t shedBusy = 0;
+    uint32_t shedRate = 0;
+    uint32_t shedHeap = 0;
+    uint8_t active = 0;         // Requests currently holding a slot
+    uint8_t peakActive = 0;
+    uint32_t minFreeHeap = UINT32_MAX;  // Lowest heap seen at admission
+    uint32_t probeHeapBytes = 0;        // Largest heap held by one probe response
+};
+
+// Admission control for the captive portal web server
+//
+// Phones fire bursts of connectivity probes at the portal; every AsyncTCP
+// connection costs a few KB, so the server must say no early instead of
+// running out of heap. Checks, cheapest first:
+//   1. Heap reserve: below MIN_FREE_HEAP everything gets a 503
+//   2. Per-client token bucket (probes included), keyed by IPv4 address
+//   3. Probes never take a slot; they get a redirect to "/"
+//   4. At most MAX_ACTIVE handlers in flight
+// The probe path is cheap but not allocation-free: ESPAsyncWebServer
+// allocates every response and the request deletes it, so there is no
+// prebuilt response to reuse, and writing on the raw AsyncClient from a
+// handler would race the reply the library sends afterwards. Each probe
+// costs a response object plus its Location header; noteProbeHeap()
+// records the largest such cost measured on the device.
+// Not thread-safe; only called from the AsyncTCP task.
+class WebAdmission {
+public:
+    static constexpr uint8_t MAX_ACTIVE = 3;
+    static constexpr uint32_t MIN_FREE_HEAP = 24 * 1024;
+
+    // Token bucket per client: BURST requests, refilled at one per REFILL_MS
+    static constexpr uint8_t BURST = 12;
+    static constexpr uint32_t REFILL_MS = 250;
+    static constexpr uint8_t MAX_CLIENTS = 6;
+
+    WebAdmission();
+
+    WebAdmit admit(uint32_t clientIp, bool isProbe, uint32_t freeHeap, uint32_t nowMs);
+
+    // Give back the slot of an ACCEPTed request
+    void release();
+
+    // Free heap before and after queueing a probe response
+    void noteProbeHeap(uint32_t heapBefore, uint32_t heapAfter);
+
+    const WebAdmissionStats& getStats() const { return _stats; }
+    void printStats() const;
+
+private:
+    struct Client {
+        uint32_t ip;
+        uint32_t lastRefillMs;
+        uint8_t tokens;
+    };
+
+    Client _clients[MAX_CLIENTS];
+    uint8_t _clientCount;
+    WebAdmissionStats _stats;
+
+    bool takeToken(uint32_t clientIp, uint32_t nowMs);
+};
+
+#endif // WEB_ADMISSION_H
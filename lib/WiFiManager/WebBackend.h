@@ -0,0 +1,79 @@
+#ifndef WEB_BACKEND_H
+#define WEB_BACKEND_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "DeviceConfig.h"
+#include "WebAdmission.h"
+
+// One network from a scan
+struct WebNetwork {
+    char ssid[33];
+    int8_t rssi;
+    bool encrypted;
+};
+
+// Connection and captive DNS state reported on /status
+struct WebStatus {
+    bool connected = false;
+    int state = 0;              // WiFiState while not connected
+    char ssid[33] = "";
+    char ip[16] = "";
+    int8_t rssi = 0;
+    uint32_t freeHeap = 0;
+
+    bool hasDns = false;        // Captive DNS running
+    uint32_t dnsQueries = 0;
+    uint32_t dnsAnswered = 0;
+    uint32_t dnsRejected = 0;
+    uint16_t dnsPeakPerSec = 0;
+    uint32_t dnsMaxUs = 0;
+};
+
+// Sampling profiler state reported on GET /profile
+struct WebProfileStatus {
+    bool running = false;
+    uint32_t rateHz = 0;
+    uint8_t depth = 0;
+    uint32_t samples = 0;       // Held in the ring
+    uint32_t taken = 0;         // Since start, including overwritten ones
+    uint32_t capacity = 0;
+};
+
+// Everything the WebInterface handlers need from the device
+//
+// Keeps the handlers free of WiFi, AsyncWebServer and the profiler's
+// timer code: on the ESP32 it is implemented over WiFiManager
+// (AsyncWebInterface.cpp), on the host by tools/web_load.cpp.
+class WebBackend {
+public:
+    // Longest profiler header and sample line, including NUL
+    static constexpr size_t PROFILE_HEADER_BYTES = 96;
+    static constexpr size_t PROFILE_SAMPLE_BYTES = 64;
+
+    virtual ~WebBackend() {}
+
+    // Blocking scan; returns the number of networks found
+    virtual int scanNetworks() = 0;
+    virtual bool getNetwork(int index, WebNetwork& network) = 0;
+
+    virtual void saveCredentials(const char* ssid, const char* password) = 0;
+    virtual void getStatus(WebStatus& status) = 0;
+    virtual const WebAdmissionStats& getWebStats() = 0;
+
+    virtual const DeviceConfig& getDeviceConfig() = 0;
+    virtual void saveDeviceConfig(const DeviceConfig& config) = 0;
+
+    // Restart once the response had time to go out
+    virtual void restart() = 0;
+    virtual uint32_t uptimeMs() = 0;
+
+    // Profiler; false/0 everywhere when there is none
+    virtual bool getProfileStatus(WebProfileStatus& status) = 0;
+    virtual bool startProfiler(uint32_t rateHz, uint8_t depth) = 0;     // rateHz 0 = default
+    virtual void stopProfiler() = 0;
+    virtual size_t formatProfileHeader(char* out, size_t size) = 0;
+    virtual size_t formatProfileSample(uint32_t index, char* out, size_t size) = 0;
+};
+
+#endif // WEB_BACKEND_H
@@ -1,11 +1,12 @@
 #include "WebInterface.h"
-#include "WiFiManager.h"
-#include <ESPAsyncWebServer.h>
-#include <WiFi.h>
-#include <ArduinoJson.h>
-
-// Multi-step configuration wizard HTML stored in PROGMEM
-const char PROGMEM html_wizard[] = R"rawliteral(
+#include "WebJson.h"
+#include <stdio.h>
+#include <string.h>
+#include <new>
+
+// Multi-step configuration wizard HTML. PROGMEM is empty on the ESP32:
+// const data is placed in flash and memory-mapped, so no attribute needed
+const char html_wizard[] = R"rawliteral(
 <!DOCTYPE html>
 <html>
 <head>
@@ -688,7 +689,7 @@ setInterval(() => { if (currentStep === 2) scanNetworks(); }, 15000);
 )rawliteral";
 
 // Terms of Service text
-const char PROGMEM terms_text[] = R"rawliteral(COOMPEL TERMS OF SERVICE
+const char terms_text[] = R"rawliteral(COOMPEL TERMS OF SERVICE
 
 1. DEVICE USAGE
 This device is designed for personal entertainment and productivity features including animations, clock, weather, and timer functions.
@@ -717,7 +718,7 @@ In no event shall the manufacturer be liable for any damages arising from the us
 Last updated: January 2025)rawliteral";
 
 // Privacy Policy text
-const char PROGMEM privacy_text[] = R"rawliteral(COOMPEL PRIVACY POLICY
+const char privacy_text[] = R"rawliteral(COOMPEL PRIVACY POLICY
 
 WHAT WE COLLECT
 When you enable location services, your device's public IP address is sent to geolocation services to determine your approximate city location. No precise GPS data is collected.
@@ -745,255 +746,323 @@ All data is stored locally on your device. We do not operate servers that collec
 
 Last updated: January 2025)rawliteral";
 
-WebInterface::WebInterface(WiFiManager* wifiManager)
-    : _wifiManager(wifiManager) {
-}
-
-void WebInterface::setupRoutes(AsyncWebServer* server) {
-    if (server == nullptr) return;
+// ============================================================================
+// ROUTES
+// ============================================================================
 
-    // Serve main setup page (wizard)
-    server->on("/", HTTP_GET, [this](AsyncWebServerRequest *request){
-        handleRoot(request);
-    });
+const WebInterface::WebRoute WebInterface::ROUTES[] = {
+    // Setup wizard
+    {"/",                          WebMethod::GET,  &WebInterface::handleRoot},
 
     // Captive portal detection URLs
-    server->on("/hotspot-detect.html", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
-    server->on("/generate_204", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
-    server->on("/gen_204", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
-    server->on("/library/test/success.html", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
-    server->on("/hotspot-detect.htm", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
-    server->on("/connectivity-check.html", HTTP_GET, [](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
+    {"/hotspot-detect.html",       WebMethod::GET,  &WebInterface::handleCaptivePortal},
+    {"/generate_204",              WebMethod::GET,  &WebInterface::handleCaptivePortal},
+    {"/gen_204",                   WebMethod::GET,  &WebInterface::handleCaptivePortal},
+    {"/library/test/success.html", WebMethod::GET,  &WebInterface::handleCaptivePortal},
+    {"/hotspot-detect.htm",        WebMethod::GET,  &WebInterface::handleCaptivePortal},
+    {"/connectivity-check.html",   WebMethod::GET,  &WebInterface::handleCaptivePortal},
 
     // API endpoints
-    server->on("/scan", HTTP_GET, [this](AsyncWebServerRequest *request){
-        handleScan(request);
-    });
-
-    server->on("/connect", HTTP_POST,
-        [this](AsyncWebServerRequest *request){
-            handleConnect(request);
-        },
-        NULL,
-        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-            if (index == 0) {
-                request->_tempObject = new String();
-            }
-            String* body = (String*)request->_tempObject;
-            for (size_t i = 0; i < len; i++) {
-                body->concat((char)data[i]);
-            }
-        });
-
-    server->on("/status", HTTP_GET, [this](AsyncWebServerRequest *request){
-        handleStatus(request);
-    });
+    {"/scan",                      WebMethod::GET,  &WebInterface::handleScan},
+    {"/connect",                   WebMethod::POST, &WebInterface::handleConnect},
+    {"/status",                    WebMethod::GET,  &WebInterface::handleStatus},
 
     // Configuration wizard endpoints
-    server->on("/config", HTTP_GET, [this](AsyncWebServerRequest *request){
-        handleGetConfig(request);
-    });
-
-    server->on("/config", HTTP_POST,
-        [this](AsyncWebServerRequest *request){
-            handleSaveConfig(request);
-        },
-        NULL,
-        [](AsyncWebServerRequest *request, uint8_t *data, size_t len, size_t index, size_t total){
-            if (index == 0) {
-                request->_tempObject = new String();
-            }
-            String* body = (String*)request->_tempObject;
-            for (size_t i = 0; i < len; i++) {
-                body->concat((char)data[i]);
-            }
-        });
+    {"/config",                    WebMethod::GET,  &WebInterface::handleGetConfig},
+    {"/config",                    WebMethod::POST, &WebInterface::handleSaveConfig},
+    {"/terms",                     WebMethod::GET,  &WebInterface::handleTerms},
+    {"/privacy",                   WebMethod::GET,  &WebInterface::handlePrivacy},
+
+    // Sampling profiler (tools/symbolize_profile.py --url)
+    {"/profile",                   WebMethod::GET,  &WebInterface::handleProfileStatus},
+    {"/profile",                   WebMethod::POST, &WebInterface::handleProfileControl},
+};
 
-    server->on("/terms", HTTP_GET, [this](AsyncWebServerRequest *request){
-        handleTerms(request);
-    });
+const uint8_t WebInterface::ROUTE_COUNT = sizeof(ROUTES) / sizeof(ROUTES[0]);
 
-    server->on("/privacy", HTTP_GET, [this](AsyncWebServerRequest *request){
-        handlePrivacy(request);
-    });
+WebInterface::WebInterface(WebBackend* backend)
+    : _backend(backend) {
+}
+
+bool WebInterface::handle(WebRequest& request) {
+    const WebRoute* route = findRoute(request.method(), request.path());
+    if (route == nullptr) {
+        handleCaptivePortal(request);
+        return false;
+    }
 
-    // Catch-all for other requests
-    server->onNotFound([](AsyncWebServerRequest *request){
-        request->redirect("/");
-    });
+    (this->*route->handler)(request);
+    return true;
+}
+
+const WebInterface::WebRoute* WebInterface::findRoute(WebMethod method, const char* path) {
+    for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        if (ROUTES[i].method == method && strcmp(ROUTES[i].path, path) == 0) {
+            return &ROUTES[i];
+        }
+    }
+    return nullptr;
+}
 
-    server->begin();
-    Serial.println("[WebInterface] Routes configured and server started");
+// Probes and unknown URLs only ever get the redirect to "/"
+bool WebInterface::isProbe(const WebRoute* route) {
+    return route == nullptr || route->handler == &WebInterface::handleCaptivePortal;
 }
 
-void WebInterface::handleRoot(AsyncWebServerRequest *request) {
-    request->send_P(200, "text/html", html_wizard);
+// ============================================================================
+// HANDLERS
+// ============================================================================
+
+void WebInterface::handleRoot(WebRequest& request) {
+    request.sendFlash(200, "text/html", html_wizard);
 }
 
-void WebInterface::handleScan(AsyncWebServerRequest *request) {
-    Serial.println("[WebInterface] Scanning for networks...");
+void WebInterface::handleCaptivePortal(WebRequest& request) {
+    request.redirect("/");
+}
 
-    int numNetworks = WiFi.scanNetworks();
+void WebInterface::handleScan(WebRequest& request) {
+    int numNetworks = _backend->scanNetworks();
 
-    StaticJsonDocument<2048> doc;
-    JsonArray networks = doc.to<JsonArray>();
+    char buffer[2048];
+    WebJsonWriter json(buffer, sizeof(buffer));
+    json.beginArray();
 
     for (int i = 0; i < numNetworks && i < 20; i++) {
-        JsonObject network = networks.createNestedObject();
-        network["ssid"] = WiFi.SSID(i);
-        network["rssi"] = WiFi.RSSI(i);
-        network["encrypted"] = (WiFi.encryptionType(i) != WIFI_AUTH_OPEN);
+        WebNetwork network;
+        if (!_backend->getNetwork(i, network)) break;
+
+        // Drop the networks that don't fit instead of sending broken JSON
+        WebJsonWriter::Mark mark = json.mark();
+        json.beginObject();
+        json.addString("ssid", network.ssid);
+        json.addInt("rssi", network.rssi);
+        json.addBool("encrypted", network.encrypted);
+        json.endObject();
+        if (json.overflowed()) {
+            json.rewind(mark);
+            break;
+        }
     }
 
-    String response;
-    serializeJson(doc, response);
-
-    request->send(200, "application/json", response);
-    Serial.printf("[WebInterface] Found %d networks\n", numNetworks);
+    json.endArray();
+    request.send(200, "application/json", json.c_str());
 }
 
-void WebInterface::handleConnect(AsyncWebServerRequest *request) {
-    if (request->_tempObject == nullptr) {
-        request->send(400, "application/json", "{\"success\":false,\"message\":\"No data provided\"}");
+void WebInterface::handleConnect(WebRequest& request) {
+    const char* body = request.body();
+    if (body == nullptr) {
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"No data provided\"}");
         return;
     }
 
-    String* bodyPtr = (String*)request->_tempObject;
-    String body = *bodyPtr;
-
-    StaticJsonDocument<512> reqDoc;
-    DeserializationError error = deserializeJson(reqDoc, body);
-
-    if (error) {
-        delete bodyPtr;
-        request->send(400, "application/json", "{\"success\":false,\"message\":\"Invalid JSON\"}");
+    WebJsonReader reqDoc;
+    if (!reqDoc.parse(body)) {
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"Invalid JSON\"}");
         return;
     }
 
-    const char* ssidPtr = reqDoc["ssid"];
-    const char* passwordPtr = reqDoc["password"];
-
-    char ssidBuf[33] = {0};
-    char passBuf[64] = {0};
-
-    if (ssidPtr != nullptr) {
-        strncpy(ssidBuf, ssidPtr, 32);
-    }
-    if (passwordPtr != nullptr) {
-        strncpy(passBuf, passwordPtr, 63);
-    }
-
-    delete bodyPtr;
-    request->_tempObject = nullptr;
-
-    Serial.printf("[WebInterface] Connection request for: %s\n", ssidBuf);
+    char ssidBuf[33];
+    char passBuf[64];
+    reqDoc.getString("ssid", ssidBuf, sizeof(ssidBuf));
+    reqDoc.getString("password", passBuf, sizeof(passBuf));
 
     if (strlen(ssidBuf) == 0) {
-        request->send(400, "application/json", "{\"success\":false,\"message\":\"SSID required\"}");
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"SSID required\"}");
         return;
     }
 
-    _wifiManager->saveCredentials(ssidBuf, passBuf);
-    request->send(200, "application/json", "{\"success\":true,\"message\":\"Credentials saved\"}");
+    _backend->saveCredentials(ssidBuf, passBuf);
+    request.send(200, "application/json", "{\"success\":true,\"message\":\"Credentials saved\"}");
 }
 
-void WebInterface::handleStatus(AsyncWebServerRequest *request) {
-    StaticJsonDocument<256> doc;
+void WebInterface::handleStatus(WebRequest& request) {
+    WebStatus status;
+    _backend->getStatus(status);
+
+    char buffer[512];
+    WebJsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
 
-    if (_wifiManager->isConnected()) {
-        doc["connected"] = true;
-        doc["ssid"] = _wifiManager->getSSID();
-        doc["ip"] = _wifiManager->getIPAddress();
-        doc["rssi"] = _wifiManager->getSignalStrength();
+    if (status.connected) {
+        json.addBool("connected", true);
+        json.addString("ssid", status.ssid);
+        json.addString("ip", status.ip);
+        json.addInt("rssi", status.rssi);
     } else {
-        doc["connected"] = false;
-        doc["state"] = (int)_wifiManager->getState();
+        json.addBool("connected", false);
+        json.addInt("state", status.state);
+    }
+
+    const WebAdmissionStats& web = _backend->getWebStats();
+    json.beginObject("server");
+    json.addUint("served", web.served);
+    json.addUint("probes", web.probes);
+    json.addUint("shedBusy", web.shedBusy);
+    json.addUint("shedRate", web.shedRate);
+    json.addUint("shedHeap", web.shedHeap);
+    json.addUint("peakActive", web.peakActive);
+    json.addUint("probeHeap", web.probeHeapBytes);
+    json.addUint("freeHeap", status.freeHeap);
+    json.endObject();
+
+    if (status.hasDns) {
+        json.beginObject("dns");
+        json.addUint("queries", status.dnsQueries);
+        json.addUint("answered", status.dnsAnswered);
+        json.addUint("rejected", status.dnsRejected);
+        json.addUint("peakPerSec", status.dnsPeakPerSec);
+        json.addUint("maxUs", status.dnsMaxUs);
+        json.endObject();
     }
 
-    String response;
-    serializeJson(doc, response);
-    request->send(200, "application/json", response);
+    json.endObject();
+    request.send(200, "application/json", json.c_str());
 }
 
-void WebInterface::handleGetConfig(AsyncWebServerRequest *request) {
-    const DeviceConfig& cfg = _wifiManager->getDeviceConfig();
-
-    StaticJsonDocument<512> doc;
-    doc["setupComplete"] = cfg.setupComplete;
-    doc["wifiEnabled"] = cfg.wifiEnabled;
-    doc["geolocationEnabled"] = cfg.geolocationEnabled;
-    doc["weatherEnabled"] = cfg.weatherEnabled;
-    doc["ntpEnabled"] = cfg.ntpEnabled;
-    doc["manualTimezoneOffset"] = cfg.manualTimezoneOffset;
-    doc["termsAccepted"] = cfg.termsAccepted;
-    doc["privacyAccepted"] = cfg.privacyAccepted;
-
-    String response;
-    serializeJson(doc, response);
-    request->send(200, "application/json", response);
+void WebInterface::handleGetConfig(WebRequest& request) {
+    const DeviceConfig& cfg = _backend->getDeviceConfig();
+
+    char buffer[256];
+    WebJsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addBool("setupComplete", cfg.setupComplete);
+    json.addBool("wifiEnabled", cfg.wifiEnabled);
+    json.addBool("geolocationEnabled", cfg.geolocationEnabled);
+    json.addBool("weatherEnabled", cfg.weatherEnabled);
+    json.addBool("ntpEnabled", cfg.ntpEnabled);
+    json.addInt("manualTimezoneOffset", cfg.manualTimezoneOffset);
+    json.addBool("termsAccepted", cfg.termsAccepted);
+    json.addBool("privacyAccepted", cfg.privacyAccepted);
+    json.endObject();
+
+    request.send(200, "application/json", json.c_str());
 }
 
-void WebInterface::handleSaveConfig(AsyncWebServerRequest *request) {
-    if (request->_tempObject == nullptr) {
-        request->send(400, "application/json", "{\"success\":false,\"message\":\"No data\"}");
+void WebInterface::handleSaveConfig(WebRequest& request) {
+    const char* body = request.body();
+    if (body == nullptr) {
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"No data\"}");
         return;
     }
 
-    String* bodyPtr = (String*)request->_tempObject;
-    String body = *bodyPtr;
-
-    StaticJsonDocument<512> doc;
-    DeserializationError error = deserializeJson(doc, body);
-
-    delete bodyPtr;
-    request->_tempObject = nullptr;
-
-    if (error) {
-        request->send(400, "application/json", "{\"success\":false,\"message\":\"Invalid JSON\"}");
+    WebJsonReader doc;
+    if (!doc.parse(body)) {
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"Invalid JSON\"}");
         return;
     }
 
     DeviceConfig cfg;
-    cfg.setupComplete = doc["setupComplete"] | false;
-    cfg.wifiEnabled = doc["wifiEnabled"] | true;
-    cfg.geolocationEnabled = doc["geolocationEnabled"] | true;
-    cfg.weatherEnabled = doc["weatherEnabled"] | true;
-    cfg.ntpEnabled = doc["ntpEnabled"] | true;
-    cfg.manualTimezoneOffset = doc["manualTimezoneOffset"] | 0;
-    cfg.termsAccepted = doc["termsAccepted"] | false;
-    cfg.privacyAccepted = doc["privacyAccepted"] | false;
-    cfg.consentTimestamp = millis() / 1000;  // Simple timestamp
-
-    _wifiManager->saveDeviceConfig(cfg);
-
-    Serial.println("[WebInterface] Configuration saved, restarting...");
-    request->send(200, "application/json", "{\"success\":true,\"message\":\"Saved\"}");
-
-    // Restart device after a delay to allow response to be sent
-    delay(500);
-    ESP.restart();
+    cfg.setupComplete = doc.getBool("setupComplete", false);
+    cfg.wifiEnabled = doc.getBool("wifiEnabled", true);
+    cfg.geolocationEnabled = doc.getBool("geolocationEnabled", true);
+    cfg.weatherEnabled = doc.getBool("weatherEnabled", true);
+    cfg.ntpEnabled = doc.getBool("ntpEnabled", true);
+    cfg.manualTimezoneOffset = doc.getInt("manualTimezoneOffset", 0);
+    cfg.termsAccepted = doc.getBool("termsAccepted", false);
+    cfg.privacyAccepted = doc.getBool("privacyAccepted", false);
+    cfg.consentTimestamp = _backend->uptimeMs() / 1000;  // Simple timestamp
+
+    _backend->saveDeviceConfig(cfg);
+    request.send(200, "application/json", "{\"success\":true,\"message\":\"Saved\"}");
+
+    _backend->restart();
 }
 
-void WebInterface::handleTerms(AsyncWebServerRequest *request) {
-    request->send_P(200, "text/plain", terms_text);
+void WebInterface::handleTerms(WebRequest& request) {
+    request.sendFlash(200, "text/plain", terms_text);
 }
 
-void WebInterface::handlePrivacy(AsyncWebServerRequest *request) {
-    request->send_P(200, "text/plain", privacy_text);
+void WebInterface::handlePrivacy(WebRequest& request) {
+    request.sendFlash(200, "text/plain", privacy_text);
 }
 
-String WebInterface::getSetupPageHTML() {
-    return String(html_wizard);
+// Profiler: GET returns status, POST {"action":"start","rate":500,"depth":2},
+// {"action":"stop"} or {"action":"dump","from":0}. A dump page is the header,
+// up to PROFILE_PAGE_SAMPLES sample lines and "# next=<from>" or "# end".
+void WebInterface::handleProfileStatus(WebRequest& request) {
+    WebProfileStatus status;
+    if (!_backend->getProfileStatus(status)) {
+        request.send(404, "application/json", "{\"success\":false,\"message\":\"No profiler\"}");
+        return;
+    }
+
+    char buffer[192];
+    WebJsonWriter json(buffer, sizeof(buffer));
+    json.beginObject();
+    json.addBool("running", status.running);
+    json.addUint("rate", status.rateHz);
+    json.addUint("depth", status.depth);
+    json.addUint("samples", status.samples);
+    json.addUint("taken", status.taken);
+    json.addUint("capacity", status.capacity);
+    json.endObject();
+
+    request.send(200, "application/json", json.c_str());
+}
+
+void WebInterface::handleProfileControl(WebRequest& request) {
+    WebProfileStatus status;
+    if (!_backend->getProfileStatus(status)) {
+        request.send(404, "application/json", "{\"success\":false,\"message\":\"No profiler\"}");
+        return;
+    }
+
+    const char* body = request.body();
+    WebJsonReader doc;
+    if (body == nullptr || !doc.parse(body)) {
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"Invalid JSON\"}");
+        return;
+    }
+
+    char action[8];
+    doc.getString("action", action, sizeof(action));
+
+    if (strcmp(action, "start") == 0) {
+        long rate = doc.getInt("rate", 0);
+        long depth = doc.getInt("depth", 0);
+        bool started = _backend->startProfiler(rate > 0 ? (uint32_t)rate : 0,
+                                               depth > 0 && depth < 256 ? (uint8_t)depth : 0);
+        request.send(started ? 200 : 503, "application/json",
+                     started ? "{\"success\":true}" : "{\"success\":false,\"message\":\"Start failed\"}");
+    } else if (strcmp(action, "stop") == 0) {
+        _backend->stopProfiler();
+        request.send(200, "application/json", "{\"success\":true}");
+    } else if (strcmp(action, "dump") == 0) {
+        _backend->stopProfiler();
+        _backend->getProfileStatus(status);
+
+        uint32_t count = status.samples;
+        long requested = doc.getInt("from", 0);
+        uint32_t from = requested > 0 ? (uint32_t)requested : 0;
+        if (from > count) from = count;
+        uint32_t to = count - from > PROFILE_PAGE_SAMPLES ? from + PROFILE_PAGE_SAMPLES : count;
+
+        // Lines are formatted straight into the page, one allocation per dump
+        const size_t TRAILER_BYTES = 24;
+        size_t size = WebBackend::PROFILE_HEADER_BYTES +
+                      (to - from) * WebBackend::PROFILE_SAMPLE_BYTES + TRAILER_BYTES;
+        char* page = new (std::nothrow) char[size];
+        if (page == nullptr) {
+            request.send(503, "application/json", "{\"success\":false,\"message\":\"Out of memory\"}");
+            return;
+        }
+
+        size_t length = _backend->formatProfileHeader(page, WebBackend::PROFILE_HEADER_BYTES);
+        page[length++] = '\n';
+        for (uint32_t i = from; i < to; i++) {
+            length += _backend->formatProfileSample(i, page + length, WebBackend::PROFILE_SAMPLE_BYTES);
+            page[length++] = '\n';
+        }
+        if (to < count) {
+            snprintf(page + length, size - length, "# next=%lu\n", (unsigned long)to);
+        } else {
+            snprintf(page + length, size - length, "# end\n");
+        }
+
+        request.send(200, "text/plain", page);
+        delete[] page;
+    } else {
+        request.send(400, "application/json", "{\"success\":false,\"message\":\"Unknown action\"}");
+    }
 }
@@ -1,37 +1,65 @@
 #ifndef WEB_INTERFACE_H
 #define WEB_INTERFACE_H
 
-#include <Arduino.h>
-
-class WiFiManager;
-class AsyncWebServer;
-class AsyncWebServerRequest;
+#include <stddef.h>
+#include <stdint.h>
+#include "WebRequest.h"
+#include "WebBackend.h"
 
+// Captive portal routes and their handlers
+//
+// Only sees WebRequest and WebBackend, so it builds without
+// ESPAsyncWebServer, WiFi or ArduinoJson and can be driven on the host
+// (tools/web_load.cpp). AsyncWebInterface serves it on the device.
 class WebInterface {
 public:
-    WebInterface(WiFiManager* wifiManager);
+    struct WebRoute {
+        const char* path;
+        WebMethod method;
+        void (WebInterface::*handler)(WebRequest& request);
+    };
+
+    WebInterface(WebBackend* backend);
+
+    // Dispatch one request through the route table; unknown paths get the
+    // captive portal redirect. Returns false when no route matched.
+    bool handle(WebRequest& request);
+
+    static uint8_t getRouteCount() { return ROUTE_COUNT; }
+    static const WebRoute& getRoute(uint8_t index) { return ROUTES[index]; }
+    static const WebRoute* findRoute(WebMethod method, const char* path);
 
-    // Setup all web server routes
-    void setupRoutes(AsyncWebServer* server);
+    // Probes and unknown paths (nullptr) are answered with the redirect
+    static bool isProbe(const WebRoute* route);
+
+    // Largest POST body buffered (bigger bodies are truncated and rejected as JSON)
+    static constexpr size_t MAX_BODY_SIZE = 1024;
+
+    // Samples per /profile dump page
+    static constexpr uint16_t PROFILE_PAGE_SAMPLES = 128;
 
 private:
-    WiFiManager* _wifiManager;
+    static const WebRoute ROUTES[];
+    static const uint8_t ROUTE_COUNT;
 
-    // HTML page generation
-    String getSetupPageHTML();
+    WebBackend* _backend;
 
     // API handlers
-    void handleRoot(AsyncWebServerRequest *request);
-    void handleScan(AsyncWebServerRequest *request);
-    void handleConnect(AsyncWebServerRequest *request);
-    void handleStatus(AsyncWebServerRequest *request);
-    void handleCaptivePortal(AsyncWebServerRequest *request);
+    void handleRoot(WebRequest& request);
+    void handleScan(WebRequest& request);
+    void handleConnect(WebRequest& request);
+    void handleStatus(WebRequest& request);
+    void handleCaptivePortal(WebRequest& request);
 
     // Configuration wizard endpoints
-    void handleGetConfig(AsyncWebServerRequest *request);
-    void handleSaveConfig(AsyncWebServerRequest *request);
-    void handleTerms(AsyncWebServerRequest *request);
-    void handlePrivacy(AsyncWebServerRequest *request);
+    void handleGetConfig(WebRequest& request);
+    void handleSaveConfig(WebRequest& request);
+    void handleTerms(WebRequest& request);
+    void handlePrivacy(WebRequest& request);
+
+    // Sampling profiler control and paged sample dump
+    void handleProfileStatus(WebRequest& request);
+    void handleProfileControl(WebRequest& request);
 };
 
 #endif // WEB_INTERFACE_H
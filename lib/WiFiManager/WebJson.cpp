@@ -0,0 +1,362 @@
+#include "WebJson.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Nesting accepted inside skipped member values
+static constexpr uint8_t MAX_SKIP_DEPTH = 8;
+
+// ============================================================================
+// WRITER
+// ============================================================================
+
+WebJsonWriter::WebJsonWriter(char* buffer, size_t size)
+    : _buffer(buffer), _size(size), _length(0), _depth(0), _needComma(false), _overflow(false) {
+    if (_size > 0) _buffer[0] = '\0';
+}
+
+void WebJsonWriter::append(const char* text, size_t length) {
+    if (_overflow) return;
+
+    // Keep one byte per open bracket plus the NUL
+    if (_length + length + _depth + 1 > _size) {
+        _overflow = true;
+        return;
+    }
+    memcpy(_buffer + _length, text, length);
+    _length += length;
+    _buffer[_length] = '\0';
+}
+
+void WebJsonWriter::key(const char* key) {
+    if (_needComma) append(',');
+    if (key == nullptr) return;
+
+    append('"');
+    append(key, strlen(key));
+    append("\":", 2);
+}
+
+void WebJsonWriter::open(const char* key, char bracket) {
+    this->key(key);
+    append(bracket);
+    _depth++;
+    _needComma = false;
+}
+
+void WebJsonWriter::close(char bracket) {
+    if (_depth > 0) _depth--;
+
+    // Always fits: the byte was reserved when the bracket was opened
+    if (_length + 1 < _size) {
+        _buffer[_length++] = bracket;
+        _buffer[_length] = '\0';
+    }
+    _needComma = true;
+}
+
+void WebJsonWriter::beginObject(const char* key) { open(key, '{'); }
+void WebJsonWriter::endObject() { close('}'); }
+void WebJsonWriter::beginArray(const char* key) { open(key, '['); }
+void WebJsonWriter::endArray() { close(']'); }
+
+void WebJsonWriter::addString(const char* key, const char* value) {
+    this->key(key);
+    append('"');
+
+    // Copy runs of plain characters, escape the rest
+    const char* run = value;
+    for (const char* p = value; *p != '\0'; p++) {
+        unsigned char c = (unsigned char)*p;
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        append(run, p - run);
+        run = p + 1;
+
+        char escaped[7];
+        if (c == '"' || c == '\\') {
+            escaped[0] = '\\';
+            escaped[1] = (char)c;
+            append(escaped, 2);
+        } else {
+            snprintf(escaped, sizeof(escaped), "\\u%04x", c);
+            append(escaped, 6);
+        }
+    }
+    append(run, strlen(run));
+
+    append('"');
+    _needComma = true;
+}
+
+void WebJsonWriter::addBool(const char* key, bool value) {
+    this->key(key);
+    if (value) {
+        append("true", 4);
+    } else {
+        append("false", 5);
+    }
+    _needComma = true;
+}
+
+void WebJsonWriter::addInt(const char* key, long value) {
+    char text[24];
+    int length = snprintf(text, sizeof(text), "%ld", value);
+    this->key(key);
+    append(text, length);
+    _needComma = true;
+}
+
+void WebJsonWriter::addUint(const char* key, unsigned long value) {
+    char text[24];
+    int length = snprintf(text, sizeof(text), "%lu", value);
+    this->key(key);
+    append(text, length);
+    _needComma = true;
+}
+
+void WebJsonWriter::rewind(const Mark& mark) {
+    _length = mark.length;
+    _needComma = mark.needComma;
+    _overflow = false;
+    if (_size > 0) _buffer[_length] = '\0';
+}
+
+// ============================================================================
+// READER
+// ============================================================================
+
+static const char* skipSpace(const char* p) {
+    while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') p++;
+    return p;
+}
+
+// p at the opening quote; returns past the closing one
+static const char* skipString(const char* p) {
+    p++;
+    while (*p != '"') {
+        if (*p == '\0' || (unsigned char)*p < 0x20) return nullptr;
+        if (*p == '\\') {
+            p++;
+            if (*p == '\0') return nullptr;
+        }
+        p++;
+    }
+    return p + 1;
+}
+
+static const char* skipNumber(const char* p) {
+    if (*p == '-') p++;
+    if (*p < '0' || *p > '9') return nullptr;
+    while (*p >= '0' && *p <= '9') p++;
+    if (*p == '.') {
+        p++;
+        if (*p < '0' || *p > '9') return nullptr;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') p++;
+        if (*p < '0' || *p > '9') return nullptr;
+        while (*p >= '0' && *p <= '9') p++;
+    }
+    return p;
+}
+
+static const char* skipValue(const char* p, uint8_t depth) {
+    switch (*p) {
+        case '"':
+            return skipString(p);
+
+        case '{':
+        case '[': {
+            if (depth >= MAX_SKIP_DEPTH) return nullptr;
+            char close = *p == '{' ? '}' : ']';
+            p = skipSpace(p + 1);
+            if (*p == close) return p + 1;
+            while (true) {
+                if (close == '}') {
+                    if (*p != '"') return nullptr;
+                    p = skipString(p);
+                    if (p == nullptr) return nullptr;
+                    p = skipSpace(p);
+                    if (*p++ != ':') return nullptr;
+                    p = skipSpace(p);
+                }
+                p = skipValue(p, depth + 1);
+                if (p == nullptr) return nullptr;
+                p = skipSpace(p);
+                if (*p == close) return p + 1;
+                if (*p++ != ',') return nullptr;
+                p = skipSpace(p);
+            }
+        }
+
+        case 't': return strncmp(p, "true", 4) == 0 ? p + 4 : nullptr;
+        case 'f': return strncmp(p, "false", 5) == 0 ? p + 5 : nullptr;
+        case 'n': return strncmp(p, "null", 4) == 0 ? p + 4 : nullptr;
+        default:  return skipNumber(p);
+    }
+}
+
+bool WebJsonReader::parse(const char* json) {
+    _count = 0;
+    if (json == nullptr) return false;
+
+    const char* p = skipSpace(json);
+    if (*p != '{') return false;
+    p = skipSpace(p + 1);
+    if (*p == '}') return *skipSpace(p + 1) == '\0';
+
+    while (true) {
+        if (*p != '"' || _count == MAX_MEMBERS) return false;
+        const char* key = p + 1;
+        p = skipString(p);
+        if (p == nullptr) return false;
+
+        Member& member = _members[_count++];
+        member.key = key;
+        member.keyLength = (uint16_t)(p - 1 - key);
+
+        p = skipSpace(p);
+        if (*p++ != ':') return false;
+        p = skipSpace(p);
+
+        const char* value = p;
+        p = skipValue(p, 0);
+        if (p == nullptr) return false;
+
+        switch (*value) {
+            case '"':
+                member.type = Type::STRING;
+                member.value = value + 1;
+                member.valueLength = (uint16_t)(p - 1 - member.value);
+                break;
+            case 't':
+            case 'f':
+                member.type = Type::BOOL;
+                member.value = value;
+                member.valueLength = (uint16_t)(p - value);
+                break;
+            case '{':
+            case '[':
+            case 'n':
+                member.type = Type::OTHER;
+                member.value = value;
+                member.valueLength = (uint16_t)(p - value);
+                break;
+            default:
+                member.type = Type::NUMBER;
+                member.value = value;
+                member.valueLength = (uint16_t)(p - value);
+                break;
+        }
+
+        p = skipSpace(p);
+        if (*p == ',') {
+            p = skipSpace(p + 1);
+            continue;
+        }
+        if (*p != '}') return false;
+        return *skipSpace(p + 1) == '\0';
+    }
+}
+
+const WebJsonReader::Member* WebJsonReader::find(const char* key) const {
+    size_t length = strlen(key);
+    for (uint8_t i = 0; i < _count; i++) {
+        if (_members[i].keyLength == length && memcmp(_members[i].key, key, length) == 0) {
+            return &_members[i];
+        }
+    }
+    return nullptr;
+}
+
+static int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool WebJsonReader::getString(const char* key, char* out, size_t size) const {
+    if (size == 0) return false;
+    out[0] = '\0';
+
+    const Member* member = find(key);
+    if (member == nullptr || member->type != Type::STRING) return false;
+
+    const char* p = member->value;
+    const char* end = p + member->valueLength;
+    size_t length = 0;
+    while (p < end) {
+        char bytes[3];
+        size_t count = 1;
+        char c = *p++;
+
+        if (c == '\\' && p < end) {
+            char e = *p++;
+            switch (e) {
+                case 'b': bytes[0] = '\b'; break;
+                case 'f': bytes[0] = '\f'; break;
+                case 'n': bytes[0] = '\n'; break;
+                case 'r': bytes[0] = '\r'; break;
+                case 't': bytes[0] = '\t'; break;
+                case 'u': {
+                    // Basic plane only, as UTF-8; anything unreadable becomes '?'
+                    long code = -1;
+                    if (end - p >= 4) {
+                        code = 0;
+                        for (uint8_t i = 0; i < 4 && code >= 0; i++) {
+                            int digit = hexValue(p[i]);
+                            code = digit < 0 ? -1 : code * 16 + digit;
+                        }
+                        p += 4;
+                    }
+                    if (code < 0 || (code >= 0xD800 && code <= 0xDFFF)) {
+                        bytes[0] = '?';
+                    } else if (code < 0x80) {
+                        bytes[0] = (char)code;
+                    } else if (code < 0x800) {
+                        bytes[0] = (char)(0xC0 | (code >> 6));
+                        bytes[1] = (char)(0x80 | (code & 0x3F));
+                        count = 2;
+                    } else {
+                        bytes[0] = (char)(0xE0 | (code >> 12));
+                        bytes[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+                        bytes[2] = (char)(0x80 | (code & 0x3F));
+                        count = 3;
+                    }
+                    break;
+                }
+                default:  bytes[0] = e; break;      // \" \\ \/
+            }
+        } else {
+            bytes[0] = c;
+        }
+
+        if (length + count >= size) break;
+        memcpy(out + length, bytes, count);
+        length += count;
+    }
+    out[length] = '\0';
+    return true;
+}
+
+bool WebJsonReader::getBool(const char* key, bool fallback) const {
+    const Member* member = find(key);
+    if (member == nullptr || member->type != Type::BOOL) return fallback;
+    return member->value[0] == 't';
+}
+
+long WebJsonReader::getInt(const char* key, long fallback) const {
+    const Member* member = find(key);
+    if (member == nullptr || member->type != Type::NUMBER) return fallback;
+
+    // Integers only; 1.5 or 1e3 fall back like ArduinoJson's is<int>()
+    for (uint16_t i = 0; i < member->valueLength; i++) {
+        char c = member->value[i];
+        if (c == '.' || c == 'e' || c == 'E') return fallback;
+    }
+    return strtol(member->value, nullptr, 10);
+}
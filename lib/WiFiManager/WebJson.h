@@ -0,0 +1,93 @@
+#ifndef WEB_JSON_H
+#define WEB_JSON_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// JSON writer into a caller-provided buffer
+//
+// Room for the closing brackets of every open object/array is kept in
+// reserve, so after an overflow the document can still be closed (and a
+// partly written element dropped with rewind()). Nothing is allocated.
+class WebJsonWriter {
+public:
+    struct Mark {
+        size_t length;
+        bool needComma;
+    };
+
+    WebJsonWriter(char* buffer, size_t size);
+
+    void beginObject(const char* key = nullptr);
+    void endObject();
+    void beginArray(const char* key = nullptr);
+    void endArray();
+
+    void addString(const char* key, const char* value);
+    void addBool(const char* key, bool value);
+    void addInt(const char* key, long value);
+    void addUint(const char* key, unsigned long value);
+
+    // Undo everything written since mark() and clear the overflow flag
+    Mark mark() const { return {_length, _needComma}; }
+    void rewind(const Mark& mark);
+
+    const char* c_str() const { return _buffer; }
+    size_t length() const { return _length; }
+    bool overflowed() const { return _overflow; }
+
+private:
+    char* _buffer;
+    size_t _size;
+    size_t _length;
+    uint8_t _depth;             // Open objects/arrays
+    bool _needComma;
+    bool _overflow;
+
+    void key(const char* key);
+    void append(const char* text, size_t length);
+    void append(char c) { append(&c, 1); }
+    void open(const char* key, char bracket);
+    void close(char bracket);
+};
+
+// Reader for the flat JSON objects the setup page POSTs
+//
+// parse() checks the whole body and indexes the top-level members in
+// place; nested values are skipped (present, but of no readable type).
+// The getters return the fallback unless the member exists with the
+// requested type, like ArduinoJson's `doc["key"] | fallback`.
+class WebJsonReader {
+public:
+    static constexpr uint8_t MAX_MEMBERS = 12;
+
+    WebJsonReader() : _count(0) {}
+
+    // false for invalid JSON, a root that isn't an object, or too many members
+    bool parse(const char* json);
+
+    bool has(const char* key) const { return find(key) != nullptr; }
+
+    // Copies and unescapes a string member; false (out empty) if absent
+    bool getString(const char* key, char* out, size_t size) const;
+    bool getBool(const char* key, bool fallback) const;
+    long getInt(const char* key, long fallback) const;
+
+private:
+    enum class Type : uint8_t { STRING, NUMBER, BOOL, OTHER };
+
+    struct Member {
+        const char* key;        // Raw (escaped) key between the quotes
+        uint16_t keyLength;
+        Type type;
+        const char* value;      // STRING: first char after the quote
+        uint16_t valueLength;
+    };
+
+    Member _members[MAX_MEMBERS];
+    uint8_t _count;
+
+    const Member* find(const char* key) const;
+};
+
+#endif // WEB_JSON_H
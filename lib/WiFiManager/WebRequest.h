@@ -0,0 +1,36 @@
+#ifndef WEB_REQUEST_H
+#define WEB_REQUEST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+enum class WebMethod : uint8_t {
+    GET,
+    POST
+};
+
+// Transport-independent view of one HTTP request and its response
+//
+// WebInterface handlers only see this interface, so they can run behind
+// AsyncWebServer on the device or against MemoryWebRequest anywhere else.
+// Exactly one send*/redirect call is expected per request.
+class WebRequest {
+public:
+    virtual ~WebRequest() {}
+
+    virtual WebMethod method() const = 0;
+    virtual const char* path() const = 0;
+
+    // Buffered request body (POST), nullptr when there is none
+    virtual const char* body() const = 0;
+
+    // Response with NUL-terminated content (copied by the transport)
+    virtual void send(int code, const char* contentType, const char* content) = 0;
+
+    // Response with static content stored in flash (not copied)
+    virtual void sendFlash(int code, const char* contentType, const char* content) = 0;
+
+    virtual void redirect(const char* location) = 0;
+};
+
+#endif // WEB_REQUEST_H
@@ -2,9 +2,10 @@
 #define WIFI_ICONS_H
 
 #include <Arduino.h>
+#include "PageAsset.h"
 
 // WiFi Connected Icon (8x8 pixels) - 3 signal bars
-const unsigned char PROGMEM wifi_connected[] = {
+constexpr uint8_t wifi_connected_rows[] = {
     0b00000000,
     0b00111100,
     0b01000010,
@@ -16,7 +17,7 @@ const unsigned char PROGMEM wifi_connected[] = {
 };
 
 // WiFi Disconnected Icon (8x8 pixels) - X symbol
-const unsigned char PROGMEM wifi_disconnected[] = {
+constexpr uint8_t wifi_disconnected_rows[] = {
     0b00000000,
     0b01000010,
     0b00100100,
@@ -28,7 +29,7 @@ const unsigned char PROGMEM wifi_disconnected[] = {
 };
 
 // WiFi AP Mode Icon (8x8 pixels) - Broadcast/antenna symbol
-const unsigned char PROGMEM wifi_ap[] = {
+constexpr uint8_t wifi_ap_rows[] = {
     0b00011000,
     0b00111100,
     0b01111110,
@@ -40,7 +41,7 @@ const unsigned char PROGMEM wifi_ap[] = {
 };
 
 // WiFi Connecting Icon (8x8 pixels) - Partial bars
-const unsigned char PROGMEM wifi_connecting[] = {
+constexpr uint8_t wifi_connecting_rows[] = {
     0b00000000,
     0b00111100,
     0b01000010,
@@ -51,4 +52,17 @@ const unsigned char PROGMEM wifi_connecting[] = {
     0b00011000
 };
 
+// Page-major icons for drawing, transcoded at compile time
+constexpr PageBitmap<8, 8> WIFI_ICON_PAGES[] = {
+    transcodeAsset<8, 8>(wifi_connected_rows),
+    transcodeAsset<8, 8>(wifi_disconnected_rows),
+    transcodeAsset<8, 8>(wifi_ap_rows),
+    transcodeAsset<8, 8>(wifi_connecting_rows)
+};
+
+constexpr PageAsset wifi_connected = WIFI_ICON_PAGES[0].asset();
+constexpr PageAsset wifi_disconnected = WIFI_ICON_PAGES[1].asset();
+constexpr PageAsset wifi_ap = WIFI_ICON_PAGES[2].asset();
+constexpr PageAsset wifi_connecting = WIFI_ICON_PAGES[3].asset();
+
 #endif // WIFI_ICONS_H
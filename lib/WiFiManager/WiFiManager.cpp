@@ -1,7 +1,7 @@
 #include "WiFiManager.h"
-#include "WebInterface.h"
+#include "AsyncWebInterface.h"
+#include "CaptiveDns.h"
 
-#include <DNSServer.h>
 #include <ESPAsyncWebServer.h>
 
 // Constants
@@ -87,10 +87,6 @@ void WiFiManager::update() {
     }
 
     switch (_state) {
-        case WiFiState::AP_MODE:
-            handleAPMode();
-            break;
-
         case WiFiState::CONNECTING:
             handleConnectionState();
             break;
@@ -134,9 +130,9 @@ void WiFiManager::startCaptivePortal() {
                   _apIP.toString().c_str());
 
     if (!_dnsServer) {
-        _dnsServer = new DNSServer();
+        _dnsServer = new CaptiveDns();
     }
-    _dnsServer->start(53, "*", _apIP);
+    _dnsServer->start(_apIP);
 
     if (!_webServer) {
         _webServer = new AsyncWebServer(80);
@@ -194,6 +190,18 @@ void WiFiManager::disconnect() {
     _state = WiFiState::DISCONNECTED;
 }
 
+void WiFiManager::radioOff() {
+    if (_state == WiFiState::AP_MODE || _state == WiFiState::RADIO_OFF) {
+        return;
+    }
+
+    Serial.println("[WiFi] Radio off");
+    WiFi.disconnect(true);
+    WiFi.mode(WIFI_OFF);
+    _state = WiFiState::RADIO_OFF;
+    _config.retryCount = 0;
+}
+
 // --------------------------------------------------
 // Credentials
 // --------------------------------------------------
@@ -262,6 +270,7 @@ void WiFiManager::freeWebServerMemory() {
     if (!_webServerActive) return;
 
     Serial.println("[WiFi] Freeing web server memory");
+    _webAdmission.printStats();
     size_t before = ESP.getFreeHeap();
 
     delete _webInterface;
@@ -274,7 +283,7 @@ void WiFiManager::freeWebServerMemory() {
     }
 
     if (_dnsServer) {
-        _dnsServer->stop();
+        _dnsServer->printStats();
         delete _dnsServer;
         _dnsServer = nullptr;
     }
@@ -348,12 +357,6 @@ void WiFiManager::handleConnectionState() {
     }
 }
 
-void WiFiManager::handleAPMode() {
-    if (_dnsServer) {
-        _dnsServer->processNextRequest();
-    }
-}
-
 void WiFiManager::triggerEvent(WiFiEvent event) {
     if (_eventCallback) {
         _eventCallback(event);
@@ -384,7 +387,7 @@ void WiFiManager::setupWebInterface() {
     if (!_webServer) return;
 
     delete _webInterface;
-    _webInterface = new WebInterface(this);
+    _webInterface = new AsyncWebInterface(this);
     _webInterface->setupRoutes(_webServer);
 }
 
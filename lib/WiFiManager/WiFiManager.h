@@ -4,11 +4,14 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <Preferences.h>
+#include "WebAdmission.h"
+#include "DeviceConfig.h"
 
 // Forward declarations (no heavy includes in header)
-class DNSServer;
+class CaptiveDns;
 class AsyncWebServer;
-class WebInterface;
+class AsyncWebInterface;
+class SamplingProfiler;
 
 // WiFi connection states
 enum class WiFiState {
@@ -17,7 +20,8 @@ enum class WiFiState {
     CONNECTING,        // Attempting to connect to configured network
     CONNECTED,         // Successfully connected
     DISCONNECTED,      // Was connected, now lost connection
-    FAILED             // Connection attempt failed
+    FAILED,            // Connection attempt failed
+    RADIO_OFF          // Radio switched off between network windows (no auto-reconnect)
 };
 
 // WiFi events
@@ -39,19 +43,6 @@ struct WiFiConfig {
     uint8_t retryCount = 0;
 };
 
-// Device configuration (setup wizard settings)
-struct DeviceConfig {
-    bool setupComplete = false;       // Has wizard been completed?
-    bool wifiEnabled = true;          // Allow WiFi connection
-    bool geolocationEnabled = true;   // Allow IP geolocation
-    bool weatherEnabled = true;       // Allow weather fetching
-    bool ntpEnabled = true;           // Allow NTP time sync
-    int32_t manualTimezoneOffset = 0; // Manual timezone (seconds from UTC)
-    bool termsAccepted = false;       // Legal terms accepted
-    bool privacyAccepted = false;     // Privacy policy accepted
-    uint32_t consentTimestamp = 0;    // When consent was given (epoch)
-};
-
 // Callback type for WiFi events
 using WiFiEventCallback = void (*)(WiFiEvent event);
 
@@ -81,6 +72,8 @@ public:
     // Connection management
     void connect();
     void disconnect();
+    void radioOff();            // Disconnect and power the radio down until connect()
+    bool isRadioOff() const { return _state == WiFiState::RADIO_OFF; }
     int8_t getSignalStrength() const;
     const char* getSSID() const;
     const char* getConfiguredSSID() const { return _config.ssid; }
@@ -102,8 +95,17 @@ public:
     void freeWebServerMemory();
     bool isWebServerActive() const { return _webServerActive; }
 
-    // Web server access (used by WebInterface only)
+    // Web server access (used by AsyncWebInterface only)
     AsyncWebServer* getWebServer() const { return _webServer; }
+    WebAdmission& getWebAdmission() { return _webAdmission; }
+    const CaptiveDns* getCaptiveDns() const { return _dnsServer; }
+
+    // Profiler exposed on /profile (not owned, nullptr = route disabled)
+    void setProfiler(SamplingProfiler* profiler) { _profiler = profiler; }
+    SamplingProfiler* getProfiler() const { return _profiler; }
+
+    // Served/shed request counters (kept across portal sessions)
+    const WebAdmissionStats& getWebStats() const { return _webAdmission.getStats(); }
 
 private:
     // Core state
@@ -113,10 +115,14 @@ private:
     WiFiEventCallback _eventCallback = nullptr;
 
     // Captive portal components (owned)
-    DNSServer* _dnsServer = nullptr;
+    CaptiveDns* _dnsServer = nullptr;
     AsyncWebServer* _webServer = nullptr;
-    WebInterface* _webInterface = nullptr;
+    AsyncWebInterface* _webInterface = nullptr;
     bool _webServerActive = false;
+    SamplingProfiler* _profiler = nullptr;
+
+    // Outlives the server so in-flight disconnect callbacks stay valid
+    WebAdmission _webAdmission;
 
     // AP configuration
     String _apName;
@@ -138,7 +144,6 @@ private:
     void loadCredentials();
     void storeCredentials();
     void handleConnectionState();
-    void handleAPMode();
     void triggerEvent(WiFiEvent event);
     bool validateCredentials(const char* ssid, const char* password);
     void generateAPName();
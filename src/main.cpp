@@ -5,30 +5,50 @@
  */
 
 #include <Arduino.h>
+#include <LittleFS.h>
 #include "config.h"
 #include "DisplayManager.h"
+#include "AutoBrightness.h"
 #include "InputManager.h"
 #include "MotionSensor.h"
 #include "TouchSensor.h"
 #include "MenuSystem.h"
 #include "AnimationEngine.h"
+#include "AnimationStateMachine.h"
+#include "PowerManager.h"
 #include "SensorHub.h"
 #include "WiFiManager.h"
+#include "WiFiIcons.h"
 #include "WeatherService.h"
+#include "DnsCache.h"
+#include "NetworkWindow.h"
 #include "WeatherIcons.h"
+#include "SamplingProfiler.h"
+#include "SensorTrace.h"
+#include "esp_sntp.h"
 
 // ============================================================================
 // GLOBAL OBJECTS
 // ============================================================================
 DisplayManager display;
+StatusBar statusBar;
 InputManager input;
 MotionSensor motion;
 TouchSensor touch(TOUCH_SENSOR_PIN);
 MenuSystem menuSystem(&display);
 AnimationEngine animator(&display);
+AnimationStateMachine behavior(&animator);
+PowerManager power(&display);
+AutoBrightness autoBrightness(&display);
 SensorHub sensors;
 WiFiManager wifi;
 WeatherService weatherService;
+DnsCache dnsCache;
+NetworkWindow netWindow(&wifi);
+SamplingProfiler profiler;
+SensorTrace sensorTrace;
+File traceFile;
+TraceHexPrint traceHex(Serial);
 
 // ============================================================================
 // APPLICATION STATE
@@ -52,8 +72,23 @@ AppMode currentMode = AppMode::ANIMATIONS;
 bool encoderEditMode = false;
 // Weather view page: 0 = overview, 1-4 = individual day details
 uint8_t weatherViewPage = 0;
+// Weather view place: 0 = geolocated location, then WEATHER_EXTRA_PLACES
+uint8_t weatherViewPlace = 0;
+// Pre-rendered weather pages (overview + days) of one place
+FrameStore weatherPages;
+volatile bool weatherPagesStale = true;  // Set from the weather fetch task
+uint8_t weatherPagesPlace = 0;
+uint8_t weatherPagesCount = 0;            // Pages ready in weatherPages
+uint32_t weatherPagesGeneration = 0;      // Bumped per render, keys the shown page
 // NTP time sync state
 bool ntpConfigured = false;
+bool ntpSynced = false;
+uint32_t ntpLastSyncMs = 0;
+uint32_t ntpLastAttemptMs = 0;
+
+// Network window jobs
+int8_t netJobNtp = -1;
+int8_t netJobWeather = -1;
 
 // Pomodoro timer state
 enum class PomodoroState { IDLE, WORK_RUNNING, WORK_PAUSED, BREAK_RUNNING, BREAK_PAUSED };
@@ -66,19 +101,52 @@ uint8_t pomodoroCount = 0;            // Completed work sessions (0-8)
 constexpr uint32_t POMODORO_WORK_MS = 25UL * 60UL * 1000UL;   // 25 minutes
 constexpr uint32_t POMODORO_BREAK_MS = 5UL * 60UL * 1000UL;   // 5 minutes
 
+// Status bar glyphs (8x8, MSB left), transcoded at compile time
+constexpr uint8_t status_pomodoro_work_rows[] = {
+    0b00011000,
+    0b00110000,
+    0b01111110,
+    0b11111111,
+    0b11111111,
+    0b11111111,
+    0b01111110,
+    0b00111100
+};
+constexpr uint8_t status_pomodoro_break_rows[] = {
+    0b00100100,
+    0b00010010,
+    0b00000000,
+    0b11111110,
+    0b10000011,
+    0b10000011,
+    0b01000110,
+    0b00111100
+};
+constexpr PageBitmap<8, 8> STATUS_GLYPHS[] = {
+    transcodeAsset<8, 8>(status_pomodoro_work_rows),
+    transcodeAsset<8, 8>(status_pomodoro_break_rows)
+};
+constexpr PageAsset status_pomodoro_work = STATUS_GLYPHS[0].asset();
+constexpr PageAsset status_pomodoro_break = STATUS_GLYPHS[1].asset();
+
 // ============================================================================
-// TIMING FOR NATURAL BEHAVIORS
+// NATURAL BEHAVIORS
 // ============================================================================
-// Timing for natural behaviors
-unsigned long lastBlinkTime = 0;
-unsigned long nextBlinkDelay = 5000;  // Next blink in 5 seconds
-unsigned long lastWinkCheck = 0;
-unsigned long nextWinkDelay = 20000;  // Check for wink in 20 seconds
-
-// Shake detection
-bool isShaking = false;
-unsigned long lastShakeTime = 0;
-const unsigned long SHAKE_COOLDOWN = 1000;  // 1 second
+// Blinks, random actions and reactions live in AnimationStateMachine.
+// Loop only feeds it events and context.
+unsigned long lastBehaviorContextUpdate = 0;
+const unsigned long BEHAVIOR_CONTEXT_INTERVAL_MS = 1000;  // 1 second
+float motionPeak = 0.0f;  // Largest deviation from 1g since last context update
+int8_t currentLocalHour = -1;  // Refreshed with the behavior context, -1 until NTP sync
+const uint8_t MOTION_WAKE_PERCENT = 40;  // ~2 m/s² (picked up) wakes the display
+const uint16_t LOUD_SOUND_THRESHOLD = 2800;  // Raw ADC level (0-4095)
+
+// Snapshot key seed for the setup-required screen (AppMode values seed the views)
+const uint32_t SNAPSHOT_SETUP_REQUIRED = 0x100;
+
+// Face view needs a full redraw after returning from another view
+AppMode lastLoopMode = AppMode::ANIMATIONS;
+bool faceRedrawPending = true;
 
 // Menu timeout
 unsigned long lastMenuActivity = 0;
@@ -90,10 +158,12 @@ const unsigned long MENU_TIMEOUT_MS = 10000;  // 10 seconds
 struct Settings {
     // Brightness stored as percent (10-100), mapped to 0-255 for the display
     uint8_t brightness;
+    bool autoBrightness;  // Brightness setting becomes the ceiling
     bool soundEnabled;
     uint8_t motionSensitivity;
 } settings = {
     .brightness = 100,   // 100% user brightness
+    .autoBrightness = true,
     .soundEnabled = true,
     .motionSensitivity = 5
 };
@@ -112,6 +182,7 @@ MenuItem test4Menu("Test 4");
 
 // Brightness as user-facing percent (10-100, in steps of 10)
 MenuItem brightnessItem("Brightness", 100, 10, 100);
+MenuItem autoBrightnessItem("Auto Bright", 1, 0, 1);  // Toggle: 0=Off, 1=On
 MenuItem soundItem("Sound", 1, 0, 1);
 MenuItem sensitivityItem("Sensitivity", 5, 1, 10);
 
@@ -155,10 +226,13 @@ void onEncoderEvent(EncoderEvent event, int32_t position);
 void onButtonEvent(ButtonEvent event);
 void onTouchEvent(TouchEvent event);
 void onMotionEvent(MotionEvent event);
+void onActivityChange(Activity from, Activity to);
 
-void checkRandomAnimations();
-void scheduleNextBlink();
-void scheduleNextWinkCheck();
+void onLoudSound(uint16_t level);
+void updateBehaviorContext();
+void updateAutoBrightness();
+void onPowerStateChange(PowerState from, PowerState to);
+bool isPomodoroRunning();
 
 void updateAnimationsMode();
 void updateMenuMode();
@@ -167,6 +241,9 @@ void updateWiFiSetupMode();
 void updateWiFiInfoMode();
 void updateWeatherViewMode();
 void updateWeatherAboutMode();
+void drawWeatherPage(const WeatherForecast& forecast, const char* placeName, uint8_t place, uint8_t page);
+void prerenderWeatherPages();
+void onWeatherEvent(WeatherEvent event);
 void updateWeatherPrivacyMode();
 void updateClockViewMode();
 void configureNTP();
@@ -182,7 +259,9 @@ void applyBrightnessFromSettings();
 void applyDeviceConfig();
 void showSetupRequiredScreen();
 void onWiFiEvent(WiFiEvent event);
-void drawWiFiStatusIcon();
+void updateStatusBar();
+void setupNetworkWindow();
+void handleSerialCommands();
 
 // ============================================================================
 // SETUP
@@ -202,14 +281,31 @@ void setup() {
         while (1) delay(1000);
     }
     
+    #ifdef DISPLAY_BENCHMARK
+    display.runBenchmark();
+    animator.printAssetReport();
+    #endif
+    #ifdef SENSOR_BENCHMARK
+    SensorHub::runFilterBenchmark();
+    MotionSensor::runActivityBenchmark();
+    #endif
+
+    // Burn-in mitigation: shift the whole frame one pixel every 3 minutes
+    display.setPixelShift(true, 180000, 1);
+
+    // Status icons over the face; hidden again when nothing changes
+    statusBar.setAutoHide(STATUS_BAR_AUTOHIDE_MS);
+    display.setOverlay(&statusBar);
+
     // Initialize animation engine
     animator.init();
 
-    // Start with static base frame (idle frame 0)
-    animator.showStaticFrame(AnimState::IDLE, 0);
+    // Behavior engine starts on the static base frame (idle frame 0)
+    behavior.init();
     
     // Initialize sensors
     sensors.init(DHT11_PIN, SOUND_SENSOR_PIN);
+    sensors.setSoundThreshold(LOUD_SOUND_THRESHOLD, onLoudSound);
 
     // Initialize buzzer for audio feedback
     setupBuzzer();
@@ -231,8 +327,14 @@ void setup() {
         Serial.println("[WARN] Motion sensor not found");
     } else {
         motion.setCallback(onMotionEvent);
+        motion.setActivityCallback(onActivityChange);
         motion.setShakeThreshold(20.0f);
     }
+
+    // Sensor sessions can be recorded and replayed ("trace" serial commands)
+    motion.setTrace(&sensorTrace);
+    sensors.setTrace(&sensorTrace);
+    input.setTrace(&sensorTrace);
     
     // Initialize touch sensor
     #if TOUCH_ENABLED
@@ -246,9 +348,20 @@ void setup() {
     setupMenu();
     applyBrightnessFromSettings();
 
+    // Auto brightness (brightness setting is the ceiling)
+    autoBrightness.setLightSensorPin(LIGHT_SENSOR_PIN);
+    autoBrightness.setEnabled(settings.autoBrightness);
+    autoBrightness.begin();
+
+    // Idle power pipeline: sleeping face -> dim -> display off
+    power.setTimeouts(SLEEP_TIMEOUT_MS, SLEEP_ANIM_DURATION_MS, DISPLAY_DIM_DURATION_MS);
+    power.setStateCallback(onPowerStateChange);
+    power.init();
+
     // Initialize WiFi (this loads device config internally)
     wifi.init();
     wifi.setEventCallback(onWiFiEvent);
+    wifi.setProfiler(&profiler);
 
     // Check if initial setup is complete
     if (!wifi.isSetupComplete()) {
@@ -261,17 +374,29 @@ void setup() {
     }
 
     // Initialize weather service
+    dnsCache.setUpstream(DNS_PRIMARY_SERVER, DNS_SECONDARY_SERVER);
+    weatherService.setDnsCache(&dnsCache);
+    weatherService.setEventCallback(onWeatherEvent);
     weatherService.init();
+    #ifdef WEATHER_EXTRA_PLACES
+    {
+        static const WeatherPlace extraPlaces[] = WEATHER_EXTRA_PLACES;
+        for (const WeatherPlace& place : extraPlaces) {
+            weatherService.addPlace(place.name, place.latitude, place.longitude);
+        }
+    }
+    #endif
 
-    // Schedule first behaviors
-    scheduleNextBlink();
-    scheduleNextWinkCheck();
+    // NTP and weather share radio-on windows
+    setupNetworkWindow();
 
     Serial.println("\n[INIT] System ready!");
     Serial.println("Natural behaviors:");
     Serial.println("  - Random blinks");
-    Serial.println("  - Rare winks (easter egg)");
+    Serial.println("  - Rare winks (easter egg), none at night");
+    Serial.println("  - Loud sound = surprised");
     Serial.println("  - Shake = dizzy loop");
+    Serial.println("  - Picked up = wink");
     Serial.println("  - Menu timeout: 10s");
     Serial.println("========================================\n");
 }
@@ -281,28 +406,51 @@ void setup() {
 // ============================================================================
 
 void loop() {
-    unsigned long currentTime = millis();
-    
+    handleSerialCommands();
+    sensorTrace.update();   // Replayed samples for this loop
+
     // Update all systems
     input.update();
     motion.update();
     sensors.update();
     wifi.update();  // Handle WiFi state machine
+    netWindow.setHold(currentMode == AppMode::WIFI_SETUP || currentMode == AppMode::WIFI_INFO);
+    netWindow.update();  // Batches NTP/weather into radio-on windows
     weatherService.update();  // Non-blocking weather updates
 
     #if TOUCH_ENABLED
     touch.update();
     #endif
 
+    updateBehaviorContext();
+
+    // Keep awake while a timer runs or the setup portal is shown
+    power.setInhibit(isPomodoroRunning() || currentMode == AppMode::WIFI_SETUP);
+    power.update();
+    display.updatePixelShift();
+    updateAutoBrightness();
+
+    // Display off - stop rendering entirely until input/motion wakes it
+    if (!power.shouldRender()) {
+        delay(behavior.getPlanner().getLoopDelayMs());
+        return;
+    }
+
     animator.update();
 
-    // Check if shaking stopped
-    if (isShaking && (currentTime - lastShakeTime > SHAKE_COOLDOWN)) {
-        Serial.println("[SHAKE] Stopped - finishing current cycle");
-        isShaking = false;
-        animator.stopLoopingGracefully();  // Will finish current cycle then stop
+    // Coming back to the face from another view - redraw it once
+    if (currentMode != lastLoopMode) {
+        if (currentMode == AppMode::ANIMATIONS) {
+            faceRedrawPending = true;
+        }
+        lastLoopMode = currentMode;
     }
 
+    // Weather pages render off-screen after a forecast arrives
+    prerenderWeatherPages();
+
+    updateStatusBar();
+
     // Update current mode
     switch (currentMode) {
         case AppMode::ANIMATIONS:
@@ -338,54 +486,115 @@ void loop() {
             break;
     }
 
-    delay(10);
+    // Icon changes go out on their own, without redrawing the screen
+    display.updateOverlay();
+
+    // Fast trace replay runs the loop flat out
+    if (sensorTrace.isReplaying() && !sensorTrace.isRealtime()) return;
+
+    // Face view slows the loop down when nothing is happening
+    delay(currentMode == AppMode::ANIMATIONS ? behavior.getPlanner().getLoopDelayMs() : 10);
 }
 
 // ============================================================================
-// RANDOM ANIMATION LOGIC
+// BEHAVIOR CONTEXT
 // ============================================================================
 
-void checkRandomAnimations() {
-    unsigned long currentTime = millis();
+void updateBehaviorContext() {
+    // Track peak movement every loop so short bumps aren't missed
+    if (motion.isReady()) {
+        float deviation = fabsf(motion.getAccelMagnitude() - 9.81f);
+        if (deviation > motionPeak) {
+            motionPeak = deviation;
+        }
+    }
 
-    // Don't interrupt running animations
-    if (animator.isPlaying()) {
+    unsigned long currentTime = millis();
+    if (currentTime - lastBehaviorContextUpdate < BEHAVIOR_CONTEXT_INTERVAL_MS) {
         return;
     }
+    lastBehaviorContextUpdate = currentTime;
 
-    // Don't run animations while shaking (dizzy handles it)
-    if (isShaking) {
-        return;
+    PlannerInputs inputs;
+    struct tm timeinfo;
+    if (ntpConfigured && getLocalTime(&timeinfo, 0)) {
+        inputs.hourOfDay = timeinfo.tm_hour;
+    }
+    currentLocalHour = inputs.hourOfDay;
+    inputs.soundPercent = sensors.isSoundReady() ? sensors.getSoundPercent() : 0;
+    // 5 m/s² of deviation (a firm nudge) counts as full motion
+    inputs.motionPercent = (uint8_t)constrain((int)(motionPeak * 20.0f), 0, 100);
+    motionPeak = 0.0f;
+
+    // Jolts while carried around don't count; picking it up does (onActivityChange)
+    Activity activity = motion.getActivity();
+    if (inputs.motionPercent >= MOTION_WAKE_PERCENT &&
+        activity != Activity::WALKING && activity != Activity::TRANSPORTED) {
+        power.notifyActivity();
     }
 
-    // Check for scheduled blink
-    if (currentTime - lastBlinkTime >= nextBlinkDelay) {
-        // Serial.println("[ANIM] Natural blink");
-        animator.play(AnimState::IDLE, true);  // Priority play
-        lastBlinkTime = currentTime;
-        scheduleNextBlink();
-        return;
+    behavior.setContext(inputs);
+}
+
+void updateAutoBrightness() {
+    // Power pipeline owns the contrast while sleeping/dimming
+    if (power.getState() != PowerState::ACTIVE) return;
+
+    const GeoLocation& loc = weatherService.getLocation();
+    autoBrightness.setLocation(loc.latitude, loc.longitude, loc.valid);
+    autoBrightness.setActivity(behavior.getPlanner().getActivityLevel());
+
+    time_t utcNow = ntpConfigured ? time(nullptr) : 0;
+    if (autoBrightness.update(utcNow, currentLocalHour)) {
+        // Wake restores the auto level, not the ceiling
+        power.setActiveBrightness(autoBrightness.getCurrent());
     }
+}
 
-    // Check for wink (easter egg)
-    if (currentTime - lastWinkCheck >= nextWinkDelay) {
-        if (random(100) < 30) {  // 30% chance
-            // Serial.println("[ANIM] Easter egg wink!");
-            animator.play(AnimState::WINK, true);
-        }
-        lastWinkCheck = currentTime;
-        scheduleNextWinkCheck();
+// ============================================================================
+// POWER PIPELINE
+// ============================================================================
+
+void onPowerStateChange(PowerState /*from*/, PowerState to) {
+    switch (to) {
+        case PowerState::SLEEP_ANIM:
+            // Leave whatever view is open and doze off on the face
+            currentMode = AppMode::ANIMATIONS;
+            encoderEditMode = false;
+            menuSystem.setEditMode(false);
+            behavior.postEvent(BehaviorEvent::SLEEP);
+            break;
+
+        case PowerState::DISPLAY_OFF:
+            display.printWearStats();
+            Serial.printf("[DISPLAY] Auto brightness saved ~%.2f mAh so far (now %d%% below ceiling)\n",
+                          autoBrightness.getSavedMilliampHours(),
+                          autoBrightness.getSavingsPercent());
+            break;
+
+        case PowerState::ACTIVE:
+            // The sleep/dim/off gap is not auto brightness savings
+            autoBrightness.resumeSavings();
+            if (currentMode == AppMode::ANIMATIONS) {
+                behavior.postEvent(BehaviorEvent::RESUME);
+            }
+            faceRedrawPending = true;
+            break;
+
+        default:
+            break;
     }
 }
 
-void scheduleNextBlink() {
-    nextBlinkDelay = random(3000, 8000);  // 3-8 seconds
-    // Serial.printf("[ANIM] Next blink in %lu ms\n", nextBlinkDelay);
+bool isPomodoroRunning() {
+    return pomodoroState == PomodoroState::WORK_RUNNING ||
+           pomodoroState == PomodoroState::BREAK_RUNNING;
 }
 
-void scheduleNextWinkCheck() {
-    nextWinkDelay = random(15000, 45000);  // 15-45 seconds
-    // Serial.printf("[ANIM] Next wink check in %lu ms\n", nextWinkDelay);
+void onLoudSound(uint16_t /*level*/) {
+    if (currentMode == AppMode::ANIMATIONS) {
+        behavior.postEvent(BehaviorEvent::LOUD_SOUND);
+    }
 }
 
 // ============================================================================
@@ -436,7 +645,11 @@ void setupMenu() {
     sensitivityItem.setType(MenuItemType::VALUE);
     sensitivityItem.setValue(settings.motionSensitivity);
     
+    autoBrightnessItem.setType(MenuItemType::TOGGLE);
+    autoBrightnessItem.setValue(settings.autoBrightness ? 1 : 0);
+
     settingsMenu.addChild(&brightnessItem);
+    settingsMenu.addChild(&autoBrightnessItem);
     settingsMenu.addChild(&soundItem);
     settingsMenu.addChild(&sensitivityItem);
     settingsMenu.addChild(&wifiMenu);
@@ -493,6 +706,7 @@ void setupMenu() {
     soundLevelItem.setID(MenuItemID::SENSOR_SOUND);
 
     brightnessItem.setID(MenuItemID::SETTING_BRIGHTNESS);
+    autoBrightnessItem.setID(MenuItemID::SETTING_AUTO_BRIGHTNESS);
     soundItem.setID(MenuItemID::SETTING_SOUND);
     sensitivityItem.setID(MenuItemID::SETTING_SENSITIVITY);
 
@@ -520,6 +734,12 @@ void setupMenu() {
 // ============================================================================
 
 void onButtonEvent(ButtonEvent event) {
+    behavior.postEvent(BehaviorEvent::USER_INPUT);
+    statusBar.poke();
+
+    // First press only wakes the display
+    if (power.notifyActivity()) return;
+
     if (currentMode == AppMode::ANIMATIONS) {
         if (event == ButtonEvent::CLICK || event == ButtonEvent::LONG_PRESS) {
             currentMode = AppMode::MENU;
@@ -622,18 +842,18 @@ void onButtonEvent(ButtonEvent event) {
 
 void onTouchEvent(TouchEvent event) {
     #if TOUCH_ENABLED
+    behavior.postEvent(BehaviorEvent::USER_INPUT);
+    statusBar.poke();
+    if (power.notifyActivity()) return;
+
     if (currentMode == AppMode::ANIMATIONS) {
         switch (event) {
             case TouchEvent::TAP:
-                if (!animator.isPlaying()) {
-                    animator.play(AnimState::SURPRISED, true);
-                }
+                behavior.postEvent(BehaviorEvent::TAP);
                 break;
 
             case TouchEvent::DOUBLE_TAP:
-                if (!animator.isPlaying()) {
-                    animator.play(AnimState::WINK, true);  // Use wink for double tap
-                }
+                behavior.postEvent(BehaviorEvent::DOUBLE_TAP);  // Use wink for double tap
                 break;
                 
             case TouchEvent::LONG_TOUCH:
@@ -671,20 +891,13 @@ void onTouchEvent(TouchEvent event) {
 }
 
 void onMotionEvent(MotionEvent event) {
-    if (event == MotionEvent::SHAKE) {
-        lastShakeTime = millis();
+    // Any gesture wakes the display; the waking gesture itself is consumed
+    if (event != MotionEvent::NONE && power.notifyActivity()) return;
 
+    if (event == MotionEvent::SHAKE) {
         if (currentMode == AppMode::ANIMATIONS) {
-            // Only start dizzy if not already playing it
-            if (!isShaking && animator.getCurrentState() != AnimState::DIZZY) {
-                Serial.println("[SHAKE] Started - playing dizzy loop");
-                isShaking = true;
-                // Start continuous dizzy loop
-                animator.play(AnimState::DIZZY, true, true);  // priority, forceLoop
-            } else {
-                // Already playing dizzy - just update shake time
-                isShaking = true;
-            }
+            // Dizzy loops while shaking, stops 1s after the last shake
+            behavior.postEvent(BehaviorEvent::SHAKE);
 
         } else if (currentMode == AppMode::MENU) {
             resetMenuTimeout();
@@ -699,6 +912,20 @@ void onMotionEvent(MotionEvent event) {
     }
 }
 
+void onActivityChange(Activity from, Activity to) {
+    // In a bag or pocket: sleep sooner
+    power.setStowed(to == Activity::WALKING || to == Activity::TRANSPORTED);
+
+    if (to != Activity::HANDLED) return;
+
+    // Picked up wakes the display; the wake itself is the reaction
+    if (power.notifyActivity()) return;
+
+    if (from == Activity::STATIONARY && currentMode == AppMode::ANIMATIONS) {
+        behavior.postEvent(BehaviorEvent::PICKED_UP);
+    }
+}
+
 // ============================================================================
 // MENU TIMEOUT
 // ============================================================================
@@ -717,7 +944,7 @@ void checkMenuTimeout() {
         Serial.println("[MENU] Timeout - returning to animations");
         currentMode = AppMode::ANIMATIONS;
         // Show base frame immediately
-        animator.showStaticFrame(AnimState::IDLE, 0);
+        behavior.postEvent(BehaviorEvent::RESUME);
     }
 }
 
@@ -733,7 +960,13 @@ void applyBrightnessFromSettings() {
 
     // Map 10–100% to a usable contrast range (approx. 10–100% of 255)
     uint8_t level = map(percent, 10, 100, 26, 255);
-    display.setBrightness(level);
+    autoBrightness.setUserCeiling(level);
+
+    // In auto mode the ramp moves toward the new ceiling on its own
+    if (!autoBrightness.isEnabled()) {
+        display.setBrightness(level);
+        power.setActiveBrightness(level);
+    }
 }
 
 // ============================================================================
@@ -741,6 +974,13 @@ void applyBrightnessFromSettings() {
 // ============================================================================
 
 void testGeolocation() {
+    if (netJobWeather >= 0) {
+        // Runs in a network window (radio is brought up if needed)
+        Serial.println("[Weather] Update requested");
+        netWindow.requestNow(netJobWeather);
+        return;
+    }
+
     if (!wifi.isConnected()) {
         Serial.println("[Weather] Not connected to WiFi");
         return;
@@ -827,17 +1067,17 @@ void onMenuStateChange(MenuItem* item) {
     switch (itemID) {
         case MenuItemID::ANIM_IDLE:
             currentMode = AppMode::ANIMATIONS;
-            animator.play(AnimState::IDLE, true);
+            behavior.triggerReaction(AnimState::IDLE);
             break;
 
         case MenuItemID::ANIM_WINK:
             currentMode = AppMode::ANIMATIONS;
-            animator.play(AnimState::WINK, true);
+            behavior.triggerReaction(AnimState::WINK);
             break;
 
         case MenuItemID::ANIM_DIZZY:
             currentMode = AppMode::ANIMATIONS;
-            animator.play(AnimState::DIZZY, true);
+            behavior.triggerReaction(AnimState::DIZZY);
             break;
 
         case MenuItemID::SENSOR_TEMP_HUM:
@@ -862,7 +1102,9 @@ void onMenuStateChange(MenuItem* item) {
 
         case MenuItemID::WEATHER_VIEW:
             weatherViewPage = 0;  // Start at overview
+            weatherViewPlace = 0;
             currentMode = AppMode::WEATHER_VIEW;
+            weatherService.noteView();  // Learns when forecasts get looked at
             Serial.println("[NAV] Entered weather view");
             break;
 
@@ -909,6 +1151,14 @@ void onMenuStateChange(MenuItem* item) {
             break;
         }
 
+        case MenuItemID::SETTING_AUTO_BRIGHTNESS:
+            settings.autoBrightness = item->getValue() == 1;
+            autoBrightness.setEnabled(settings.autoBrightness);
+            if (!settings.autoBrightness) {
+                applyBrightnessFromSettings();  // Back to the manual level
+            }
+            break;
+
         case MenuItemID::SETTING_SOUND:
             settings.soundEnabled = item->getValue() == 1;
             break;
@@ -951,18 +1201,33 @@ void updateMenuMode() {
 // ============================================================================
 
 void onEncoderEvent(EncoderEvent event, int32_t /*position*/) {
+    behavior.postEvent(BehaviorEvent::USER_INPUT);
+    statusBar.poke();
+
+    // First turn/press only wakes the display
+    if (power.notifyActivity()) return;
+
     // Handle weather view navigation
     if (currentMode == AppMode::WEATHER_VIEW) {
         if (event == EncoderEvent::ROTATED_CW || event == EncoderEvent::ROTATED_CCW) {
-            const WeatherForecast& forecast = weatherService.getForecast();
+            // Pages run overview, day 1..n of one place, then the next place
+            uint8_t placeCount = weatherService.getPlaceCount();
+            WeatherForecast forecast;
+            char name[32];
+            weatherService.getPlaceForecast(weatherViewPlace, forecast, name, sizeof(name));
             uint8_t maxPage = forecast.valid ? forecast.dayCount : 0;
 
             if (event == EncoderEvent::ROTATED_CW) {
                 weatherViewPage++;
-                if (weatherViewPage > maxPage) weatherViewPage = 0;
+                if (weatherViewPage > maxPage) {
+                    weatherViewPage = 0;
+                    weatherViewPlace = (weatherViewPlace + 1) % placeCount;
+                }
             } else {
                 if (weatherViewPage == 0) {
-                    weatherViewPage = maxPage;
+                    weatherViewPlace = (weatherViewPlace + placeCount - 1) % placeCount;
+                    weatherService.getPlaceForecast(weatherViewPlace, forecast, name, sizeof(name));
+                    weatherViewPage = forecast.valid ? forecast.dayCount : 0;
                 } else {
                     weatherViewPage--;
                 }
@@ -1021,48 +1286,17 @@ void onEncoderEvent(EncoderEvent event, int32_t /*position*/) {
 }
 
 void updateAnimationsMode() {
-    static bool wasPlaying = false;
-    static uint8_t lastFrame = 255;
-    bool isPlaying = animator.isPlaying();
-    uint8_t currentFrame = animator.getCurrentFrame();
-
-    // Track if redraw needed
-    bool needsRedraw = false;
-
-    // If animation just stopped, show base frame
-    if (wasPlaying && !isPlaying && !isShaking) {
-        animator.showStaticFrame(AnimState::IDLE, 0);
-        needsRedraw = true;
-        // Serial.println("[ANIM] Transition to base frame");
-    }
-
-    // Check if frame changed
-    if (currentFrame != lastFrame) {
-        needsRedraw = true;
-    }
+    // Drains queued events; returns immediately between scheduled deadlines
+    behavior.update();
 
-    // State changed
-    if (wasPlaying != isPlaying) {
-        needsRedraw = true;
-    }
-
-    wasPlaying = isPlaying;
-    lastFrame = currentFrame;
-
-    // Check for random animations (blink, wink)
-    if (!isPlaying && !isShaking) {
-        checkRandomAnimations();
-    }
+    // Only redraw when the visible frame changed
+    if (faceRedrawPending || animator.isFrameDirty() || display.isDirty()) {
+        faceRedrawPending = false;
+        animator.clearFrameDirty();
 
-    // Only redraw when necessary
-    if (needsRedraw || display.isDirty()) {
         display.clear();
         animator.draw();
-
-        // Draw WiFi status icon in top-right corner
-        drawWiFiStatusIcon();
-
-        display.update();
+        display.update();   // Status bar is composited on top
     }
 }
 
@@ -1115,6 +1349,7 @@ void onWiFiEvent(WiFiEvent event) {
         case WiFiEvent::CONNECTED:
             Serial.printf("[WiFi] Connected to %s\n", wifi.getSSID());
             Serial.printf("[WiFi] IP: %s\n", wifi.getIPAddress().c_str());
+            dnsCache.applyUpstream();
             if (currentMode == AppMode::WIFI_SETUP) {
                 currentMode = AppMode::ANIMATIONS;
             }
@@ -1122,6 +1357,8 @@ void onWiFiEvent(WiFiEvent event) {
 
         case WiFiEvent::DISCONNECTED:
             Serial.println("[WiFi] Disconnected");
+            dnsCache.printStats();
+            dnsCache.clear();  // Next network may answer differently
             break;
 
         case WiFiEvent::FAILED:
@@ -1133,28 +1370,36 @@ void onWiFiEvent(WiFiEvent event) {
     }
 }
 
-void drawWiFiStatusIcon() {
-    #include "WiFiIcons.h"
-
-    const uint8_t* icon = nullptr;
+void updateStatusBar() {
+    // Only the face leaves the top-right corner free
+    statusBar.setEnabled(currentMode == AppMode::ANIMATIONS);
 
+    const PageAsset* wifiIcon;
     if (wifi.isConnected()) {
-        icon = wifi_connected;
+        wifiIcon = &wifi_connected;
     } else if (wifi.isAPActive()) {
-        icon = wifi_ap;
+        wifiIcon = &wifi_ap;
+    } else if (wifi.getState() == WiFiState::CONNECTING) {
+        wifiIcon = &wifi_connecting;
     } else {
-        WiFiState state = wifi.getState();
-        switch (state) {
-            case WiFiState::CONNECTING: icon = wifi_connecting; break;
-            case WiFiState::DISCONNECTED:
-            case WiFiState::FAILED:
-            default: icon = wifi_disconnected; break;
-        }
+        wifiIcon = &wifi_disconnected;
     }
+    statusBar.setIcon(StatusElement::WIFI, wifiIcon);
 
-    if (icon != nullptr) {
-        display.drawBitmap(icon, 120, 0, 8, 8); // Top-right corner
+    const WeatherForecast& forecast = weatherService.getForecast();
+    statusBar.setIcon(StatusElement::WEATHER,
+                      forecast.valid && forecast.dayCount > 0
+                          ? getWeatherIcon(forecast.days[0].symbolCode) : nullptr);
+
+    const PageAsset* pomodoroIcon = nullptr;
+    if (pomodoroState == PomodoroState::WORK_RUNNING) {
+        pomodoroIcon = &status_pomodoro_work;
+    } else if (pomodoroState == PomodoroState::BREAK_RUNNING) {
+        pomodoroIcon = &status_pomodoro_break;
     }
+    statusBar.setIcon(StatusElement::POMODORO, pomodoroIcon);
+
+    // StatusElement::BATTERY stays empty until there is a battery reading
 }
 
 void updateWiFiSetupMode() {
@@ -1162,15 +1407,19 @@ void updateWiFiSetupMode() {
     if (millis() - lastUpdate < 500) return;
     lastUpdate = millis();
 
+    String apName = wifi.getAPName();
+    uint32_t key = DisplayManager::snapshotKey((uint32_t)AppMode::WIFI_SETUP, apName.c_str());
+    if (display.showSnapshot(key)) return;
+
     display.clear();
     display.showTextCentered("WiFi Setup", 0, 1);
 
     display.drawText("Connect to:", 0, 16, 1);
-    display.drawText(wifi.getAPName().c_str(), 0, 28, 1);
+    display.drawText(apName.c_str(), 0, 28, 1);
     display.drawText("Open browser:", 0, 40, 1);
     display.drawText("192.168.4.1", 0, 52, 1);
 
-    display.update();
+    display.saveSnapshot(key);
 }
 
 void updateWiFiInfoMode() {
@@ -1178,20 +1427,34 @@ void updateWiFiInfoMode() {
     if (millis() - lastUpdate < 1000) return;
     lastUpdate = millis();
 
-    display.clear();
-    display.showTextCentered("WiFi Status", 0, 1);
-
     bool connected = (WiFi.status() == WL_CONNECTED);
     WiFiState state = wifi.getState();
 
+    // Inputs shown below; RSSI in 5 dB steps so jitter doesn't redraw
+    String ip = connected ? wifi.getIPAddress() : String();
+    int8_t rssiStep = connected ? (int8_t)(wifi.getSignalStrength() / 5 * 5) : 0;
+    uint32_t key = DisplayManager::snapshotKey((uint32_t)AppMode::WIFI_INFO,
+                                               (int32_t)((uint8_t)state | (connected ? 0x100 : 0) |
+                                                         (wifi.hasCredentials() ? 0x200 : 0)));
+    key = DisplayManager::snapshotKey(key, connected ? wifi.getSSID() : wifi.getConfiguredSSID());
+    key = DisplayManager::snapshotKey(key, ip.c_str());
+    key = DisplayManager::snapshotKey(key, (int32_t)rssiStep);
+    if (state == WiFiState::RADIO_OFF) {
+        key = DisplayManager::snapshotKey(key, (int32_t)netWindow.getRadioOnSecsToday());
+    }
+    if (display.showSnapshot(key)) return;
+
+    display.clear();
+    display.showTextCentered("WiFi Status", 0, 1);
+
     if (connected) {
         // WiFi is really connected
         display.drawText("Connected", 0, 16, 1);
         display.drawText(wifi.getSSID(), 0, 28, 1);
-        display.drawText(wifi.getIPAddress().c_str(), 0, 40, 1);
+        display.drawText(ip.c_str(), 0, 40, 1);
 
         char rssi[16];
-        snprintf(rssi, sizeof(rssi), "RSSI: %d dBm", wifi.getSignalStrength());
+        snprintf(rssi, sizeof(rssi), "RSSI: %d dBm", rssiStep);
         display.drawText(rssi, 0, 52, 1);
 
     } else if (wifi.hasCredentials()) {
@@ -1206,8 +1469,15 @@ void updateWiFiInfoMode() {
             case WiFiState::CONNECTING: stateStr = "Connecting..."; break;
             case WiFiState::DISCONNECTED: stateStr = "Disconnected"; break;
             case WiFiState::FAILED: stateStr = "Failed"; break;
+            case WiFiState::RADIO_OFF: stateStr = "Radio off"; break;
             default: break;
         }
+        char stateLine[32];
+        if (state == WiFiState::RADIO_OFF) {
+            snprintf(stateLine, sizeof(stateLine), "Radio off (%lus today)",
+                     (unsigned long)netWindow.getRadioOnSecsToday());
+            stateStr = stateLine;
+        }
         display.drawText("Status:", 0, 40, 1);
         display.drawText(stateStr, 0, 52, 1);
 
@@ -1216,7 +1486,7 @@ void updateWiFiInfoMode() {
         display.drawText("Not configured", 0, 16, 1);
     }
 
-    display.update();
+    display.saveSnapshot(key);
 }
 
 // ============================================================================
@@ -1228,9 +1498,31 @@ void updateWeatherViewMode() {
     if (millis() - lastUpdate < 100) return;
     lastUpdate = millis();
 
+    // Pre-rendered page: a flip is one decode + flush, idle frames cost nothing
+    if (weatherPagesPlace == weatherViewPlace && !weatherPagesStale &&
+        weatherViewPage < weatherPagesCount &&
+        (weatherViewPlace > 0 || weatherService.hasValidData())) {
+        uint32_t key = DisplayManager::snapshotKey(weatherPagesGeneration, (int32_t)weatherViewPage);
+        if (display.showStoredFrame(weatherPages, weatherViewPage, key)) return;
+    }
+
     display.clear();
 
-    if (!weatherService.hasValidData()) {
+    WeatherForecast forecast;
+    char placeName[32];
+    bool havePlace = weatherService.getPlaceForecast(weatherViewPlace, forecast, placeName, sizeof(placeName));
+
+    if (weatherViewPlace > 0 && !havePlace) {
+        // Extra place not cached yet - fetched in the next network window
+        display.showTextCentered(placeName, 0, 1);
+        display.drawText("Getting", 0, 20, 1);
+        display.drawText("forecast...", 0, 32, 1);
+        display.drawText("Rotate: next place", 0, 56, 1);
+        display.update();
+        return;
+    }
+
+    if (weatherViewPlace == 0 && !weatherService.hasValidData()) {
         display.showTextCentered("Weather", 0, 1);
 
         WeatherState state = weatherService.getState();
@@ -1262,13 +1554,27 @@ void updateWeatherViewMode() {
         return;
     }
 
-    const WeatherForecast& forecast = weatherService.getForecast();
-    const GeoLocation& location = weatherService.getLocation();
+    if (weatherViewPage > forecast.dayCount) {
+        weatherViewPage = 0;
+        return;
+    }
 
-    if (weatherViewPage == 0) {
+    drawWeatherPage(forecast, placeName, weatherViewPlace, weatherViewPage);
+    display.update();
+}
+
+// Overview (page 0) or one day's details (page 1-4); draws only, no flush
+void drawWeatherPage(const WeatherForecast& forecast, const char* placeName, uint8_t place, uint8_t page) {
+    if (page == 0) {
         // Overview page: show all 4 days in compact format
-        // Header: City name
-        display.drawText(location.city, 0, 0, 1);
+        // Header: City name (+ place number when there are several)
+        display.drawText(placeName, 0, 0, 1);
+        if (weatherService.getPlaceCount() > 1) {
+            char placeNum[8];
+            snprintf(placeNum, sizeof(placeNum), "%u/%u",
+                     place + 1, weatherService.getPlaceCount());
+            display.drawText(placeNum, 96, 0, 1);
+        }
 
         // Show 4 days in compact format
         // Each row: icon (8px) + date (5 chars) + temp range
@@ -1276,8 +1582,7 @@ void updateWeatherViewMode() {
             int y = 14 + (i * 12);
 
             // Draw weather icon (8x8)
-            const uint8_t* icon = getWeatherIcon(forecast.days[i].symbolCode);
-            display.drawBitmap(icon, 0, y, 8, 8, 1);
+            display.drawAsset(*getWeatherIcon(forecast.days[i].symbolCode), 0, y);
 
             // Date: show day of month only (chars 8-9 from YYYY-MM-DD)
             char dayNum[4];
@@ -1302,11 +1607,8 @@ void updateWeatherViewMode() {
 
     } else {
         // Detail page for single day (1-4)
-        uint8_t dayIdx = weatherViewPage - 1;
-        if (dayIdx >= forecast.dayCount) {
-            weatherViewPage = 0;
-            return;
-        }
+        uint8_t dayIdx = page - 1;
+        if (dayIdx >= forecast.dayCount) return;
 
         const DailyForecast& day = forecast.days[dayIdx];
 
@@ -1314,8 +1616,7 @@ void updateWeatherViewMode() {
         display.drawText(day.date, 0, 0, 1);
 
         // Large weather icon (centered, 8x8 but we can draw it larger conceptually)
-        const uint8_t* icon = getWeatherIcon(day.symbolCode);
-        display.drawBitmap(icon, 60, 0, 8, 8, 1);
+        display.drawAsset(*getWeatherIcon(day.symbolCode), 60, 0);
 
         // Temperature
         char tempLine[32];
@@ -1342,8 +1643,66 @@ void updateWeatherViewMode() {
                 dayIdx + 1, forecast.dayCount);
         display.drawText(navHint, 0, 56, 1);
     }
+}
 
-    display.update();
+// Renders one weather page per call into weatherPages, so the view can
+// flip pages without drawing. Restarts when the forecast or place changes.
+void prerenderWeatherPages() {
+    static WeatherForecast forecast;
+    static char placeName[32];
+    static uint8_t nextPage = 0;
+    static bool rendering = false;
+
+    uint8_t place = currentMode == AppMode::WEATHER_VIEW ? weatherViewPlace : 0;
+
+    if (rendering && (weatherPagesStale || place != weatherPagesPlace)) {
+        rendering = false;
+    }
+
+    if (!rendering) {
+        if (!weatherPagesStale && place == weatherPagesPlace) return;
+
+        weatherPagesStale = false;
+        weatherPagesPlace = place;
+        weatherPagesCount = 0;
+        weatherPagesGeneration++;
+        weatherPages.clear();
+
+        if (place == 0 && !weatherService.hasValidData()) return;
+        if (!weatherService.getPlaceForecast(place, forecast, placeName, sizeof(placeName)) ||
+            !forecast.valid) {
+            return;
+        }
+        nextPage = 0;
+        rendering = true;
+    }
+
+    display.beginOffscreen();
+    drawWeatherPage(forecast, placeName, place, nextPage);
+    bool stored = display.storeFrame(weatherPages, nextPage);
+    display.endOffscreen();
+
+    if (!stored) {
+        rendering = false;  // Store full: remaining pages are drawn live
+        return;
+    }
+
+    nextPage++;
+    weatherPagesCount = nextPage;
+    if (nextPage > forecast.dayCount) {
+        rendering = false;
+        Serial.printf("[Weather] %u pages pre-rendered (%u bytes)\n",
+                      weatherPagesCount, weatherPages.getUsedBytes());
+    }
+}
+
+// Runs on the weather fetch task: only flag the pages for the main loop
+void onWeatherEvent(WeatherEvent event) {
+    if (event == WeatherEvent::WEATHER_UPDATED ||
+        event == WeatherEvent::CACHE_LOADED ||
+        event == WeatherEvent::LOCATION_UPDATED) {
+        weatherPagesStale = true;
+    }
 }
 
 // ============================================================================
@@ -1355,6 +1714,9 @@ void updateWeatherAboutMode() {
     if (millis() - lastUpdate < 500) return;
     lastUpdate = millis();
 
+    uint32_t key = DisplayManager::snapshotKey((uint32_t)AppMode::WEATHER_ABOUT, "Weather Data");
+    if (display.showSnapshot(key)) return;
+
     display.clear();
 
     // Title
@@ -1367,7 +1729,7 @@ void updateWeatherAboutMode() {
 
     // Footer hint
     
-    display.update();
+    display.saveSnapshot(key);
 }
 
 // ============================================================================
@@ -1379,6 +1741,9 @@ void updateWeatherPrivacyMode() {
     if (millis() - lastUpdate < 500) return;
     lastUpdate = millis();
 
+    uint32_t key = DisplayManager::snapshotKey((uint32_t)AppMode::WEATHER_PRIVACY, "Privacy Info");
+    if (display.showSnapshot(key)) return;
+
     display.clear();
 
     // Title
@@ -1392,7 +1757,72 @@ void updateWeatherPrivacyMode() {
 
     // Footer hint
     
-    display.update();
+    display.saveSnapshot(key);
+}
+
+// ============================================================================
+// NETWORK WINDOWS
+// ============================================================================
+
+bool netNtpDue(uint32_t& deadlineMs) {
+    if (!wifi.getDeviceConfig().ntpEnabled) return false;
+
+    if (ntpSynced) {
+        deadlineMs = ntpLastSyncMs + NET_NTP_INTERVAL_MS;
+    } else if (ntpLastAttemptMs != 0) {
+        deadlineMs = ntpLastAttemptMs + NET_NTP_RETRY_MS;
+    } else {
+        deadlineMs = millis();  // Never synced - as soon as possible
+    }
+    return true;
+}
+
+bool netNtpStart() {
+    const DeviceConfig& cfg = wifi.getDeviceConfig();
+    ntpLastAttemptMs = millis();
+
+    // (Re)starting SNTP sends a request right away
+    sntp_set_sync_status(SNTP_SYNC_STATUS_RESET);
+    if (cfg.geolocationEnabled) {
+        ntpConfigured = false;
+        configureNTP();
+    } else {
+        configTime(cfg.manualTimezoneOffset, 0, "pool.ntp.org", "time.nist.gov");
+        ntpConfigured = true;
+    }
+    return true;
+}
+
+bool netNtpFinished() {
+    if (sntp_get_sync_status() != SNTP_SYNC_STATUS_COMPLETED) return false;
+    ntpSynced = true;
+    ntpLastSyncMs = millis();
+    return true;
+}
+
+bool netWeatherDue(uint32_t& deadlineMs) {
+    return weatherService.getNextDeadline(deadlineMs);
+}
+
+bool netWeatherStart() {
+    // Geolocation runs first inside the same fetch when the network changed
+    return weatherService.forceUpdate();
+}
+
+bool netWeatherFinished() {
+    return !weatherService.isFetching();
+}
+
+void setupNetworkWindow() {
+    // Order within a window: clock first (location age uses it), then weather
+    NetJob ntp = {"NTP", NET_NTP_FLEX_MS, NET_NTP_TIMEOUT_MS, netNtpDue, netNtpStart, netNtpFinished};
+    NetJob weather = {"WEATHER", NET_WEATHER_FLEX_MS, NET_WEATHER_TIMEOUT_MS,
+                      netWeatherDue, netWeatherStart, netWeatherFinished};
+    netJobNtp = netWindow.addJob(ntp);
+    netJobWeather = netWindow.addJob(weather);
+
+    weatherService.setExternalScheduling(true);
+    netWindow.setRadioControl(NET_RADIO_OFF_BETWEEN_WINDOWS);
 }
 
 // ============================================================================
@@ -1603,11 +2033,15 @@ void updatePomodoroViewMode() {
 // ============================================================================
 
 void showSetupRequiredScreen() {
+    String apName = wifi.getAPName();
+    uint32_t key = DisplayManager::snapshotKey(SNAPSHOT_SETUP_REQUIRED, apName.c_str());
+    if (display.showSnapshot(key)) return;
+
     display.clear();
     display.showTextCentered("Setup", 8, 2);
     display.drawText("Connect to:", 16, 32, 1);
-    display.showTextCentered(wifi.getAPName().c_str(), 44, 1);
-    display.update();
+    display.showTextCentered(apName.c_str(), 44, 1);
+    display.saveSnapshot(key);
 }
 
 void applyDeviceConfig() {
@@ -1643,3 +2077,107 @@ void applyDeviceConfig() {
         Serial.println("[Time] NTP disabled by user");
     }
 }
+
+// ============================================================================
+// SERIAL COMMANDS
+// ============================================================================
+
+// trace rec [file] | trace play <file> [fast] | trace stop | trace status
+// Traces are LittleFS files; "trace rec" alone streams to serial, see
+// tools/trace_from_log.py
+void runTraceCommand(char* action) {
+    bool start = action != nullptr && (strcmp(action, "rec") == 0 || strcmp(action, "play") == 0);
+    if (start && sensorTrace.getMode() != SensorTrace::Mode::IDLE) {
+        Serial.println("[TRACE] Busy, use trace stop first");
+        return;
+    }
+
+    if (action != nullptr && strcmp(action, "rec") == 0) {
+        char* name = strtok(nullptr, " ");
+        if (name == nullptr) {
+            sensorTrace.startRecording(&traceHex);
+            return;
+        }
+        if (!LittleFS.begin(true)) {
+            Serial.println("[TRACE] LittleFS unavailable");
+            return;
+        }
+        traceFile = LittleFS.open(name, "w");
+        if (!traceFile || !sensorTrace.startRecording(&traceFile)) {
+            Serial.printf("[TRACE] Can't record to %s\n", name);
+            traceFile.close();
+        }
+    } else if (action != nullptr && strcmp(action, "play") == 0) {
+        char* name = strtok(nullptr, " ");
+        char* speed = strtok(nullptr, " ");
+        if (name == nullptr || !LittleFS.begin(true)) {
+            Serial.println("[TRACE] Usage: trace play <file> [fast]");
+            return;
+        }
+        traceFile = LittleFS.open(name, "r");
+        bool realtime = speed == nullptr || strcmp(speed, "fast") != 0;
+        if (!traceFile || !sensorTrace.startReplay(&traceFile, realtime)) {
+            Serial.printf("[TRACE] Can't replay %s\n", name);
+            traceFile.close();
+        }
+    } else if (action != nullptr && strcmp(action, "stop") == 0) {
+        sensorTrace.stopRecording();
+        sensorTrace.stopReplay();
+        traceHex.endLine();
+        traceFile.close();
+    } else {
+        sensorTrace.printStats(Serial);
+    }
+}
+
+// prof start [hz] [depth] | prof stop | prof status | prof dump
+// Dump output goes to tools/symbolize_profile.py
+void runSerialCommand(char* line) {
+    char* command = strtok(line, " ");
+    if (command != nullptr && strcmp(command, "trace") == 0) {
+        runTraceCommand(strtok(nullptr, " "));
+        return;
+    }
+    if (command != nullptr && strcmp(command, "activity") == 0) {
+        motion.getActivityClassifier().printStatus(Serial);
+        return;
+    }
+    if (command == nullptr || strcmp(command, "prof") != 0) {
+        Serial.println("[CMD] Commands: prof start [hz] [depth], prof stop, prof status, prof dump,");
+        Serial.println("[CMD]           trace rec [file], trace play <file> [fast], trace stop, trace status,");
+        Serial.println("[CMD]           activity");
+        return;
+    }
+
+    char* action = strtok(nullptr, " ");
+    if (action != nullptr && strcmp(action, "start") == 0) {
+        char* rate = strtok(nullptr, " ");
+        char* depth = strtok(nullptr, " ");
+        profiler.start(rate ? strtoul(rate, nullptr, 10) : SamplingProfiler::DEFAULT_RATE_HZ,
+                       depth ? atoi(depth) : 0);
+    } else if (action != nullptr && strcmp(action, "stop") == 0) {
+        profiler.stop();
+    } else if (action != nullptr && strcmp(action, "dump") == 0) {
+        profiler.dump(Serial);
+    } else {
+        profiler.printStatus(Serial);
+    }
+}
+
+void handleSerialCommands() {
+    static char line[48];
+    static uint8_t length = 0;
+
+    while (Serial.available() > 0) {
+        char c = Serial.read();
+        if (c == '\r') continue;
+
+        if (c == '\n') {
+            line[length] = '\0';
+            if (length > 0) runSerialCommand(line);
+            length = 0;
+        } else if (length < sizeof(line) - 1) {
+            line[length++] = c;
+        }
+    }
+}
@@ -0,0 +1,233 @@
+// Host check of the fixed-geometry drawing primitives (DisplayCore.h)
+//
+//   g++ -O2 -std=c++17 -Ilib/DisplayManager tools/display_core_check.cpp -o display_check
+//   ./display_check [cases] [seed]
+//
+// Draws random pixels, rectangles, 1-bit bitmaps and page assets with
+// NativePanel and with a per-pixel reference that follows Adafruit_GFX
+// (drawPixel with clipping, fillRect/drawRect as pixel loops, drawBitmap
+// setting only the set bits, DisplayManager's per-pixel asset fallback),
+// then compares the two 128x64 page buffers byte for byte. Positions
+// run past every edge, including negative ones. Prints the host time
+// per call for both; device figures come from the esp32c3_bench build.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "DisplayCore.h"
+
+typedef DisplayCore<128, 64, SH1106Controller> NativePanel;
+
+static const int W = NativePanel::WIDTH;
+static const int H = NativePanel::HEIGHT;
+
+// ============================================================================
+// REFERENCE
+// ============================================================================
+
+static void refPixel(uint8_t* buffer, int x, int y, bool on) {
+    if (x < 0 || x >= W || y < 0 || y >= H) return;
+    uint8_t mask = 1 << (y & 7);
+    if (on) {
+        buffer[(y / 8) * W + x] |= mask;
+    } else {
+        buffer[(y / 8) * W + x] &= ~mask;
+    }
+}
+
+static void refFillRect(uint8_t* buffer, int x, int y, int w, int h, bool on) {
+    for (int i = x; i < x + w; i++) {
+        for (int j = y; j < y + h; j++) refPixel(buffer, i, j, on);
+    }
+}
+
+// Adafruit_GFX::drawRect: two horizontal, then two vertical lines
+static void refDrawRect(uint8_t* buffer, int x, int y, int w, int h, bool on) {
+    if (w <= 0 || h <= 0) return;
+    refFillRect(buffer, x, y, w, 1, on);
+    refFillRect(buffer, x, y + h - 1, w, 1, on);
+    refFillRect(buffer, x, y, 1, h, on);
+    refFillRect(buffer, x + w - 1, y, 1, h, on);
+}
+
+static void refDrawBitmap(uint8_t* buffer, int x, int y, const uint8_t* bitmap, int w, int h, bool on) {
+    int byteWidth = (w + 7) / 8;
+    for (int row = 0; row < h; row++) {
+        for (int col = 0; col < w; col++) {
+            if (bitmap[row * byteWidth + col / 8] & (0x80 >> (col & 7))) {
+                refPixel(buffer, x + col, y + row, on);
+            }
+        }
+    }
+}
+
+static void refDrawAsset(uint8_t* buffer, int x, int y, const PageAsset& asset) {
+    for (int row = asset.boxY; row < asset.boxY + asset.boxH; row++) {
+        const uint8_t* page = asset.data + (row >> 3) * asset.width;
+        for (int col = asset.boxX; col < asset.boxX + asset.boxW; col++) {
+            if (page[col] & (1 << (row & 7))) refPixel(buffer, x + col, y + row, true);
+        }
+    }
+}
+
+// ============================================================================
+// CASES
+// ============================================================================
+
+static uint32_t g_state = 1;
+
+static int randomInt(int lo, int hi) {
+    g_state ^= g_state << 13;
+    g_state ^= g_state >> 17;
+    g_state ^= g_state << 5;
+    return lo + (int)(g_state % (uint32_t)(hi - lo + 1));
+}
+
+struct Bitmap {
+    int w, h;
+    std::vector<uint8_t> rows;      // Row-major, MSB left
+    std::vector<uint8_t> pages;     // Page-major, for the asset
+    PageAsset asset;
+};
+
+// Row-major bitmap with its page-major transcoding and lit box, built at
+// run time the way transcodeAsset() does at compile time
+static Bitmap makeBitmap(int w, int h, int density) {
+    Bitmap b;
+    b.w = w;
+    b.h = h;
+    b.rows.assign((w + 7) / 8 * h, 0);
+    b.pages.assign(w * ((h + 7) / 8), 0);
+
+    int x0 = w, y0 = h, x1 = -1, y1 = -1;
+    for (int y = 0; y < h; y++) {
+        for (int x = 0; x < w; x++) {
+            if (randomInt(0, 99) >= density) continue;
+            b.rows[y * ((w + 7) / 8) + x / 8] |= 0x80 >> (x & 7);
+            b.pages[(y / 8) * w + x] |= 1 << (y & 7);
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            if (y > y1) y1 = y;
+        }
+    }
+
+    b.asset = PageAsset{b.pages.data(), (uint8_t)w, (uint8_t)h, 0, 0, 0, 0};
+    if (x1 >= 0) {
+        b.asset.boxX = x0;
+        b.asset.boxY = y0;
+        b.asset.boxW = x1 - x0 + 1;
+        b.asset.boxH = y1 - y0 + 1;
+    }
+    return b;
+}
+
+static int g_failures = 0;
+
+static void compare(const char* name, const uint8_t* core, const uint8_t* ref,
+                    int x, int y, int w, int h) {
+    if (memcmp(core, ref, NativePanel::BUFFER_BYTES) == 0) return;
+    if (g_failures < 10) {
+        for (int i = 0; i < NativePanel::BUFFER_BYTES; i++) {
+            if (core[i] == ref[i]) continue;
+            std::printf("FAIL %s at %d,%d %dx%d: column %d page %d is %02x, expected %02x\n",
+                        name, x, y, w, h, i % W, i / W, core[i], ref[i]);
+            break;
+        }
+    }
+    g_failures++;
+}
+
+template <typename F>
+static double nsPerCall(int calls, F draw) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) draw(i);
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+}
+
+int main(int argc, char** argv) {
+    int cases = argc > 1 ? atoi(argv[1]) : 20000;
+    g_state = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 1;
+    if (g_state == 0) g_state = 1;
+
+    uint8_t core[NativePanel::BUFFER_BYTES];
+    uint8_t ref[NativePanel::BUFFER_BYTES];
+
+    for (int n = 0; n < cases; n++) {
+        // Same random background in both, so clearing is checked too
+        for (int i = 0; i < NativePanel::BUFFER_BYTES; i++) core[i] = ref[i] = (uint8_t)randomInt(0, 255);
+
+        int x = randomInt(-40, W + 8);
+        int y = randomInt(-40, H + 8);
+        int w = randomInt(1, 48);
+        int h = randomInt(1, 40);
+        bool on = randomInt(0, 1) != 0;
+
+        switch (n % 5) {
+            case 0:
+                NativePanel::setPixel(core, x, y, on);
+                refPixel(ref, x, y, on);
+                compare("setPixel", core, ref, x, y, 1, 1);
+                break;
+            case 1:
+                NativePanel::fillRect(core, x, y, w, h, on);
+                refFillRect(ref, x, y, w, h, on);
+                compare("fillRect", core, ref, x, y, w, h);
+                break;
+            case 2:
+                NativePanel::drawRect(core, x, y, w, h, on);
+                refDrawRect(ref, x, y, w, h, on);
+                compare("drawRect", core, ref, x, y, w, h);
+                break;
+            case 3: {
+                Bitmap b = makeBitmap(w, h, randomInt(0, 100));
+                NativePanel::drawBitmap(core, x, y, b.rows.data(), w, h, on);
+                refDrawBitmap(ref, x, y, b.rows.data(), w, h, on);
+                compare("drawBitmap", core, ref, x, y, w, h);
+                break;
+            }
+            case 4: {
+                Bitmap b = makeBitmap(w, h, randomInt(0, 100));
+                NativePanel::drawAsset(core, x, y, b.asset);
+                refDrawAsset(ref, x, y, b.asset);
+                compare("drawAsset", core, ref, x, y, w, h);
+                break;
+            }
+        }
+    }
+    std::printf("%d cases, %d mismatches\n", cases, g_failures);
+
+    // Host timing, same calls as DisplayManager::runBenchmark()
+    static const uint8_t ICON[] = {0x3C, 0x42, 0xA5, 0x81, 0xA5, 0x99, 0x42, 0x3C};
+    Bitmap face = makeBitmap(32, 32, 40);
+    const int calls = 200000;
+    uint8_t* b = core;
+
+    struct Row {
+        const char* name;
+        double ref;
+        double core;
+    } rows[] = {
+        {"pixel", nsPerCall(calls, [&](int i) { refPixel(b, i & 127, i & 63, true); }),
+                  nsPerCall(calls, [&](int i) { NativePanel::setPixel(b, i & 127, i & 63, true); })},
+        {"fillRect", nsPerCall(calls, [&](int i) { refFillRect(b, i & 63, 3, 40, 20, true); }),
+                     nsPerCall(calls, [&](int i) { NativePanel::fillRect(b, i & 63, 3, 40, 20, true); })},
+        {"drawRect", nsPerCall(calls, [&](int i) { refDrawRect(b, i & 63, 3, 40, 20, true); }),
+                     nsPerCall(calls, [&](int i) { NativePanel::drawRect(b, i & 63, 3, 40, 20, true); })},
+        {"bitmap 8x8", nsPerCall(calls, [&](int i) { refDrawBitmap(b, i & 119, i & 55, ICON, 8, 8, true); }),
+                       nsPerCall(calls, [&](int i) { NativePanel::drawBitmap(b, i & 119, i & 55, ICON, 8, 8, true); })},
+        {"asset 32x32", nsPerCall(calls, [&](int i) { refDrawAsset(b, i & 95, i & 31, face.asset); }),
+                        nsPerCall(calls, [&](int i) { NativePanel::drawAsset(b, i & 95, i & 31, face.asset); })},
+    };
+
+    std::printf("%-12s %9s %9s\n", "ns per call", "per-pixel", "core");
+    for (const Row& row : rows) {
+        std::printf("%-12s %9.1f %9.1f  x%.1f\n", row.name, row.ref, row.core, row.ref / row.core);
+    }
+    std::printf("(buffer checksum %u)\n", (unsigned)(b[0] + b[500] + b[1000]));
+    return g_failures == 0 ? 0 : 1;
+}
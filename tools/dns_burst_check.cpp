@@ -0,0 +1,190 @@
+// Host check of the captive portal DNS responder (CaptiveDns::buildResponse)
+//
+//   g++ -O2 -std=c++17 -Ilib/WiFiManager tools/dns_burst_check.cpp
+//       lib/WiFiManager/CaptiveDnsPacket.cpp -o dns_check && ./dns_check tools/fixtures/dns_burst.hex
+//
+// Feeds the lookup burst a phone fires when it joins the portal AP through
+// the responder and checks every reply: ID and RD echoed, QR/AA set, the
+// question echoed byte for byte, one answer for A/ANY (pointer to the
+// name, TTL_SECS, the AP address) and none for AAAA/HTTPS, EDNS dropped.
+// Then every truncation of every query, compressed or overrunning names
+// and responses must be dropped, and unsupported opcodes or question
+// counts must get a header-only error. Exits non-zero on any failure.
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "CaptiveDns.h"
+
+struct Query {
+    std::string name;
+    std::vector<uint8_t> bytes;
+};
+
+static const uint8_t AP_ADDRESS[4] = {192, 168, 4, 1};
+
+static int failures = 0;
+
+static void fail(const std::string& name, const char* what) {
+    std::printf("FAIL %s: %s\n", name.c_str(), what);
+    failures++;
+}
+
+static uint16_t readU16(const uint8_t* p) {
+    return (uint16_t)((p[0] << 8) | p[1]);
+}
+
+static bool loadBurst(const char* file, std::vector<Query>& burst) {
+    std::ifstream in(file);
+    if (!in) return false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        size_t colon = line.rfind(": ");
+        if (colon == std::string::npos) return false;
+
+        Query query;
+        query.name = line.substr(0, colon);
+        std::string hex = line.substr(colon + 2);
+        for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+            query.bytes.push_back((uint8_t)std::stoul(hex.substr(i, 2), nullptr, 16));
+        }
+        burst.push_back(query);
+    }
+    return !burst.empty();
+}
+
+// End of the question section, 0 if it doesn't parse
+static size_t questionEnd(const std::vector<uint8_t>& query) {
+    size_t pos = CaptiveDns::HEADER_SIZE;
+    while (pos < query.size() && query[pos] != 0) pos += 1 + query[pos];
+    return pos < query.size() ? pos + 1 + 4 : 0;
+}
+
+static void checkAnswered(const Query& query, const uint8_t* answer) {
+    const std::vector<uint8_t>& q = query.bytes;
+    uint8_t out[CaptiveDns::MAX_PACKET];
+    bool isAddress = false;
+    size_t length = CaptiveDns::buildResponse(q.data(), q.size(), answer, out, sizeof(out), &isAddress);
+
+    size_t end = questionEnd(q);
+    uint16_t qtype = readU16(&q[end - 4]);
+    bool wantAddress = qtype == 1 || qtype == 255;
+
+    if (length != end + (wantAddress ? CaptiveDns::ANSWER_SIZE : 0)) {
+        fail(query.name, "wrong length (EDNS not dropped or answer missing)");
+        return;
+    }
+    if (isAddress != wantAddress) fail(query.name, "isAddress");
+    if (readU16(out) != readU16(q.data())) fail(query.name, "ID not echoed");
+    if (!(out[2] & 0x80) || !(out[2] & 0x04)) fail(query.name, "QR/AA not set");
+    if ((out[2] & 0x01) != (q[2] & 0x01)) fail(query.name, "RD not echoed");
+    if ((out[3] & 0x0F) != 0) fail(query.name, "RCODE not NOERROR");
+    if (readU16(&out[4]) != 1) fail(query.name, "QDCOUNT");
+    if (readU16(&out[6]) != (wantAddress ? 1 : 0)) fail(query.name, "ANCOUNT");
+    if (readU16(&out[8]) != 0 || readU16(&out[10]) != 0) fail(query.name, "NSCOUNT/ARCOUNT");
+    if (memcmp(out + 12, q.data() + 12, end - 12) != 0) fail(query.name, "question not echoed");
+
+    if (wantAddress) {
+        const uint8_t* a = out + end;
+        uint32_t ttl = ((uint32_t)a[6] << 24) | (a[7] << 16) | (a[8] << 8) | a[9];
+        if (a[0] != 0xC0 || a[1] != 0x0C) fail(query.name, "answer name is not a pointer to the question");
+        if (readU16(a + 2) != 1 || readU16(a + 4) != 1) fail(query.name, "answer not A/IN");
+        if (ttl != CaptiveDns::TTL_SECS) fail(query.name, "TTL");
+        if (readU16(a + 8 + 2) != 4 || memcmp(a + 12, AP_ADDRESS, 4) != 0) fail(query.name, "address");
+    }
+}
+
+static void checkDropped(const std::string& name, const std::vector<uint8_t>& q, const uint8_t* answer) {
+    uint8_t out[CaptiveDns::MAX_PACKET];
+    if (CaptiveDns::buildResponse(q.data(), q.size(), answer, out, sizeof(out)) != 0) {
+        fail(name, "not dropped");
+    }
+}
+
+static void checkErrorReply(const std::string& name, const std::vector<uint8_t>& q,
+                            const uint8_t* answer, uint8_t rcode) {
+    uint8_t out[CaptiveDns::MAX_PACKET];
+    size_t length = CaptiveDns::buildResponse(q.data(), q.size(), answer, out, sizeof(out));
+    if (length != CaptiveDns::HEADER_SIZE || (out[3] & 0x0F) != rcode || readU16(&out[6]) != 0) {
+        fail(name, "expected a header-only error reply");
+    }
+}
+
+int main(int argc, char** argv) {
+    const char* file = argc > 1 ? argv[1] : "tools/fixtures/dns_burst.hex";
+    std::vector<Query> burst;
+    if (!loadBurst(file, burst)) {
+        std::fprintf(stderr, "Cannot read %s\n", file);
+        return 2;
+    }
+
+    uint8_t answer[CaptiveDns::ANSWER_SIZE];
+    CaptiveDns::buildAnswer(AP_ADDRESS, answer);
+
+    // Well-formed burst
+    for (const Query& query : burst) {
+        checkAnswered(query, answer);
+    }
+
+    // Every truncation of every query; the EDNS record after the question
+    // may be cut without harm, everything shorter must be dropped
+    size_t truncations = 0;
+    for (const Query& query : burst) {
+        size_t end = questionEnd(query.bytes);
+        for (size_t cut = 0; cut < end; cut++) {
+            std::vector<uint8_t> q(query.bytes.begin(), query.bytes.begin() + cut);
+            checkDropped(query.name + " cut at " + std::to_string(cut), q, answer);
+            truncations++;
+        }
+    }
+
+    // Malformed
+    const std::vector<uint8_t>& sample = burst[0].bytes;
+    std::vector<uint8_t> q = sample;
+    q[12] = 0xC0;
+    checkDropped("compressed question name", q, answer);
+
+    q = sample;
+    q[12] = 63;                                     // Label runs past the packet
+    checkDropped("label past the end", q, answer);
+
+    q = sample;
+    q[2] |= 0x80;
+    checkDropped("response packet", q, answer);
+
+    uint8_t small[CaptiveDns::HEADER_SIZE + 8];
+    if (CaptiveDns::buildResponse(sample.data(), sample.size(), answer, small, sizeof(small)) != 0) {
+        fail("small output buffer", "not dropped");
+    }
+
+    // Well-formed header, unsupported content
+    q = sample;
+    q[5] = 2;
+    checkErrorReply("two questions", q, answer, 1);
+
+    q = sample;
+    q[2] = (q[2] & 0x87) | (2 << 3);                // STATUS opcode
+    checkErrorReply("status opcode", q, answer, 4);
+
+    // Timing of the whole burst
+    const int runs = 200000;
+    uint8_t out[CaptiveDns::MAX_PACKET];
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        const Query& query = burst[i % burst.size()];
+        bytes += CaptiveDns::buildResponse(query.bytes.data(), query.bytes.size(), answer, out, sizeof(out));
+    }
+    auto end = std::chrono::steady_clock::now();
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / runs;
+
+    std::printf("%zu queries answered, %zu truncations dropped, %d failures; %.0f ns per query (%zu bytes)\n",
+                burst.size(), truncations, failures, ns, bytes);
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,30 @@
+// Host timings of the SensorHub filter chains and the activity classifier
+// (same code the device runs with -DSENSOR_BENCHMARK):
+//   g++ -O2 -std=c++17 -Ilib/SensorHub -Ilib/MotionSensor tools/filter_bench.cpp
+//       lib/MotionSensor/ActivityClassifier.cpp -o filter_bench && ./filter_bench
+
+#include <chrono>
+#include <cstdio>
+
+#include "ActivityBenchmark.h"
+#include "FilterBenchmark.h"
+
+int main() {
+    auto origin = std::chrono::steady_clock::now();
+    auto nowUs = [origin]() {
+        return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - origin).count();
+    };
+
+    std::printf("Filter benchmark (ns per sample)\n");
+    filter_bench::run(nowUs, [](const char* name, uint32_t ns) {
+        std::printf("  %-18s %6u\n", name, (unsigned)ns);
+    }, 10000000);
+
+    std::printf("Activity benchmark (ns per reading, one every %u ms)\n",
+                (unsigned)activity_bench::READING_MS);
+    activity_bench::run(nowUs, [](const char* name, uint32_t ns) {
+        std::printf("  %-18s %6u  (%.6f%% CPU)\n", name, (unsigned)ns, activity_bench::cpuPercent(ns));
+    }, 10000000);
+    return 0;
+}
@@ -0,0 +1,335 @@
+// Diff test and benchmark of MetForecastScanner against a generic JSON parser
+//
+//   g++ -O2 -std=c++17 -Ilib/WeatherService -I.pio/libdeps/esp32c3_dev/ArduinoJson/src
+//       tools/met_scanner_check.cpp lib/WeatherService/MetForecastScanner.cpp -o met_check
+//   ./met_check tools/fixtures/met_compact.json
+//
+// The reference is ArduinoJson (as used with -DWEATHER_USE_ARDUINOJSON)
+// when its headers are on the include path, otherwise a small DOM parser
+// in this file. Every sample of the fixture is compared field by field,
+// the fixture is fed in several chunk sizes, and documents whose root is
+// not an object must be rejected. Exits non-zero on any difference.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "MetForecastScanner.h"
+
+#if __has_include(<ArduinoJson.h>)
+#define ARDUINOJSON_ENABLE_STD_STRING 1
+#include <ArduinoJson.h>
+#define REFERENCE_NAME "ArduinoJson"
+#else
+#define REFERENCE_NAME "DOM parser"
+#endif
+
+struct Sample {
+    std::string time;
+    std::string symbol;
+    int temperature = 0;    // 0.1 units, like MetSample
+    int humidity = 0;
+    bool hasTemperature = false;
+    bool hasHumidity = false;
+    bool hasSymbol = false;
+};
+
+static int toTenths(double value) {
+    return (int)std::lround(value * 10.0);
+}
+
+// ============================================================================
+// REFERENCE PARSER
+// ============================================================================
+
+#ifdef ARDUINOJSON_VERSION_MAJOR
+
+static bool referenceParse(const std::string& json, std::vector<Sample>& out) {
+    DynamicJsonDocument doc(json.size() * 2);
+    if (deserializeJson(doc, json)) return false;
+
+    JsonArray series = doc["properties"]["timeseries"];
+    for (JsonObject entry : series) {
+        Sample s;
+        s.time = entry["time"] | "";
+        JsonVariant temperature = entry["data"]["instant"]["details"]["air_temperature"];
+        JsonVariant humidity = entry["data"]["instant"]["details"]["relative_humidity"];
+        JsonVariant symbol = entry["data"]["next_1_hours"]["summary"]["symbol_code"];
+        if (!temperature.isNull()) {
+            s.temperature = toTenths(temperature.as<double>());
+            s.hasTemperature = true;
+        }
+        if (!humidity.isNull()) {
+            s.humidity = toTenths(humidity.as<double>());
+            s.hasHumidity = true;
+        }
+        if (!symbol.isNull()) {
+            s.symbol = symbol.as<const char*>();
+            s.hasSymbol = true;
+        }
+        out.push_back(s);
+    }
+    return true;
+}
+
+#else
+
+struct Value {
+    enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    double number = 0;
+    std::string string;
+    std::vector<Value> items;
+    std::map<std::string, Value> members;
+
+    const Value* get(const char* key) const {
+        if (type != OBJECT) return nullptr;
+        auto it = members.find(key);
+        return it == members.end() ? nullptr : &it->second;
+    }
+};
+
+class DomParser {
+public:
+    explicit DomParser(const std::string& text) : s_(text), p_(0) {}
+
+    bool parse(Value& v) {
+        return value(v) && (space(), p_ == s_.size());
+    }
+
+private:
+    const std::string& s_;
+    size_t p_;
+
+    void space() {
+        while (p_ < s_.size() && strchr(" \t\r\n", s_[p_])) p_++;
+    }
+
+    bool string(std::string& out) {
+        if (s_[p_++] != '"') return false;
+        while (p_ < s_.size() && s_[p_] != '"') {
+            char c = s_[p_++];
+            if (c == '\\') {
+                if (p_ >= s_.size()) return false;
+                char e = s_[p_++];
+                if (e == 'u') { out += '?'; p_ += 4; continue; }
+                c = e == 'n' ? '\n' : e == 't' ? '\t' : e;
+            }
+            out += c;
+        }
+        return p_++ < s_.size();
+    }
+
+    bool value(Value& v) {
+        space();
+        if (p_ >= s_.size()) return false;
+        char c = s_[p_];
+        if (c == '{') {
+            v.type = Value::OBJECT;
+            p_++;
+            space();
+            if (s_[p_] == '}') { p_++; return true; }
+            while (true) {
+                std::string key;
+                space();
+                if (!string(key)) return false;
+                space();
+                if (s_[p_++] != ':') return false;
+                if (!value(v.members[key])) return false;
+                space();
+                if (s_[p_] == ',') { p_++; continue; }
+                return s_[p_++] == '}';
+            }
+        }
+        if (c == '[') {
+            v.type = Value::ARRAY;
+            p_++;
+            space();
+            if (s_[p_] == ']') { p_++; return true; }
+            while (true) {
+                v.items.emplace_back();
+                if (!value(v.items.back())) return false;
+                space();
+                if (s_[p_] == ',') { p_++; continue; }
+                return s_[p_++] == ']';
+            }
+        }
+        if (c == '"') {
+            v.type = Value::STRING;
+            return string(v.string);
+        }
+        if (c == 't' || c == 'f' || c == 'n') {
+            v.type = c == 'n' ? Value::NUL : Value::BOOL;
+            p_ += c == 'f' ? 5 : 4;
+            return p_ <= s_.size();
+        }
+        char* end = nullptr;
+        v.type = Value::NUMBER;
+        v.number = strtod(s_.c_str() + p_, &end);
+        if (end == s_.c_str() + p_) return false;
+        p_ = end - s_.c_str();
+        return true;
+    }
+};
+
+static const Value* path(const Value* v, std::initializer_list<const char*> keys) {
+    for (const char* key : keys) {
+        if (v == nullptr) return nullptr;
+        v = v->get(key);
+    }
+    return v;
+}
+
+static bool referenceParse(const std::string& json, std::vector<Sample>& out) {
+    Value root;
+    if (!DomParser(json).parse(root)) return false;
+
+    const Value* series = path(&root, {"properties", "timeseries"});
+    if (series == nullptr || series->type != Value::ARRAY) return false;
+
+    for (const Value& entry : series->items) {
+        Sample s;
+        const Value* time = entry.get("time");
+        const Value* temperature = path(&entry, {"data", "instant", "details", "air_temperature"});
+        const Value* humidity = path(&entry, {"data", "instant", "details", "relative_humidity"});
+        const Value* symbol = path(&entry, {"data", "next_1_hours", "summary", "symbol_code"});
+        if (time && time->type == Value::STRING) s.time = time->string;
+        if (temperature && temperature->type == Value::NUMBER) {
+            s.temperature = toTenths(temperature->number);
+            s.hasTemperature = true;
+        }
+        if (humidity && humidity->type == Value::NUMBER) {
+            s.humidity = toTenths(humidity->number);
+            s.hasHumidity = true;
+        }
+        if (symbol && symbol->type == Value::STRING) {
+            s.symbol = symbol->string;
+            s.hasSymbol = true;
+        }
+        out.push_back(s);
+    }
+    return true;
+}
+
+#endif
+
+// ============================================================================
+// SCANNER
+// ============================================================================
+
+static bool collect(const MetSample& sample, void* context) {
+    Sample s;
+    s.time = sample.time;
+    s.symbol = sample.symbol;
+    s.temperature = sample.temperature;
+    s.humidity = sample.humidity;
+    s.hasTemperature = sample.hasTemperature;
+    s.hasHumidity = sample.hasHumidity;
+    s.hasSymbol = sample.hasSymbol;
+    static_cast<std::vector<Sample>*>(context)->push_back(s);
+    return true;
+}
+
+static bool scan(MetForecastScanner& scanner, const std::string& json, size_t chunk,
+                 std::vector<Sample>& out) {
+    scanner.reset(collect, &out);
+    for (size_t pos = 0; pos < json.size(); pos += chunk) {
+        size_t len = std::min(chunk, json.size() - pos);
+        if (!scanner.feed(json.data() + pos, len)) break;
+    }
+    return scanner.isDone();
+}
+
+static bool same(const Sample& a, const Sample& b) {
+    return a.time == b.time && a.hasTemperature == b.hasTemperature &&
+           a.hasHumidity == b.hasHumidity && a.hasSymbol == b.hasSymbol &&
+           (!a.hasTemperature || a.temperature == b.temperature) &&
+           (!a.hasHumidity || a.humidity == b.humidity) &&
+           (!a.hasSymbol || a.symbol == b.symbol);
+}
+
+int main(int argc, char** argv) {
+    const char* file = argc > 1 ? argv[1] : "tools/fixtures/met_compact.json";
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        std::fprintf(stderr, "Cannot read %s\n", file);
+        return 2;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string json = buffer.str();
+
+    int failures = 0;
+    std::vector<Sample> expected;
+    if (!referenceParse(json, expected)) {
+        std::fprintf(stderr, "Reference (%s) failed to parse %s\n", REFERENCE_NAME, file);
+        return 2;
+    }
+
+    // Diff, fed in different chunk sizes (1 byte exercises every resume path)
+    std::unique_ptr<MetForecastScanner> scanner(new MetForecastScanner());
+    const size_t chunks[] = {1, 7, 64, 256, json.size()};
+    for (size_t chunk : chunks) {
+        std::vector<Sample> got;
+        if (!scan(*scanner, json, chunk, got)) {
+            std::printf("FAIL chunk %zu: scanner did not finish the document\n", chunk);
+            failures++;
+            continue;
+        }
+        if (got.size() != expected.size()) {
+            std::printf("FAIL chunk %zu: %zu entries, reference %zu\n", chunk, got.size(), expected.size());
+            failures++;
+            continue;
+        }
+        for (size_t i = 0; i < got.size(); i++) {
+            if (!same(got[i], expected[i])) {
+                std::printf("FAIL chunk %zu entry %zu (%s): %d/%d '%s' vs %d/%d '%s'\n", chunk, i,
+                            expected[i].time.c_str(), got[i].temperature, got[i].humidity,
+                            got[i].symbol.c_str(), expected[i].temperature, expected[i].humidity,
+                            expected[i].symbol.c_str());
+                failures++;
+            }
+        }
+    }
+    std::printf("Diff against %s: %zu entries, %d differences\n", REFERENCE_NAME, expected.size(), failures);
+
+    // Roots that are not an object must be rejected, not walked
+    const char* badRoots[] = {"[1,2,3]", "\"text\"", "42 ", "true ", "[{\"properties\":{}}]", "}"};
+    for (const char* doc : badRoots) {
+        std::vector<Sample> got;
+        scan(*scanner, doc, strlen(doc), got);
+        if (!scanner->hasError()) {
+            std::printf("FAIL root %s not rejected\n", doc);
+            failures++;
+        }
+    }
+
+    // Benchmark
+    const int runs = 200;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        std::vector<Sample> got;
+        got.reserve(expected.size());
+        scan(*scanner, json, 256, got);
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) {
+        std::vector<Sample> got;
+        referenceParse(json, got);
+    }
+    auto t2 = std::chrono::steady_clock::now();
+
+    double scanUs = std::chrono::duration<double, std::micro>(t1 - t0).count() / runs;
+    double refUs = std::chrono::duration<double, std::micro>(t2 - t1).count() / runs;
+    std::printf("%zu bytes: scanner %.1f us (%.0f MB/s, %zu bytes of state), %s %.1f us, x%.1f\n",
+                json.size(), scanUs, json.size() / scanUs, sizeof(MetForecastScanner),
+                REFERENCE_NAME, refUs, refUs / scanUs);
+
+    return failures == 0 ? 0 : 1;
+}
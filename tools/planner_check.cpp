@@ -0,0 +1,180 @@
+// Host check of the idle behavior planner (BehaviorPlanner)
+//
+//   g++ -O2 -std=c++17 -Ilib/AnimationEngine tools/planner_check.cpp
+//       lib/AnimationEngine/BehaviorPlanner.cpp -o planner_check && ./planner_check [seed]
+//
+// Feeds a scripted day through BehaviorPlanner::update() at 1 Hz: a quiet
+// night, button presses at 04:00, a quiet afternoon with nobody around and
+// a busy afternoon (talking, handling, frequent input). Every 4 s it asks
+// for a blink delay and an expression, as AnimationStateMachine does, and
+// records them with the sleepy flag and loop delay. The script runs twice
+// with the same seed and must produce the identical plan; the modulation
+// must point the right way: quiet nights blink slower than busy days and
+// drop to the low-activity loop delay, busy days play more expressions
+// than quiet ones. Exits non-zero on any failure.
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "BehaviorPlanner.h"
+
+// AnimationStateMachine defaults
+static const uint32_t BLINK_MIN_MS = 3000;
+static const uint32_t BLINK_MAX_MS = 8000;
+static const uint8_t EXPRESSION_CHANCE = 30;
+static const unsigned long PLAN_INTERVAL_MS = 4000;
+
+struct Phase {
+    const char* name;
+    int8_t startHour;
+    uint32_t seconds;
+    uint8_t soundMin, soundMax;
+    uint8_t motionMin, motionMax;
+    uint32_t inputEverySecs;        // 0 = no input
+};
+
+static const Phase PHASES[] = {
+    {"quiet night",     1, 3 * 3600,  2,  6,  0,  1,   0},
+    {"input at night",  4,       60,  2,  6,  0,  1,  30},
+    {"rest of night",   4, 2 * 3600,  2,  6,  0,  1,   0},
+    {"quiet afternoon", 13, 2 * 3600, 3,  8,  0,  1,   0},
+    {"busy afternoon",  15, 2 * 3600, 40, 75, 15, 60, 20},
+};
+
+static const size_t PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+
+struct Plan {
+    uint32_t blinkDelay;
+    PlannedAction action;
+    bool sleepy;
+    uint16_t loopDelay;
+
+    bool operator==(const Plan& other) const {
+        return blinkDelay == other.blinkDelay && action == other.action &&
+               sleepy == other.sleepy && loopDelay == other.loopDelay;
+    }
+};
+
+struct PhaseStats {
+    uint64_t blinkSum = 0;
+    uint32_t plans = 0;
+    uint32_t actions = 0;
+    uint32_t sleepy = 0;
+    uint32_t sleepyActions = 0;
+    uint16_t lastLoopDelay = 0;
+    uint8_t lastActivity = 0;
+};
+
+// Scripted sensor noise, independent of the planner's generator
+static uint32_t scriptRandom(uint32_t& state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static std::vector<Plan> runDay(uint32_t seed, PhaseStats* stats) {
+    BehaviorPlanner planner;
+    planner.seed(seed);
+
+    std::vector<Plan> plans;
+    uint32_t script = 0x1234567u;
+    unsigned long now = 0;
+
+    for (size_t p = 0; p < PHASE_COUNT; p++) {
+        const Phase& phase = PHASES[p];
+        unsigned long phaseStart = now;
+
+        for (uint32_t s = 0; s < phase.seconds; s++) {
+            now += 1000;
+
+            PlannerInputs inputs;
+            inputs.soundPercent = phase.soundMin + scriptRandom(script) % (phase.soundMax - phase.soundMin + 1);
+            inputs.motionPercent = phase.motionMin + scriptRandom(script) % (phase.motionMax - phase.motionMin + 1);
+            inputs.hourOfDay = (int8_t)((phase.startHour + s / 3600) % 24);
+
+            if (phase.inputEverySecs != 0 && s % phase.inputEverySecs == 0) {
+                planner.noteInteraction(now);
+            }
+            planner.update(inputs, now);
+
+            if ((now - phaseStart) % PLAN_INTERVAL_MS != 0) continue;
+
+            Plan plan;
+            plan.blinkDelay = planner.nextBlinkDelay(BLINK_MIN_MS, BLINK_MAX_MS);
+            plan.action = planner.pickAction(EXPRESSION_CHANCE, now);
+            plan.sleepy = planner.isSleepy();
+            plan.loopDelay = planner.getLoopDelayMs();
+            plans.push_back(plan);
+
+            PhaseStats& st = stats[p];
+            st.blinkSum += plan.blinkDelay;
+            st.plans++;
+            st.actions += plan.action != PlannedAction::NONE;
+            st.sleepy += plan.sleepy;
+            st.sleepyActions += plan.sleepy && plan.action != PlannedAction::NONE;
+            st.lastLoopDelay = plan.loopDelay;
+            st.lastActivity = planner.getActivityLevel();
+        }
+    }
+    return plans;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        std::printf("FAIL %s\n", what);
+        failures++;
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t seed = argc > 1 ? (uint32_t)strtoul(argv[1], nullptr, 10) : 1;
+
+    PhaseStats first[PHASE_COUNT];
+    PhaseStats second[PHASE_COUNT];
+    PhaseStats other[PHASE_COUNT];
+    std::vector<Plan> a = runDay(seed, first);
+    std::vector<Plan> b = runDay(seed, second);
+    std::vector<Plan> c = runDay(seed + 1, other);
+
+    // Determinism
+    check(a.size() == b.size() && a == b, "same seed gave a different plan");
+    check(a != c, "different seeds gave the same plan");
+
+    std::printf("%-16s %6s %9s %9s %7s %5s\n", "phase", "plans", "blink ms", "actions", "sleepy", "loop");
+    for (size_t p = 0; p < PHASE_COUNT; p++) {
+        const PhaseStats& st = first[p];
+        std::printf("%-16s %6u %9.0f %8.1f%% %6.0f%% %3u ms  (activity %u)\n", PHASES[p].name, st.plans,
+                    (double)st.blinkSum / st.plans, 100.0 * st.actions / st.plans,
+                    100.0 * st.sleepy / st.plans, st.lastLoopDelay, st.lastActivity);
+    }
+
+    const PhaseStats& night = first[0];
+    const PhaseStats& wake = first[1];
+    const PhaseStats& quietDay = first[3];
+    const PhaseStats& busyDay = first[4];
+    double nightBlink = (double)night.blinkSum / night.plans;
+    double busyBlink = (double)busyDay.blinkSum / busyDay.plans;
+
+    // Direction of the modulation
+    check(nightBlink > busyBlink, "quiet night does not blink slower than a busy day");
+    check(night.lastLoopDelay == BehaviorPlanner::LOW_ACTIVITY_LOOP_MS,
+          "quiet night not on the low-activity loop delay");
+    check(night.sleepy * 2 > night.plans, "quiet night mostly not sleepy");
+    for (const PhaseStats& st : first) {
+        check(st.sleepyActions == 0, "sleepy face played an expression");
+    }
+    check(wake.sleepy < wake.plans, "input at night did not wake the face");
+    check(busyDay.lastLoopDelay == BehaviorPlanner::NORMAL_LOOP_MS,
+          "busy day not on the normal loop delay");
+    check(busyDay.sleepy == 0, "sleepy face on a busy day");
+    check((uint64_t)busyDay.actions * quietDay.plans > (uint64_t)quietDay.actions * busyDay.plans,
+          "busy day plays no more expressions than a quiet one");
+
+    std::printf("%zu plans, seed %u, %d failures\n", a.size(), seed, failures);
+    return failures == 0 ? 0 : 1;
+}
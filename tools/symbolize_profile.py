@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+"""Symbolize SamplingProfiler dumps into folded stacks for flame graphs.
+
+Input is the text the firmware prints for "prof dump" on the serial
+console (a captured monitor log works, other lines are ignored), or a
+live capture pulled from the setup portal's /profile endpoint:
+
+    # From a serial log
+    pio device monitor | tee monitor.log       # then type: prof start 1000 2 ... prof dump
+    tools/symbolize_profile.py -e .pio/build/esp32c3_profile/firmware.elf monitor.log > app.folded
+
+    # From the web (device in setup portal mode)
+    tools/symbolize_profile.py -e firmware.elf --url http://192.168.4.1 --seconds 10 > app.folded
+
+    flamegraph.pl app.folded > app.svg
+
+Each output line is "outermost;...;innermost <count>", the format read by
+flamegraph.pl, speedscope and inferno. A flat profile of the innermost
+functions goes to stderr.
+"""
+
+import argparse
+import collections
+import json
+import re
+import shutil
+import subprocess
+import sys
+import time
+import urllib.request
+
+SAMPLE_RE = re.compile(r"@prof((?: 0x[0-9a-fA-F]{8})+)")
+HEADER_RE = re.compile(r"# profile (.*)")
+NEXT_RE = re.compile(r"# next=(\d+)")
+
+
+def parse_dump(lines):
+    """Return (header fields, list of address tuples, innermost first)."""
+    header = {}
+    samples = []
+    for line in lines:
+        match = HEADER_RE.search(line)
+        if match:
+            header = dict(field.split("=", 1) for field in match.group(1).split())
+            continue
+        match = SAMPLE_RE.search(line)
+        if match:
+            samples.append(tuple(int(word, 16) for word in match.group(1).split()))
+    return header, samples
+
+
+def post(url, payload):
+    request = urllib.request.Request(url + "/profile", data=json.dumps(payload).encode(),
+                                     headers={"Content-Type": "application/json"})
+    with urllib.request.urlopen(request, timeout=10) as response:
+        return response.read().decode()
+
+
+def capture_web(url, rate, depth, seconds):
+    url = url.rstrip("/")
+    post(url, {"action": "start", "rate": rate, "depth": depth})
+    print(f"Sampling {seconds} s at {rate} Hz, depth {depth}...", file=sys.stderr)
+    time.sleep(seconds)
+
+    lines = []
+    start = 0
+    while True:
+        page = post(url, {"action": "dump", "from": start}).splitlines()
+        lines.extend(page)
+        match = next((NEXT_RE.match(line) for line in page if NEXT_RE.match(line)), None)
+        if match is None:
+            return lines
+        start = int(match.group(1))
+
+
+def find_addr2line(name):
+    if name:
+        return name
+    for candidate in ("riscv32-esp-elf-addr2line", "addr2line"):
+        if shutil.which(candidate):
+            return candidate
+    sys.exit("addr2line not found; pass --addr2line (e.g. from ~/.platformio/packages/toolchain-riscv32-esp/bin)")
+
+
+def symbolize(addr2line, elf, addresses):
+    """Map each address to a function name (hex when unknown)."""
+    addresses = sorted(addresses)
+    names = {}
+    for i in range(0, len(addresses), 500):
+        batch = addresses[i:i + 500]
+        output = subprocess.run([addr2line, "-f", "-C", "-e", elf] + [hex(a) for a in batch],
+                                check=True, capture_output=True, text=True).stdout.splitlines()
+        # Two lines per address: function, file:line
+        for address, function in zip(batch, output[0::2]):
+            names[address] = function if function and function != "??" else hex(address)
+    return names
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("logs", nargs="*", help="serial logs with a prof dump (default: stdin)")
+    parser.add_argument("-e", "--elf", required=True, help="firmware ELF the samples were taken with")
+    parser.add_argument("--addr2line", help="addr2line binary (default: riscv32-esp-elf-addr2line)")
+    parser.add_argument("--url", help="capture from http://<device> instead of logs")
+    parser.add_argument("--rate", type=int, default=500, help="sample rate for --url (Hz)")
+    parser.add_argument("--depth", type=int, default=0, help="backtrace depth for --url")
+    parser.add_argument("--seconds", type=float, default=10, help="capture time for --url")
+    parser.add_argument("--top", type=int, default=20, help="flat profile entries on stderr")
+    args = parser.parse_args()
+
+    if args.url:
+        lines = capture_web(args.url, args.rate, args.depth, args.seconds)
+    elif args.logs:
+        lines = []
+        for path in args.logs:
+            with open(path, errors="replace") as log:
+                lines.extend(log)
+    else:
+        lines = sys.stdin
+
+    header, samples = parse_dump(lines)
+    if not samples:
+        sys.exit("No @prof samples found")
+
+    # Callers are return addresses; step back into the call instruction
+    lookups = set()
+    for sample in samples:
+        lookups.add(sample[0])
+        lookups.update(address - 1 for address in sample[1:])
+    names = symbolize(find_addr2line(args.addr2line), args.elf, lookups)
+
+    stacks = collections.Counter()
+    leaves = collections.Counter()
+    for sample in samples:
+        frames = [names[sample[0]]] + [names[address - 1] for address in sample[1:]]
+        stacks[";".join(reversed(frames))] += 1
+        leaves[frames[0]] += 1
+
+    for stack, count in stacks.most_common():
+        print(f"{stack} {count}")
+
+    total = len(samples)
+    print(f"{total} samples ({header.get('rate', '?')} Hz, depth {header.get('depth', '?')}, "
+          f"{header.get('taken', '?')} taken)", file=sys.stderr)
+    for function, count in leaves.most_common(args.top):
+        print(f"{100.0 * count / total:6.1f}% {count:7d}  {function}", file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,48 @@
+#!/usr/bin/env python3
+"""Extract a sensor trace streamed over serial into a trace file.
+
+"trace rec" without a file name streams the trace to the console as
+"@trace <hex>" lines between the normal log output. This collects them
+from a captured monitor log and writes the binary trace, ready to be put
+on the device's LittleFS (data/ + "pio run -t uploadfs") and replayed
+with "trace play /<name> [fast]":
+
+    pio device monitor | tee session.log     # type: trace rec ... trace stop
+    tools/trace_from_log.py session.log data/shake1.trc
+"""
+
+import argparse
+import re
+import sys
+
+TRACE_RE = re.compile(r"@trace ([0-9a-f]+)")
+MAGIC = b"CTR1"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("log", help="captured serial log")
+    parser.add_argument("output", help="trace file to write")
+    args = parser.parse_args()
+
+    data = bytearray()
+    with open(args.log, errors="replace") as log:
+        for line in log:
+            match = TRACE_RE.search(line)
+            if match:
+                chunk = bytes.fromhex(match.group(1))
+                # A new recording starts on a fresh line; keep only the last one
+                if chunk.startswith(MAGIC):
+                    data = bytearray()
+                data += chunk
+
+    if not data.startswith(MAGIC):
+        sys.exit("No trace found (expected @trace lines starting with the CTR1 header)")
+
+    with open(args.output, "wb") as out:
+        out.write(data)
+    print(f"{len(data)} bytes written to {args.output}")
+
+
+if __name__ == "__main__":
+    main()
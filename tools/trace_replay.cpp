@@ -0,0 +1,276 @@
+// Host replay of a recorded sensor session through the detection code
+//
+//   g++ -O2 -std=c++17 -Ilib/SensorTrace -Ilib/MotionSensor -Ilib/SensorHub
+//       tools/trace_replay.cpp lib/SensorTrace/TraceCodec.cpp -o trace_replay
+//   ./trace_replay session.trc          # a trace from "trace rec" / trace_from_log.py
+//   ./trace_replay [--write out.trc]    # built-in synthetic session
+//
+// Decodes the trace with TraceDecoder and runs every IMU record through
+// the MotionSensor detectors (MotionDetectors.h) and every sound record
+// through the SensorHub sound chain and trigger (SensorFilters.h), with
+// the recorded timestamps as clock, like "trace play <file> fast" on the
+// device. Reports detections, encoded bytes per sample and host time per
+// sample. Without a file, an 80 s session (desk, handling, shaking,
+// walking, two loud bursts) is synthesized with TraceEncoder; --write
+// saves it for replay on the device.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include "TraceCodec.h"
+#include "MotionDetectors.h"
+#include "SensorFilters.h"
+
+// Thresholds as set in src/main.cpp
+static const float SHAKE_THRESHOLD = 20.0f;
+static const uint16_t LOUD_SOUND_THRESHOLD = 2800;
+
+// ============================================================================
+// SYNTHETIC SESSION
+// ============================================================================
+
+class Noise {
+public:
+    explicit Noise(uint32_t seed) : _state(seed) {}
+
+    float uniform() {
+        _state = _state * 1664525u + 1013904223u;
+        return ((_state >> 8) + 0.5f) / 16777216.0f;
+    }
+
+    float gaussian(float sigma) {
+        return sigma * sqrtf(-2.0f * logf(uniform())) * cosf(6.2831853f * uniform());
+    }
+
+private:
+    uint32_t _state;
+};
+
+static int16_t toFixed(float value, float scale) {
+    float scaled = value * scale;
+    if (scaled > 32767.0f) return 32767;
+    if (scaled < -32768.0f) return -32768;
+    return (int16_t)lroundf(scaled);
+}
+
+static std::vector<uint8_t> synthesize() {
+    const float G = 9.81f;
+    Noise noise(20240611);
+    TraceEncoder encoder;
+    std::vector<uint8_t> trace(TraceEncoder::HEADER_BYTES);
+    encoder.writeHeader(trace.data());
+
+    uint8_t buffer[TraceEncoder::MAX_RECORD_BYTES];
+    auto append = [&](const TraceRecord& record) {
+        size_t length = encoder.encode(record, buffer);
+        trace.insert(trace.end(), buffer, buffer + length);
+    };
+
+    uint32_t nextSoundMs = 0;
+    bool pressed = false;
+    float gyroBias[3] = {0.012f, -0.007f, 0.003f};
+
+    // One IMU reading per loop (10 ms delay plus work), sound every 100 ms
+    for (uint32_t t = 0; t < 80000; t += 11 + (uint32_t)(noise.uniform() * 4)) {
+        float s = t / 1000.0f;
+        float accel[3] = {0.0f, 0.0f, G};
+        float gyro[3] = {0.0f, 0.0f, 0.0f};
+        float jitter = 0.03f;
+
+        if (s >= 20.0f && s < 30.0f) {
+            // Handled: slow turning plus hand tremor
+            float pitch = 0.6f * sinf(0.9f * s) + 0.2f * sinf(2.3f * s);
+            float roll = 0.5f * sinf(0.7f * s + 1.0f);
+            accel[0] = G * sinf(roll);
+            accel[1] = G * sinf(pitch) * cosf(roll);
+            accel[2] = G * cosf(pitch) * cosf(roll);
+            gyro[0] = 0.54f * cosf(0.9f * s) + 0.46f * cosf(2.3f * s);
+            gyro[1] = 0.35f * cosf(0.7f * s + 1.0f);
+            jitter = 0.25f;
+        } else if (s >= 30.0f && s < 33.0f) {
+            // Shaken side to side at ~4 Hz
+            accel[0] = 22.0f * sinf(6.2831853f * 4.0f * s);
+            gyro[2] = 3.0f * cosf(6.2831853f * 4.0f * s);
+            jitter = 0.8f;
+        } else if (s >= 33.0f && s < 60.0f) {
+            // Carried while walking: ~1.8 Hz vertical bounce
+            accel[2] = G + 2.5f * sinf(6.2831853f * 1.8f * s);
+            accel[0] = 0.8f * sinf(6.2831853f * 0.9f * s);
+            gyro[0] = 0.2f * sinf(6.2831853f * 1.8f * s);
+            jitter = 0.3f;
+        }
+
+        TraceRecord record = {};
+        record.channel = TraceChannel::IMU;
+        record.timeMs = t;
+        for (int i = 0; i < 3; i++) {
+            record.imu.accel[i] = toFixed(accel[i] + noise.gaussian(jitter), TRACE_ACCEL_SCALE);
+            record.imu.gyro[i] = toFixed(gyro[i] + gyroBias[i] + noise.gaussian(0.002f + jitter / 20),
+                                         TRACE_GYRO_SCALE);
+        }
+        append(record);
+
+        if (t >= nextSoundMs) {
+            nextSoundMs += 100;
+            bool loud = (s >= 10.0f && s < 12.0f) || (s >= 45.0f && s < 47.5f);
+            float level = (loud ? 3500.0f : 1200.0f) + noise.gaussian(loud ? 250.0f : 60.0f);
+
+            TraceRecord sound = {};
+            sound.channel = TraceChannel::SOUND;
+            sound.timeMs = t;
+            sound.sound = (uint16_t)std::min(4095.0f, std::max(0.0f, level));
+            append(sound);
+        }
+
+        // A button press at 70 s
+        if (!pressed && t >= 70000) {
+            pressed = true;
+            TraceRecord inputs = {};
+            inputs.channel = TraceChannel::INPUTS;
+            inputs.timeMs = t;
+            inputs.inputs = TRACE_INPUT_SELECT;
+            append(inputs);
+        }
+    }
+    return trace;
+}
+
+// ============================================================================
+// REPLAY
+// ============================================================================
+
+struct ReplayResult {
+    uint32_t records[TRACE_CHANNELS] = {};
+    uint32_t bytes[TRACE_CHANNELS] = {};
+    uint32_t shakes = 0;
+    uint32_t suddenMovements = 0;
+    uint32_t loudSounds = 0;
+    uint32_t durationMs = 0;
+    std::vector<uint32_t> shakeTimes;
+    std::vector<uint32_t> loudTimes;
+    bool error = false;
+};
+
+static ReplayResult replay(const std::vector<uint8_t>& trace) {
+    ReplayResult result;
+    TraceDecoder decoder;
+    ShakeDetector shake;
+    SoundFilter soundFilter;
+    SoundTrigger soundTrigger;
+    shake.setThreshold(SHAKE_THRESHOLD);
+    soundTrigger.setThreshold(LOUD_SOUND_THRESHOLD);
+
+    size_t pos = TraceEncoder::HEADER_BYTES;
+    TraceRecord record;
+    while (pos < trace.size()) {
+        size_t used = decoder.decode(trace.data() + pos, trace.size() - pos, record);
+        if (used == 0) {
+            result.error = decoder.hasError();
+            break;
+        }
+        pos += used;
+
+        uint8_t channel = (uint8_t)record.channel;
+        result.records[channel]++;
+        result.bytes[channel] += used;
+        result.durationMs = record.timeMs;
+
+        // Same steps as MotionSensor::update() and SensorHub::updateSound()
+        if (record.channel == TraceChannel::IMU) {
+            float x = record.imu.accel[0] / TRACE_ACCEL_SCALE;
+            float y = record.imu.accel[1] / TRACE_ACCEL_SCALE;
+            float z = record.imu.accel[2] / TRACE_ACCEL_SCALE;
+            float magnitude = sqrtf(x * x + y * y + z * z);
+
+            if (shake.update(magnitude, record.timeMs)) {
+                result.shakes++;
+                result.shakeTimes.push_back(record.timeMs);
+            }
+            if (isSuddenMovement(x, y, z)) {
+                result.suddenMovements++;
+            }
+        } else if (record.channel == TraceChannel::SOUND) {
+            uint16_t level;
+            soundFilter.push(record.sound, level);
+            soundTrigger.update(level);
+            if (soundTrigger.rose()) {
+                result.loudSounds++;
+                result.loudTimes.push_back(record.timeMs);
+            }
+        }
+    }
+    return result;
+}
+
+static void printTimes(const char* name, const std::vector<uint32_t>& times) {
+    std::printf("  %-16s", name);
+    for (size_t i = 0; i < times.size() && i < 8; i++) {
+        std::printf(" %.2fs", times[i] / 1000.0f);
+    }
+    std::printf(times.size() > 8 ? " ...\n" : "\n");
+}
+
+int main(int argc, char** argv) {
+    const char* input = nullptr;
+    const char* output = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--write") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            input = argv[i];
+        }
+    }
+
+    std::vector<uint8_t> trace;
+    if (input != nullptr) {
+        std::ifstream in(input, std::ios::binary);
+        trace.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (!TraceDecoder::checkHeader(trace.data(), trace.size())) {
+            std::fprintf(stderr, "%s is not a trace\n", input);
+            return 2;
+        }
+    } else {
+        trace = synthesize();
+        if (output != nullptr) {
+            std::ofstream out(output, std::ios::binary);
+            out.write((const char*)trace.data(), trace.size());
+        }
+    }
+
+    ReplayResult result = replay(trace);
+    if (result.error) {
+        std::printf("Trace is corrupt after %u records\n",
+                    result.records[0] + result.records[1] + result.records[2]);
+        return 1;
+    }
+
+    // Host cost of decode + detection per record
+    const int runs = 50;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < runs; i++) replay(trace);
+    auto end = std::chrono::steady_clock::now();
+    uint32_t total = result.records[0] + result.records[1] + result.records[2];
+    double ns = std::chrono::duration<double, std::nano>(end - start).count() / runs / total;
+
+    const uint8_t imu = (uint8_t)TraceChannel::IMU;
+    const uint8_t sound = (uint8_t)TraceChannel::SOUND;
+    std::printf("%s: %zu bytes, %.1f s\n", input ? input : "synthetic session", trace.size(),
+                result.durationMs / 1000.0f);
+    std::printf("  IMU              %u samples, %.2f bytes each (28 as floats + time)\n",
+                result.records[imu],
+                result.records[imu] ? (double)result.bytes[imu] / result.records[imu] : 0.0);
+    std::printf("  sound            %u samples, %.2f bytes each\n", result.records[sound],
+                result.records[sound] ? (double)result.bytes[sound] / result.records[sound] : 0.0);
+    std::printf("  detections       %u shakes, %u sudden-movement readings, %u loud sounds\n",
+                result.shakes, result.suddenMovements, result.loudSounds);
+    printTimes("shakes at", result.shakeTimes);
+    printTimes("loud sounds at", result.loudTimes);
+    std::printf("  host time        %.0f ns per record (decode + detection)\n", ns);
+    return 0;
+}
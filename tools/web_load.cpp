@@ -0,0 +1,271 @@
+// Host load generator for the captive portal handlers (WebInterface)
+//
+//   g++ -O2 -std=c++17 -Ilib/WiFiManager tools/web_load.cpp lib/WiFiManager/WebInterface.cpp
+//       lib/WiFiManager/WebJson.cpp -o web_load && ./web_load [requests] [seed]
+//
+// Replays a weighted request mix shaped like a phone setup session (probe
+// bursts, /status polling, a few scans and form posts, a profile dump)
+// through WebInterface::handle() with MemoryWebRequest and a canned
+// backend. Per route it reports latency percentiles, heap allocations per
+// request and the peak heap held while the handler ran (operator new is
+// counted; the handlers allocate nothing else). JSON buffers live on the
+// handler's stack and are not included.
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "MemoryWebRequest.h"
+#include "WebInterface.h"
+
+// ============================================================================
+// ALLOCATION COUNTING
+// ============================================================================
+
+namespace {
+
+bool g_tracking = false;
+size_t g_allocations = 0;
+size_t g_liveBytes = 0;
+size_t g_peakBytes = 0;
+
+// Size is kept in front of the block so delete can account for it
+constexpr size_t HEADER = alignof(std::max_align_t);
+
+void* trackedAlloc(size_t size) {
+    char* block = (char*)std::malloc(size + HEADER);
+    if (block == nullptr) return nullptr;
+    *(size_t*)block = size;
+    if (g_tracking) {
+        g_allocations++;
+        g_liveBytes += size;
+        g_peakBytes = std::max(g_peakBytes, g_liveBytes);
+    }
+    return block + HEADER;
+}
+
+void trackedFree(void* p) {
+    if (p == nullptr) return;
+    char* block = (char*)p - HEADER;
+    if (g_tracking) {
+        size_t size = *(size_t*)block;
+        g_liveBytes = size < g_liveBytes ? g_liveBytes - size : 0;
+    }
+    std::free(block);
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+    void* p = trackedAlloc(size);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void operator delete(void* p) noexcept { trackedFree(p); }
+void operator delete[](void* p) noexcept { trackedFree(p); }
+void operator delete(void* p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void* p, size_t) noexcept { trackedFree(p); }
+
+// ============================================================================
+// CANNED BACKEND
+// ============================================================================
+
+class HostBackend : public WebBackend {
+public:
+    uint32_t restarts = 0;
+    uint32_t credentialsSaved = 0;
+    bool profilerRunning = false;
+
+    int scanNetworks() override { return NETWORK_COUNT; }
+
+    bool getNetwork(int index, WebNetwork& network) override {
+        if (index < 0 || index >= NETWORK_COUNT) return false;
+        snprintf(network.ssid, sizeof(network.ssid), "%s", NETWORKS[index]);
+        network.rssi = (int8_t)(-40 - index * 4);
+        network.encrypted = index % 3 != 0;
+        return true;
+    }
+
+    void saveCredentials(const char*, const char*) override { credentialsSaved++; }
+
+    void getStatus(WebStatus& status) override {
+        status.connected = false;
+        status.state = 1;
+        status.freeHeap = 180000;
+        status.hasDns = true;
+        status.dnsQueries = 5210;
+        status.dnsAnswered = 4800;
+        status.dnsRejected = 3;
+        status.dnsPeakPerSec = 41;
+        status.dnsMaxUs = 320;
+    }
+
+    const WebAdmissionStats& getWebStats() override { return stats_; }
+    const DeviceConfig& getDeviceConfig() override { return config_; }
+    void saveDeviceConfig(const DeviceConfig& config) override { config_ = config; }
+    void restart() override { restarts++; }
+    uint32_t uptimeMs() override { return 123456; }
+
+    bool getProfileStatus(WebProfileStatus& status) override {
+        status.running = profilerRunning;
+        status.rateHz = 500;
+        status.depth = 2;
+        status.samples = PROFILE_SAMPLES;
+        status.taken = PROFILE_SAMPLES;
+        status.capacity = 1365;
+        return true;
+    }
+
+    bool startProfiler(uint32_t, uint8_t) override { return profilerRunning = true; }
+    void stopProfiler() override { profilerRunning = false; }
+
+    size_t formatProfileHeader(char* out, size_t size) override {
+        int n = snprintf(out, size, "# profile rate=500 depth=2 samples=%u taken=%u missed=0",
+                         PROFILE_SAMPLES, PROFILE_SAMPLES);
+        return std::min((size_t)n, size - 1);
+    }
+
+    size_t formatProfileSample(uint32_t index, char* out, size_t size) override {
+        if (index >= PROFILE_SAMPLES) return 0;
+        int n = snprintf(out, size, "@prof 0x%08x 0x%08x 0x%08x",
+                         0x42001000u + index * 52, 0x42008000u + index % 7, 0x4200c000u);
+        return std::min((size_t)n, size - 1);
+    }
+
+private:
+    static constexpr int NETWORK_COUNT = 14;
+    static constexpr uint32_t PROFILE_SAMPLES = 300;
+    static const char* const NETWORKS[NETWORK_COUNT];
+
+    WebAdmissionStats stats_;
+    DeviceConfig config_;
+};
+
+const char* const HostBackend::NETWORKS[NETWORK_COUNT] = {
+    "HomeNet", "FRITZ!Box 7590 XY", "Vodafone-8A3C", "\"quoted\" \\ net", "eduroam",
+    "Telekom_FON", "DIRECT-4F-HP OfficeJet", "Caf\xc3\xa9 Wifi", "Guest", "iPhone von Alex",
+    "TP-Link_2.4GHz_5A1B2C", "o2-WLAN42", "Free\tWiFi", "01234567890123456789012345678901",
+};
+
+// ============================================================================
+// REQUEST MIX
+// ============================================================================
+
+struct MixEntry {
+    const char* label;
+    WebMethod method;
+    const char* path;
+    const char* body;
+    unsigned weight;
+};
+
+static const MixEntry MIX[] = {
+    {"probe generate_204",   WebMethod::GET,  "/generate_204", nullptr, 220},
+    {"probe hotspot-detect", WebMethod::GET,  "/hotspot-detect.html", nullptr, 160},
+    {"unknown path",         WebMethod::GET,  "/favicon.ico", nullptr, 40},
+    {"GET /",                WebMethod::GET,  "/", nullptr, 60},
+    {"GET /status",          WebMethod::GET,  "/status", nullptr, 180},
+    {"GET /scan",            WebMethod::GET,  "/scan", nullptr, 40},
+    {"GET /config",          WebMethod::GET,  "/config", nullptr, 50},
+    {"GET /terms",           WebMethod::GET,  "/terms", nullptr, 25},
+    {"GET /privacy",         WebMethod::GET,  "/privacy", nullptr, 25},
+    {"POST /connect",        WebMethod::POST, "/connect",
+     "{\"ssid\":\"HomeNet\",\"password\":\"correct horse battery\"}", 30},
+    {"POST /connect bad",    WebMethod::POST, "/connect", "{\"ssid\":\"HomeNet\",", 10},
+    {"POST /config",         WebMethod::POST, "/config",
+     "{\"setupComplete\":true,\"wifiEnabled\":true,\"geolocationEnabled\":false,"
+     "\"weatherEnabled\":true,\"ntpEnabled\":true,\"manualTimezoneOffset\":3600,"
+     "\"termsAccepted\":true,\"privacyAccepted\":true}", 15},
+    {"GET /profile",         WebMethod::GET,  "/profile", nullptr, 20},
+    {"POST /profile start",  WebMethod::POST, "/profile", "{\"action\":\"start\",\"rate\":500,\"depth\":2}", 5},
+    {"POST /profile dump",   WebMethod::POST, "/profile", "{\"action\":\"dump\",\"from\":128}", 10},
+};
+
+static constexpr size_t MIX_COUNT = sizeof(MIX) / sizeof(MIX[0]);
+
+struct RouteStats {
+    std::vector<uint32_t> latencyNs;
+    size_t allocations = 0;
+    size_t peakBytes = 0;
+    size_t responseBytes = 0;
+    int status = 0;
+};
+
+int main(int argc, char** argv) {
+    size_t requests = argc > 1 ? strtoul(argv[1], nullptr, 10) : 200000;
+    uint32_t seed = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 1;
+
+    unsigned totalWeight = 0;
+    for (const MixEntry& entry : MIX) totalWeight += entry.weight;
+
+    HostBackend backend;
+    WebInterface web(&backend);
+
+    std::vector<RouteStats> stats(MIX_COUNT);
+    for (RouteStats& route : stats) route.latencyNs.reserve(requests);
+
+    // Fixed xorshift sequence so runs are comparable
+    uint32_t state = seed ? seed : 1;
+    for (size_t n = 0; n < requests; n++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+
+        unsigned pick = state % totalWeight;
+        size_t index = 0;
+        while (pick >= MIX[index].weight) pick -= MIX[index++].weight;
+
+        const MixEntry& entry = MIX[index];
+        MemoryWebRequest request(entry.method, entry.path, entry.body);
+
+        g_allocations = 0;
+        g_liveBytes = 0;
+        g_peakBytes = 0;
+        g_tracking = true;
+        auto start = std::chrono::steady_clock::now();
+        web.handle(request);
+        auto end = std::chrono::steady_clock::now();
+        g_tracking = false;
+
+        RouteStats& route = stats[index];
+        route.latencyNs.push_back(
+            (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        route.allocations += g_allocations;
+        route.peakBytes = std::max(route.peakBytes, g_peakBytes);
+        route.responseBytes = request.responseLength();
+        route.status = request.status();
+
+        if (request.responseCount() != 1) {
+            std::printf("FAIL %s answered %u times\n", entry.label, request.responseCount());
+            return 1;
+        }
+    }
+
+    std::printf("%zu requests, seed %u\n", requests, seed);
+    std::printf("%-22s %6s %6s %8s %8s %8s %8s %9s %7s\n", "route", "status", "count",
+                "p50 us", "p99 us", "max us", "allocs", "peak heap", "bytes");
+
+    for (size_t i = 0; i < MIX_COUNT; i++) {
+        RouteStats& route = stats[i];
+        std::vector<uint32_t>& ns = route.latencyNs;
+        if (ns.empty()) continue;
+        std::sort(ns.begin(), ns.end());
+
+        std::printf("%-22s %6d %6zu %8.2f %8.2f %8.2f %8.2f %9zu %7zu\n", MIX[i].label, route.status,
+                    ns.size(), ns[ns.size() / 2] / 1000.0, ns[ns.size() * 99 / 100] / 1000.0,
+                    ns.back() / 1000.0, (double)route.allocations / ns.size(), route.peakBytes,
+                    route.responseBytes);
+    }
+
+    std::printf("credentials saved %u, restarts %u\n", backend.credentialsSaved, backend.restarts);
+    return 0;
+}